@@ -1,246 +1,186 @@
-#include <jni.h>
-#include <string>
-
-#include <android/asset_manager.h>
-#include <android/asset_manager_jni.h>
-
-#include "RoadSignAPI/RoadSignAPI.h"
-#include "FilterManagementLibrary/Logger.h"
-#include "cstdint"
-
-
-typedef cv::Point3_<uint8_t> Pixel;
-
-
-
-double get_us(struct timeval t)
-{
-    return (t.tv_sec * 1000000 + t.tv_usec);
-}
-
-bool roadSignAPIStaticInit(const int numThreads, AAssetManager* const assetManager)
-{
-
-    return RoadSignAPI::RoadSignAPI::staticInit(numThreads, assetManager);
-}
-
-jobjectArray roadSignAPIStaticFeedImage(JNIEnv* env,
-                                        jobject thiz,
-                                        jint width,
-                                        jint height,
-                                        jbyteArray YUVFrameData,
-                                        jintArray bgra,
-                                        jint stride,
-										jint rotate)
-{
-    jbyte * _yuv = env->GetByteArrayElements(YUVFrameData, 0);
-    jint* _bgra = env->GetIntArrayElements(bgra, 0);
-
-
-
-    // Convert YUV data array to cv BGR Mat (BGR, because the RoadSignAPI expects that)
-    struct timeval start_time, stop_time;
-    gettimeofday(&start_time, NULL);
-    cv::Mat yuvMat = cv::Mat(height + (height / 2), width, CV_8UC1, _yuv);
-    cv::Mat bgrMat = cv::Mat(height, width, CV_8UC3);
-
-    if (stride == 1)
-    {
-        cv::cvtColor(yuvMat, bgrMat, cv::COLOR_YUV2BGR_I420, 3);
-    }
-    else
-    {
-        cv::cvtColor(yuvMat, bgrMat, cv::COLOR_YUV2BGR_NV21, 3);
-    }
-
-    yuvMat.release();
-
-	// If the image has to be rotated by 180 then flip it both horizontally and vertically.
-	if (rotate == 180 || rotate == -180)
-	{
-		cv::flip(bgrMat, bgrMat, -1);
-	}
-
-    RoadSignAPI::RoadSignAPI::staticFeedImage(bgrMat);
-
-    const std::vector<RoadSignAPI::DetectedSignCombination>* detectedSignCombinations =
-            RoadSignAPI::RoadSignAPI::staticGetDetectedSignCombinations();
-
-
-
-    std::stringstream ss;
-
-    int numSignCombinations = detectedSignCombinations->size();
-
-
-    int** signsOnPole = new int*[numSignCombinations];
-
-
-    RoadSignAPI::DetectedSignDescriptor* currentSignDescriptor;
-
-    //FilterManagementLibrary::Logger::printfln("numSignCombinations: %d", numSignCombinations);
-
-    int numSignsOnCurrentCombination = 0;
-    int arraySizeForCurrentCombination = 0;
-
-    // Get the int array class
-    jclass intArrayClass = env->FindClass("[I");
-
-    jobjectArray myReturnable2DArray =
-            env->NewObjectArray((jsize) numSignCombinations, intArrayClass,
-                                NULL);
-
-    if (intArrayClass == NULL)
-    {
-        return NULL;
-    }
-
-
-
-
-    for(int i = 0; i < numSignCombinations; i++)
-    {
-        const RoadSignAPI::DetectedSignCombination*
-                currentSignCombination = &detectedSignCombinations->at(i);
-
-        const std::vector<RoadSignAPI::DetectedSignDescriptor>* signsInCurrentCombination =
-                currentSignCombination->getSignsInCombination();
-
-        int minX = 100000;
-        int minY = 100000;
-        int maxX = 0;
-        int maxY = 0;
-
-        numSignsOnCurrentCombination = currentSignCombination->getDetectedSignsAmount();
-        arraySizeForCurrentCombination = 1 + numSignsOnCurrentCombination * 5;
-        signsOnPole[i] = new int[arraySizeForCurrentCombination];
-        signsOnPole[i][0] = numSignsOnCurrentCombination;
-
-        for(int j = 0; j < currentSignCombination->getDetectedSignsAmount(); j++)
-        {
-            const RoadSignAPI::DetectedSignDescriptor* currentSignDescriptor =
-                   &signsInCurrentCombination->at(j);
-
-
-
-            signsOnPole[i][1 + j * 5] = currentSignDescriptor->classifierApprovedClassID;
-            signsOnPole[i][2 + j * 5] = currentSignDescriptor->upperLeft.x;
-            signsOnPole[i][3 + j * 5] = currentSignDescriptor->upperLeft.y;
-            signsOnPole[i][4 + j * 5] = currentSignDescriptor->lowerRight.x;
-            signsOnPole[i][5 + j * 5] = currentSignDescriptor->lowerRight.y;
-
-
-/*
-
-            // Debug (should be removed prior to release)
-
-            if(currentSignDescriptor->upperLeft.x < minX)
-                minX = currentSignDescriptor->upperLeft.x;
-
-            if(currentSignDescriptor->upperLeft.y < minY)
-                minY = currentSignDescriptor->upperLeft.y;
-
-            if(currentSignDescriptor->lowerRight.x > maxX)
-                maxX = currentSignDescriptor->lowerRight.x;
-
-            if(currentSignDescriptor->lowerRight.y > maxY)
-                maxY = currentSignDescriptor->lowerRight.y;
-
-            ss.str("");
-
-            /*labels[detectedSignDescriptor->detectionPredictedClassID - 1] << ": "
-                    <<
-
-            int poleXLeft = currentSignCombination->getGestimatedPolePositionX() - (bgrMat.cols * 0.025f);
-            int poleXRight = currentSignCombination->getGestimatedPolePositionX() + (bgrMat.cols * 0.025f);
-
-            if(poleXLeft < 0)
-                poleXLeft = 0;
-
-            if(poleXRight > bgrMat.cols)
-                poleXRight = bgrMat.cols;
-
-            cv::rectangle(bgrMat, cv::Point(poleXLeft, 0), cv::Point(poleXRight, 700), cv::Scalar(0, 255, 255), 3);
-            cv::rectangle(bgrMat, currentSignDescriptor->upperLeft,
-                          currentSignDescriptor->lowerRight, cv::Scalar(0, 255, 0), 3);
-
-            ss << currentSignDescriptor->classifierApprovedClassID << " " <<
-               currentSignDescriptor->classifierConfidence;
-            cv::putText(bgrMat,
-                        ss.str().c_str(),
-                        cv::Point(currentSignDescriptor->upperLeft.x,
-                                  currentSignDescriptor->upperLeft.y - 20),
-                    // Coordinates
-                        cv::FONT_HERSHEY_COMPLEX_SMALL, // Font
-                        1.0, // Scale. 2.0 = 2x bigger
-                        cv::Scalar(255,255,255), // BGR Color
-                        3);
-                        */
-
-        }
-      //  cv::rectangle(bgrMat, cv::Point(minX, minY), cv::Point(maxX, maxY), cv::Scalar(0, 0, 255), 3);
-
-        jint length2D = 1 + 5 * numSignsOnCurrentCombination;
-        jintArray intArray = env->NewIntArray(length2D);
-        env->SetIntArrayRegion(intArray, (jsize) 0, (jsize) length2D,
-                               (int*) signsOnPole[i]);
-        env->SetObjectArrayElement(myReturnable2DArray, (jsize) i, intArray);
-        env->DeleteLocalRef(intArray);
-    }
-
-
-
-
-    // cleanup array.
-    for(int i = 0; i < numSignCombinations; i++)
-    {
-        delete[] signsOnPole[i];
-    }
-    delete[] signsOnPole;
-
-    // Copy in reverse order, as Java part expects RGB whereas RoadSignAPI uses BGR
-    bgrMat.forEach<Pixel>
-            (
-                    [&](Pixel &p, const int *position) -> void
-                    {
-
-                        int color = (int) p.z << 16 | (int) p.y << 8 |
-                                    (int) p.x | 0xFF000000;
-                        _bgra[position[1] + position[0] * width] = color;
-
-                    }
-            );
-
-    env->ReleaseByteArrayElements(YUVFrameData, _yuv, 0);
-    env->ReleaseIntArrayElements(bgra, _bgra, 0);
-
-    gettimeofday(&stop_time, NULL);
-
-    //FilterManagementLibrary::Logger::printfln("Time: %f",
-    //                                          ((get_us(stop_time) - get_us(start_time)) / (1000.0)));
-    return myReturnable2DArray;
-}
-
-extern "C" JNIEXPORT jboolean
-
-JNICALL
-Java_de_swp_tsd_trafficsigndetection_MainActivity_initRoadSignAPI(
-        JNIEnv *env,
-        jobject /* this */, jint numThreads, jobject javaAssetManager) {
-
-    AAssetManager* const assetManager =
-            AAssetManager_fromJava(env, javaAssetManager);
-    return roadSignAPIStaticInit(numThreads, assetManager);
-}
-
-
-extern "C" JNIEXPORT jobjectArray
-JNICALL
-Java_de_swp_tsd_trafficsigndetection_TSDShutterCameraImageListener_roadSignAPIfeedImage(
-        JNIEnv* env, jobject thiz,
-        jint width, jint height,
-        jbyteArray YUVFrameData, jintArray bgra, jint stride, jint rotate)
-{
-    return roadSignAPIStaticFeedImage(env, thiz, width, height, YUVFrameData,
-                                      bgra, stride, rotate);
+#include <jni.h>
+#include <string>
+
+#include <android/asset_manager.h>
+#include <android/asset_manager_jni.h>
+
+#include "RoadSignAPI/RoadSignAPI.h"
+#include "FilterManagementLibrary/Logger.h"
+#include "cstdint"
+
+
+double get_us(struct timeval t)
+{
+    return (t.tv_sec * 1000000 + t.tv_usec);
+}
+
+bool roadSignAPIStaticInit(const int numThreads, AAssetManager* const assetManager)
+{
+
+    return RoadSignAPI::RoadSignAPI::staticInit(numThreads, assetManager);
+}
+
+jobjectArray roadSignAPIStaticFeedImage(JNIEnv* env,
+                                        jobject thiz,
+                                        jint width,
+                                        jint height,
+                                        jbyteArray YUVFrameData,
+                                        jintArray bgra,
+                                        jint stride,
+										jint rotate)
+{
+    jbyte * _yuv = env->GetByteArrayElements(YUVFrameData, 0);
+    jint* _bgra = env->GetIntArrayElements(bgra, 0);
+
+
+
+    // Feed the frame as it is, the RoadSignAPI samples the pixels it needs
+    // straight from the YUV planes. stride is the pixel stride of the chroma
+    // planes: 1 means I420, otherwise the Java part created NV21.
+    struct timeval start_time, stop_time;
+    gettimeofday(&start_time, NULL);
+
+    const uint8_t* yPlane = reinterpret_cast<const uint8_t*>(_yuv);
+    const uint8_t* chromaPlane = yPlane + width * height;
+
+    const uint8_t* planes[3];
+    int strides[3];
+    FilterManagementLibrary::YUVFormat format;
+
+    if (stride == 1)
+    {
+        planes[0] = yPlane;
+        planes[1] = chromaPlane;
+        planes[2] = chromaPlane + (width / 2) * (height / 2);
+        strides[0] = width;
+        strides[1] = width / 2;
+        strides[2] = width / 2;
+        format = FilterManagementLibrary::YUVFormat::I420;
+    }
+    else
+    {
+        planes[0] = yPlane;
+        planes[1] = chromaPlane;
+        planes[2] = NULL;
+        strides[0] = width;
+        strides[1] = width;
+        strides[2] = 0;
+        format = FilterManagementLibrary::YUVFormat::NV21;
+    }
+
+    // If the image has to be rotated by 180 degrees, the RoadSignAPI
+    // interprets the frame as rotated instead of flipping it in memory.
+    const bool rotate180 = (rotate == 180 || rotate == -180);
+
+    RoadSignAPI::RoadSignAPI::staticFeedImageYUV(planes, strides, format,
+                                                 width, height, rotate180);
+
+    // Serialize the results into a flat buffer (reused for all frames) and
+    // build the Java arrays from it: [numSigns, (classID, x0, y0, x1, y1) * numSigns]
+    static std::vector<uint64_t> resultStorage;
+    const size_t resultSize =
+            RoadSignAPI::RoadSignAPI::staticGetSerializedResultsSize();
+    if (resultStorage.size() * sizeof(uint64_t) < resultSize)
+    {
+        resultStorage.resize(resultSize / sizeof(uint64_t) + 1);
+    }
+
+    uint8_t* resultBuffer = reinterpret_cast<uint8_t*>(resultStorage.data());
+    RoadSignAPI::ResultBufferReader resultReader;
+
+    // If this fails, the reader stays detached and reports no combinations
+    if (RoadSignAPI::RoadSignAPI::staticSerializeResults(resultBuffer,
+            resultStorage.size() * sizeof(uint64_t), NULL))
+    {
+        resultReader.attach(resultBuffer, resultSize);
+    }
+
+    const int numSignCombinations = resultReader.getCombinationCount();
+
+    // Get the int array class
+    jclass intArrayClass = env->FindClass("[I");
+
+    if (intArrayClass == NULL)
+    {
+        return NULL;
+    }
+
+    jobjectArray myReturnable2DArray =
+            env->NewObjectArray((jsize) numSignCombinations, intArrayClass,
+                                NULL);
+
+    static std::vector<jint> signsOnPole;
+
+    for(int i = 0; i < numSignCombinations; i++)
+    {
+        const RoadSignAPI::ResultCombinationSpan* combination =
+                resultReader.getCombination(i);
+        const int numSignsOnCurrentCombination = combination->signCount;
+
+        signsOnPole.resize(1 + numSignsOnCurrentCombination * 5);
+        signsOnPole[0] = numSignsOnCurrentCombination;
+
+        for(int j = 0; j < numSignsOnCurrentCombination; j++)
+        {
+            const RoadSignAPI::ResultSignRecord* sign =
+                    resultReader.getSignOfCombination(i, j);
+
+            signsOnPole[1 + j * 5] = sign->classID;
+            signsOnPole[2 + j * 5] = sign->upperLeftX;
+            signsOnPole[3 + j * 5] = sign->upperLeftY;
+            signsOnPole[4 + j * 5] = sign->lowerRightX;
+            signsOnPole[5 + j * 5] = sign->lowerRightY;
+        }
+
+        jint length2D = signsOnPole.size();
+        jintArray intArray = env->NewIntArray(length2D);
+        env->SetIntArrayRegion(intArray, (jsize) 0, (jsize) length2D,
+                               signsOnPole.data());
+        env->SetObjectArrayElement(myReturnable2DArray, (jsize) i, intArray);
+        env->DeleteLocalRef(intArray);
+    }
+
+    // Java expects 0xAARRGGBB ints, which is BGRA in memory. The frame is
+    // converted straight from the YUV planes in a single pass. As before,
+    // no boxes are drawn into it.
+    RoadSignAPI::AnnotationOptions annotationOptions;
+    annotationOptions.drawSignCombinations = false;
+    RoadSignAPI::RoadSignAPI::staticRenderAnnotatedImage(
+            reinterpret_cast<uint8_t*>(_bgra), width * 4,
+            FilterManagementLibrary::ImageConversion::PixelFormat::BGRA,
+            annotationOptions);
+
+    // The YUV data was only read, no need to copy it back
+    env->ReleaseByteArrayElements(YUVFrameData, _yuv, JNI_ABORT);
+    env->ReleaseIntArrayElements(bgra, _bgra, 0);
+
+    gettimeofday(&stop_time, NULL);
+
+    //FilterManagementLibrary::Logger::printfln("Time: %f",
+    //                                          ((get_us(stop_time) - get_us(start_time)) / (1000.0)));
+    return myReturnable2DArray;
+}
+
+extern "C" JNIEXPORT jboolean
+
+JNICALL
+Java_de_swp_tsd_trafficsigndetection_MainActivity_initRoadSignAPI(
+        JNIEnv *env,
+        jobject /* this */, jint numThreads, jobject javaAssetManager) {
+
+    AAssetManager* const assetManager =
+            AAssetManager_fromJava(env, javaAssetManager);
+    return roadSignAPIStaticInit(numThreads, assetManager);
+}
+
+
+extern "C" JNIEXPORT jobjectArray
+JNICALL
+Java_de_swp_tsd_trafficsigndetection_TSDShutterCameraImageListener_roadSignAPIfeedImage(
+        JNIEnv* env, jobject thiz,
+        jint width, jint height,
+        jbyteArray YUVFrameData, jintArray bgra, jint stride, jint rotate)
+{
+    return roadSignAPIStaticFeedImage(env, thiz, width, height, YUVFrameData,
+                                      bgra, stride, rotate);
 }
\ No newline at end of file
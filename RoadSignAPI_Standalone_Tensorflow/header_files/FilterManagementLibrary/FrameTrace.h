@@ -0,0 +1,175 @@
+/*
+ * FrameTrace.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#ifndef HEADER_FILES_FILTERMANAGEMENTLIBRARY_FRAMETRACE_H_
+#define HEADER_FILES_FILTERMANAGEMENTLIBRARY_FRAMETRACE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "FilterManagementLibrary/PipeSystem/ProcessingPipeline.h"
+
+namespace FilterManagementLibrary
+{
+	/**
+	 * Layout of a trace file, all values little endian (native):
+	 *
+	 * FrameTraceFileHeader
+	 * names:    filterCount filter names followed by counterCount counter
+	 *           names, each terminated by '\0', padded to 8 bytes
+	 *           (namesSize includes the padding)
+	 * records:  FrameTraceRecordHeader, followed by filterCount
+	 *           PipeFilterTiming and counterCount int64_t counters
+	 *
+	 * All records have the same size, so a trace which was not closed
+	 * properly can still be read up to the last complete record.
+	 */
+	struct FrameTraceFileHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t filterCount;
+		uint32_t counterCount;
+		uint64_t namesSize;
+	};
+
+	/**
+	 * Fixed part of the record of a frame.
+	 */
+	struct FrameTraceRecordHeader
+	{
+		uint64_t frameID;
+
+		/**
+		 * Time the frame arrived (i.e. was pushed to a queue), the
+		 * processing started and ended, see Utilities::getTimeUs().
+		 * startTimeUs - arrivalTimeUs is the time the frame waited.
+		 */
+		int64_t arrivalTimeUs;
+		int64_t startTimeUs;
+		int64_t endTimeUs;
+
+		/**
+		 * Defined by the application, i.e. the DegradationFlag bits of
+		 * the RoadSignAPI.
+		 */
+		uint32_t flags;
+
+		/**
+		 * 1 if the frame was processed successfully, 0 otherwise.
+		 */
+		uint32_t processed;
+	};
+
+	/**
+	 * @brief Writes one fixed size record per frame to a trace file, to
+	 * find out offline which frames were slow and why.
+	 *
+	 * append(...) only copies the record into a buffer allocated in
+	 * open(...). Full buffers are written by a background thread, so the
+	 * processing thread never waits for the file. If the background
+	 * thread falls behind by a whole buffer, records are dropped (and
+	 * counted) instead.
+	 * append(...) may be called from several threads.
+	 * The trace can be read with FrameTraceReader, tools/rsapi_trace2json
+	 * converts it for chrome://tracing or Perfetto.
+	 */
+	class FrameTraceWriter
+	{
+		private:
+			FILE* file;
+			std::string path;
+
+			size_t recordSize;
+			uint32_t filterCount;
+			uint32_t counterCount;
+
+			/**
+			 * append(...) writes to activeBuffer, flushThread writes
+			 * flushBuffer to the file while flushPending is set.
+			 */
+			std::vector<uint8_t> activeBuffer;
+			std::vector<uint8_t> flushBuffer;
+			bool flushPending;
+
+			bool stopping;
+			bool writeFailed;
+
+			uint64_t recordCount;
+			uint64_t droppedRecordCount;
+
+			std::mutex mutex;
+			std::condition_variable flushCondition;
+			std::thread flushThread;
+
+			void runFlushThread();
+
+			bool write(const std::vector<uint8_t>& buffer);
+
+		public:
+			bool open(const std::string& path,
+					const std::vector<std::string>& filterNames,
+					const std::vector<std::string>& counterNames,
+					size_t bufferSize = 1 << 20);
+
+			bool append(const FrameTraceRecordHeader& frame,
+					const PipeSystem::PipeFilterTiming* filterTimings,
+					const int64_t* counters);
+
+			bool close();
+
+			bool isOpen() const;
+
+			uint64_t getRecordCount();
+
+			uint64_t getDroppedRecordCount();
+
+			FrameTraceWriter();
+			~FrameTraceWriter();
+	};
+
+	/**
+	 * @brief Reads the records of a trace file written by
+	 * FrameTraceWriter one after another.
+	 */
+	class FrameTraceReader
+	{
+		private:
+			FILE* file;
+
+			std::vector<std::string> filterNames;
+			std::vector<std::string> counterNames;
+
+			std::vector<uint8_t> record;
+
+		public:
+			bool open(const std::string& path);
+
+			void close();
+
+			const std::vector<std::string>& getFilterNames() const;
+
+			const std::vector<std::string>& getCounterNames() const;
+
+			bool readNext(FrameTraceRecordHeader* frame,
+					std::vector<PipeSystem::PipeFilterTiming>* filterTimings,
+					std::vector<int64_t>* counters);
+
+			FrameTraceReader();
+			~FrameTraceReader();
+	};
+}
+
+
+#endif /* HEADER_FILES_FILTERMANAGEMENTLIBRARY_FRAMETRACE_H_ */
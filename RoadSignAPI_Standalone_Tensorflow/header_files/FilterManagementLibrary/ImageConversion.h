@@ -0,0 +1,112 @@
+/*
+ * ImageConversion.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#ifndef HEADER_FILES_FILTERMANAGEMENTLIBRARY_IMAGECONVERSION_H_
+#define HEADER_FILES_FILTERMANAGEMENTLIBRARY_IMAGECONVERSION_H_
+
+#include <stdint.h>
+
+namespace FilterManagementLibrary
+{
+	/**
+	 * Color conversion routines between YUV 4:2:0 and packed RGB formats,
+	 * ported from the Tensorflow Android example (yuv2rgb.cc and
+	 * rgb2yuv.cc) so they can be used on every platform.
+	 *
+	 * The YUV to RGB direction is implemented as row kernels which
+	 * exist as scalar version and as SSE4.1 / AVX2 (x86) and NEON (ARM)
+	 * versions. The fastest kernel supported by the executing CPU is
+	 * selected at runtime (x86) or at compile time (NEON).
+	 * All kernels use the same integer BT.601 arithmetic as the original
+	 * scalar code and thus produce bit-exact identical output.
+	 * Repacking BGR rows (OpenCV 8UC3) into the other pixel formats uses
+	 * the same kernel selection.
+	 *
+	 * Unlike TensorflowOpenCVUtils, this does not depend on OpenCV
+	 * or Tensorflow.
+	 */
+	class ImageConversion
+	{
+		public:
+
+			/**
+			 * Memory layout of packed output pixels.
+			 */
+			enum class PixelFormat
+			{
+				/**
+				 * 3 bytes per pixel in B, G, R order (OpenCV 8UC3).
+				 */
+				BGR,
+
+				/**
+				 * 4 bytes per pixel in B, G, R, A order. On little endian
+				 * systems this equals 0xAARRGGBB integers, which is what
+				 * Java's Bitmap.setPixels(int[] ...) and the Tensorflow
+				 * example's ARGB8888 functions use.
+				 */
+				BGRA,
+
+				/**
+				 * 4 bytes per pixel in R, G, B, A order (i.e. the memory
+				 * layout of an Android ARGB_8888 Bitmap or OpenGL RGBA).
+				 */
+				RGBA
+			};
+
+			/**
+			 * Row kernel implementations, see selectKernel(...).
+			 */
+			enum class Kernel
+			{
+				AUTO,
+				SCALAR,
+				SSE41,
+				AVX2,
+				NEON
+			};
+
+			static void convertYUVRow(const uint8_t* yRow,
+					const uint8_t* uRow, const uint8_t* vRow,
+					uint8_t* dstRow, int width, PixelFormat format);
+
+			static void convertYUVRowScalar(const uint8_t* yRow,
+					const uint8_t* uRow, const uint8_t* vRow,
+					uint8_t* dstRow, int width, PixelFormat format);
+
+			static void convertBGRRow(const uint8_t* bgrRow,
+					uint8_t* dstRow, int width, PixelFormat format);
+
+			static void convertBGRRowScalar(const uint8_t* bgrRow,
+					uint8_t* dstRow, int width, PixelFormat format);
+
+			static bool selectKernel(Kernel kernel);
+
+			static Kernel getActiveKernel();
+
+			static const char* getKernelName(Kernel kernel);
+
+			// Ports of the Tensorflow Android example functions, same
+			// semantics and output.
+
+			static void convertYUV420ToARGB8888(const uint8_t* const yData,
+					const uint8_t* const uData, const uint8_t* const vData,
+					uint32_t* const output, const int width, const int height,
+					const int yRowStride, const int uvRowStride,
+					const int uvPixelStride);
+
+			static void convertYUV420SPToARGB8888(const uint8_t* const yData,
+					const uint8_t* const uvData, uint32_t* const output,
+					const int width, const int height);
+
+			static void convertARGB8888ToYUV420SP(const uint32_t* const input,
+					uint8_t* const output, const int width, const int height);
+	};
+}
+
+
+#endif /* HEADER_FILES_FILTERMANAGEMENTLIBRARY_IMAGECONVERSION_H_ */
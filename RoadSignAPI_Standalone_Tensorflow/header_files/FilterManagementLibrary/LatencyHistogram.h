@@ -0,0 +1,66 @@
+/*
+ * LatencyHistogram.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#ifndef HEADER_FILES_FILTERMANAGEMENTLIBRARY_LATENCYHISTOGRAM_H_
+#define HEADER_FILES_FILTERMANAGEMENTLIBRARY_LATENCYHISTOGRAM_H_
+
+#include <stdint.h>
+
+namespace FilterManagementLibrary
+{
+	/**
+	 * @brief Histogram of durations in microseconds with a fixed memory
+	 * footprint.
+	 *
+	 * Every power of two is split into 8 linear buckets, so recording is
+	 * a few bit operations and percentiles are accurate to 12.5% from
+	 * 1 microsecond up to days, without any allocation. Values below 8
+	 * microseconds are counted exactly.
+	 * Not thread safe, each histogram is meant to be written by one
+	 * thread at a time.
+	 */
+	class LatencyHistogram
+	{
+		public:
+			static const int SUB_BUCKET_BITS = 3;
+			static const int SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+			static const int BUCKET_COUNT = 62 * SUB_BUCKET_COUNT;
+
+		private:
+			uint64_t counts[BUCKET_COUNT];
+			uint64_t count;
+			int64_t total;
+			int64_t minimum;
+			int64_t maximum;
+
+			static int getBucketIndex(int64_t valueUs);
+
+			static int64_t getBucketUpperBound(int bucketIndex);
+
+		public:
+			void record(int64_t valueUs);
+
+			void merge(const LatencyHistogram& other);
+
+			void reset();
+
+			uint64_t getCount() const;
+
+			int64_t getMinimum() const;
+
+			int64_t getMaximum() const;
+
+			double getMean() const;
+
+			int64_t getPercentile(double percentile) const;
+
+			LatencyHistogram();
+	};
+}
+
+
+#endif /* HEADER_FILES_FILTERMANAGEMENTLIBRARY_LATENCYHISTOGRAM_H_ */
@@ -0,0 +1,182 @@
+/*
+ * MPMCQueue.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#ifndef HEADER_FILES_FILTERMANAGEMENTLIBRARY_MPMCQUEUE_H_
+#define HEADER_FILES_FILTERMANAGEMENTLIBRARY_MPMCQUEUE_H_
+
+#include <stddef.h>
+
+#include <atomic>
+#include <memory>
+
+namespace FilterManagementLibrary
+{
+	/**
+	 * @brief Bounded lock-free queue for any number of producer and
+	 * consumer threads.
+	 *
+	 * Array based queue after Dmitry Vyukov: every cell carries a
+	 * sequence number telling whether it is free for the producer or
+	 * filled for the consumer of a given position, so producers and
+	 * consumers only contend on their own position counter (one
+	 * compare-and-swap per operation) and never wait for each other.
+	 * tryPush(...) fails if the queue is full, tryPop(...) if it is empty.
+	 * T needs to be cheap to copy, i.e. a pointer or an index.
+	 */
+	template<typename T>
+	class MPMCQueue
+	{
+		private:
+			struct Cell
+			{
+				std::atomic<size_t> sequence;
+				T data;
+			};
+
+			std::unique_ptr<Cell[]> cells;
+
+			size_t mask = 0;
+
+			// Kept on separate cache lines, as they are written by
+			// different threads
+			char padding0[64];
+			std::atomic<size_t> enqueuePosition;
+			char padding1[64];
+			std::atomic<size_t> dequeuePosition;
+			char padding2[64];
+
+		public:
+			MPMCQueue() : enqueuePosition(0), dequeuePosition(0)
+			{
+			}
+
+			/**
+			 * @brief Allocates the cells, must be called before the queue
+			 * is used and not while it is used.
+			 *
+			 * @param size_t capacity minimum number of elements the
+			 * queue can hold, rounded up to the next power of two
+			 *
+			 * @return bool true on success, false if capacity is 0
+			 */
+			bool init(size_t capacity)
+			{
+				if(capacity == 0)
+					return false;
+
+				size_t size = 1;
+				while(size < capacity)
+				{
+					size <<= 1;
+				}
+
+				this->cells.reset(new Cell[size]);
+				this->mask = size - 1;
+
+				for(size_t i = 0; i < size; i++)
+				{
+					this->cells[i].sequence.store(i,
+							std::memory_order_relaxed);
+				}
+
+				this->enqueuePosition.store(0, std::memory_order_relaxed);
+				this->dequeuePosition.store(0, std::memory_order_relaxed);
+
+				return true;
+			}
+
+			size_t getCapacity() const
+			{
+				return this->cells ? this->mask + 1 : 0;
+			}
+
+			/**
+			 * @brief Appends value to the queue.
+			 *
+			 * @return bool true on success, false if the queue is full
+			 */
+			bool tryPush(const T& value)
+			{
+				size_t position =
+						this->enqueuePosition.load(std::memory_order_relaxed);
+
+				for(;;)
+				{
+					Cell* cell = &this->cells[position & this->mask];
+					const size_t sequence =
+							cell->sequence.load(std::memory_order_acquire);
+					const ptrdiff_t difference =
+							(ptrdiff_t) sequence - (ptrdiff_t) position;
+
+					if(difference == 0)
+					{
+						// The cell is free, try to claim it
+						if(this->enqueuePosition.compare_exchange_weak(
+								position, position + 1,
+								std::memory_order_relaxed))
+						{
+							cell->data = value;
+							cell->sequence.store(position + 1,
+									std::memory_order_release);
+							return true;
+						}
+					}
+					else if(difference < 0)
+						return false;
+					else
+					{
+						position = this->enqueuePosition.load(
+								std::memory_order_relaxed);
+					}
+				}
+			}
+
+			/**
+			 * @brief Removes the oldest element from the queue.
+			 *
+			 * @return bool true on success, false if the queue is empty
+			 */
+			bool tryPop(T* value)
+			{
+				size_t position =
+						this->dequeuePosition.load(std::memory_order_relaxed);
+
+				for(;;)
+				{
+					Cell* cell = &this->cells[position & this->mask];
+					const size_t sequence =
+							cell->sequence.load(std::memory_order_acquire);
+					const ptrdiff_t difference =
+							(ptrdiff_t) sequence - (ptrdiff_t) (position + 1);
+
+					if(difference == 0)
+					{
+						// The cell is filled, try to claim it
+						if(this->dequeuePosition.compare_exchange_weak(
+								position, position + 1,
+								std::memory_order_relaxed))
+						{
+							*value = cell->data;
+							cell->sequence.store(position + this->mask + 1,
+									std::memory_order_release);
+							return true;
+						}
+					}
+					else if(difference < 0)
+						return false;
+					else
+					{
+						position = this->dequeuePosition.load(
+								std::memory_order_relaxed);
+					}
+				}
+			}
+	};
+}
+
+
+#endif /* HEADER_FILES_FILTERMANAGEMENTLIBRARY_MPMCQUEUE_H_ */
@@ -0,0 +1,153 @@
+/*
+ * MemoryAccounting.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#ifndef HEADER_FILES_FILTERMANAGEMENTLIBRARY_MEMORYACCOUNTING_H_
+#define HEADER_FILES_FILTERMANAGEMENTLIBRARY_MEMORYACCOUNTING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+namespace FilterManagementLibrary
+{
+	/**
+	 * Snapshot of the counters of a MemoryAccount.
+	 */
+	struct MemoryUsage
+	{
+		/**
+		 * Bytes allocated and not freed yet.
+		 */
+		int64_t currentBytes = 0;
+
+		/**
+		 * Maximum of currentBytes since the account was created or
+		 * MemoryAccount::resetPeak() was called.
+		 */
+		int64_t peakBytes = 0;
+
+		/**
+		 * Number of allocations not freed yet.
+		 */
+		int64_t liveAllocations = 0;
+
+		/**
+		 * Number of allocations since the account was created.
+		 */
+		uint64_t totalAllocations = 0;
+	};
+
+	/**
+	 * Counters of a MemoryAccount, opaque outside of MemoryAccounting.cpp.
+	 * They outlive the account as long as allocations charged to it are
+	 * not freed, so accounts can be destroyed at any time.
+	 */
+	struct MemoryAccountState;
+
+	/**
+	 * @brief Counts the bytes allocated on behalf of a component (i.e. a
+	 * model or a pipeline), to find out where the memory of the process
+	 * goes.
+	 *
+	 * Allocations are charged to the account set for the allocating thread
+	 * by a MemoryAccountScope, and to all of its parents. Freeing them
+	 * subtracts them from the accounts they were charged to, regardless of
+	 * the thread freeing them.
+	 * Tensorflow tensors (and everything else Tensorflow allocates through
+	 * its CPU allocator) are charged automatically, cv::Mat buffers after
+	 * enableOpenCVAccounting() was called. Both are additionally counted
+	 * by a subsystem account (getTensorflowAccount(), getOpenCVAccount()),
+	 * which includes the allocations of threads without account.
+	 * Tensorflow runs most operations of a session on its own threads,
+	 * which have no account: the weights and buffers created by
+	 * Session::Create(...) and the first inference are charged to the
+	 * model, the intermediate results of the inferences only to the
+	 * Tensorflow subsystem account.
+	 */
+	class MemoryAccount
+	{
+		private:
+			std::string name;
+
+			MemoryAccountState* state;
+
+			MemoryAccount(const MemoryAccount&) = delete;
+			MemoryAccount& operator=(const MemoryAccount&) = delete;
+
+		public:
+			explicit MemoryAccount(const std::string& name,
+					MemoryAccount* parent = NULL);
+
+			const std::string& getName() const;
+
+			void setParent(MemoryAccount* parent);
+
+			MemoryUsage getUsage() const;
+
+			void resetPeak();
+
+			static MemoryAccount* getCurrent();
+
+			static MemoryAccountState* charge(MemoryAccount* subsystem,
+					int64_t bytes);
+
+			static void release(MemoryAccount* subsystem,
+					MemoryAccountState* account, int64_t bytes);
+
+			static MemoryAccount* getTensorflowAccount();
+
+			static MemoryAccount* getOpenCVAccount();
+
+			static void enableOpenCVAccounting();
+
+			~MemoryAccount();
+	};
+
+	/**
+	 * @brief Sets the account the allocations of the calling thread are
+	 * charged to, until the scope ends (the previous account is restored
+	 * then). NULL charges them to the subsystem accounts only.
+	 */
+	class MemoryAccountScope
+	{
+		private:
+			MemoryAccount* previousAccount;
+
+			MemoryAccountScope(const MemoryAccountScope&) = delete;
+			MemoryAccountScope& operator=(const MemoryAccountScope&) = delete;
+
+		public:
+			explicit MemoryAccountScope(MemoryAccount* account);
+
+			~MemoryAccountScope();
+	};
+
+	/**
+	 * @brief Charges memory which is not allocated through a tracked
+	 * allocator (i.e. a protobuf message) to the current account of the
+	 * calling thread, until the charge is destroyed.
+	 */
+	class MemoryAccountCharge
+	{
+		private:
+			MemoryAccount* subsystem;
+			MemoryAccountState* account;
+			int64_t bytes;
+
+			MemoryAccountCharge(const MemoryAccountCharge&) = delete;
+			MemoryAccountCharge& operator=(const MemoryAccountCharge&) =
+					delete;
+
+		public:
+			MemoryAccountCharge(MemoryAccount* subsystem, int64_t bytes);
+
+			~MemoryAccountCharge();
+	};
+}
+
+
+#endif /* HEADER_FILES_FILTERMANAGEMENTLIBRARY_MEMORYACCOUNTING_H_ */
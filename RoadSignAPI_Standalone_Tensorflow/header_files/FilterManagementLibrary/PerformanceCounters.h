@@ -0,0 +1,124 @@
+/*
+ * PerformanceCounters.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#ifndef HEADER_FILES_FILTERMANAGEMENTLIBRARY_PERFORMANCECOUNTERS_H_
+#define HEADER_FILES_FILTERMANAGEMENTLIBRARY_PERFORMANCECOUNTERS_H_
+
+#include <stdint.h>
+
+namespace FilterManagementLibrary
+{
+	/**
+	 * Hardware counter values summed up over several measurements, see
+	 * PerformanceCounters.
+	 */
+	struct PerformanceCounterValues
+	{
+		uint64_t cycles = 0;
+		uint64_t instructions = 0;
+
+		/**
+		 * Last level cache misses (PERF_COUNT_HW_CACHE_MISSES).
+		 */
+		uint64_t cacheMisses = 0;
+
+		uint64_t branchMisses = 0;
+
+		/**
+		 * Number of measurements summed up.
+		 */
+		uint64_t samples = 0;
+
+		double getInstructionsPerCycle() const;
+
+		double getCacheMissesPerKiloInstruction() const;
+
+		double getBranchMissesPerKiloInstruction() const;
+	};
+
+	/**
+	 * Raw counter values at a point in time, see PerformanceCounters::read(...).
+	 */
+	struct PerformanceCounterReading
+	{
+		uint64_t values[4];
+
+		/**
+		 * False if the counters of the thread are not available.
+		 */
+		bool valid;
+	};
+
+	/**
+	 * @brief Hardware performance counters (cycles, instructions, last
+	 * level cache misses, branch misses) of the calling thread, using
+	 * perf_event_open (Linux and Android only).
+	 *
+	 * Measure a piece of code by calling read(...) before and
+	 * accumulate(...) after it. The counters are opened as one group per
+	 * thread on first use and kept open until the process exits. They
+	 * only count the calling thread: work handed to other threads (i.e.
+	 * the intra op thread pool of a Tensorflow session) is not included.
+	 * If the kernel multiplexes the counters, the values are scaled by
+	 * the share of time they were running.
+	 * If the counters can not be opened (not supported by the kernel or
+	 * the CPU, or prohibited by /proc/sys/kernel/perf_event_paranoid), this
+	 * is logged once per thread and nothing is counted. Counters the CPU
+	 * does not support (i.e. cache misses in some VMs) stay 0.
+	 */
+	class PerformanceCounters
+	{
+		public:
+			enum Counter
+			{
+				COUNTER_CYCLES,
+				COUNTER_INSTRUCTIONS,
+				COUNTER_CACHE_MISSES,
+				COUNTER_BRANCH_MISSES,
+				COUNTER_COUNT
+			};
+
+		private:
+			/**
+			 * File descriptor of the group leader, -1 if no counter
+			 * could be opened.
+			 */
+			int groupFD;
+
+			int counterFDs[COUNTER_COUNT];
+
+			/**
+			 * Position of each counter in the values read from the
+			 * group, -1 if the counter could not be opened.
+			 */
+			int groupIndices[COUNTER_COUNT];
+
+			int openedCounterCount;
+
+			PerformanceCounters();
+
+			PerformanceCounters(const PerformanceCounters&) = delete;
+			PerformanceCounters& operator=(const PerformanceCounters&) = delete;
+
+			bool open();
+
+			bool readValues(PerformanceCounterReading* reading);
+
+			static PerformanceCounters* getThreadCounters();
+
+		public:
+			static void read(PerformanceCounterReading* reading);
+
+			static void accumulate(const PerformanceCounterReading& start,
+					PerformanceCounterValues* values);
+
+			static bool isAvailable();
+	};
+}
+
+
+#endif /* HEADER_FILES_FILTERMANAGEMENTLIBRARY_PERFORMANCECOUNTERS_H_ */
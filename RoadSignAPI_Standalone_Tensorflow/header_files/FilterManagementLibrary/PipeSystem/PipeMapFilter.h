@@ -0,0 +1,87 @@
+/*
+ * PipeMapFilter.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#ifndef HEADER_FILES_FILTERMANAGEMENTLIBRARY_PIPESYSTEM_PIPEMAPFILTER_H_
+#define HEADER_FILES_FILTERMANAGEMENTLIBRARY_PIPESYSTEM_PIPEMAPFILTER_H_
+
+#include "FilterManagementLibrary/PipeSystem/PipeFilter.h"
+
+#include <functional>
+#include <vector>
+
+namespace FilterManagementLibrary
+{
+	namespace PipeSystem
+	{
+		/**
+		 * @brief Base class for filters which do the same work for every
+		 * item of a list (i.e. for every detected sign).
+		 *
+		 * Instead of process(), derived filters implement
+		 * getItemCount() and processItem(...); process() distributes the
+		 * items over the worker threads of the pipe (see
+		 * ProcessingPipeline::setWorkerThreadCount(...)) and waits until
+		 * all of them are done:
+		 * 	beginItems(...) is called once before any item, on the
+		 * 	calling thread. It gets the number of items and of threads,
+		 * 	so that a filter can size one result slot per item and one
+		 * 	scratch buffer per thread.
+		 * 	processItem(itemIndex, workerIndex) is called for every item,
+		 * 	possibly concurrently. It may only write to the result slot of
+		 * 	its item and to the scratch buffer of its worker index; two
+		 * 	items running at the same time never get the same worker
+		 * 	index. As results are stored by item index, their order does
+		 * 	not depend on which thread processed which item.
+		 * 	endItems() is called once after all items, on the calling
+		 * 	thread. It has to indicate which filter to invoke next, just
+		 * 	like process() would.
+		 * If there are less than minParallelItems items (or the pipe has
+		 * no workers), all items run on the calling thread with worker
+		 * index 0.
+		 */
+		class PipeMapFilter : public PipeFilter
+		{
+			private:
+				/**
+				 * Result of processItem(...) of each item; char instead of
+				 * bool, as the workers write it concurrently.
+				 */
+				std::vector<char> itemResults;
+
+				/**
+				 * Calls processItem(...), created once so that no
+				 * std::function needs to be created for every data set.
+				 */
+				std::function<void(int, int)> runItem;
+
+			protected:
+				/**
+				 * Minimum number of items to distribute them over the
+				 * worker threads, set it higher for very cheap items.
+				 */
+				int minParallelItems = 2;
+
+				virtual int getItemCount() = 0;
+
+				virtual bool beginItems(int itemCount, int workerCount);
+
+				virtual bool processItem(int itemIndex, int workerIndex) = 0;
+
+				virtual bool endItems() = 0;
+
+				bool process();
+
+			public:
+				PipeMapFilter();
+
+				virtual ~PipeMapFilter();
+		};
+	}
+}
+
+
+#endif /* HEADER_FILES_FILTERMANAGEMENTLIBRARY_PIPESYSTEM_PIPEMAPFILTER_H_ */
@@ -0,0 +1,101 @@
+/*
+ * PipeWorkerPool.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#ifndef HEADER_FILES_FILTERMANAGEMENTLIBRARY_PIPESYSTEM_PIPEWORKERPOOL_H_
+#define HEADER_FILES_FILTERMANAGEMENTLIBRARY_PIPESYSTEM_PIPEWORKERPOOL_H_
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "FilterManagementLibrary/MemoryAccounting.h"
+
+namespace FilterManagementLibrary
+{
+	namespace PipeSystem
+	{
+		/**
+		 * @brief Fixed set of threads the ProcessingPipeline runs
+		 * independent work on.
+		 *
+		 * run(...) distributes a number of tasks over the worker threads
+		 * and the calling thread and returns when all of them are done.
+		 * The threads are created once by start(...) and sleep while
+		 * there is nothing to do, so running small batches every frame
+		 * does not create any threads.
+		 * Calls to run(...) from one of the tasks of a running batch
+		 * (like a PipeMapFilter running in DAG scheduling mode) run their
+		 * tasks on the calling thread, with the thread index of the
+		 * calling task. Calls from other threads wait until the running
+		 * batch is finished.
+		 * The tasks run with the MemoryAccount of the thread calling
+		 * run(...), so their allocations are charged to it.
+		 */
+		class PipeWorkerPool
+		{
+			private:
+				std::vector<std::thread> workers;
+
+				std::mutex mutex;
+
+				/**
+				 * Signaled when a batch is started or the pool is stopped.
+				 */
+				std::condition_variable tasksAvailable;
+
+				/**
+				 * Signaled when the last task of a batch is finished.
+				 */
+				std::condition_variable tasksFinished;
+
+				/**
+				 * Signaled when a batch is done and the next one may start.
+				 */
+				std::condition_variable batchFinished;
+
+				/**
+				 * The batch currently running, only valid as long as run(...)
+				 * did not return. Tasks are handed out in order of their
+				 * index, nextTask is the next one to hand out.
+				 */
+				const std::function<void(int, int)>* task = nullptr;
+				int taskCount = 0;
+				int nextTask = 0;
+				int unfinishedTasks = 0;
+
+				/**
+				 * Current MemoryAccount of the thread which started the
+				 * batch.
+				 */
+				MemoryAccount* taskMemoryAccount = nullptr;
+
+				bool stopping = false;
+
+				bool runNextTask(std::unique_lock<std::mutex>* lock,
+						int workerIndex);
+
+				void workerLoop(int workerIndex);
+
+			public:
+				bool start(int threadCount);
+
+				void stop();
+
+				int getThreadCount() const;
+
+				void run(int taskCount,
+						const std::function<void(int, int)>& task);
+
+				~PipeWorkerPool();
+		};
+	}
+}
+
+
+#endif /* HEADER_FILES_FILTERMANAGEMENTLIBRARY_PIPESYSTEM_PIPEWORKERPOOL_H_ */
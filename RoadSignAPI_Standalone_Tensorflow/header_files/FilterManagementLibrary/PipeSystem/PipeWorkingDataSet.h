@@ -1,35 +1,35 @@
-/*
- * PipeWorkingDataSet.h
- *
- *  Created on: 30.05.2018
- *      Author: Patrick Langer
- */
-
-#ifndef HEADER_FILES_FILTERMANAGEMENTLIBRARY_PIPESYSTEM_PIPEWORKINGDATASET_H_
-#define HEADER_FILES_FILTERMANAGEMENTLIBRARY_PIPESYSTEM_PIPEWORKINGDATASET_H_
-
-
-
-namespace FilterManagementLibrary
-{
-	namespace PipeSystem
-	{
-
-		/**
-		* @brief Template structfor PipeWorkingDataSets
-		*
-		* In from this derived structs, the working data set for
-		* the specific pipe environment should be implemented.
-		* Refer to ProcessingPipeline for more context; when it's used and how.
-		*/
-		struct PipeWorkingDataSet
-		{
-
-
-
-		};
-	}
-}
-
-
-#endif /* HEADER_FILES_FILTERMANAGEMENTLIBRARY_PIPESYSTEM_PIPEWORKINGDATASET_H_ */
+/*
+ * PipeWorkingDataSet.h
+ *
+ *  Created on: 30.05.2018
+ *      Author: Patrick Langer
+ */
+
+#ifndef HEADER_FILES_FILTERMANAGEMENTLIBRARY_PIPESYSTEM_PIPEWORKINGDATASET_H_
+#define HEADER_FILES_FILTERMANAGEMENTLIBRARY_PIPESYSTEM_PIPEWORKINGDATASET_H_
+
+
+
+namespace FilterManagementLibrary
+{
+	namespace PipeSystem
+	{
+
+		/**
+		* @brief Template structfor PipeWorkingDataSets
+		*
+		* In from this derived structs, the working data set for
+		* the specific pipe environment should be implemented.
+		* Refer to ProcessingPipeline for more context; when it's used and how.
+		*/
+		struct PipeWorkingDataSet
+		{
+
+
+
+		};
+	}
+}
+
+
+#endif /* HEADER_FILES_FILTERMANAGEMENTLIBRARY_PIPESYSTEM_PIPEWORKINGDATASET_H_ */
@@ -1,176 +1,372 @@
-/*
- * ProcessingPipeline.h
- *
- *  Created on: 30.05.2018
- *      Author: Patrick Langer
- */
-
-#ifndef HEADER_FILES_FILTERMANAGEMENTLIBRARY_PIPESYSTEM_PROCESSINGPIPELINE_H_
-#define HEADER_FILES_FILTERMANAGEMENTLIBRARY_PIPESYSTEM_PROCESSINGPIPELINE_H_
-
-#include "FilterManagementLibrary/PipeSystem/PipeFilter.h"
-#include "FilterManagementLibrary/PipeSystem/PipeWorkingDataSet.h"
-#include "FilterManagementLibrary/PipeSystem/PipeRegisteredFilters.h"
-#include <vector>
-
-
-class PipeFilter;
-namespace FilterManagementLibrary
-{
-	namespace PipeSystem
-	{
-		/**
-		 * @brief Pipeline of the pipes and filters architecture.
-		 *
-		 * The Pipes-and-Filters-Architecture is a software architectural
-		 * pattern usually used for systems processing data or data streams
-		 * in a specific way.
-		 * A pipe, which can be seen as a sequence of processing operations,
-		 * represents the connection between the individual filters
-		 * (processing steps).
-		 * You may refer to {@link PipeFilter} for a more detailed explanation of the
-		 * filters part of the architecture.
-		 *
-		 * The output of a processing step (filter) can be seen as the input
-		 * for the subsequent processing step, although in this implementation
-		 * the input and output data is mapped to a single object allocated
-		 * on the heap, the {@link PipeWorkingDataSet}.
-		 *
-		 * As this implementation is based on the
-		 * "Tee-and-Joins-Pipes-and-Filters-Architecture", the order in which
-		 * the filters are executed can change dynamically.
-		 * For now this is implemented as follows:
-		 * 	Each filter provides a function process().
-		 * 	In this function a filter either has to indicate which filter
-		 * 	shall be invoked next, or that it claims to be the last filter
-		 * 	of the processing at least for the current iteration, which means
-		 * 	the current data set has been fully processed.
-		 * 	The filter may decide differently for other input data, however.
-		 * 	Strictly speaking, this means every filter has to give a hint to
-		 * 	the pipe to allow it to decide what to do next.
-		 *  For this, each filter knows the ID's of all registered filters
-		 *  on the pipe itself does belong to. These ID's are provided via
-		 *  a shared object, a derivate of the PipeRegisteredFilters struct.
-         * 
-         *  @image latex api_class_filtermanagement.png width=16cm
-         *  @image html api_class_filtermanagement.svg
-		 */
-		class ProcessingPipeline
-		{
-			public:
-				enum ErrorType
-				{
-					/**
-					 * Standard value set on initialization.
-					 * Needed because getLastError() shall not return a
-					 * random value (which could cause unexpected behavior)
-					 */
-					ERROR_NONE,
-
-					/**
-					 * E.g. if a filter neither marked a next filter nor
-					 * indicated the workingDataSet has been fully processed.
-					 */
-					ERROR_LOGIC_FAULT,
-
-					/**
-					 * If a filter returned false in process()
-					 */
-					ERROR_FILTER_INDICATED_FAILURE,
-
-					/**
-					 * If a filter wants to invoke a next filter
-					 * with an ID that is not assigned.
-					 */
-					ERROR_FILTER_ID_NOT_FOUND,
-
-					/**
-					 * When we reun initByPipeSetup() on a filter
-					 * and it returned false, which means the
-					 * filter could not be set up and all filters depending
-					 * on it may not be able to perform their tasks.
-					 */
-					ERROR_FILTER_SETUP_FAILED,
-
-				};
-
-
-			private:
-				/**
-				 * ID of the currently active filter.
-				 * Each filter ID is unique and has to be positive.
-				 * Uniqueness is assured by the pipe itself due to
-				 * continuous numerating in registerFilter()
-				 */
-				int currentFilterID = 0;
-
-				/**
-				 * Stores whether the last filter indicated the current
-				 * data set has been fully processed.
-				 */
-				bool processingFinishied = false;
-
-
-				/**
-				 * Indicate whether we shall manage the heap allocated memory
-				 * of workingDataSet, pipeRegisteredFiltersHeader and the
-				 * themselves, i.e. explicitly delete those externally
-				 * allocated objects in our destructor.
-				 */
-				bool manageExternalAllocatedRessources = true;
-
-				/**
-				 * Just a list containing pointers to all filters registered
-				 * on this instance of the pipe.
-				 */
-				std::vector<PipeFilter*> registeredFilters;
-
-				/**
-				 * Error code of the last error that happened.
-				 * See ProcessingPipeline::ErrorType
-				 */
-				ErrorType lastError;
-
-			protected:
-
-				/**
-				 * Pointer to a derivate of PipeWorkingDataSet, being the
-				 * dataSet the filters of the pipe will work on.
-				 * Will be passed to all filters using their
-				 * setCredentials(...) function.
-				 */
-				PipeWorkingDataSet* workingDataSet;
-
-
-				/**
-				 * Pointer to a derivate of PipeRegisteredFilters,
-				 * being a container for all ID's of the filters registered
-				 * to the pipe, mapped to a unique name.
-				 * Via this all filters know the ID's of every other filter
-				 * registered to the pipe.
-				 * The pointer will be passed to all filters using their
-				 * setCredentials(...) function.
-				 */
-				PipeRegisteredFilters* pipeRegisteredFiltersHeader;
-
-			public:
-				ProcessingPipeline(PipeWorkingDataSet* workingDataSet,
-						PipeRegisteredFilters* pipeRegisteredFiltersHeader,
-						bool manageExternalAllocatedRessources = true);
-
-				void registerFilter(PipeFilter* filter, int* filterID);
-
-				ErrorType getLastError() const;
-
-				bool setup();
-
-				bool processCurrentDataSet();
-
-				~ProcessingPipeline();
-		};
-	}
-}
-
-
-
-#endif /* HEADER_FILES_FILTERMANAGEMENTLIBRARY_PIPESYSTEM_PROCESSINGPIPELINE_H_ */
+/*
+ * ProcessingPipeline.h
+ *
+ *  Created on: 30.05.2018
+ *      Author: Patrick Langer
+ */
+
+#ifndef HEADER_FILES_FILTERMANAGEMENTLIBRARY_PIPESYSTEM_PROCESSINGPIPELINE_H_
+#define HEADER_FILES_FILTERMANAGEMENTLIBRARY_PIPESYSTEM_PROCESSINGPIPELINE_H_
+
+#include "FilterManagementLibrary/PipeSystem/PipeFilter.h"
+#include "FilterManagementLibrary/PipeSystem/PipeWorkingDataSet.h"
+#include "FilterManagementLibrary/PipeSystem/PipeRegisteredFilters.h"
+#include "FilterManagementLibrary/PipeSystem/PipeWorkerPool.h"
+#include "FilterManagementLibrary/LatencyHistogram.h"
+#include "FilterManagementLibrary/PerformanceCounters.h"
+#include "FilterManagementLibrary/MemoryAccounting.h"
+#include <stdint.h>
+#include <vector>
+
+
+class PipeFilter;
+namespace FilterManagementLibrary
+{
+	namespace PipeSystem
+	{
+		/**
+		 * Counters the ProcessingPipeline keeps for each registered filter.
+		 */
+		struct PipeFilterStatistics
+		{
+			/**
+			 * Number of times the filter was invoked (including the
+			 * times it was skipped).
+			 */
+			uint64_t invocations = 0;
+
+			/**
+			 * Number of times the filter was skipped, because it
+			 * declared its input empty (see PipeFilter::isInputEmpty()).
+			 */
+			uint64_t skips = 0;
+
+			/**
+			 * Durations of the process() calls of the filter (skips are
+			 * not counted).
+			 */
+			LatencyHistogram processingTime;
+
+			/**
+			 * Hardware counters of the process() calls of the filter, on
+			 * the thread calling process() (work the filter hands to the
+			 * worker pool is not included). Only counted while enabled,
+			 * see ProcessingPipeline::setPerformanceCountersEnabled(...).
+			 */
+			PerformanceCounterValues processCounters;
+
+			/**
+			 * Hardware counters of the part of process() the filter
+			 * marked (see PipeFilter::beginCountedSection()), i.e. the
+			 * model inferences (Session::Run) of a TFNNBasedPipeFilter.
+			 * Included in processCounters.
+			 */
+			PerformanceCounterValues sectionCounters;
+		};
+
+		/**
+		 * When a filter ran on the last data set, see
+		 * ProcessingPipeline::getLastDataSetTimings().
+		 */
+		struct PipeFilterTiming
+		{
+			/**
+			 * Times (see Utilities::getTimeUs()) the filter was invoked
+			 * and returned, both 0 if it was not invoked. A skipped
+			 * filter (see PipeFilter::isInputEmpty()) has the same start
+			 * and end time.
+			 */
+			int64_t startTimeUs = 0;
+			int64_t endTimeUs = 0;
+		};
+
+		/**
+		 * @brief Pipeline of the pipes and filters architecture.
+		 *
+		 * The Pipes-and-Filters-Architecture is a software architectural
+		 * pattern usually used for systems processing data or data streams
+		 * in a specific way.
+		 * A pipe, which can be seen as a sequence of processing operations,
+		 * represents the connection between the individual filters
+		 * (processing steps).
+		 * You may refer to {@link PipeFilter} for a more detailed explanation of the
+		 * filters part of the architecture.
+		 *
+		 * The output of a processing step (filter) can be seen as the input
+		 * for the subsequent processing step, although in this implementation
+		 * the input and output data is mapped to a single object allocated
+		 * on the heap, the {@link PipeWorkingDataSet}.
+		 *
+		 * As this implementation is based on the
+		 * "Tee-and-Joins-Pipes-and-Filters-Architecture", the order in which
+		 * the filters are executed can change dynamically.
+		 * For now this is implemented as follows:
+		 * 	Each filter provides a function process().
+		 * 	In this function a filter either has to indicate which filter
+		 * 	shall be invoked next, or that it claims to be the last filter
+		 * 	of the processing at least for the current iteration, which means
+		 * 	the current data set has been fully processed.
+		 * 	The filter may decide differently for other input data, however.
+		 * 	Strictly speaking, this means every filter has to give a hint to
+		 * 	the pipe to allow it to decide what to do next.
+		 *  For this, each filter knows the ID's of all registered filters
+		 *  on the pipe itself does belong to. These ID's are provided via
+		 *  a shared object, a derivate of the PipeRegisteredFilters struct.
+		 *  Filters with nothing to work on (see PipeFilter::isInputEmpty())
+		 *  are short-circuited: only their onInputEmpty() function is
+		 *  called, which just hands over to the next filter.
+		 *
+		 *  Optionally, the pipe can be run in DAG scheduling mode instead
+		 *  (see setSchedulingMode(...)): filters declare the data they read
+		 *  and write (PipeFilter::declareInput(...) / declareOutput(...)),
+		 *  the pipe derives the dependencies between the filters from this
+		 *  once and runs them level by level, with the filters of a level
+		 *  (which don't depend on each other) running concurrently.
+		 *  invokeNext(...) is ignored then, indicateProcessingFinished()
+		 *  skips everything depending on the filter (conditional edges).
+         * 
+         *  @image latex api_class_filtermanagement.png width=16cm
+         *  @image html api_class_filtermanagement.svg
+		 */
+		class ProcessingPipeline
+		{
+			public:
+				enum ErrorType
+				{
+					/**
+					 * Standard value set on initialization.
+					 * Needed because getLastError() shall not return a
+					 * random value (which could cause unexpected behavior)
+					 */
+					ERROR_NONE,
+
+					/**
+					 * E.g. if a filter neither marked a next filter nor
+					 * indicated the workingDataSet has been fully processed.
+					 */
+					ERROR_LOGIC_FAULT,
+
+					/**
+					 * If a filter returned false in process()
+					 */
+					ERROR_FILTER_INDICATED_FAILURE,
+
+					/**
+					 * If a filter wants to invoke a next filter
+					 * with an ID that is not assigned.
+					 */
+					ERROR_FILTER_ID_NOT_FOUND,
+
+					/**
+					 * When we reun initByPipeSetup() on a filter
+					 * and it returned false, which means the
+					 * filter could not be set up and all filters depending
+					 * on it may not be able to perform their tasks.
+					 */
+					ERROR_FILTER_SETUP_FAILED,
+
+					/**
+					 * If the declared data flow of the filters can't be
+					 * scheduled in DAG scheduling mode, i.e. it contains
+					 * a cycle or a data has two producers.
+					 */
+					ERROR_SCHEDULE_INVALID,
+
+				};
+
+				enum SchedulingMode
+				{
+					/**
+					 * The filters decide which filter runs next
+					 * (invokeNext(...)), one after another.
+					 */
+					SCHEDULING_DYNAMIC,
+
+					/**
+					 * The order follows from the declared inputs and
+					 * outputs of the filters, independent filters run
+					 * concurrently.
+					 */
+					SCHEDULING_DAG
+				};
+
+
+			private:
+				/**
+				 * ID of the currently active filter.
+				 * Each filter ID is unique and has to be positive.
+				 * Uniqueness is assured by the pipe itself due to
+				 * continuous numerating in registerFilter()
+				 */
+				int currentFilterID = 0;
+
+				/**
+				 * Stores whether the last filter indicated the current
+				 * data set has been fully processed.
+				 */
+				bool processingFinishied = false;
+
+
+				/**
+				 * Indicate whether we shall manage the heap allocated memory
+				 * of workingDataSet, pipeRegisteredFiltersHeader and the
+				 * themselves, i.e. explicitly delete those externally
+				 * allocated objects in our destructor.
+				 */
+				bool manageExternalAllocatedRessources = true;
+
+				/**
+				 * Just a list containing pointers to all filters registered
+				 * on this instance of the pipe.
+				 */
+				std::vector<PipeFilter*> registeredFilters;
+
+				/**
+				 * Error code of the last error that happened.
+				 * See ProcessingPipeline::ErrorType
+				 */
+				ErrorType lastError;
+
+				/**
+				 * Counters of each registered filter, indexed by filter ID.
+				 */
+				std::vector<PipeFilterStatistics> filterStatistics;
+
+				/**
+				 * Invocation times of each registered filter on the last
+				 * data set, indexed by filter ID.
+				 */
+				std::vector<PipeFilterTiming> dataSetTimings;
+
+				/**
+				 * Durations of the processCurrentDataSet() calls.
+				 */
+				LatencyHistogram dataSetLatency;
+
+				SchedulingMode schedulingMode = SCHEDULING_DYNAMIC;
+
+				/**
+				 * Whether the filters are measured with hardware counters,
+				 * see setPerformanceCountersEnabled(...).
+				 */
+				bool performanceCountersEnabled = false;
+
+				/**
+				 * Memory allocated by the filters while processing data
+				 * sets, see getMemoryAccount().
+				 */
+				MemoryAccount memoryAccount;
+
+				/**
+				 * Whether setup() was successful, the schedule is built
+				 * then.
+				 */
+				bool isSetUp = false;
+
+				/**
+				 * Threads (in addition to the calling thread) running the
+				 * filters of a level in DAG scheduling mode and the items
+				 * of PipeMapFilters.
+				 */
+				int workerThreadCount = 0;
+				PipeWorkerPool workerPool;
+
+				/**
+				 * Static schedule for DAG scheduling mode: the IDs of the
+				 * filters of each level, in registration order. All
+				 * filters a filter depends on are in previous levels.
+				 */
+				std::vector<std::vector<int> > scheduleLevels;
+
+				/**
+				 * IDs of the filters directly depending on each filter,
+				 * indexed by filter ID.
+				 */
+				std::vector<std::vector<int> > filterDependents;
+
+				/**
+				 * Per data set state of the DAG scheduling mode, indexed
+				 * by filter ID. char instead of bool, as the workers write
+				 * the results concurrently.
+				 */
+				std::vector<char> skippedFilters;
+				std::vector<char> filterResults;
+				std::vector<int> runnableFilters;
+
+				bool invokeFilter(PipeFilter* filter);
+
+				bool buildSchedule();
+
+				bool processCurrentDataSetByDAG();
+
+				bool processCurrentDataSetDynamically();
+
+			protected:
+
+				/**
+				 * Pointer to a derivate of PipeWorkingDataSet, being the
+				 * dataSet the filters of the pipe will work on.
+				 * Will be passed to all filters using their
+				 * setCredentials(...) function.
+				 */
+				PipeWorkingDataSet* workingDataSet;
+
+
+				/**
+				 * Pointer to a derivate of PipeRegisteredFilters,
+				 * being a container for all ID's of the filters registered
+				 * to the pipe, mapped to a unique name.
+				 * Via this all filters know the ID's of every other filter
+				 * registered to the pipe.
+				 * The pointer will be passed to all filters using their
+				 * setCredentials(...) function.
+				 */
+				PipeRegisteredFilters* pipeRegisteredFiltersHeader;
+
+			public:
+				ProcessingPipeline(PipeWorkingDataSet* workingDataSet,
+						PipeRegisteredFilters* pipeRegisteredFiltersHeader,
+						bool manageExternalAllocatedRessources = true);
+
+				void registerFilter(PipeFilter* filter, int* filterID);
+
+				ErrorType getLastError() const;
+
+				bool setup();
+
+				bool setSchedulingMode(SchedulingMode schedulingMode,
+						int workerThreadCount = 0);
+
+				SchedulingMode getSchedulingMode() const;
+
+				bool setWorkerThreadCount(int workerThreadCount);
+
+				const std::vector<std::vector<int> >*
+						getScheduleLevels() const;
+
+				bool processCurrentDataSet();
+
+				const std::vector<PipeFilterStatistics>*
+						getFilterStatistics() const;
+
+				const LatencyHistogram* getDataSetLatency() const;
+
+				const std::vector<PipeFilterTiming>*
+						getLastDataSetTimings() const;
+
+				void resetFilterStatistics();
+
+				bool setPerformanceCountersEnabled(bool enabled);
+
+				bool arePerformanceCountersEnabled() const;
+
+				MemoryAccount* getMemoryAccount();
+
+				~ProcessingPipeline();
+		};
+	}
+}
+
+
+
+#endif /* HEADER_FILES_FILTERMANAGEMENTLIBRARY_PIPESYSTEM_PROCESSINGPIPELINE_H_ */
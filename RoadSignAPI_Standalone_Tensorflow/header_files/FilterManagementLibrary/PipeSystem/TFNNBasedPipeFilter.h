@@ -1,124 +1,348 @@
-/*
- * TFNNBasedFilter.h
- *
- *  Created on: 30.05.2018
- *      Author: Patrick Langer
- */
-
-#ifndef HEADER_FILES_FILTERMANAGEMENTLIBRARY_PIPESYSTEM_TFNNBASEDPIPEFILTER_H_
-#define HEADER_FILES_FILTERMANAGEMENTLIBRARY_PIPESYSTEM_TFNNBASEDPIPEFILTER_H_
-
-// Tensorflow Neuronal Network Based Filter
-#include <stdint.h>
-#include "FilterManagementLibrary/TensorflowIntegration/TensorflowNNInstance.h"
-#include "FilterManagementLibrary/TensorflowIntegration/TensorflowResultContainer.h"
-#include "FilterManagementLibrary/TensorflowIntegration/TensorflowNNModelDescription.h"
-#include "FilterManagementLibrary/PipeSystem/PipeWorkingDataSet.h"
-#include "FilterManagementLibrary/PipeSystem/PipeFilter.h"
-
-
-namespace FilterManagementLibrary
-{
-	namespace PipeSystem
-	{
-		/**
-		 * @brief Abstract template class to derive Tensorflow based filters from.
-		 *
-		 * A TFNNBasedPipeFilter is a special type of filter (thus derived from
-		 * PipeFilter) already providing some functions to easily implemented
-		 * filters based on Tensorflow Neuronal Networks.
-		 * Strictly speaking the main processing of these filters is done by
-		 * a preloaded Tensorflow model. The filter may take a part of the
-		 * working data set and feed it into the model using the output of
-		 * it's inference to generate the result of this filter.
-		 * If you use it, make sure to call evaluateInputVectorByNN() in order
-		 * to let the neuronal network do it's predictions.
-		 *
-		 * For this, the TFNNBasedPipeFilter abstract class uses a
-		 * TensorflowNNInstance (TensorflowNNInstanceClassifier is not used,
-		 * as this is just a test class for basic classification models
-		 * with a predefined way of interpreting their outputs, which is
-		 * not assured to be a general way to interprete the output
-		 * other classificator networks may use).
-		 *
-		 * It provides a predefined easy way to apply input vectors from a
-		 * 3 dimensional array of uint8_t's (applyNNImageInputVector).
-		 * If the underlying model expects floats however, the conversion
-		 * will be done automatically (see TensorflowNNInstance for
-		 * more details).
-		 * If a more specific way to apply an input is needed, the function
-		 * getInputTensor() is provided which provides a direct access to the
-		 * input tensor of the Neural Network Instance.
-		 * Also keep in mind we provide some utility functions for easy
-		 * OpenCV integration! In detail, offering some functions to directly
-		 * apply a cv::Mat to an input tensor (see TensorflowOpenCVUtils).
-		 *
-		 * A basic example to performantely effective
-		 * apply a matrix to the underlying neuronal network, expecting
-		 * uint8_t as input vector, from within a derivate of
-		 * TFNNBasedPipeFilter would be:
-		 * TensorflowOpenCVUtils::fastApplyCVMatOnInputTensorUInt8(&yourMat,
-		 * 	this->getNNInputTensor());
-		 * 	simple as that!
-		 *
-		 * 	However, keep in mind TensorflowOpenCVUtils do NOT have to be
-		 * 	compiled with and linked to a exectuable or libary using the
-		 * 	FilterManagementLibrary, if for example you don't use OpenCV
-		 * 	(Mat's as input methods).
-		 */
-		class TFNNBasedPipeFilter : public PipeFilter
-		{
-			private:
-				/**
-				 * The filter local instance of the underlying
-				 * tensorflow neuronal network model.
-				 */
-				TFIntegration::TensorflowNNInstance tfNNInstance;
-
-			protected:
-
-				bool applyNNImageInputVector(uint8_t*** image,
-									const int height,
-									const int width, const int channels);
-				bool evaluateInputVectorByNN();
-
-				tensorflow::Tensor* getNNInputTensor();
-
-				const FilterManagementLibrary::TFIntegration::
-				TensorflowNNModelDescription* getNNModelDescription() const;
-
-				TFIntegration::TensorflowNNInstance::
-						ErrorType getNeuralNetLastError() const;
-
-				virtual void onNNEvaluationFinished
-								(const TFIntegration::TensorflowResultContainer
-										resultContainer) = 0;
-
-			public:
-
-				TFNNBasedPipeFilter(TFIntegration::TensorflowNNModelDescription
-						nnModelDescription,
-						int numThreads);
-
-
-
-				void adjustModelFile(std::string modelFile);
-
-				bool setupModelFromFile();
-
-				#ifdef __ANDROID__
-					bool setupModelFromAssets(
-							AAssetManager* const assetManager);
-				#endif
-
-				virtual ~TFNNBasedPipeFilter();
-
-
-
-		};
-	}
-}
-
-
-
-#endif /* HEADER_FILES_FILTERMANAGEMENTLIBRARY_PIPESYSTEM_TFNNBASEDPIPEFILTER_H_ */
+/*
+ * TFNNBasedFilter.h
+ *
+ *  Created on: 30.05.2018
+ *      Author: Patrick Langer
+ */
+
+#ifndef HEADER_FILES_FILTERMANAGEMENTLIBRARY_PIPESYSTEM_TFNNBASEDPIPEFILTER_H_
+#define HEADER_FILES_FILTERMANAGEMENTLIBRARY_PIPESYSTEM_TFNNBASEDPIPEFILTER_H_
+
+// Tensorflow Neuronal Network Based Filter
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "FilterManagementLibrary/TensorflowIntegration/TensorflowNNInstance.h"
+#include "FilterManagementLibrary/TensorflowIntegration/TensorflowResultContainer.h"
+#include "FilterManagementLibrary/TensorflowIntegration/TensorflowNNModelDescription.h"
+#include "FilterManagementLibrary/TensorflowIntegration/TensorflowOutputRecording.h"
+#include "FilterManagementLibrary/PipeSystem/PipeWorkingDataSet.h"
+#include "FilterManagementLibrary/PipeSystem/PipeFilter.h"
+#include "FilterManagementLibrary/MemoryAccounting.h"
+
+
+namespace FilterManagementLibrary
+{
+	namespace PipeSystem
+	{
+		/**
+		 * @brief Abstract template class to derive Tensorflow based filters from.
+		 *
+		 * A TFNNBasedPipeFilter is a special type of filter (thus derived from
+		 * PipeFilter) already providing some functions to easily implemented
+		 * filters based on Tensorflow Neuronal Networks.
+		 * Strictly speaking the main processing of these filters is done by
+		 * a preloaded Tensorflow model. The filter may take a part of the
+		 * working data set and feed it into the model using the output of
+		 * it's inference to generate the result of this filter.
+		 * If you use it, make sure to call evaluateInputVectorByNN() in order
+		 * to let the neuronal network do it's predictions.
+		 *
+		 * For this, the TFNNBasedPipeFilter abstract class uses a
+		 * TensorflowNNInstance (TensorflowNNInstanceClassifier is not used,
+		 * as this is just a test class for basic classification models
+		 * with a predefined way of interpreting their outputs, which is
+		 * not assured to be a general way to interprete the output
+		 * other classificator networks may use).
+		 *
+		 * It provides a predefined easy way to apply input vectors from a
+		 * 3 dimensional array of uint8_t's (applyNNImageInputVector).
+		 * If the underlying model expects floats however, the conversion
+		 * will be done automatically (see TensorflowNNInstance for
+		 * more details).
+		 * If a more specific way to apply an input is needed, the function
+		 * getInputTensor() is provided which provides a direct access to the
+		 * input tensor of the Neural Network Instance.
+		 * Also keep in mind we provide some utility functions for easy
+		 * OpenCV integration! In detail, offering some functions to directly
+		 * apply a cv::Mat to an input tensor (see TensorflowOpenCVUtils).
+		 *
+		 * A basic example to performantely effective
+		 * apply a matrix to the underlying neuronal network, expecting
+		 * uint8_t as input vector, from within a derivate of
+		 * TFNNBasedPipeFilter would be:
+		 * TensorflowOpenCVUtils::fastApplyCVMatOnInputTensorUInt8(&yourMat,
+		 * 	this->getNNInputTensor());
+		 * 	simple as that!
+		 * 	For quantized int8 models, use fastApplyCVMatOnInputTensorInt8
+		 * 	together with getNNInputQuantizationTable() instead.
+		 * 	Output tensors of quantized models can be read as float using
+		 * 	TensorflowResultContainer::getFloatOutputTensorByID(...).
+		 *
+		 * 	However, keep in mind TensorflowOpenCVUtils do NOT have to be
+		 * 	compiled with and linked to a exectuable or libary using the
+		 * 	FilterManagementLibrary, if for example you don't use OpenCV
+		 * 	(Mat's as input methods).
+	
+		 *
+		 * 	Several variants of the model (i.e. different input sizes or a
+		 * 	quantized version) can be added with addModelVariant(...).
+		 * 	All of them are loaded up front, so selectModelVariant(...)
+		 * 	can switch between them from one data set to the next without
+		 * 	setting up the pipe again.
+		 *
+		 * 	A model variant can also be replaced by a new model (i.e. an
+		 * 	updated version of it) while the pipe keeps running:
+		 * 	replaceModelVariantFromFile(...) loads and warms up the new
+		 * 	model on a separate thread. Once it is ready, the next
+		 * 	applyPendingModelSwap() call, which has to happen between two
+		 * 	data sets, swaps it in. The previous model is closed on the
+		 * 	loading thread afterwards, so neither loading nor closing a
+		 * 	model stalls the processing of the data sets.
+		 *
+		 * 	The outputs of the inferences can be recorded to a file
+		 * 	(setOutputRecorder(...)) and replayed instead of running the
+		 * 	model (setOutputReplay(...)), i.e. to test changes of the
+		 * 	interpretation of the outputs on many data sets without
+		 * 	inference cost. Outputs are identified by the hash of the
+		 * 	input tensor.
+		 */
+		class TFNNBasedPipeFilter : public PipeFilter
+		{
+			public:
+
+				enum class ModelSwapState
+				{
+					/**
+					 * No model was replaced so far.
+					 */
+					MODEL_SWAP_NONE,
+
+					/**
+					 * The new model is loaded on the loading thread.
+					 */
+					MODEL_SWAP_LOADING,
+
+					/**
+					 * The new model is loaded and warmed up, it will be
+					 * swapped in by the next applyPendingModelSwap() call.
+					 */
+					MODEL_SWAP_READY,
+
+					/**
+					 * The new model was swapped in.
+					 */
+					MODEL_SWAP_DONE,
+
+					/**
+					 * The new model could not be loaded or its warm-up
+					 * inference failed, the previous one is still used.
+					 */
+					MODEL_SWAP_FAILED,
+				};
+
+			private:
+				/**
+				 * Memory of the models of all variants, declared before
+				 * them so it is constructed first.
+				 */
+				MemoryAccount memoryAccount;
+
+				/**
+				 * The filter local instances of the underlying
+				 * tensorflow neuronal network model, one per model variant.
+				 * Index 0 is the model passed to the constructor.
+				 */
+				std::vector<std::unique_ptr<
+						TFIntegration::TensorflowNNInstance> > tfNNInstances;
+
+				/**
+				 * Whether the model of each variant was set up already.
+				 */
+				std::vector<bool> modelVariantLoaded;
+
+				/**
+				 * Index of the variant used for inference.
+				 */
+				int activeModelVariant = 0;
+
+				/**
+				 * Passed to the instances of all variants.
+				 */
+				int numThreads;
+
+				/**
+				 * Thread loading the model of replaceModelVariantFromFile(...)
+				 * and closing the model it replaced.
+				 */
+				std::thread modelLoader;
+
+				/**
+				 * Protects pendingNNInstance, retiredNNInstance and
+				 * cancelModelSwap.
+				 */
+				std::mutex modelSwapMutex;
+
+				/**
+				 * Wakes up the loading thread once the new model was
+				 * swapped in (or the filter is destroyed).
+				 */
+				std::condition_variable modelSwapCondition;
+
+				/**
+				 * Loaded and warmed up model waiting to be swapped in.
+				 */
+				std::unique_ptr<TFIntegration::TensorflowNNInstance>
+						pendingNNInstance;
+
+				/**
+				 * Model which was swapped out, to be closed by the
+				 * loading thread.
+				 */
+				std::unique_ptr<TFIntegration::TensorflowNNInstance>
+						retiredNNInstance;
+
+				/**
+				 * Model variant pendingNNInstance replaces.
+				 */
+				int pendingModelVariant = 0;
+
+				/**
+				 * Set by the destructor to stop the loading thread from
+				 * waiting for the swap.
+				 */
+				bool cancelModelSwap = false;
+
+				/**
+				 * Read on every data set by applyPendingModelSwap(), so
+				 * it does not need to lock modelSwapMutex.
+				 */
+				std::atomic<ModelSwapState> modelSwapState;
+
+				/**
+				 * Records the outputs of every inference if set, not
+				 * owned by the filter.
+				 */
+				TFIntegration::TensorflowOutputRecorder* outputRecorder =
+						NULL;
+
+				/**
+				 * Replaces the inference by recorded outputs if set, not
+				 * owned by the filter.
+				 */
+				const TFIntegration::TensorflowOutputRecording*
+						outputRecording = NULL;
+
+				/**
+				 * Outputs found in outputRecording for the current input.
+				 */
+				std::vector<tensorflow::Tensor> replayedOutputTensors;
+
+				/**
+				 * Number of successful evaluateInputVectorByNN() calls.
+				 */
+				uint64_t inferenceCount = 0;
+
+				uint64_t getInputHash();
+
+				TFIntegration::TensorflowNNInstance* getActiveNNInstance()
+						const;
+
+				static void logSetupError(TFIntegration::TensorflowNNInstance::
+						ErrorType error);
+
+				bool startModelLoader(int modelVariant,
+						TFIntegration::TensorflowNNModelDescription
+						nnModelDescription,
+						std::function<bool(TFIntegration::TensorflowNNInstance*)>
+						setupModel);
+
+				void runModelLoader(std::unique_ptr<
+						TFIntegration::TensorflowNNInstance> nnInstance,
+						std::function<bool(TFIntegration::TensorflowNNInstance*)>
+						setupModel);
+
+			protected:
+
+				bool applyNNImageInputVector(uint8_t*** image,
+									const int height,
+									const int width, const int channels);
+				bool evaluateInputVectorByNN();
+
+				tensorflow::Tensor* getNNInputTensor();
+
+				const int8_t* getNNInputQuantizationTable() const;
+
+				const FilterManagementLibrary::TFIntegration::
+				TensorflowNNModelDescription* getNNModelDescription() const;
+
+				TFIntegration::TensorflowNNInstance::
+						ErrorType getNeuralNetLastError() const;
+
+				virtual void onNNEvaluationFinished
+								(const TFIntegration::TensorflowResultContainer
+										resultContainer) = 0;
+
+				// Called after selectModelVariant(...) switched the model,
+				// i.e. to adapt to a different input size
+				virtual void onModelVariantChanged();
+
+			public:
+
+				TFNNBasedPipeFilter(TFIntegration::TensorflowNNModelDescription
+						nnModelDescription,
+						int numThreads);
+
+
+
+				void adjustModelFile(std::string modelFile);
+
+				int addModelVariant(TFIntegration::TensorflowNNModelDescription
+						nnModelDescription);
+
+				bool selectModelVariant(int modelVariant);
+
+				int getModelVariant() const;
+
+				int getModelVariantCount() const;
+
+				bool setupModelFromFile();
+
+				#ifdef __ANDROID__
+					bool setupModelFromAssets(
+							AAssetManager* const assetManager);
+				#endif
+
+				bool replaceModelVariantFromFile(int modelVariant,
+						TFIntegration::TensorflowNNModelDescription
+						nnModelDescription);
+
+				#ifdef __ANDROID__
+					bool replaceModelVariantFromAssets(int modelVariant,
+							TFIntegration::TensorflowNNModelDescription
+							nnModelDescription,
+							AAssetManager* const assetManager);
+				#endif
+
+				bool applyPendingModelSwap();
+
+				ModelSwapState getModelSwapState() const;
+
+				uint64_t getInferenceCount() const;
+
+				MemoryAccount* getMemoryAccount();
+
+				void setOutputRecorder(
+						TFIntegration::TensorflowOutputRecorder*
+						outputRecorder);
+
+				void setOutputReplay(
+						const TFIntegration::TensorflowOutputRecording*
+						outputRecording);
+
+				virtual ~TFNNBasedPipeFilter();
+
+
+
+		};
+	}
+}
+
+
+
+#endif /* HEADER_FILES_FILTERMANAGEMENTLIBRARY_PIPESYSTEM_TFNNBASEDPIPEFILTER_H_ */
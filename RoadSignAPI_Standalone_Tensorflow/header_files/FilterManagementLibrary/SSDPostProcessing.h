@@ -0,0 +1,240 @@
+/*
+ * SSDPostProcessing.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#ifndef HEADER_FILES_FILTERMANAGEMENTLIBRARY_SSDPOSTPROCESSING_H_
+#define HEADER_FILES_FILTERMANAGEMENTLIBRARY_SSDPOSTPROCESSING_H_
+
+#include <utility>
+#include <vector>
+
+namespace FilterManagementLibrary
+{
+	/**
+	 * How the class predictions of an SSD model are converted to scores.
+	 */
+	enum SSDScoreConversion
+	{
+		/**
+		 * The predictions are scores already.
+		 */
+		SSD_SCORE_IDENTITY = 0,
+
+		/**
+		 * Sigmoid per class (SSDLite models of the Tensorflow object
+		 * detection API).
+		 */
+		SSD_SCORE_SIGMOID,
+
+		/**
+		 * Softmax over the classes (including the background class) of
+		 * each anchor.
+		 */
+		SSD_SCORE_SOFTMAX
+	};
+
+	/**
+	 * Parameters of SSDPostProcessor, the defaults match the SSDLite
+	 * configurations of the Tensorflow object detection API.
+	 */
+	struct SSDPostProcessingParameters
+	{
+		/**
+		 * The score a detection needs to exceed.
+		 */
+		float scoreThreshold = 0.0f;
+
+		/**
+		 * Maximum number of detections returned, the ones with the
+		 * highest scores are kept.
+		 */
+		int maxDetections = 100;
+
+		/**
+		 * Only used for raw model outputs. Two detections of the same
+		 * class whose IoU exceeds this threshold are considered to be
+		 * the same object, the one with the lower score is suppressed
+		 * (1 disables the non maximum suppression).
+		 */
+		float iouThreshold = 0.6f;
+
+		/**
+		 * Only used for raw model outputs. Maximum number of detections
+		 * per class which are kept by the non maximum suppression.
+		 */
+		int maxDetectionsPerClass = 10;
+
+		/**
+		 * Only used for raw model outputs.
+		 */
+		SSDScoreConversion scoreConversion = SSD_SCORE_SIGMOID;
+
+		/**
+		 * Only used for raw model outputs. The box encodings are divided
+		 * by these scales before they are applied to the anchors
+		 * (see FasterRcnnBoxCoder of the object detection API).
+		 */
+		float yScale = 10.0f;
+		float xScale = 10.0f;
+		float heightScale = 5.0f;
+		float widthScale = 5.0f;
+	};
+
+	/**
+	 * Parameters of the anchors of an SSD model (see
+	 * SSDPostProcessor::generateAnchors(...)), the defaults match
+	 * ssd_anchor_generator in the pipeline.config of our SSDLite model.
+	 */
+	struct SSDAnchorParameters
+	{
+		/**
+		 * Number of feature maps the boxes are predicted on.
+		 */
+		int layerCount = 6;
+
+		/**
+		 * Scale of the anchors of the first and the last feature map,
+		 * relative to the (shorter side of the) input. The scales of the
+		 * layers in between are interpolated linearly.
+		 */
+		float minScale = 0.2f;
+		float maxScale = 0.95f;
+
+		/**
+		 * Aspect ratios (width / height) of the anchors on every
+		 * location.
+		 */
+		std::vector<float> aspectRatios = {1.0f, 2.0f, 0.5f, 3.0f, 0.3333f};
+
+		/**
+		 * Aspect ratio of the additional anchor per location, whose
+		 * scale lies between the ones of this and the next layer
+		 * (0 to leave it out).
+		 */
+		float interpolatedScaleAspectRatio = 1.0f;
+
+		/**
+		 * If true, the first layer only has three anchors per location,
+		 * (0.1, 1.0), (scale, 2.0) and (scale, 0.5).
+		 */
+		bool reduceBoxesInLowestLayer = true;
+
+		/**
+		 * Stride of the first feature map in pixels of the input, the
+		 * stride doubles from layer to layer. The size of a feature map
+		 * is the input size divided by its stride, rounded up (like the
+		 * SAME padded convolutions of MobilenetV2 do).
+		 */
+		int firstLayerStride = 16;
+	};
+
+	/**
+	 * Detections decoded by SSDPostProcessor, one vector per member (row i
+	 * of all vectors describes the same detection), sorted by descending
+	 * score. The boxes are normalized to [0, 1].
+	 */
+	struct SSDDetections
+	{
+		std::vector<float> yMin;
+		std::vector<float> xMin;
+		std::vector<float> yMax;
+		std::vector<float> xMax;
+
+		std::vector<float> scores;
+
+		/**
+		 * Class IDs as the postprocessing of the object detection API
+		 * outputs them (1 is the first class after the background).
+		 */
+		std::vector<int> classIDs;
+
+		int size() const;
+
+		void resize(int count);
+	};
+
+	/**
+	 * @brief Turns the output of an SSD detection model into detections.
+	 *
+	 * Supports models which include the postprocessing of the object
+	 * detection API (detection_boxes, detection_scores, ...), as well as
+	 * models which output the raw box encodings and class predictions
+	 * per anchor, which are then decoded here instead of by Tensorflow
+	 * operations (anchor decoding, score conversion and the per class non
+	 * maximum suppression, with the same results as the postprocessing
+	 * of the object detection API).
+	 * In both cases the scores are thresholded first (without branches,
+	 * the indices of the remaining ones are compacted into a candidate
+	 * list), only the candidates are sorted, converted and decoded.
+	 * The buffers are kept between calls, so after the first frames no
+	 * memory is allocated. Not thread safe, use one instance per thread.
+	 */
+	class SSDPostProcessor
+	{
+		private:
+			/**
+			 * Indices of the scores which exceed the threshold.
+			 */
+			std::vector<int> candidates;
+
+			/**
+			 * Converted scores of the raw class predictions, anchor by
+			 * anchor (only used for SSD_SCORE_SOFTMAX).
+			 */
+			std::vector<float> convertedScores;
+
+			/**
+			 * (converted score, index) of the candidates, sorted by
+			 * sortCandidates(...).
+			 */
+			std::vector<std::pair<float, int> > rankedCandidates;
+
+			/**
+			 * Decoded and clipped boxes (ymin, xmin, ymax, xmax) and
+			 * their areas, one per entry of rankedCandidates (only used
+			 * for raw model outputs).
+			 */
+			std::vector<float> candidateBoxes;
+			std::vector<float> candidateAreas;
+
+			/**
+			 * Positions in rankedCandidates of the candidates kept by
+			 * the non maximum suppression.
+			 */
+			std::vector<int> keptCandidates;
+
+			int selectCandidates(const float* scores, int rowCount,
+					int columnCount, int firstColumn, float threshold);
+
+			void sortCandidates(int maxDetections);
+
+			int decodeCandidateBoxes(const float* boxEncodings,
+					const float* anchors, int classCount,
+					const SSDPostProcessingParameters& parameters);
+
+			void suppressNonMaximumCandidates(int classCount,
+					const SSDPostProcessingParameters& parameters);
+
+		public:
+			void decodeDetections(const float* boxes, const float* scores,
+					const float* classes, int count,
+					const SSDPostProcessingParameters& parameters,
+					SSDDetections* detections);
+
+			void decodeRawOutputs(const float* boxEncodings,
+					const float* classPredictions, const float* anchors,
+					int anchorCount, int classCount,
+					const SSDPostProcessingParameters& parameters,
+					SSDDetections* detections);
+
+			static int generateAnchors(const SSDAnchorParameters& parameters,
+					int inputWidth, int inputHeight,
+					std::vector<float>* anchors);
+	};
+}
+
+
+#endif /* HEADER_FILES_FILTERMANAGEMENTLIBRARY_SSDPOSTPROCESSING_H_ */
@@ -0,0 +1,102 @@
+/*
+ * SharedMemoryRing.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#ifndef HEADER_FILES_FILTERMANAGEMENTLIBRARY_SHAREDMEMORYRING_H_
+#define HEADER_FILES_FILTERMANAGEMENTLIBRARY_SHAREDMEMORYRING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <string>
+
+namespace FilterManagementLibrary
+{
+	/**
+	 * Control block at the start of the shared memory segment of a
+	 * SharedMemoryRing. The slots follow at dataOffset.
+	 */
+	struct SharedMemoryRingHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t slotCount;
+		uint32_t slotSize;
+		uint32_t dataOffset;
+
+		/**
+		 * Set by the creator once the header is initialized, cleared when
+		 * the ring is closed. Waiting processes are woken up then.
+		 */
+		std::atomic<uint32_t> open;
+
+		/**
+		 * Number of slots committed by the writer / released by the
+		 * reader so far (wrapping). Both are used as futex words.
+		 */
+		std::atomic<uint32_t> writeSequence;
+		std::atomic<uint32_t> readSequence;
+	};
+
+	/**
+	 * Single producer / single consumer ring of fixed size slots in a
+	 * POSIX shared memory segment, to pass data between processes
+	 * without copying it through sockets or pipes.
+	 *
+	 * The writer fills a slot in place (acquireWriteSlot(...) /
+	 * commitWriteSlot()), the reader processes it in place
+	 * (acquireReadSlot(...) / releaseReadSlot()); a slot is not reused
+	 * before the reader released it. Waiting is done with futexes on
+	 * the sequence counters, so an idle ring costs no CPU time.
+	 *
+	 * Only available on Linux (not on Android, which lacks shm_open).
+	 */
+	class SharedMemoryRing
+	{
+		private:
+			std::string name;
+			SharedMemoryRingHeader* header;
+			uint8_t* slots;
+			size_t mappedSize;
+			bool owner;
+
+			bool map(int fd, size_t size);
+
+			static bool waitWhileEqual(std::atomic<uint32_t>* word,
+					uint32_t value, int timeoutMs);
+
+			static void wakeAll(std::atomic<uint32_t>* word);
+
+		public:
+			bool create(const std::string& name, uint32_t slotCount,
+					uint32_t slotSize);
+
+			bool open(const std::string& name);
+
+			void close();
+
+			bool isOpen() const;
+
+			uint32_t getSlotCount() const;
+
+			uint32_t getSlotSize() const;
+
+			uint8_t* acquireWriteSlot(int timeoutMs);
+
+			void commitWriteSlot();
+
+			uint8_t* acquireReadSlot(int timeoutMs);
+
+			void releaseReadSlot();
+
+			SharedMemoryRing();
+			~SharedMemoryRing();
+	};
+}
+
+
+#endif /* HEADER_FILES_FILTERMANAGEMENTLIBRARY_SHAREDMEMORYRING_H_ */
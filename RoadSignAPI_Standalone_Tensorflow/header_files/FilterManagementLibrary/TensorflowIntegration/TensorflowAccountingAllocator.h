@@ -0,0 +1,53 @@
+/*
+ * TensorflowAccountingAllocator.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#ifndef HEADER_FILES_FILTERMANAGEMENTLIBRARY_TENSORFLOWINTEGRATION_TENSORFLOWACCOUNTINGALLOCATOR_H_
+#define HEADER_FILES_FILTERMANAGEMENTLIBRARY_TENSORFLOWINTEGRATION_TENSORFLOWACCOUNTINGALLOCATOR_H_
+
+#include <stddef.h>
+#include <string>
+
+#include <tensorflow/core/framework/allocator.h>
+
+namespace FilterManagementLibrary
+{
+	namespace TFIntegration
+	{
+		/**
+		 * @brief CPU allocator of Tensorflow charging every allocation to
+		 * MemoryAccount::getTensorflowAccount() and the current
+		 * MemoryAccount of the allocating thread.
+		 *
+		 * Registered with a higher priority than the default CPU allocator,
+		 * so Tensorflow uses it for all tensors allocated on the CPU once
+		 * TensorflowAccountingAllocator.cpp is linked.
+		 * Each allocation is preceded by a header (padded to the requested
+		 * alignment) holding its size and the account it was charged to,
+		 * so freeing it does not need a lookup.
+		 */
+		class TensorflowAccountingAllocator : public tensorflow::Allocator
+		{
+			public:
+				std::string Name() override;
+
+				void* AllocateRaw(size_t alignment, size_t numBytes) override;
+
+				void DeallocateRaw(void* ptr) override;
+
+				bool TracksAllocationSizes() override;
+
+				size_t RequestedSize(const void* ptr) override;
+
+				size_t AllocatedSize(const void* ptr) override;
+
+				void GetStats(tensorflow::AllocatorStats* stats) override;
+		};
+	}
+}
+
+
+#endif /* HEADER_FILES_FILTERMANAGEMENTLIBRARY_TENSORFLOWINTEGRATION_TENSORFLOWACCOUNTINGALLOCATOR_H_ */
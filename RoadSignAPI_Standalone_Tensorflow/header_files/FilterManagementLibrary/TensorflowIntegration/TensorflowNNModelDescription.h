@@ -1,107 +1,170 @@
-/*
- * NeuronalNetworkImageProcessSettings.h
- *
- *  Created on: 19.05.2018
- *      Author: Patrick Langer
- */
-
-#ifndef HEADER_FILES_FILTERMANAGEMENTLIBRARY_NEURONALNETWORKIMAGEPROCESSSETTINGS_H_
-#define HEADER_FILES_FILTERMANAGEMENTLIBRARY_NEURONALNETWORKIMAGEPROCESSSETTINGS_H_
-
-#include <memory>
-#include <string>
-
-namespace FilterManagementLibrary
-{
-	namespace TFIntegration
-	{
-
-		struct TensorflowNNModelDescription
-		{
-
-			/**
-			 * Specifys whether the input type of the neuronal network model
-			 * is tensorflow::DT_UINT8 or tensorflow::DT_FLOAT (true means float,
-			 * false means uint8). Others are not supported for now.
-			 */
-			bool input_floating = false;
-
-			/**
-			 * Only used if input_floating = true.
-			 * As the default operations of the FilterManagementLibrary are
-			 * implemented to use uint8_t, we need a way to convert those
-			 * values to their float counterparts.
-			 * For this, we need a mean and a std value for normalization.
-			 * Formula is:
-			 * float_value = (uint8_t_value - input_mean) / input_std;
-			 */
-			float input_mean = 127.5f; // default value for mobilenet v1 and v2
-
-			/**
-			 * Only used if input_floating = true.
-			 * As the default operations of the FilterManagementLibrary are
-			 * implemented to use uint8_t, we need a way to convert those
-			 * values to their float counterparts.
-			 * For this, we need a mean and a std value for normalization.
-			 * Formula is:
-			 * float_value = (uint8_t_value - input_mean) / input_std;
-			*/
-			float input_std = 127.5f; // default value for mobilenet v1 and v2
-
-			/**
-			 * Width of the input layer. Although if it may be flattened,
-			 * Tensorflow provides functions to map tensors to access the data
-			 * using x, y and z coordinates, which is what is used in
-			 * TensorflowNNInstance::applyImageInputVector(...)
-			 */
-			int inputWidth;
-
-			/**
-			  * Height of the input layer. Although if it may be flattened,
-			  * Tensorflow provides functions to map tensors to access the data
-			  * using x, y and z coordinates, which is what is used in
-			  * TensorflowNNInstance::applyImageInputVector(...)
-			  */
-			int inputHeight;
-
-			/**
-			  * Amount of channels of the input layer (channels(RGB) = 3)
-			  * Although if it may be flattened,
-			  * Tensorflow provides functions to map tensors to access the data
-			  * using x, y and z coordinates, which is what is used in
-			  * TensorflowNNInstance::applyImageInputVector(...)
-			  */
-			int channels = 3;
-
-			/**
-			 * Path to the protobuf model file which contains the model and
-			 * where the Tensorflow graph is built from.
-			 */
-			std::string modelFile;
-
-			/**
-			 * Name of the input layer of the Neuronal Network model.
-			 */
-			std::string inputLayerNameStr;
-
-			/**
-			 * List of names of the output layers that shall be used
-			 * during inference. For output interpretation, you can also
-			 * use these names to get the corresponding output tensor
-			 * from a {@link TensorflowResultContainer}.
-			 * But if your network model has really silly or annoying
-			 * 1042 character long names, be aware that you could also
-			 * use an ID tou get the corresponding tensor form
-			 * {@link TensorflowResultContainer}.
-			 * The ID corresponds to the position of the
-			 * layer in this vector, so be sure to remember it!
-			 */
-			std::vector<std::string> outputLayerNames;
-		};
-	}
-}
-
-
-
-
-#endif /* HEADER_FILES_FILTERMANAGEMENTLIBRARY_NEURONALNETWORKIMAGEPROCESSSETTINGS_H_ */
+/*
+ * NeuronalNetworkImageProcessSettings.h
+ *
+ *  Created on: 19.05.2018
+ *      Author: Patrick Langer
+ */
+
+#ifndef HEADER_FILES_FILTERMANAGEMENTLIBRARY_NEURONALNETWORKIMAGEPROCESSSETTINGS_H_
+#define HEADER_FILES_FILTERMANAGEMENTLIBRARY_NEURONALNETWORKIMAGEPROCESSSETTINGS_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace FilterManagementLibrary
+{
+	namespace TFIntegration
+	{
+		/**
+		 * Affine quantization parameters of a quantized (uint8 / int8)
+		 * tensor, as they are used by quantized Tensorflow models.
+		 * Formula is:
+		 * real_value = scale * (quantized_value - zeroPoint);
+		 */
+		struct TensorflowQuantizationParameters
+		{
+			/**
+			 * Step size between two neighbouring quantized values.
+			 */
+			float scale;
+
+			/**
+			 * Quantized value which represents the real value 0.0f.
+			 */
+			int zeroPoint;
+
+			TensorflowQuantizationParameters(float scale = 1.0f,
+					int zeroPoint = 0) : scale(scale), zeroPoint(zeroPoint)
+			{
+
+			}
+		};
+
+		struct TensorflowNNModelDescription
+		{
+
+			/**
+			 * Specifys whether the input type of the neuronal network model
+			 * is tensorflow::DT_UINT8 / tensorflow::DT_INT8 or
+			 * tensorflow::DT_FLOAT (true means float, false means uint8 or
+			 * int8, depending on input_int8). Others are not supported for now.
+			 */
+			bool input_floating = false;
+
+			/**
+			 * Only used if input_floating = false.
+			 * If true, the input type of the neuronal network model is
+			 * tensorflow::DT_INT8 (fully quantized models) instead of
+			 * tensorflow::DT_UINT8. The uint8_t pixel values will then be
+			 * normalized using input_mean and input_std and afterwards
+			 * quantized using inputQuantization. Formula is:
+			 * int8_value = round(((uint8_t_value - input_mean) / input_std)
+			 * 				/ scale) + zeroPoint;
+			 * As there are only 256 possible pixel values,
+			 * {@link TensorflowNNInstance} precomputes this mapping once.
+			 */
+			bool input_int8 = false;
+
+			/**
+			 * Only used if input_floating = false and input_int8 = true.
+			 * Quantization parameters of the input layer.
+			 * Default value matches the common int8 mobilenet
+			 * quantization (scale = 1 / 128, zeroPoint = 0), which together
+			 * with the default input_mean and input_std maps [0, 255]
+			 * to [-128, 127].
+			 */
+			TensorflowQuantizationParameters inputQuantization =
+					{1.0f / 128.0f, 0};
+
+			/**
+			 * Only used if input_floating = true.
+			 * As the default operations of the FilterManagementLibrary are
+			 * implemented to use uint8_t, we need a way to convert those
+			 * values to their float counterparts.
+			 * For this, we need a mean and a std value for normalization.
+			 * Formula is:
+			 * float_value = (uint8_t_value - input_mean) / input_std;
+			 */
+			float input_mean = 127.5f; // default value for mobilenet v1 and v2
+
+			/**
+			 * Only used if input_floating = true.
+			 * As the default operations of the FilterManagementLibrary are
+			 * implemented to use uint8_t, we need a way to convert those
+			 * values to their float counterparts.
+			 * For this, we need a mean and a std value for normalization.
+			 * Formula is:
+			 * float_value = (uint8_t_value - input_mean) / input_std;
+			*/
+			float input_std = 127.5f; // default value for mobilenet v1 and v2
+
+			/**
+			 * Width of the input layer. Although if it may be flattened,
+			 * Tensorflow provides functions to map tensors to access the data
+			 * using x, y and z coordinates, which is what is used in
+			 * TensorflowNNInstance::applyImageInputVector(...)
+			 */
+			int inputWidth;
+
+			/**
+			  * Height of the input layer. Although if it may be flattened,
+			  * Tensorflow provides functions to map tensors to access the data
+			  * using x, y and z coordinates, which is what is used in
+			  * TensorflowNNInstance::applyImageInputVector(...)
+			  */
+			int inputHeight;
+
+			/**
+			  * Amount of channels of the input layer (channels(RGB) = 3)
+			  * Although if it may be flattened,
+			  * Tensorflow provides functions to map tensors to access the data
+			  * using x, y and z coordinates, which is what is used in
+			  * TensorflowNNInstance::applyImageInputVector(...)
+			  */
+			int channels = 3;
+
+			/**
+			 * Path to the protobuf model file which contains the model and
+			 * where the Tensorflow graph is built from.
+			 */
+			std::string modelFile;
+
+			/**
+			 * Name of the input layer of the Neuronal Network model.
+			 */
+			std::string inputLayerNameStr;
+
+			/**
+			 * List of names of the output layers that shall be used
+			 * during inference. For output interpretation, you can also
+			 * use these names to get the corresponding output tensor
+			 * from a {@link TensorflowResultContainer}.
+			 * But if your network model has really silly or annoying
+			 * 1042 character long names, be aware that you could also
+			 * use an ID tou get the corresponding tensor form
+			 * {@link TensorflowResultContainer}.
+			 * The ID corresponds to the position of the
+			 * layer in this vector, so be sure to remember it!
+			 */
+			std::vector<std::string> outputLayerNames;
+
+			/**
+			 * Quantization parameters of the output layers, in the same
+			 * order as outputLayerNames. Only used for output tensors
+			 * of type tensorflow::DT_UINT8 or tensorflow::DT_INT8, which
+			 * will be dequantized to float by {@link TensorflowNNInstance}
+			 * after each inference (see
+			 * {@link TensorflowResultContainer}::getFloatOutputTensorByID(...)).
+			 * May be left empty or shorter than outputLayerNames, missing
+			 * entries default to scale = 1.0f and zeroPoint = 0.
+			 */
+			std::vector<TensorflowQuantizationParameters> outputQuantizations;
+		};
+	}
+}
+
+
+
+
+#endif /* HEADER_FILES_FILTERMANAGEMENTLIBRARY_NEURONALNETWORKIMAGEPROCESSSETTINGS_H_ */
@@ -0,0 +1,171 @@
+/*
+ * TensorflowOutputRecording.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#ifndef HEADER_FILES_FILTERMANAGEMENTLIBRARY_TENSORFLOWINTEGRATION_TENSORFLOWOUTPUTRECORDING_H_
+#define HEADER_FILES_FILTERMANAGEMENTLIBRARY_TENSORFLOWINTEGRATION_TENSORFLOWOUTPUTRECORDING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <tensorflow/core/framework/tensor.h>
+
+#include "FilterManagementLibrary/TensorflowIntegration/TensorflowResultContainer.h"
+
+namespace FilterManagementLibrary
+{
+	namespace TFIntegration
+	{
+		/**
+		 * Layout of a recording file, all values little endian (native)
+		 * and every structure aligned to 8 bytes, so the tensor data can
+		 * be used right from the mapped file:
+		 *
+		 * TensorflowOutputFileHeader
+		 * records:  TensorflowOutputRecordHeader, followed by tensorCount
+		 *           times TensorflowOutputTensorHeader and the data of the
+		 *           tensor (padded to 8 bytes)
+		 * index:    recordCount TensorflowOutputIndexEntry, sorted by key
+		 * TensorflowOutputFileFooter
+		 *
+		 * The index is written when the recording is closed, a file which
+		 * was not closed can not be replayed.
+		 */
+		struct TensorflowOutputFileHeader
+		{
+			uint32_t magic;
+			uint32_t version;
+			uint64_t reserved;
+		};
+
+		struct TensorflowOutputRecordHeader
+		{
+			uint64_t key;
+			uint32_t tensorCount;
+			uint32_t reserved;
+		};
+
+		struct TensorflowOutputTensorHeader
+		{
+			/**
+			 * tensorflow::DataType of the tensor.
+			 */
+			uint32_t dataType;
+			uint32_t dimensionCount;
+			int64_t dimensions[6];
+
+			/**
+			 * Size of the data in bytes, without padding.
+			 */
+			uint64_t dataSize;
+		};
+
+		struct TensorflowOutputIndexEntry
+		{
+			uint64_t key;
+			uint64_t offset;
+		};
+
+		struct TensorflowOutputFileFooter
+		{
+			uint64_t indexOffset;
+			uint64_t recordCount;
+			uint32_t magic;
+			uint32_t version;
+		};
+
+		/**
+		 * @brief Writes the output tensors of inferences to a recording
+		 * file, which can be replayed by TensorflowOutputRecording.
+		 *
+		 * Each record is stored under a key, i.e. a hash of the input
+		 * of the inference (see TFNNBasedPipeFilter::setOutputRecorder(...)),
+		 * a key is only recorded once. The float view of the outputs is
+		 * stored (see TensorflowResultContainer::getFloatOutputTensorByID(...)),
+		 * so quantized outputs are replayed dequantized.
+		 * record(...) may be called from several threads, so one recorder
+		 * can be shared by the filters of several pipes using the same
+		 * model.
+		 */
+		class TensorflowOutputRecorder
+		{
+			private:
+				FILE* file;
+
+				std::string path;
+
+				/**
+				 * Offset the next record is written to.
+				 */
+				uint64_t offset;
+
+				std::vector<TensorflowOutputIndexEntry> index;
+
+				std::unordered_set<uint64_t> recordedKeys;
+
+				std::mutex mutex;
+
+				bool write(const void* data, size_t size);
+
+			public:
+				bool open(const std::string& path);
+
+				bool record(uint64_t key,
+						const TensorflowResultContainer& resultContainer,
+						size_t outputCount);
+
+				bool close();
+
+				uint64_t getRecordCount();
+
+				TensorflowOutputRecorder();
+				~TensorflowOutputRecorder();
+		};
+
+		/**
+		 * @brief Read only view of a recording file written by
+		 * TensorflowOutputRecorder.
+		 *
+		 * The file is mapped into memory, looking up a record is a binary
+		 * search in the index and copying its tensors. findRecord(...)
+		 * does not change the recording, so it may be called from several
+		 * threads.
+		 */
+		class TensorflowOutputRecording
+		{
+			private:
+				const uint8_t* data;
+				size_t size;
+
+				const TensorflowOutputIndexEntry* index;
+				uint64_t recordCount;
+
+			public:
+				bool open(const std::string& path);
+
+				void close();
+
+				bool isOpen() const;
+
+				uint64_t getRecordCount() const;
+
+				bool findRecord(uint64_t key,
+						std::vector<tensorflow::Tensor>* outputTensors) const;
+
+				TensorflowOutputRecording();
+				~TensorflowOutputRecording();
+		};
+	}
+}
+
+
+#endif /* HEADER_FILES_FILTERMANAGEMENTLIBRARY_TENSORFLOWINTEGRATION_TENSORFLOWOUTPUTRECORDING_H_ */
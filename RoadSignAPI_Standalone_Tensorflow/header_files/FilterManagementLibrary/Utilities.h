@@ -1,28 +1,37 @@
-/*
- * Utilities.h
- *
- *  Created on: 19.05.2018
- *      Author: Patrick Langer
- */
-
-#ifndef HEADER_FILES_UTILITIES_H_
-#define HEADER_FILES_UTILITIES_H_
-
-#include <string>
-
-namespace FilterManagementLibrary
-{
-	//! Providing some basic utilities, like checking if a file exists.
-	class Utilities
-	{
-
-		public:
-			static bool fileExists(const std::string& name);
-
-
-	};
-}
-
-
-
-#endif /* HEADER_FILES_UTILITIES_H_ */
+/*
+ * Utilities.h
+ *
+ *  Created on: 19.05.2018
+ *      Author: Patrick Langer
+ */
+
+#ifndef HEADER_FILES_UTILITIES_H_
+#define HEADER_FILES_UTILITIES_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+
+namespace FilterManagementLibrary
+{
+	//! Providing some basic utilities, like checking if a file exists.
+	class Utilities
+	{
+
+		public:
+			static bool fileExists(const std::string& name);
+
+			static int64_t getTimeUs();
+
+			// Pass the previous result as hash to continue hashing
+			static uint64_t hashFNV1a(const void* data, size_t size,
+					uint64_t hash = 0xcbf29ce484222325ULL);
+
+
+	};
+}
+
+
+
+#endif /* HEADER_FILES_UTILITIES_H_ */
@@ -0,0 +1,101 @@
+/*
+ * YUVImageUtils.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#ifndef HEADER_FILES_FILTERMANAGEMENTLIBRARY_YUVIMAGEUTILS_H_
+#define HEADER_FILES_FILTERMANAGEMENTLIBRARY_YUVIMAGEUTILS_H_
+
+#include <stdint.h>
+
+#include <opencv2/opencv.hpp>
+
+#include "FilterManagementLibrary/ImageConversion.h"
+
+namespace FilterManagementLibrary
+{
+	/**
+	 * Memory layouts of YUV 4:2:0 frames as they are delivered by
+	 * camera APIs (Android Camera / Camera2, V4L2) and hardware decoders.
+	 */
+	enum class YUVFormat
+	{
+		/**
+		 * Y plane followed by an interleaved chroma plane in V, U order.
+		 * Android camera default.
+		 */
+		NV21,
+
+		/**
+		 * Y plane followed by an interleaved chroma plane in U, V order.
+		 * Common for V4L2 and hardware decoders.
+		 */
+		NV12,
+
+		/**
+		 * Y plane followed by separate U and V planes.
+		 */
+		I420
+	};
+
+	/**
+	 * Describes a YUV 4:2:0 frame in memory without owning it.
+	 * All planes are addressed as
+	 * plane[(y >> 1) * uvRowStride + (x >> 1) * uvPixelStride]
+	 * (or plane[y * yRowStride + x] for the Y plane), which covers
+	 * planar and semi-planar layouts alike.
+	 * Use YUVImageUtils::describeFrame(...) to create one.
+	 */
+	struct YUVFrame
+	{
+		const uint8_t* yPlane = NULL;
+		const uint8_t* uPlane = NULL;
+		const uint8_t* vPlane = NULL;
+
+		int yRowStride = 0;
+		int uvRowStride = 0;
+
+		/**
+		 * Distance in bytes between two chroma samples of the same row
+		 * (1 for I420, 2 for NV21 / NV12).
+		 */
+		int uvPixelStride = 1;
+
+		int width = 0;
+		int height = 0;
+
+		/**
+		 * If true, the frame is interpreted as rotated by 180 degrees, so
+		 * all coordinates passed to YUVImageUtils refer to the rotated
+		 * image. Saves flipping the frame in memory.
+		 */
+		bool rotate180 = false;
+	};
+
+	/**
+	 * Some utilities to sample BGR images straight from YUV frames,
+	 * so only the pixels that are actually needed (i.e. the downscaled
+	 * detector input or small classifier crops) are color converted.
+	 * Color conversion is done by the row kernels of ImageConversion.
+	 */
+	class YUVImageUtils
+	{
+		public:
+			static bool describeFrame(const uint8_t* const planes[3],
+					const int strides[3], YUVFormat format,
+					int width, int height, bool rotate180,
+					YUVFrame* frame);
+
+			static void resizeRegionToBGR(const YUVFrame& frame,
+					const cv::Rect& region, cv::Mat* dst);
+
+			static void convertFrame(const YUVFrame& frame,
+					uint8_t* dst, int dstStride,
+					ImageConversion::PixelFormat format);
+	};
+}
+
+
+#endif /* HEADER_FILES_FILTERMANAGEMENTLIBRARY_YUVIMAGEUTILS_H_ */
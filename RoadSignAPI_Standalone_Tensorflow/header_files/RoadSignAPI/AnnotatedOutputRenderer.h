@@ -0,0 +1,71 @@
+/*
+ * AnnotatedOutputRenderer.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#ifndef HEADER_FILES_ROADSIGNAPI_ANNOTATEDOUTPUTRENDERER_H_
+#define HEADER_FILES_ROADSIGNAPI_ANNOTATEDOUTPUTRENDERER_H_
+
+#include <stdint.h>
+
+#include "FilterManagementLibrary/ImageConversion.h"
+#include "RoadSignAPI/RSAPIWorkingDataSet/RSAPIWorkingDataSet.h"
+
+namespace RoadSignAPI
+{
+	/**
+	 * Describes what AnnotatedOutputRenderer draws on top of the frame.
+	 */
+	struct AnnotationOptions
+	{
+		/**
+		 * Draw the boxes of all signs the detector found (green),
+		 * regardless of whether they were classified.
+		 */
+		bool drawDetectedSigns = false;
+
+		/**
+		 * Draw the boxes of all classified signs (green) and a box around
+		 * each DetectedSignCombination (red).
+		 */
+		bool drawSignCombinations = true;
+
+		/**
+		 * Draw the class ID and confidence above each box.
+		 */
+		bool drawLabels = false;
+
+		/**
+		 * Line thickness of the boxes in pixels.
+		 */
+		int lineThickness = 3;
+	};
+
+	/**
+	 * Renders the frame which was lastly fed into the RoadSignAPI, plus the
+	 * results for it, into a caller provided buffer in the requested pixel
+	 * format.
+	 * The frame is converted row by row with the kernels of
+	 * ImageConversion straight from its original representation (YUV or
+	 * BGR) into the output buffer, so there is exactly one pass over the
+	 * full frame. Boxes are drawn into the output buffer afterwards, the
+	 * frame itself is never modified.
+	 * Nothing of this runs as part of the ProcessingPipeline: consumers
+	 * which only need the results simply never call it and don't pay for
+	 * any full frame conversion.
+	 */
+	class AnnotatedOutputRenderer
+	{
+		public:
+			static bool render(const RSAPIWorkingDataSet& workingDataSet,
+					uint8_t* output, int outputStride,
+					FilterManagementLibrary::ImageConversion::PixelFormat
+					format,
+					const AnnotationOptions& options);
+	};
+}
+
+
+#endif /* HEADER_FILES_ROADSIGNAPI_ANNOTATEDOUTPUTRENDERER_H_ */
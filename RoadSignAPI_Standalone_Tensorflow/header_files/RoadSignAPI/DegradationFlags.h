@@ -0,0 +1,60 @@
+/*
+ * DegradationFlags.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#ifndef HEADER_FILES_ROADSIGNAPI_DEGRADATIONFLAGS_H_
+#define HEADER_FILES_ROADSIGNAPI_DEGRADATIONFLAGS_H_
+
+#include <stdint.h>
+
+namespace RoadSignAPI
+{
+	/**
+	 * Bits of RSAPIWorkingDataSet::degradationFlags (and of
+	 * ResultBufferHeader::degradationFlags), telling which work was left
+	 * out to finish a frame before its deadline
+	 * (see RoadSignAPI::setFrameBudget(...)) or to hold the frame rate
+	 * (see QoSController).
+	 */
+	enum DegradationFlag : uint32_t
+	{
+		DEGRADATION_NONE = 0,
+
+		/**
+		 * Detections with a detector confidence below the low confidence
+		 * threshold of the classifier were dropped without being
+		 * classified.
+		 */
+		DEGRADATION_LOW_CONFIDENCE_SKIPPED = 1 << 0,
+
+		/**
+		 * Only the most confident detections were classified, the others
+		 * are reported with UNCLASSIFIED_SIGN_CLASS_ID.
+		 */
+		DEGRADATION_CROPS_CAPPED = 1 << 1,
+
+		/**
+		 * No detection was classified, all of them are reported with
+		 * UNCLASSIFIED_SIGN_CLASS_ID.
+		 */
+		DEGRADATION_DETECTOR_ONLY = 1 << 2,
+
+		/**
+		 * The results were not ready before the deadline anyway.
+		 */
+		DEGRADATION_DEADLINE_MISSED = 1 << 3,
+
+		/**
+		 * The detector did not run, the detections of the last keyframe
+		 * were classified on the current frame instead (see
+		 * SSDLiteRoadSignDetector::setKeyframeInterval(...)).
+		 */
+		DEGRADATION_DETECTIONS_REUSED = 1 << 4
+	};
+}
+
+
+#endif /* HEADER_FILES_ROADSIGNAPI_DEGRADATIONFLAGS_H_ */
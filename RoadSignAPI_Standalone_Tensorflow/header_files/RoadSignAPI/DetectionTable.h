@@ -0,0 +1,96 @@
+/*
+ * DetectionTable.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#ifndef HEADER_FILES_ROADSIGNAPI_DETECTIONTABLE_H_
+#define HEADER_FILES_ROADSIGNAPI_DETECTIONTABLE_H_
+
+#include <vector>
+
+#include "FilterManagementLibrary/SSDPostProcessing.h"
+#include "RoadSignAPI/DetectedSignDescriptor.h"
+
+namespace RoadSignAPI
+{
+	/**
+	 * The detected signs of a frame, stored column by column (one vector
+	 * per member of {@link DetectedSignDescriptor}) instead of as a vector
+	 * of descriptors. Row i of all columns describes the same sign.
+	 *
+	 * The filters of the pipe work on this table: scaling the detector
+	 * output, the overlap tests of the
+	 * {@link RoadSignDuplicationDeleter} and the box expansion of the
+	 * {@link DetectionBasedImageSlicer} each only touch the columns they
+	 * need, in loops over contiguous arrays the compiler can vectorize.
+	 * The descriptors the API returns are a copy created by
+	 * toDescriptors(...) once the frame is done.
+	 */
+	struct DetectionTable
+	{
+		/**
+		 * Upper left corner of the boxes, in coordinates of the original
+		 * image (see DetectedSignDescriptor::upperLeft).
+		 */
+		std::vector<int> x1;
+		std::vector<int> y1;
+
+		/**
+		 * Lower right corner of the boxes, in coordinates of the original
+		 * image (see DetectedSignDescriptor::lowerRight).
+		 */
+		std::vector<int> x2;
+		std::vector<int> y2;
+
+		/**
+		 * See DetectedSignDescriptor::detectorConfidence.
+		 */
+		std::vector<float> detectorConfidence;
+
+		/**
+		 * See DetectedSignDescriptor::detectionPredictedClassID.
+		 */
+		std::vector<int> detectionPredictedClassID;
+
+		/**
+		 * See DetectedSignDescriptor::classifierApprovedClassID.
+		 */
+		std::vector<int> classifierApprovedClassID;
+
+		/**
+		 * See DetectedSignDescriptor::classifierConfidence.
+		 */
+		std::vector<float> classifierConfidence;
+
+		int size() const;
+
+		bool empty() const;
+
+		void clear();
+
+		void resize(int count);
+
+		void reserve(int count);
+
+		void append(const DetectedSignDescriptor& descriptor);
+
+		void appendSSDDetections(
+				const FilterManagementLibrary::SSDDetections& ssdDetections,
+				int imageWidth, int imageHeight);
+
+		void removeBySwapWithBack(int index);
+
+		DetectedSignDescriptor getDescriptor(int index) const;
+
+		void toDescriptors(
+				std::vector<DetectedSignDescriptor>* descriptors) const;
+
+		void fromDescriptors(
+				const std::vector<DetectedSignDescriptor>& descriptors);
+	};
+}
+
+
+#endif /* HEADER_FILES_ROADSIGNAPI_DETECTIONTABLE_H_ */
@@ -1,80 +1,148 @@
-/*
- * ClassifiedSignGrouper.h
- *
- *  Created on: 21.06.2018
- *      Author: Patrick Langer
- */
-
-#ifndef HEADER_FILES_ROADSIGNAPI_FILTERS_CLASSIFIEDSIGNSGROUPER_H_
-#define HEADER_FILES_ROADSIGNAPI_FILTERS_CLASSIFIEDSIGNSGROUPER_H_
-
-#include "FilterManagementLibrary/PipeSystem/PipeFilter.h"
-#include "RoadSignAPI/DetectedSignCombination.h"
-#include "RoadSignAPI/RSAPIWorkingDataSet/RSAPIWorkingDataSet.h"
-#include "RoadSignAPI/RSAPIPipeRegisteredFilters/RSAPIPipeRegisteredFilters.h"
-#include "FilterManagementLibrary/Logger.h"
-
-
-namespace RoadSignAPI
-{
-	/**
-	 * For the user, it is nice to know which signs are mounted onto the
-	 * same pole, so they are logically grouped. This has a direct effect
-	 * on the scope of some signs (i.e. signs indicating danger can limit
-	 * the validity of speed limits for the duration of a dangerous right turn
-	 * etc.). This Filter aims to group those signs into one
-	 * @link{DetectedSignCombination}. For this, it estimates where the pole
-	 * of a sign is located (for more, please refer to the process() function
-	 * and to @link{DetectedSignCombination}.
-	 */
-	class ClassifiedSignsGrouper :
-			public FilterManagementLibrary::PipeSystem::PipeFilter
-	{
-		private:
-			/**
-			 * Just a pointer casted from {@link PipeWorkingDataSet}*
-			 * to {@link RSAPIWorkingDataSet}*, so we just don't have to do
-			 * the casting every time we need it ;)
-			 */
-			RSAPIWorkingDataSet* castedWorkingDataSet;
-
-			/**
-			 * We store a local copy to the originalImageWidth of the
-			 * working data set (just for easier access and aesthetically more
-			 * pleasing code ;) )
-			 */
-			int imageWidth;
-
-			/**
-			 * We try to find out which signs are on one pole. For this, we
-			 * take the middle of the box of the detected sign and add a threshold
-			 * in +X and -X direction, to guess where the pole is. This variable
-			 * specifies how big this threshold is (i.e. how wide the area is in
-			 * which the pole is expected).
-			 * The percentage refers to the total width of the originalBGRImage.
-			 * If the width for example is 1280, a horizontalPercentageRange of
-			 * 10% would mean 128 pixels in EACH direction (which, of course would
-			 * be a lot, so we would use something around 1-5%...).
-			 * If we would exceed the image boundaries while applying this value,
-			 * we of course would adjust it to stay within the boundaries
-			 * (we assert that the range always starts where x > 0 and ends
-			 * where x < originalBGRImageWidth).
-			 */
-			float horizontalRangePercentage = 0.025;
-
-			// Get's called when the pipe's setup function is called
-			// after all the filters have been registered.
-			bool initByPipeSetup();
-
-			// The main function of this filter, will be called
-			// by the pipe when data shall be processed.
-			bool process();
-
-
-	};
-}
-
-
-
-
-#endif /* HEADER_FILES_ROADSIGNAPI_FILTERS_CLASSIFIEDSIGNSGROUPER_H_ */
+/*
+ * ClassifiedSignGrouper.h
+ *
+ *  Created on: 21.06.2018
+ *      Author: Patrick Langer
+ */
+
+#ifndef HEADER_FILES_ROADSIGNAPI_FILTERS_CLASSIFIEDSIGNSGROUPER_H_
+#define HEADER_FILES_ROADSIGNAPI_FILTERS_CLASSIFIEDSIGNSGROUPER_H_
+
+#include "FilterManagementLibrary/PipeSystem/PipeFilter.h"
+#include "RoadSignAPI/DetectedSignCombination.h"
+#include "RoadSignAPI/RSAPIWorkingDataSet/RSAPIWorkingDataSet.h"
+#include "RoadSignAPI/RSAPIPipeRegisteredFilters/RSAPIPipeRegisteredFilters.h"
+#include "FilterManagementLibrary/Logger.h"
+
+
+namespace RoadSignAPI
+{
+	/**
+	 * For the user, it is nice to know which signs are mounted onto the
+	 * same pole, so they are logically grouped. This has a direct effect
+	 * on the scope of some signs (i.e. signs indicating danger can limit
+	 * the validity of speed limits for the duration of a dangerous right turn
+	 * etc.). This Filter aims to group those signs into one
+	 * @link{DetectedSignCombination}. For this, it estimates where the pole
+	 * of a sign is located (for more, please refer to the process() function
+	 * and to @link{DetectedSignCombination}.
+	 * Furthermore, the combinations are followed over consecutive frames:
+	 * each one is assigned to a @link{SignCombinationTrack} with a stable
+	 * ID, so consumers only need to look at the tracks which are new,
+	 * updated or expired in a frame.
+	 */
+	class ClassifiedSignsGrouper :
+			public FilterManagementLibrary::PipeSystem::PipeFilter
+	{
+		private:
+			/**
+			 * Just a pointer casted from {@link PipeWorkingDataSet}*
+			 * to {@link RSAPIWorkingDataSet}*, so we just don't have to do
+			 * the casting every time we need it ;)
+			 */
+			RSAPIWorkingDataSet* castedWorkingDataSet;
+
+			/**
+			 * We store a local copy to the originalImageWidth of the
+			 * working data set (just for easier access and aesthetically more
+			 * pleasing code ;) )
+			 */
+			int imageWidth;
+
+			/**
+			 * We try to find out which signs are on one pole. For this, we
+			 * take the middle of the box of the detected sign and add a threshold
+			 * in +X and -X direction, to guess where the pole is. This variable
+			 * specifies how big this threshold is (i.e. how wide the area is in
+			 * which the pole is expected).
+			 * The percentage refers to the total width of the originalBGRImage.
+			 * If the width for example is 1280, a horizontalPercentageRange of
+			 * 10% would mean 128 pixels in EACH direction (which, of course would
+			 * be a lot, so we would use something around 1-5%...).
+			 * If we would exceed the image boundaries while applying this value,
+			 * we of course would adjust it to stay within the boundaries
+			 * (we assert that the range always starts where x > 0 and ends
+			 * where x < originalBGRImageWidth).
+			 */
+			float horizontalRangePercentage = 0.025;
+
+			/**
+			 * Maximum distance (as percentage of the image width) between
+			 * the pole of a combination and the averaged pole of a track
+			 * for the combination to be assigned to the track. A bit wider
+			 * than the pole area, as poles move between frames.
+			 */
+			float trackMatchingRangePercentage = 0.05;
+
+			/**
+			 * Weight of a new pole position in the running average of a
+			 * track, once the track has been seen 1 / poleSmoothingFactor
+			 * times (before that, the plain average of all positions is
+			 * used).
+			 */
+			float poleSmoothingFactor = 0.3;
+
+			/**
+			 * A track is reported as UPDATED if its pole moved by more
+			 * than this percentage of the image width since it was last
+			 * reported (or if its signs changed).
+			 */
+			float reportThresholdPercentage = 0.01;
+
+			/**
+			 * Number of consecutive frames a pole may be missed (i.e.
+			 * because a sign was not classified) before its track expires.
+			 */
+			int maxMissedFrames = 5;
+
+			/**
+			 * ID the next new track will get.
+			 */
+			uint32_t nextTrackID = 1;
+
+			/**
+			 * Scratch list of (distance, combination, track) candidates
+			 * used by updateTracks(), kept to avoid reallocations.
+			 */
+			std::vector<std::pair<int, std::pair<int, int> > >
+					trackMatchingCandidates;
+
+			std::vector<bool> trackMatched;
+
+			/**
+			 * Scratch list used by groupSigns(...), kept to avoid
+			 * reallocations: (estimated pole X, index) of the
+			 * combinations created so far, sorted by pole X.
+			 */
+			std::vector<std::pair<int, int> > polePositions;
+
+			void updateTracks();
+
+			void updateTrack(SignCombinationTrack* track,
+					const DetectedSignCombination& combination) const;
+
+			// Get's called when the pipe's setup function is called
+			// after all the filters have been registered.
+			bool initByPipeSetup();
+
+			// The main function of this filter, will be called
+			// by the pipe when data shall be processed.
+			bool process();
+
+		public:
+			void setHorizontalRangePercentage(
+					float horizontalRangePercentage);
+
+			void groupSigns(
+					const std::vector<DetectedSignDescriptor>& detectedSigns,
+					const std::vector<int>& signIDs, int imageWidth,
+					std::vector<DetectedSignCombination>* combinations);
+
+
+	};
+}
+
+
+
+
+#endif /* HEADER_FILES_ROADSIGNAPI_FILTERS_CLASSIFIEDSIGNSGROUPER_H_ */
@@ -1,102 +1,177 @@
-/*
- * SSDLite_RoadSignDetector.h
- *
- *  Created on: 03.06.2018
- *      Author: Patrick Langer
- */
-
-#ifndef HEADER_FILES_ROADSIGNAPI_FILTERS_SSDLITEROADSIGNDETECTOR_H_
-#define HEADER_FILES_ROADSIGNAPI_FILTERS_SSDLITEROADSIGNDETECTOR_H_
-
-
-#include "FilterManagementLibrary/PipeSystem/TFNNBasedPipeFilter.h"
-#include "RoadSignAPI/RSAPIWorkingDataSet/RSAPIWorkingDataSet.h"
-#include "opencv2/opencv.hpp"
-
-#ifdef __ANDROID__
-	#include "FilterManagementLibrary/TensorflowAndroidJNIUtils.h"
-#endif
-
-namespace RoadSignAPI
-{
-	/**
-	 * This filter is based on TFNNBasedPipeFilter and uses SSDLite for
-	 * (roadsign) detection.
-	 */
-	class SSDLiteRoadSignDetector :
-			public FilterManagementLibrary::PipeSystem::TFNNBasedPipeFilter
-	{
-		private:
-
-			/**
-			  * Just a copy from the input height provided in the
-			  * {@link TensorflowNNModelDescription} of the underlaying
-			  * {@link TensorflowNNInstance}.
-			  */
-			int nnModelInputHeight;
-
-			/**
-			  * Just a copy from the input height provided in the
-			  * {@link TensorflowNNModelDescription} of the underlaying
-			  * {@link TensorflowNNInstance}.
-			  */
-			int nnModelInputWidth;
-			
-			/**
-			  * Threshold the confidence of a prediction from our underlying
-			  * neuronal network model needs to exceed in order to be included
-			  * to {@link RSAPIWorkingDataSet}::detectedSigns
-			  *
-			  */
-			float threshold = 0.28f;
-
-			/**
-			  * Just a pointer casted from {@link PipeWorkingDataSet}*
-			  * to {@link RSAPIWorkingDataSet}*, so we just don't have to do
-			  * the casting every time we need it ;)
-			  */
-			RSAPIWorkingDataSet* castedWorkingDataSet;
-
-			#ifdef __ANDROID__
-				/**
-				 * A pointer to an AssetManager which can be passed via
-				 * the constructor (only available under Android environments).
-				 * We need it to be able to load model files from the Android
-				 * assets folder, which we want to do so the files do not have
-				 * to be placed in the normal user space.
-				 */
-				AAssetManager* const assetManager;
-			#endif
-
-			// Get's called when the pipe's setup function is called
-			// after all the filters have been registered.
-			bool initByPipeSetup();
-
-			// The main function of this filter, will be called
-			// by the pipe when data shall be processed.
-			bool process();
-
-			void onNNEvaluationFinished
-				(const FilterManagementLibrary::TFIntegration::
-						TensorflowResultContainer resultContainer);
-
-			void applyImageVectorFromOpenCVMat(cv::Mat *mat);
-
-		public:
-			// We provide a slightly different constructor for Android environments
-			// to be able to pass in an AAssetManager to load model files from
-			// the Android assets folder of an application using this.
-			#ifdef __ANDROID__
-				SSDLiteRoadSignDetector(FilterManagementLibrary::
-						TFIntegration::TensorflowNNModelDescription,
-						int numThreads,
-						AAssetManager* const assetManager);
-			#else
-				SSDLiteRoadSignDetector(FilterManagementLibrary::
-				TFIntegration::TensorflowNNModelDescription,
-				int numThreads);
-			#endif
-	};
-}
-
-#endif /* HEADER_FILES_ROADSIGNAPI_FILTERS_SSDLITEROADSIGNDETECTOR_H_ */
+/*
+ * SSDLite_RoadSignDetector.h
+ *
+ *  Created on: 03.06.2018
+ *      Author: Patrick Langer
+ */
+
+#ifndef HEADER_FILES_ROADSIGNAPI_FILTERS_SSDLITEROADSIGNDETECTOR_H_
+#define HEADER_FILES_ROADSIGNAPI_FILTERS_SSDLITEROADSIGNDETECTOR_H_
+
+
+#include "FilterManagementLibrary/PipeSystem/TFNNBasedPipeFilter.h"
+#include "FilterManagementLibrary/SSDPostProcessing.h"
+#include "RoadSignAPI/RSAPIWorkingDataSet/RSAPIWorkingDataSet.h"
+#include "opencv2/opencv.hpp"
+
+#ifdef __ANDROID__
+	#include "FilterManagementLibrary/TensorflowAndroidJNIUtils.h"
+#endif
+
+namespace RoadSignAPI
+{
+	/**
+	 * This filter is based on TFNNBasedPipeFilter and uses SSDLite for
+	 * (roadsign) detection.
+	 */
+	class SSDLiteRoadSignDetector :
+			public FilterManagementLibrary::PipeSystem::TFNNBasedPipeFilter
+	{
+		private:
+
+			/**
+			  * Just a copy from the input height provided in the
+			  * {@link TensorflowNNModelDescription} of the underlaying
+			  * {@link TensorflowNNInstance}.
+			  */
+			int nnModelInputHeight;
+
+			/**
+			  * Just a copy from the input height provided in the
+			  * {@link TensorflowNNModelDescription} of the underlaying
+			  * {@link TensorflowNNInstance}.
+			  */
+			int nnModelInputWidth;
+			
+			/**
+			  * Threshold the confidence of a prediction from our underlying
+			  * neuronal network model needs to exceed in order to be included
+			  * to {@link RSAPIWorkingDataSet}::detections
+			  *
+			  */
+			float threshold = 0.28f;
+
+			/**
+			 * Maximum number of detections per frame, the ones with the
+			 * highest confidence are kept (max_total_detections of the
+			 * pipeline.config of our model).
+			 */
+			int maxDetections = 10;
+
+			/**
+			 * False if the model includes the postprocessing of the
+			 * object detection API (it has a num_detections output).
+			 * Otherwise the outputs need to be the box encodings (ID 0),
+			 * the class predictions including the background class as
+			 * logits (ID 1) and optionally the anchors (ID 2), like the
+			 * graphs written by export_tflite_ssd_graph.py of the object
+			 * detection API (raw_outputs/box_encodings,
+			 * raw_outputs/class_predictions, anchors), which are decoded
+			 * by postProcessor. Without an anchors output, the anchors
+			 * are generated (see generatedAnchors).
+			 */
+			bool rawModelOutputs = false;
+
+			/**
+			 * Anchors of a model with raw outputs but without an anchors
+			 * output, generated with anchorParameters for the input size
+			 * of the model (empty otherwise).
+			 */
+			FilterManagementLibrary::SSDAnchorParameters anchorParameters;
+			std::vector<float> generatedAnchors;
+
+			/**
+			 * Turns the model outputs into detections, see
+			 * onNNEvaluationFinished(...).
+			 */
+			FilterManagementLibrary::SSDPostProcessor postProcessor;
+			FilterManagementLibrary::SSDPostProcessingParameters
+				postProcessingParameters;
+			FilterManagementLibrary::SSDDetections ssdDetections;
+
+			/**
+			  * Just a pointer casted from {@link PipeWorkingDataSet}*
+			  * to {@link RSAPIWorkingDataSet}*, so we just don't have to do
+			  * the casting every time we need it ;)
+			  */
+			RSAPIWorkingDataSet* castedWorkingDataSet;
+
+			/**
+			 * The detector only runs on every keyframeInterval-th frame,
+			 * the frames in between reuse keyframeDetections (1: every
+			 * frame is a keyframe).
+			 */
+			int keyframeInterval = 1;
+
+			/**
+			 * Frames processed since the last keyframe, -1 if there was
+			 * no keyframe yet (or it may not be reused).
+			 */
+			int framesSinceKeyframe = -1;
+
+			/**
+			 * Detections of the last keyframe and the size of the image
+			 * they refer to.
+			 */
+			DetectionTable keyframeDetections;
+			cv::Size keyframeImageSize;
+
+			#ifdef __ANDROID__
+				/**
+				 * A pointer to an AssetManager which can be passed via
+				 * the constructor (only available under Android environments).
+				 * We need it to be able to load model files from the Android
+				 * assets folder, which we want to do so the files do not have
+				 * to be placed in the normal user space.
+				 */
+				AAssetManager* const assetManager;
+			#endif
+
+			// Get's called when the pipe's setup function is called
+			// after all the filters have been registered.
+			bool initByPipeSetup();
+
+			// The main function of this filter, will be called
+			// by the pipe when data shall be processed.
+			bool process();
+
+			void onNNEvaluationFinished
+				(const FilterManagementLibrary::TFIntegration::
+						TensorflowResultContainer resultContainer);
+
+			void applyImageVectorFromOpenCVMat(cv::Mat *mat);
+
+			void onModelVariantChanged();
+
+			void applyModelInputSize();
+
+		public:
+			bool loadModels();
+
+			bool replaceModel(int modelVariant, FilterManagementLibrary::
+					TFIntegration::TensorflowNNModelDescription
+					nnModelDescription);
+
+			void setKeyframeInterval(int keyframeInterval);
+
+			void setThreshold(float threshold);
+
+			void setMaxDetections(int maxDetections);
+
+			// We provide a slightly different constructor for Android environments
+			// to be able to pass in an AAssetManager to load model files from
+			// the Android assets folder of an application using this.
+			#ifdef __ANDROID__
+				SSDLiteRoadSignDetector(FilterManagementLibrary::
+						TFIntegration::TensorflowNNModelDescription,
+						int numThreads,
+						AAssetManager* const assetManager);
+			#else
+				SSDLiteRoadSignDetector(FilterManagementLibrary::
+				TFIntegration::TensorflowNNModelDescription,
+				int numThreads);
+			#endif
+	};
+}
+
+#endif /* HEADER_FILES_ROADSIGNAPI_FILTERS_SSDLITEROADSIGNDETECTOR_H_ */
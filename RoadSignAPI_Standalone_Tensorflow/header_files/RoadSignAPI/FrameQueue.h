@@ -0,0 +1,220 @@
+/*
+ * FrameQueue.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#ifndef HEADER_FILES_ROADSIGNAPI_FRAMEQUEUE_H_
+#define HEADER_FILES_ROADSIGNAPI_FRAMEQUEUE_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+#include "FilterManagementLibrary/MPMCQueue.h"
+#include "FilterManagementLibrary/YUVImageUtils.h"
+
+namespace RoadSignAPI
+{
+	/**
+	 * A frame owned by a FrameQueue, either a BGR image or a tightly
+	 * packed YUV 4:2:0 frame.
+	 */
+	struct QueuedFrame
+	{
+		int streamID;
+
+		/**
+		 * ID passed by the producer, i.e. a camera frame number.
+		 */
+		uint64_t frameID;
+
+		/**
+		 * Time the frame was pushed, in microseconds of
+		 * FrameQueue::getTimeUs().
+		 */
+		int64_t pushTimeUs;
+
+		bool yuvInput;
+
+		cv::Mat bgrImage;
+
+		std::vector<uint8_t> yuvData;
+		FilterManagementLibrary::YUVFormat yuvFormat;
+		int yuvStrides[3];
+		size_t yuvPlaneOffsets[3];
+		int width;
+		int height;
+		bool rotate180;
+	};
+
+	/**
+	 * Counters of a stream of a FrameQueue, see
+	 * FrameQueue::getStreamStatistics(...).
+	 */
+	struct FrameStreamStatistics
+	{
+		/**
+		 * Frames accepted by push...(...).
+		 */
+		uint64_t pushed = 0;
+
+		/**
+		 * Frames handed out by acquireFrame(...).
+		 */
+		uint64_t delivered = 0;
+
+		/**
+		 * Frames replaced by a newer frame of the same stream before
+		 * they were handed out (latest frame wins).
+		 */
+		uint64_t coalesced = 0;
+
+		/**
+		 * Frames refused by push...(...), because all buffers of the
+		 * stream were in use.
+		 */
+		uint64_t rejected = 0;
+
+		/**
+		 * Frames dropped by acquireFrame(...), because they were older
+		 * than the maximum frame age.
+		 */
+		uint64_t expired = 0;
+
+		/**
+		 * Sum and maximum of the time between push...(...) and
+		 * acquireFrame(...) of the delivered frames in microseconds.
+		 */
+		uint64_t totalQueueingTimeUs = 0;
+		uint64_t maxQueueingTimeUs = 0;
+	};
+
+	/**
+	 * @brief Bounded queue of frames from several capture threads in
+	 * front of the RoadSignAPI.
+	 *
+	 * Every camera (or other source) is a stream with a priority. Each
+	 * stream holds at most one pending frame: pushing a frame while the
+	 * previous one was not handed out yet replaces it (latest frame
+	 * wins), so under overload stale frames are dropped instead of
+	 * building up latency. acquireFrame(...) hands out the pending frames
+	 * of the streams with the highest priority first, streams of the same
+	 * priority in the order their frames arrived.
+	 *
+	 * Producers never block and never take a lock (apart from waking up a
+	 * sleeping consumer): the frames are copied into buffers preallocated
+	 * per stream, which are passed around through lock-free MPMCQueues.
+	 * If all buffers of a stream are in use (pending or being processed),
+	 * the frame is rejected. Any number of threads may push and acquire
+	 * frames; addStream(...) must be called before that.
+	 *
+	 * Usage: capture threads call pushImage(...) / pushImageYUV(...), the
+	 * processing thread calls acquireFrame(...),
+	 * RoadSignAPI::staticFeedQueuedFrame(...) and releaseFrame(...) once
+	 * it is done with the results.
+	 */
+	class FrameQueue
+	{
+		private:
+			struct FrameStream
+			{
+				int priority;
+
+				/**
+				 * Index of the ready queue of the priority.
+				 */
+				int readyQueueIndex;
+
+				std::vector<std::unique_ptr<QueuedFrame> > frames;
+
+				/**
+				 * Buffers which are neither pending nor being processed.
+				 */
+				FilterManagementLibrary::MPMCQueue<QueuedFrame*> freeFrames;
+
+				/**
+				 * The frame waiting to be acquired, if any.
+				 */
+				std::atomic<QueuedFrame*> pendingFrame;
+
+				std::atomic<uint64_t> pushed;
+				std::atomic<uint64_t> delivered;
+				std::atomic<uint64_t> coalesced;
+				std::atomic<uint64_t> rejected;
+				std::atomic<uint64_t> expired;
+				std::atomic<uint64_t> totalQueueingTimeUs;
+				std::atomic<uint64_t> maxQueueingTimeUs;
+			};
+
+			std::vector<std::unique_ptr<FrameStream> > streams;
+
+			/**
+			 * IDs of the streams with a pending frame, one queue per
+			 * priority ordered by descending priority. A stream ID is
+			 * pushed when its pending frame goes from none to one, so it
+			 * is contained at most once.
+			 */
+			std::vector<std::unique_ptr<
+					FilterManagementLibrary::MPMCQueue<int> > > readyQueues;
+			std::vector<int> readyQueuePriorities;
+
+			/**
+			 * Frames older than this are dropped instead of being
+			 * handed out (0: never).
+			 */
+			int maxFrameAgeMs;
+
+			/**
+			 * Only used to let consumers sleep while there is no frame.
+			 */
+			std::mutex waitMutex;
+			std::condition_variable frameAvailable;
+			std::atomic<int> waitingConsumers;
+			std::atomic<bool> isShutDown;
+
+			QueuedFrame* acquireFreeFrame(int streamID);
+
+			void publishFrame(QueuedFrame* frame);
+
+			QueuedFrame* tryAcquireFrame();
+
+		public:
+			FrameQueue();
+
+			int addStream(int priority, int bufferCount = 3);
+
+			bool pushImage(int streamID, const cv::Mat& image,
+					uint64_t frameID);
+
+			bool pushImageYUV(int streamID, const uint8_t* const planes[3],
+					const int strides[3],
+					FilterManagementLibrary::YUVFormat format,
+					int width, int height, bool rotate180,
+					uint64_t frameID);
+
+			QueuedFrame* acquireFrame(int timeoutMs);
+
+			void releaseFrame(QueuedFrame* frame);
+
+			void shutdown();
+
+			void setMaxFrameAge(int maxFrameAgeMs);
+
+			int getStreamCount() const;
+
+			FrameStreamStatistics getStreamStatistics(int streamID) const;
+
+			static int64_t getTimeUs();
+	};
+}
+
+
+#endif /* HEADER_FILES_ROADSIGNAPI_FRAMEQUEUE_H_ */
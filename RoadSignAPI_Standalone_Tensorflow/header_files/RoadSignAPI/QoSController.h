@@ -0,0 +1,120 @@
+/*
+ * QoSController.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#ifndef HEADER_FILES_ROADSIGNAPI_QOSCONTROLLER_H_
+#define HEADER_FILES_ROADSIGNAPI_QOSCONTROLLER_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "FilterManagementLibrary/LatencyHistogram.h"
+
+namespace RoadSignAPI
+{
+	/**
+	 * One configuration the RoadSignAPI can run in, see QoSController.
+	 */
+	struct QoSOperatingPoint
+	{
+		/**
+		 * Model variants of the detector and the classifier (see
+		 * TFNNBasedPipeFilter::addModelVariant(...)), i.e. a 200x200
+		 * instead of a 300x300 detector or a quantized classifier.
+		 */
+		int detectorModelVariant = 0;
+		int classifierModelVariant = 0;
+
+		/**
+		 * See SSDLiteRoadSignDetector::setKeyframeInterval(...).
+		 */
+		int keyframeInterval = 1;
+	};
+
+	/**
+	 * @brief Chooses between operating points to hold a target frame rate.
+	 *
+	 * The operating points are ordered from the best (and most expensive)
+	 * to the cheapest one. The processing time of every frame is recorded
+	 * into a histogram covering a window of frames. At the end of each
+	 * window, its mean (or a percentile, see setHysteresis(...)) is
+	 * compared to the target frame time:
+	 * - above degradeRatio * target, the next cheaper point is selected
+	 * - below upgradeRatio * target, the next better point is selected,
+	 *   but only after staying upgradeHoldFrames frames at the current one
+	 * The gap between both ratios and the hold time keep the controller
+	 * from oscillating. If an upgrade has to be taken back within four
+	 * windows, the hold time is doubled (up to 8 times), so the
+	 * controller stops probing a point the device can't sustain (i.e.
+	 * while it is throttled) too often. Once an upgrade held for 16
+	 * windows, the hold time goes back to normal.
+	 */
+	class QoSController
+	{
+		private:
+			std::vector<QoSOperatingPoint> operatingPoints;
+
+			int currentOperatingPoint = 0;
+
+			/**
+			 * 0 if the controller is disabled.
+			 */
+			int64_t targetFrameTimeUs = 0;
+
+			float degradeRatio = 1.0f;
+			float upgradeRatio = 0.7f;
+
+			/**
+			 * Percentile of the window compared to the target, 0 to use
+			 * the mean (which is what determines the frame rate).
+			 */
+			double percentile = 0.0;
+
+			int windowFrames = 30;
+			int upgradeHoldFrames = 90;
+
+			/**
+			 * upgradeHoldFrames including the back-off.
+			 */
+			int currentUpgradeHoldFrames = 90;
+
+			int framesSinceSwitch = 0;
+			bool lastSwitchWasUpgrade = false;
+
+			uint64_t switchCount = 0;
+
+			FilterManagementLibrary::LatencyHistogram window;
+
+			void switchTo(int operatingPoint);
+
+		public:
+			int addOperatingPoint(const QoSOperatingPoint& operatingPoint);
+
+			void setTargetFrameRate(float framesPerSecond);
+
+			void setHysteresis(float degradeRatio, float upgradeRatio,
+					int windowFrames, int upgradeHoldFrames,
+					double percentile = 0.0);
+
+			bool isEnabled() const;
+
+			bool recordFrame(int64_t processingTimeUs);
+
+			int getOperatingPointCount() const;
+
+			int getCurrentOperatingPointIndex() const;
+
+			const QoSOperatingPoint* getCurrentOperatingPoint() const;
+
+			uint64_t getSwitchCount() const;
+
+			void reset();
+	};
+}
+
+
+#endif /* HEADER_FILES_ROADSIGNAPI_QOSCONTROLLER_H_ */
@@ -0,0 +1,60 @@
+/*
+ * RSAPIParameters.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#ifndef HEADER_FILES_ROADSIGNAPI_RSAPIPARAMETERS_H_
+#define HEADER_FILES_ROADSIGNAPI_RSAPIPARAMETERS_H_
+
+namespace RoadSignAPI
+{
+	/**
+	 * Tuning parameters of the filters, which can be changed between two
+	 * frames (see RoadSignAPI::setParameters(...)). The defaults are the
+	 * values the filters were tuned with.
+	 */
+	struct RSAPIParameters
+	{
+		/**
+		 * Confidence a detection of the SSDLiteRoadSignDetector needs to
+		 * exceed to be passed on (0..1).
+		 */
+		float detectorThreshold = 0.28f;
+
+		/**
+		 * Maximum number of detections the SSDLiteRoadSignDetector passes
+		 * on per frame, the most confident ones are kept (>= 1).
+		 */
+		int detectorMaxDetections = 10;
+
+		/**
+		 * Confidence the MobilenetV2RoadSignClassificator needs to reach
+		 * for a sign to be approved (0..1).
+		 */
+		float classifierThreshold = 0.95f;
+
+		/**
+		 * Share of its box by which a detection has to overlap another
+		 * one to be deleted as duplicate by the RoadSignDuplicationDeleter
+		 * (0..1, 1 keeps all detections).
+		 */
+		float duplicateMinOverlapPercentage = 0.60f;
+
+		/**
+		 * Share of the box size by which the DetectionBasedImageSlicer
+		 * expands each detection before it is classified (>= 0).
+		 */
+		float sliceExpandPercentage = 0.1f;
+
+		/**
+		 * Width of the pole area of the ClassifiedSignsGrouper in each
+		 * direction, as share of the image width (0..1).
+		 */
+		float groupHorizontalRangePercentage = 0.025f;
+	};
+}
+
+
+#endif /* HEADER_FILES_ROADSIGNAPI_RSAPIPARAMETERS_H_ */
@@ -1,90 +1,167 @@
-/*
- * RSAPIWorkingDataSet.h
- *
- *  Created on: 03.06.2018
- *      Author: Patrick Langer
- */
-
-#ifndef HEADER_FILES_ROADSIGNAPI_RSAPIWORKINGDATASET_RSAPIWORKINGDATASET_H_
-#define HEADER_FILES_ROADSIGNAPI_RSAPIWORKINGDATASET_RSAPIWORKINGDATASET_H_
-
-#include <opencv2/opencv.hpp>
-
-#include "FilterManagementLibrary/PipeSystem/PipeWorkingDataSet.h"
-#include "RoadSignAPI/DetectedSignDescriptor.h"
-#include "RoadSignAPI/DetectedSignCombination.h"
-
-namespace RoadSignAPI
-{
-	/**
-	 * Contains all variables which are needed to (efficiently!) detect and
-	 * classifiy roadsigns from an OpenCV image Matrix.
-	 * The detected and classified signs will also be stored here as a result.
-	 */
-	struct RSAPIWorkingDataSet :
-			public FilterManagementLibrary::PipeSystem::PipeWorkingDataSet
-	{
-			/**
-			 * This is the image which was feed into the API using
-			 * {see RoadSignAPI}'s feedImage(...) function
-			 * Needs to be 8UC3 BGR Image because {link TensorflowOpenCVUtils}
-			 * expects that.
-			 */
-			cv::Mat originalBGRImage;
-
-			/**
-			 * This will be initialized by {@link SSDLiteRoadSignDetector}.
-			 * It creates a scaled cv::Mat from the originalBGRImage
-			 * (in 8UC3 format, too) which matches the input size of
-			 * the neuronal network model used for
-			 * the {@link SSDLiteRoadSignDetector} using bicubic interpolation.
-			 */
-			cv::Mat detectorScaledBGRImage;
-
-			/**
-			 * Describes the signs that were detected by the
-			 * {@link SSDLiteRoadSignDetector}.
-			 * See {@link DetectedSignDescriptor} for a more detailed
-			 * description.
-			 */
-			std::vector<DetectedSignDescriptor> detectedSigns;
-
-			/**
-			 * This vector will be filled by the
-			 * {@link DetectionBasedImageSlicer}. It uses the detectedSigns
-			 * vector to crop the corresponding signs from the originalBgrImage.
-			 * {@link MobilenetV2RoadSignClassificator} will scale them to
-			 * the size it needs using bicubic interpolation.
-			 */
-			std::vector<cv::Mat> cutOutImages;
-
-			/**
-			 * Height of the originalBGRImage.
-			 */
-			int originalImageHeight;
-
-			/**
-			 * Width of the originalBGRImage
-			 */
-			int originalImageWidth;
-
-			/**
-			 * Contains the ID of entries in detectedSigns
-			 * which were successfully classified by the classifier Filter
-			 * and are not in the class of unimportant signs.
-			*/
-			std::vector<int> classifierApprovedSigns;
-
-			/**
-			 * The ClassifiedSignsGrouper tries to group all successfully
-			 * classified signs on an (estimated) pole (which means they
-			 * are located vertically above each other) into an
-			 * DetectedSignCombination. The result is stored in this vector.
-			 */
-			std::vector<DetectedSignCombination> detectedSignCombinations;
-
-	};
-}
-
-
-#endif /* HEADER_FILES_ROADSIGNAPI_RSAPIWORKINGDATASET_RSAPIWORKINGDATASET_H_ */
+/*
+ * RSAPIWorkingDataSet.h
+ *
+ *  Created on: 03.06.2018
+ *      Author: Patrick Langer
+ */
+
+#ifndef HEADER_FILES_ROADSIGNAPI_RSAPIWORKINGDATASET_RSAPIWORKINGDATASET_H_
+#define HEADER_FILES_ROADSIGNAPI_RSAPIWORKINGDATASET_RSAPIWORKINGDATASET_H_
+
+#include <opencv2/opencv.hpp>
+
+#include "FilterManagementLibrary/PipeSystem/PipeWorkingDataSet.h"
+#include "FilterManagementLibrary/YUVImageUtils.h"
+#include "RoadSignAPI/DegradationFlags.h"
+#include "RoadSignAPI/DetectedSignDescriptor.h"
+#include "RoadSignAPI/DetectionTable.h"
+#include "RoadSignAPI/DetectedSignCombination.h"
+#include "RoadSignAPI/SignCombinationTrack.h"
+
+namespace RoadSignAPI
+{
+	/**
+	 * Contains all variables which are needed to (efficiently!) detect and
+	 * classifiy roadsigns from an OpenCV image Matrix.
+	 * The detected and classified signs will also be stored here as a result.
+	 */
+	struct RSAPIWorkingDataSet :
+			public FilterManagementLibrary::PipeSystem::PipeWorkingDataSet
+	{
+			/**
+			 * This is the image which was feed into the API using
+			 * {see RoadSignAPI}'s feedImage(...) function
+			 * Needs to be 8UC3 BGR Image because {link TensorflowOpenCVUtils}
+			 * expects that.
+			 */
+			cv::Mat originalBGRImage;
+
+			/**
+			 * True if the current image was feed into the API using
+			 * {see RoadSignAPI}'s feedImageYUV(...) function. In this case
+			 * originalBGRImage stays empty and all filters sample the
+			 * pixels they need from originalYUVFrame instead.
+			 */
+			bool yuvInput = false;
+
+			/**
+			 * Describes the (not owned) YUV frame which was feed into the
+			 * API using {see RoadSignAPI}'s feedImageYUV(...) function.
+			 * Only valid if yuvInput is true.
+			 */
+			FilterManagementLibrary::YUVFrame originalYUVFrame;
+
+			/**
+			 * This will be initialized by {@link SSDLiteRoadSignDetector}.
+			 * It creates a scaled cv::Mat from the originalBGRImage
+			 * (in 8UC3 format, too) which matches the input size of
+			 * the neuronal network model used for
+			 * the {@link SSDLiteRoadSignDetector} using bicubic interpolation.
+			 */
+			cv::Mat detectorScaledBGRImage;
+
+			/**
+			 * Describes the signs that were detected by the
+			 * {@link SSDLiteRoadSignDetector}, column by column (see
+			 * {@link DetectionTable}). The filters of the pipe work on
+			 * this table, indices into it (i.e. classifierApprovedSigns)
+			 * are also valid for detectedSigns.
+			 */
+			DetectionTable detections;
+
+			/**
+			 * Describes the signs that were detected by the
+			 * {@link SSDLiteRoadSignDetector}.
+			 * See {@link DetectedSignDescriptor} for a more detailed
+			 * description.
+			 * Only a copy of detections, created by the
+			 * {@link ClassifiedSignsGrouper} at the end of the frame for
+			 * the users of the API.
+			 */
+			std::vector<DetectedSignDescriptor> detectedSigns;
+
+			/**
+			 * Number of detections the {@link SSDLiteRoadSignDetector}
+			 * found, before the {@link RoadSignDuplicationDeleter} removed
+			 * the duplicates.
+			 */
+			int rawDetectionCount = 0;
+
+			/**
+			 * This vector will be filled by the
+			 * {@link DetectionBasedImageSlicer}. It uses the detections
+			 * table to crop the corresponding signs from the originalBgrImage.
+			 * {@link MobilenetV2RoadSignClassificator} will scale them to
+			 * the size it needs using bicubic interpolation.
+			 */
+			std::vector<cv::Mat> cutOutImages;
+
+			/**
+			 * This vector will be filled by the
+			 * {@link DetectionBasedImageSlicer}, too. It contains the
+			 * (expanded) regions of the original image the cutOutImages
+			 * were cropped from, in the same order as detections.
+			 * If yuvInput is true, no cutOutImages are created and
+			 * {@link MobilenetV2RoadSignClassificator} samples these regions
+			 * straight from originalYUVFrame.
+			 */
+			std::vector<cv::Rect> cutOutRegions;
+
+			/**
+			 * Height of the originalBGRImage (or originalYUVFrame).
+			 */
+			int originalImageHeight = 0;
+
+			/**
+			 * Width of the originalBGRImage (or originalYUVFrame).
+			 */
+			int originalImageWidth = 0;
+
+			/**
+			 * Time (see Utilities::getTimeUs()) at which the results of the
+			 * current frame are due, 0 if the frame has no deadline.
+			 * The {@link MobilenetV2RoadSignClassificator} classifies fewer
+			 * signs if it would not finish in time otherwise.
+			 */
+			int64_t frameDeadlineUs = 0;
+
+			/**
+			 * Combination of DegradationFlag bits, telling which work was
+			 * left out in the current frame to meet frameDeadlineUs.
+			 */
+			uint32_t degradationFlags = DEGRADATION_NONE;
+
+			/**
+			 * Contains the ID of entries in detections (and detectedSigns)
+			 * which were successfully classified by the classifier Filter
+			 * and are not in the class of unimportant signs.
+			*/
+			std::vector<int> classifierApprovedSigns;
+
+			/**
+			 * The ClassifiedSignsGrouper tries to group all successfully
+			 * classified signs on an (estimated) pole (which means they
+			 * are located vertically above each other) into an
+			 * DetectedSignCombination. The result is stored in this vector.
+			 */
+			std::vector<DetectedSignCombination> detectedSignCombinations;
+
+			/**
+			 * The ClassifiedSignsGrouper follows the detectedSignCombinations
+			 * over consecutive frames. In contrast to everything else in
+			 * this data set, the tracks are kept from frame to frame, their
+			 * state tells what happened to them in the current frame.
+			 */
+			std::vector<SignCombinationTrack> signCombinationTracks;
+
+			/**
+			 * IDs of the signCombinationTracks which expired (were removed)
+			 * in the current frame.
+			 */
+			std::vector<uint32_t> expiredSignCombinationTrackIDs;
+
+	};
+}
+
+
+#endif /* HEADER_FILES_ROADSIGNAPI_RSAPIWORKINGDATASET_RSAPIWORKINGDATASET_H_ */
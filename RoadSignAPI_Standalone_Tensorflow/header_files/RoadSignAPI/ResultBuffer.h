@@ -0,0 +1,160 @@
+/*
+ * ResultBuffer.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#ifndef HEADER_FILES_ROADSIGNAPI_RESULTBUFFER_H_
+#define HEADER_FILES_ROADSIGNAPI_RESULTBUFFER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "RoadSignAPI/DegradationFlags.h"
+#include "RoadSignAPI/DetectedSignCombination.h"
+
+namespace RoadSignAPI
+{
+	/**
+	 * Flat, versioned binary representation of the results of one frame,
+	 * meant to be passed around with a single memcpy (i.e. into shared
+	 * memory or over a socket to another process):
+	 *
+	 * [ResultBufferHeader][ResultSignRecord * signCount]
+	 * [ResultCombinationSpan * combinationCount]
+	 *
+	 * All values are stored in the byte order of the writing machine, which
+	 * can be detected by the reader using the magic value. Record sizes and
+	 * offsets are stored in the header, so newer versions can append fields
+	 * to the records without breaking older readers.
+	 */
+	static const uint32_t RESULT_BUFFER_MAGIC = 0x42525352; // "RSRB"
+	static const uint16_t RESULT_BUFFER_VERSION = 1;
+
+	struct ResultBufferHeader
+	{
+		uint32_t magic;
+		uint16_t version;
+		uint16_t headerSize;
+
+		/**
+		 * Size of the whole buffer (header and all records) in bytes.
+		 */
+		uint32_t totalSize;
+
+		uint32_t signCount;
+		uint32_t combinationCount;
+		uint32_t signRecordSize;
+		uint32_t combinationRecordSize;
+
+		/**
+		 * Offsets of the first sign record and the first combination span,
+		 * counted from the start of the buffer.
+		 */
+		uint32_t signsOffset;
+		uint32_t combinationsOffset;
+
+		int32_t imageWidth;
+		int32_t imageHeight;
+
+		/**
+		 * DegradationFlag bits of the frame (was reserved and always 0
+		 * before, so readers of version 1 can rely on it).
+		 */
+		uint32_t degradationFlags;
+
+		/**
+		 * Number of the frame these results belong to, counted by the
+		 * RoadSignAPI instance since its creation (the frame ID of the
+		 * producer for results of a SharedMemoryFrameServer).
+		 */
+		uint64_t frameIndex;
+	};
+
+	/**
+	 * One classified sign. Coordinates refer to the original image.
+	 * classID is UNCLASSIFIED_SIGN_CLASS_ID if only the detector looked at
+	 * the sign (see DegradationFlags.h).
+	 */
+	struct ResultSignRecord
+	{
+		int32_t classID;
+		float confidence;
+		int32_t detectorClassID;
+		float detectorConfidence;
+		int32_t upperLeftX;
+		int32_t upperLeftY;
+		int32_t lowerRightX;
+		int32_t lowerRightY;
+	};
+
+	/**
+	 * One DetectedSignCombination, referencing signCount consecutive
+	 * sign records starting at firstSign (sorted from top to bottom).
+	 */
+	struct ResultCombinationSpan
+	{
+		uint32_t firstSign;
+		uint32_t signCount;
+		int32_t estimatedPolePositionX;
+
+		/**
+		 * See DetectedSignCombination::getTrackID(), 0 if not tracked.
+		 */
+		uint32_t trackID;
+	};
+
+	/**
+	 * Writes results into caller provided buffers without allocating
+	 * any memory.
+	 */
+	class ResultBufferWriter
+	{
+		public:
+			static size_t getRequiredSize(const
+					std::vector<DetectedSignCombination>& combinations);
+
+			static bool serialize(const
+					std::vector<DetectedSignCombination>& combinations,
+					int imageWidth, int imageHeight, uint64_t frameIndex,
+					uint8_t* buffer, size_t bufferSize,
+					size_t* writtenSize,
+					uint32_t degradationFlags = DEGRADATION_NONE);
+	};
+
+	/**
+	 * Zero-copy view on a serialized result buffer. All returned pointers
+	 * point into the attached buffer, which needs to stay valid (and
+	 * unchanged) as long as they are used.
+	 */
+	class ResultBufferReader
+	{
+		private:
+			const uint8_t* buffer;
+			const ResultBufferHeader* header;
+
+		public:
+			bool attach(const uint8_t* buffer, size_t bufferSize);
+
+			const ResultBufferHeader* getHeader() const;
+
+			uint32_t getSignCount() const;
+
+			uint32_t getCombinationCount() const;
+
+			const ResultSignRecord* getSign(uint32_t index) const;
+
+			const ResultCombinationSpan* getCombination(uint32_t index) const;
+
+			const ResultSignRecord* getSignOfCombination(
+					uint32_t combinationIndex, uint32_t signIndex) const;
+
+			ResultBufferReader();
+	};
+}
+
+
+#endif /* HEADER_FILES_ROADSIGNAPI_RESULTBUFFER_H_ */
@@ -1,209 +1,526 @@
-/*
- * RoadSignAPI.h
- *
- *  Created on: 05.06.2018
- *      Author: Patrick Langer
- */
-
-#ifndef SOURCE_FILES_ROADSIGNAPI_ROADSIGNAPI_H_
-#define SOURCE_FILES_ROADSIGNAPI_ROADSIGNAPI_H_
-
-#include <vector>
-#include "RoadSignAPI/DetectedSignDescriptor.h"
-
-#include "FilterManagementLibrary/PipeSystem/ProcessingPipeline.h"
-#include "RoadSignAPI/Filters/SSDLiteRoadSignDetector.h"
-#include "RoadSignAPI/Filters/DetectionBasedImageSlicer.h"
-#include "RoadSignAPI/Filters/MobilenetV2RoadSignClassificator.h"
-#include "RoadSignAPI/Filters/ClassifiedSignsGrouper.h"
-#include "RoadSignAPI/Filters/RoadSignDuplicationDeleter.h"
-#include "RoadSignAPI/RSAPIWorkingDataSet/RSAPIWorkingDataSet.h"
-#include "RoadSignAPI/RSAPIPipeRegisteredFilters/RSAPIPipeRegisteredFilters.h"
-
-
-
-
-
-// Class of static functions which provides an entry to all
-// of the functionality of RoadSignAPI
-
-namespace RoadSignAPI
-{
-	/**
-	 * Implemenation of the RoadSignAPI.
-	 * Here all filters used for roadsign detection and classification will
-	 * be set up and managed.
-	 * It provides a static interface using a static instance of RoadSignAPI
-	 * to easily feed an image and analyze it from static environments
-	 * (i.e. Java Native Interface)
-	 *
-     * 
-     * @image html api_class_roadsign2.svg
-     * @image latex api_class_roadsign2.png width=16cm
-    **/
-	class RoadSignAPI
-	{
-		private:
-			/**
-			 * Pipeline which is used for sequencial processing of filters
-			 * used for roadsign detection, classification, grouping
-			 * and filtering.
-			 */
-			FilterManagementLibrary::
-			PipeSystem::ProcessingPipeline processingPipeline;
-
-			/**
-			 * Static description for the ssdLite network, used for static interface.
-			 */
-			static FilterManagementLibrary::TFIntegration::TensorflowNNModelDescription ssdLiteModelDescription;
-
-			/**
-			 * Static description for the mobilenetv2 network, used for static interface.
-			 */
-			static FilterManagementLibrary::TFIntegration::TensorflowNNModelDescription mobilenetModelDescription;
-
-			/**
-			 * Instance of the SSDLiteRoadSignDetector used for roadsign
-			 * detection, which is registered to the pipe of an instance
-			 * of RoadSignAPI.
-			 */
-			SSDLiteRoadSignDetector roadSignDetector;
-
-			/**
-			 * Instance of the MobilenetV2RoadSignClassificator used for
-			 * roadsign classification, which is registered to the pipe of
-			 * an instance of RoadSignAPI.
-			 */
-			MobilenetV2RoadSignClassificator roadSignClassificator;
-
-			/**
-			 * Instance of DetectionBasedImageSlicer used to crop the boxes
-			 * in which the roadsigns are contained, predicted by the
-			 * SSDLiteRoadSignDetector.
-			 */
-			DetectionBasedImageSlicer detectionBasedImageSlicer;
-
-			/**
-			 * Instance of ClassifiedSignsGrouper which groups all signs
-			 * that where detected *AND* classified into
-			 * @link{DetectedSignCombination}s
-			 */
-			ClassifiedSignsGrouper classifiedSignsGrouper;
-
-			/**
-			 * Instance of RoadSignDuplicationDeleter which is used to
-			 * delete signs that were detected multiple times (with a little
-			 * offset) by the SSDLiteRoadSignDetector.
-			 */
-			RoadSignDuplicationDeleter roadSignDuplicationDeleter;
-
-			/**
-			 * Instance of RSAPIWorkingDataSet, which is the shared resource
-			 * in which all results of the filters used in this class
-			 * are stored.
-			 */
-			RSAPIWorkingDataSet workingDataSet;
-
-			/**
-			 * Instance of RSAPIPipeRegisteredFilters, which is a struct in
-			 * which all IDs of the filters which are added to the
-			 * ProcessingPipeline of this class are stored.
-			 * It is passed to all filters so they know the IDs of all other
-			 * filters.
-			 */
-			RSAPIPipeRegisteredFilters pipeRegisteredFilters;
-
-			/**
-			 * Static instance of RoadSignAPI for static interface.
-			 */
-			static RoadSignAPI* instance;
-
-			#ifdef __ANDROID__
-				/**
-				 * A pointer to an AssetManager which can be passed via
-				 * the constructor.
-				 * We need it to be able to load model files from the Android
-				 * assets folder, which we want to do so the files do not have
-				 * to be placed in the normal user space.
-				 * Will be passed to SSDLiteRoadSignDetector and
-				 * MobilenetV2RoadSignClassificator.
-				 */
-				AAssetManager* const assetManager;
-			#endif
-
-
-		public:
-
-			bool init();
-
-			bool feedImage(cv::Mat iamge);
-
-			const
-				std::vector<DetectedSignDescriptor>* getDetectedSigns();
-
-			void getClassifierApprovedDetectedSigns(
-				std::vector<const DetectedSignDescriptor*>* detectedSigns);
-
-			const std::vector<DetectedSignCombination>*
-					const getDetectedSignCombinations() const;
-
-			// Static interface
-
-			#ifdef __ANDROID__
-				// Under Android, we need an AssetManager passed from Java
-				// in order to be able to load the model files from the
-				// assets folder of the Android app.
-			static bool staticInit(
-						const int numThreads,
-						AAssetManager* const assetManager);
-			#else
-				static bool staticInit(const int numThreads);
-			#endif
-
-
-			// cv::Mat uses Smartpointers, so we
-			// don't have to use pointers to pass it around
-			static bool staticFeedImage(cv::Mat image);
-
-			// Remember: If you have a const vector<int> you cannot modify the container,
-			// nor can you modify any of the elements in the container.
-			static const
-				std::vector<DetectedSignDescriptor>* staticGetDetectedSigns();
-
-			static void staticGetClassifierApprovedDetectedSigns(
-					std::vector<const DetectedSignDescriptor*>* detectedSigns);
-
-
-			static const std::vector<DetectedSignCombination>*
-						const staticGetDetectedSignCombinations();
-
-
-
-			// We provide a slightly different constructor for Android environments
-			// to be able to pass in an AAssetManager to load model files from
-			// the Android assets folder of an application using this.
-			#ifdef __ANDROID__
-			RoadSignAPI(
-					FilterManagementLibrary::
-					TFIntegration::TensorflowNNModelDescription
-					detectorModelDescription,
-					FilterManagementLibrary::
-					TFIntegration::TensorflowNNModelDescription
-					classificatorModelDescription,
-					const int numThreads, AAssetManager* const assetManager);
-			#else
-			RoadSignAPI(
-					FilterManagementLibrary::
-					TFIntegration::TensorflowNNModelDescription
-					detectorModelDescription,
-					FilterManagementLibrary::
-					TFIntegration::TensorflowNNModelDescription
-					classificatorModelDescription,
-					const int numThreads);
-			#endif
-
-	};
-}
-
-
-#endif /* SOURCE_FILES_ROADSIGNAPI_ROADSIGNAPI_H_ */
+/*
+ * RoadSignAPI.h
+ *
+ *  Created on: 05.06.2018
+ *      Author: Patrick Langer
+ */
+
+#ifndef SOURCE_FILES_ROADSIGNAPI_ROADSIGNAPI_H_
+#define SOURCE_FILES_ROADSIGNAPI_ROADSIGNAPI_H_
+
+#include <vector>
+#include "RoadSignAPI/DetectedSignDescriptor.h"
+
+#include "FilterManagementLibrary/PipeSystem/ProcessingPipeline.h"
+#include "RoadSignAPI/Filters/SSDLiteRoadSignDetector.h"
+#include "RoadSignAPI/Filters/DetectionBasedImageSlicer.h"
+#include "RoadSignAPI/Filters/MobilenetV2RoadSignClassificator.h"
+#include "RoadSignAPI/Filters/ClassifiedSignsGrouper.h"
+#include "RoadSignAPI/Filters/RoadSignDuplicationDeleter.h"
+#include "RoadSignAPI/RSAPIWorkingDataSet/RSAPIWorkingDataSet.h"
+#include "RoadSignAPI/RSAPIPipeRegisteredFilters/RSAPIPipeRegisteredFilters.h"
+#include "FilterManagementLibrary/YUVImageUtils.h"
+#include "RoadSignAPI/AnnotatedOutputRenderer.h"
+#include "RoadSignAPI/ResultBuffer.h"
+#include "RoadSignAPI/SignCombinationTrack.h"
+#include "RoadSignAPI/FrameQueue.h"
+#include "RoadSignAPI/QoSController.h"
+#include "RoadSignAPI/RSAPIParameters.h"
+#include "FilterManagementLibrary/FrameTrace.h"
+
+
+
+
+
+// Class of static functions which provides an entry to all
+// of the functionality of RoadSignAPI
+
+namespace RoadSignAPI
+{
+	/**
+	 * Implemenation of the RoadSignAPI.
+	 * Here all filters used for roadsign detection and classification will
+	 * be set up and managed.
+	 * It provides a static interface using a static instance of RoadSignAPI
+	 * to easily feed an image and analyze it from static environments
+	 * (i.e. Java Native Interface)
+	 *
+     * 
+     * @image html api_class_roadsign2.svg
+     * @image latex api_class_roadsign2.png width=16cm
+    **/
+	class RoadSignAPI
+	{
+		private:
+			/**
+			 * Pipeline which is used for sequencial processing of filters
+			 * used for roadsign detection, classification, grouping
+			 * and filtering.
+			 */
+			FilterManagementLibrary::
+			PipeSystem::ProcessingPipeline processingPipeline;
+
+			/**
+			 * Static description for the ssdLite network, used for static interface.
+			 */
+			static FilterManagementLibrary::TFIntegration::TensorflowNNModelDescription ssdLiteModelDescription;
+
+			/**
+			 * Static description for the mobilenetv2 network, used for static interface.
+			 */
+			static FilterManagementLibrary::TFIntegration::TensorflowNNModelDescription mobilenetModelDescription;
+
+			/**
+			 * Instance of the SSDLiteRoadSignDetector used for roadsign
+			 * detection, which is registered to the pipe of an instance
+			 * of RoadSignAPI.
+			 */
+			SSDLiteRoadSignDetector roadSignDetector;
+
+			/**
+			 * Instance of the MobilenetV2RoadSignClassificator used for
+			 * roadsign classification, which is registered to the pipe of
+			 * an instance of RoadSignAPI.
+			 */
+			MobilenetV2RoadSignClassificator roadSignClassificator;
+
+			/**
+			 * Instance of DetectionBasedImageSlicer used to crop the boxes
+			 * in which the roadsigns are contained, predicted by the
+			 * SSDLiteRoadSignDetector.
+			 */
+			DetectionBasedImageSlicer detectionBasedImageSlicer;
+
+			/**
+			 * Instance of ClassifiedSignsGrouper which groups all signs
+			 * that where detected *AND* classified into
+			 * @link{DetectedSignCombination}s
+			 */
+			ClassifiedSignsGrouper classifiedSignsGrouper;
+
+			/**
+			 * Instance of RoadSignDuplicationDeleter which is used to
+			 * delete signs that were detected multiple times (with a little
+			 * offset) by the SSDLiteRoadSignDetector.
+			 */
+			RoadSignDuplicationDeleter roadSignDuplicationDeleter;
+
+			/**
+			 * Instance of RSAPIWorkingDataSet, which is the shared resource
+			 * in which all results of the filters used in this class
+			 * are stored.
+			 */
+			RSAPIWorkingDataSet workingDataSet;
+
+			/**
+			 * Instance of RSAPIPipeRegisteredFilters, which is a struct in
+			 * which all IDs of the filters which are added to the
+			 * ProcessingPipeline of this class are stored.
+			 * It is passed to all filters so they know the IDs of all other
+			 * filters.
+			 */
+			RSAPIPipeRegisteredFilters pipeRegisteredFilters;
+
+			/**
+			 * Number of frames fed into this instance so far, the current
+			 * frame has index frameCounter - 1. Written into serialized
+			 * results so consumers can match them to frames.
+			 */
+			uint64_t frameCounter;
+
+			/**
+			 * Time the results of a frame are due after it arrived in
+			 * microseconds, 0 if frames have no deadline
+			 * (see setFrameBudget(...)).
+			 */
+			int64_t frameBudgetUs;
+
+			/**
+			 * Switches between the operating points added by
+			 * addQoSOperatingPoint(...) to hold a target frame rate.
+			 */
+			QoSController qosController;
+
+			/**
+			 * Tuning parameters the filters currently use, see
+			 * setParameters(...).
+			 */
+			RSAPIParameters parameters;
+
+			/**
+			 * Writes a record for every frame if open, see
+			 * startFrameTrace(...).
+			 */
+			FilterManagementLibrary::FrameTraceWriter frameTraceWriter;
+
+			/**
+			 * Inferences of the roadSignClassificator before the current
+			 * frame, to trace the number of crops classified per frame.
+			 */
+			uint64_t tracedClassifierInferenceCount;
+
+			/**
+			 * Static instance of RoadSignAPI for static interface.
+			 */
+			static RoadSignAPI* instance;
+
+			#ifdef __ANDROID__
+				/**
+				 * A pointer to an AssetManager which can be passed via
+				 * the constructor.
+				 * We need it to be able to load model files from the Android
+				 * assets folder, which we want to do so the files do not have
+				 * to be placed in the normal user space.
+				 * Will be passed to SSDLiteRoadSignDetector and
+				 * MobilenetV2RoadSignClassificator.
+				 */
+				AAssetManager* const assetManager;
+			#endif
+
+			void setBGRInput(cv::Mat image);
+
+			bool setYUVInput(const uint8_t* const planes[3],
+					const int strides[3],
+					FilterManagementLibrary::YUVFormat format,
+					const int width, const int height,
+					const bool rotate180);
+
+			bool processFrame(int64_t arrivalTimeUs);
+
+			bool applyQoSOperatingPoint();
+
+			void traceFrame(int64_t arrivalTimeUs, int64_t startTimeUs,
+					int64_t endTimeUs, bool processed);
+
+			static void setupModelDescriptions();
+
+
+		public:
+
+			bool init();
+
+			bool feedImage(cv::Mat iamge);
+
+			bool feedImageYUV(const uint8_t* const planes[3],
+					const int strides[3],
+					FilterManagementLibrary::YUVFormat format,
+					const int width, const int height,
+					const bool rotate180 = false);
+
+			bool feedQueuedFrame(const QueuedFrame* frame);
+
+			const
+				std::vector<DetectedSignDescriptor>* getDetectedSigns();
+
+			void getClassifierApprovedDetectedSigns(
+				std::vector<const DetectedSignDescriptor*>* detectedSigns);
+
+			const std::vector<DetectedSignCombination>*
+					const getDetectedSignCombinations() const;
+
+			const std::vector<SignCombinationTrack>*
+					getSignCombinationTracks() const;
+
+			const std::vector<uint32_t>*
+					getExpiredSignCombinationTrackIDs() const;
+
+			const std::vector<FilterManagementLibrary::
+			PipeSystem::PipeFilterStatistics>*
+					getPipelineStatistics() const;
+
+			bool setPipelineSchedulingMode(FilterManagementLibrary::
+					PipeSystem::ProcessingPipeline::SchedulingMode
+					schedulingMode, int workerThreadCount = 0);
+
+			bool setPerformanceCountersEnabled(bool enabled);
+
+			FilterManagementLibrary::MemoryUsage getPipelineMemoryUsage();
+
+			FilterManagementLibrary::MemoryUsage getDetectorMemoryUsage();
+
+			FilterManagementLibrary::MemoryUsage getClassifierMemoryUsage();
+
+			void resetMemoryPeaks();
+
+			int addDetectorModelVariant(FilterManagementLibrary::
+					TFIntegration::TensorflowNNModelDescription
+					modelDescription);
+
+			int addClassifierModelVariant(FilterManagementLibrary::
+					TFIntegration::TensorflowNNModelDescription
+					modelDescription);
+
+			bool replaceDetectorModel(int modelVariant,
+					FilterManagementLibrary::TFIntegration::
+					TensorflowNNModelDescription modelDescription);
+
+			bool replaceClassifierModel(int modelVariant,
+					FilterManagementLibrary::TFIntegration::
+					TensorflowNNModelDescription modelDescription);
+
+			FilterManagementLibrary::PipeSystem::TFNNBasedPipeFilter::
+					ModelSwapState getDetectorModelSwapState() const;
+
+			FilterManagementLibrary::PipeSystem::TFNNBasedPipeFilter::
+					ModelSwapState getClassifierModelSwapState() const;
+
+			int addQoSOperatingPoint(const QoSOperatingPoint& operatingPoint);
+
+			void setQoSTargetFrameRate(float framesPerSecond);
+
+			void setQoSHysteresis(float degradeRatio, float upgradeRatio,
+					int windowFrames, int upgradeHoldFrames,
+					double percentile = 0.0);
+
+			int getQoSOperatingPoint() const;
+
+			const FilterManagementLibrary::LatencyHistogram*
+					getFrameLatencyHistogram() const;
+
+			void setFrameBudget(int budgetMs);
+
+			uint32_t getDegradationFlags() const;
+
+			bool setParameters(const RSAPIParameters& parameters);
+
+			const RSAPIParameters& getParameters() const;
+
+			bool startFrameTrace(const std::string& path);
+
+			bool stopFrameTrace();
+
+			void setOutputRecorders(FilterManagementLibrary::TFIntegration::
+					TensorflowOutputRecorder* detectorRecorder,
+					FilterManagementLibrary::TFIntegration::
+					TensorflowOutputRecorder* classifierRecorder);
+
+			void setOutputReplay(const FilterManagementLibrary::
+					TFIntegration::TensorflowOutputRecording*
+					detectorRecording,
+					const FilterManagementLibrary::TFIntegration::
+					TensorflowOutputRecording* classifierRecording);
+
+			size_t getSerializedResultsSize() const;
+
+			bool serializeResults(uint8_t* buffer, size_t bufferSize,
+					size_t* writtenSize) const;
+
+			bool serializeResults(uint8_t* buffer, size_t bufferSize,
+					size_t* writtenSize, uint64_t frameIndex) const;
+
+			bool renderAnnotatedImage(uint8_t* output, int outputStride,
+					FilterManagementLibrary::ImageConversion::PixelFormat
+					format,
+					const AnnotationOptions& options = AnnotationOptions())
+					const;
+
+			// Descriptions of the models the static interface uses, to
+			// create further instances (i.e. to process images in parallel)
+			static FilterManagementLibrary::TFIntegration::
+					TensorflowNNModelDescription
+					getDefaultDetectorModelDescription();
+
+			static FilterManagementLibrary::TFIntegration::
+					TensorflowNNModelDescription
+					getRawOutputDetectorModelDescription();
+
+			static FilterManagementLibrary::TFIntegration::
+					TensorflowNNModelDescription
+					getDefaultClassifierModelDescription();
+
+			// Static interface
+
+			#ifdef __ANDROID__
+				// Under Android, we need an AssetManager passed from Java
+				// in order to be able to load the model files from the
+				// assets folder of the Android app.
+			static bool staticInit(
+						const int numThreads,
+						AAssetManager* const assetManager);
+			#else
+				static bool staticInit(const int numThreads);
+			#endif
+
+
+			// cv::Mat uses Smartpointers, so we
+			// don't have to use pointers to pass it around
+			static bool staticFeedImage(cv::Mat image);
+
+			// The planes are not copied, they only need to stay valid
+			// until the call returns (or until staticRenderAnnotatedImage
+			// returns, if it is used).
+			static bool staticFeedImageYUV(const uint8_t* const planes[3],
+					const int strides[3],
+					FilterManagementLibrary::YUVFormat format,
+					const int width, const int height,
+					const bool rotate180 = false);
+
+			// Frames from a FrameQueue, release the frame only after the
+			// results were read (see FrameQueue.h)
+			static bool staticFeedQueuedFrame(const QueuedFrame* frame);
+
+			// Remember: If you have a const vector<int> you cannot modify the container,
+			// nor can you modify any of the elements in the container.
+			static const
+				std::vector<DetectedSignDescriptor>* staticGetDetectedSigns();
+
+			static void staticGetClassifierApprovedDetectedSigns(
+					std::vector<const DetectedSignDescriptor*>* detectedSigns);
+
+
+			static const std::vector<DetectedSignCombination>*
+						const staticGetDetectedSignCombinations();
+
+			// Combinations followed over consecutive frames, only the
+			// ones which are NEW or UPDATED (plus the expired IDs) need
+			// to be looked at, see SignCombinationTrack.h
+			static const std::vector<SignCombinationTrack>*
+						staticGetSignCombinationTracks();
+
+			static const std::vector<uint32_t>*
+						staticGetExpiredSignCombinationTrackIDs();
+
+			// How often each filter was invoked and skipped (because it had
+			// nothing to work on), in the order the filters are registered
+			static const std::vector<FilterManagementLibrary::
+			PipeSystem::PipeFilterStatistics>*
+						staticGetPipelineStatistics();
+
+			// Switches the pipe to the DAG scheduling mode (or back),
+			// see ProcessingPipeline::setSchedulingMode(...)
+			static bool staticSetPipelineSchedulingMode(
+					FilterManagementLibrary::PipeSystem::ProcessingPipeline::
+					SchedulingMode schedulingMode, int workerThreadCount = 0);
+
+			// Hardware counters (cycles, instructions, cache and branch
+			// misses) per filter in the pipeline statistics, see
+			// ProcessingPipeline::setPerformanceCountersEnabled(...)
+			static bool staticSetPerformanceCountersEnabled(bool enabled);
+
+			// Current and peak bytes of the pipe (including the models)
+			// and of each model, see MemoryAccount. The totals of
+			// Tensorflow and OpenCV (all instances and the application)
+			// are available from MemoryAccount::getTensorflowAccount()
+			// and getOpenCVAccount().
+			static FilterManagementLibrary::MemoryUsage
+					staticGetPipelineMemoryUsage();
+
+			static FilterManagementLibrary::MemoryUsage
+					staticGetDetectorMemoryUsage();
+
+			static FilterManagementLibrary::MemoryUsage
+					staticGetClassifierMemoryUsage();
+
+			static void staticResetMemoryPeaks();
+
+			// Additional models which can be switched to without setting
+			// up the pipe again, loaded right away. See QoSController.h
+			static int staticAddDetectorModelVariant(
+					FilterManagementLibrary::TFIntegration::
+					TensorflowNNModelDescription modelDescription);
+
+			static int staticAddClassifierModelVariant(
+					FilterManagementLibrary::TFIntegration::
+					TensorflowNNModelDescription modelDescription);
+
+			// Updated models, loaded in the background and swapped in
+			// between two frames (modelVariant 0 for the models passed to
+			// staticInit). Only one model per filter at a time.
+			static bool staticReplaceDetectorModel(int modelVariant,
+					FilterManagementLibrary::TFIntegration::
+					TensorflowNNModelDescription modelDescription);
+
+			static bool staticReplaceClassifierModel(int modelVariant,
+					FilterManagementLibrary::TFIntegration::
+					TensorflowNNModelDescription modelDescription);
+
+			static FilterManagementLibrary::PipeSystem::TFNNBasedPipeFilter::
+					ModelSwapState staticGetDetectorModelSwapState();
+
+			static FilterManagementLibrary::PipeSystem::TFNNBasedPipeFilter::
+					ModelSwapState staticGetClassifierModelSwapState();
+
+			static int staticAddQoSOperatingPoint(
+					const QoSOperatingPoint& operatingPoint);
+
+			// 0 disables the QoS controller
+			static void staticSetQoSTargetFrameRate(float framesPerSecond);
+
+			static void staticSetQoSHysteresis(float degradeRatio,
+					float upgradeRatio, int windowFrames,
+					int upgradeHoldFrames, double percentile = 0.0);
+
+			static int staticGetQoSOperatingPoint();
+
+			// Processing time of the frames, see LatencyHistogram.h
+			static const FilterManagementLibrary::LatencyHistogram*
+						staticGetFrameLatencyHistogram();
+
+			// Latency budget per frame, the results are degraded (fewer
+			// signs classified) as it runs out, see setFrameBudget(...)
+			static void staticSetFrameBudget(int budgetMs);
+
+			// DegradationFlag bits of the lastly processed frame
+			static uint32_t staticGetDegradationFlags();
+
+			// Thresholds of the filters, see RSAPIParameters.h. Take
+			// effect with the next frame.
+			static bool staticSetParameters(
+					const RSAPIParameters& parameters);
+
+			static const RSAPIParameters& staticGetParameters();
+
+			// Per frame trace of the filter times and box counts, see
+			// startFrameTrace(...) and tools/rsapi_trace2json
+			static bool staticStartFrameTrace(const std::string& path);
+
+			static bool staticStopFrameTrace();
+
+			// Writes the detected sign combinations into a flat buffer,
+			// see ResultBuffer.h
+			static size_t staticGetSerializedResultsSize();
+
+			static bool staticSerializeResults(uint8_t* buffer,
+					size_t bufferSize, size_t* writtenSize);
+
+			static bool staticSerializeResults(uint8_t* buffer,
+					size_t bufferSize, size_t* writtenSize,
+					uint64_t frameIndex);
+
+			// Optional, only needed if the frame shall be displayed
+			static bool staticRenderAnnotatedImage(uint8_t* output,
+					int outputStride,
+					FilterManagementLibrary::ImageConversion::PixelFormat
+					format,
+					const AnnotationOptions& options = AnnotationOptions());
+
+
+
+			// We provide a slightly different constructor for Android environments
+			// to be able to pass in an AAssetManager to load model files from
+			// the Android assets folder of an application using this.
+			#ifdef __ANDROID__
+			RoadSignAPI(
+					FilterManagementLibrary::
+					TFIntegration::TensorflowNNModelDescription
+					detectorModelDescription,
+					FilterManagementLibrary::
+					TFIntegration::TensorflowNNModelDescription
+					classificatorModelDescription,
+					const int numThreads, AAssetManager* const assetManager);
+			#else
+			RoadSignAPI(
+					FilterManagementLibrary::
+					TFIntegration::TensorflowNNModelDescription
+					detectorModelDescription,
+					FilterManagementLibrary::
+					TFIntegration::TensorflowNNModelDescription
+					classificatorModelDescription,
+					const int numThreads);
+			#endif
+
+	};
+}
+
+
+#endif /* SOURCE_FILES_ROADSIGNAPI_ROADSIGNAPI_H_ */
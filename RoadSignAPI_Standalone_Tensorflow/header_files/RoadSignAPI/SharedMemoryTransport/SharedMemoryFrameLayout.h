@@ -0,0 +1,117 @@
+/*
+ * SharedMemoryFrameLayout.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#ifndef HEADER_FILES_ROADSIGNAPI_SHAREDMEMORYTRANSPORT_SHAREDMEMORYFRAMELAYOUT_H_
+#define HEADER_FILES_ROADSIGNAPI_SHAREDMEMORYTRANSPORT_SHAREDMEMORYFRAMELAYOUT_H_
+
+#include <stdint.h>
+
+#include <string>
+
+namespace RoadSignAPI
+{
+	/**
+	 * Pixel layouts a producer can write into a frame slot.
+	 */
+	enum class SharedMemoryFrameFormat : uint32_t
+	{
+		NV21 = 0,
+		NV12 = 1,
+		I420 = 2,
+
+		/**
+		 * Packed 8 bit BGR (OpenCV 8UC3), only plane 0 is used.
+		 */
+		BGR = 3
+	};
+
+	/**
+	 * Status of a result slot.
+	 */
+	enum class SharedMemoryResultStatus : uint32_t
+	{
+		OK = 0,
+
+		/**
+		 * The frame slot header was invalid (i.e. planes outside of
+		 * the slot), the result buffer is empty.
+		 */
+		INVALID_FRAME = 1,
+
+		/**
+		 * The pipeline failed to process the frame, the result buffer
+		 * is empty.
+		 */
+		PROCESSING_FAILED = 2,
+
+		/**
+		 * The results did not fit into the result slot, the result buffer
+		 * is empty.
+		 */
+		RESULT_TOO_LARGE = 3
+	};
+
+	/**
+	 * Header at the start of each slot of the frame ring, followed by the
+	 * pixel data. Plane offsets are counted from the start of the slot.
+	 */
+	struct SharedMemoryFrameSlotHeader
+	{
+		/**
+		 * Chosen by the producer, returned with the results.
+		 */
+		uint64_t frameID;
+
+		uint32_t format;
+		int32_t width;
+		int32_t height;
+		uint32_t rotate180;
+		int32_t strides[3];
+		uint32_t planeOffsets[3];
+		uint32_t reserved[4];
+	};
+
+	/**
+	 * Header at the start of each slot of the result ring, followed by a
+	 * serialized result buffer (see ResultBuffer.h) at
+	 * SHARED_MEMORY_RESULT_OFFSET.
+	 */
+	struct SharedMemoryResultSlotHeader
+	{
+		uint64_t frameID;
+		uint32_t status;
+
+		/**
+		 * Size of the serialized result buffer in bytes.
+		 */
+		uint32_t resultSize;
+	};
+
+	/**
+	 * Offset of the pixel data of a frame slot written by
+	 * SharedMemoryFrameProducer (and of the result buffer in a result
+	 * slot). Keeps the data cache line aligned.
+	 */
+	static const uint32_t SHARED_MEMORY_FRAME_DATA_OFFSET = 64;
+	static const uint32_t SHARED_MEMORY_RESULT_OFFSET = 64;
+
+	/**
+	 * Names of the two rings used by a server with the given base name.
+	 */
+	inline std::string getSharedMemoryFrameRingName(const std::string& name)
+	{
+		return name + "_frames";
+	}
+
+	inline std::string getSharedMemoryResultRingName(const std::string& name)
+	{
+		return name + "_results";
+	}
+}
+
+
+#endif /* HEADER_FILES_ROADSIGNAPI_SHAREDMEMORYTRANSPORT_SHAREDMEMORYFRAMELAYOUT_H_ */
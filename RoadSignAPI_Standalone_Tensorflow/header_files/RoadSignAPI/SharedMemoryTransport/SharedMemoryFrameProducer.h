@@ -0,0 +1,59 @@
+/*
+ * SharedMemoryFrameProducer.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#ifndef HEADER_FILES_ROADSIGNAPI_SHAREDMEMORYTRANSPORT_SHAREDMEMORYFRAMEPRODUCER_H_
+#define HEADER_FILES_ROADSIGNAPI_SHAREDMEMORYTRANSPORT_SHAREDMEMORYFRAMEPRODUCER_H_
+
+#include <string>
+
+#include "FilterManagementLibrary/SharedMemoryRing.h"
+#include "RoadSignAPI/ResultBuffer.h"
+#include "RoadSignAPI/SharedMemoryTransport/SharedMemoryFrameLayout.h"
+
+namespace RoadSignAPI
+{
+	/**
+	 * Client side of SharedMemoryFrameServer, used by the capturing
+	 * process.
+	 *
+	 * Frames are written straight into the slots of the frame ring
+	 * (acquireFrame(...) / commitFrame()), i.e. a camera or decoder can
+	 * deliver into them without an intermediate buffer. Results are read
+	 * in place from the result ring (acquireResult(...) / releaseResult()).
+	 * Writing frames and reading results may happen in two different
+	 * threads.
+	 */
+	class SharedMemoryFrameProducer
+	{
+		private:
+			FilterManagementLibrary::SharedMemoryRing frameRing;
+			FilterManagementLibrary::SharedMemoryRing resultRing;
+
+		public:
+			bool connect(const std::string& name);
+
+			void disconnect();
+
+			bool isConnected() const;
+
+			SharedMemoryFrameSlotHeader* acquireFrame(
+					SharedMemoryFrameFormat format, int width, int height,
+					bool rotate180, uint64_t frameID, uint8_t* planes[3],
+					int timeoutMs);
+
+			void commitFrame();
+
+			bool acquireResult(ResultBufferReader* reader,
+					uint64_t* frameID, SharedMemoryResultStatus* status,
+					int timeoutMs);
+
+			void releaseResult();
+	};
+}
+
+
+#endif /* HEADER_FILES_ROADSIGNAPI_SHAREDMEMORYTRANSPORT_SHAREDMEMORYFRAMEPRODUCER_H_ */
@@ -0,0 +1,83 @@
+/*
+ * SharedMemoryFrameServer.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#ifndef HEADER_FILES_ROADSIGNAPI_SHAREDMEMORYTRANSPORT_SHAREDMEMORYFRAMESERVER_H_
+#define HEADER_FILES_ROADSIGNAPI_SHAREDMEMORYTRANSPORT_SHAREDMEMORYFRAMESERVER_H_
+
+#include <atomic>
+#include <string>
+
+#include "FilterManagementLibrary/SharedMemoryRing.h"
+#include "RoadSignAPI/SharedMemoryTransport/SharedMemoryFrameLayout.h"
+
+namespace RoadSignAPI
+{
+	/**
+	 * Serves the RoadSignAPI to other processes via shared memory.
+	 *
+	 * Creates a frame ring, into which a producer process (see
+	 * SharedMemoryFrameProducer) writes frames, and a result ring, into
+	 * which the serialized results (see ResultBuffer.h) are written.
+	 * Frames are processed in place: YUV frames are fed into the static
+	 * RoadSignAPI instance straight from the slot memory via
+	 * staticFeedImageYUV(...), BGR frames via a cv::Mat header on the
+	 * slot. Neither frames nor results are copied on the way.
+	 *
+	 * The static interface of the RoadSignAPI needs to be initialized
+	 * (staticInit(...)) before frames are processed.
+	 */
+	class SharedMemoryFrameServer
+	{
+		private:
+			FilterManagementLibrary::SharedMemoryRing frameRing;
+			FilterManagementLibrary::SharedMemoryRing resultRing;
+
+			/**
+			 * If true, frames are not fed into the RoadSignAPI and empty
+			 * results are returned. Allows to test producers and the
+			 * transport itself without any models.
+			 */
+			bool transportOnly;
+
+			/**
+			 * Maximum time in milliseconds to wait for a free result slot
+			 * before the result of a frame is dropped (so a producer which
+			 * does not read its results can't stall the server).
+			 */
+			int resultTimeoutMs;
+
+			uint64_t processedFrames;
+			uint64_t droppedResults;
+
+			bool isFrameValid(const SharedMemoryFrameSlotHeader* frame) const;
+
+			SharedMemoryResultStatus feedFrame(uint8_t* slot);
+
+		public:
+			bool start(const std::string& name, uint32_t slotCount,
+					int maxWidth, int maxHeight, int maxSigns);
+
+			void stop();
+
+			bool processNextFrame(int timeoutMs);
+
+			void run(const std::atomic<bool>* stopRequested);
+
+			void setTransportOnly(bool transportOnly);
+
+			void setResultTimeout(int resultTimeoutMs);
+
+			uint64_t getProcessedFrames() const;
+
+			uint64_t getDroppedResults() const;
+
+			SharedMemoryFrameServer();
+	};
+}
+
+
+#endif /* HEADER_FILES_ROADSIGNAPI_SHAREDMEMORYTRANSPORT_SHAREDMEMORYFRAMESERVER_H_ */
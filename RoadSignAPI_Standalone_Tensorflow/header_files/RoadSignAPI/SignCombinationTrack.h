@@ -0,0 +1,94 @@
+/*
+ * SignCombinationTrack.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#ifndef HEADER_FILES_ROADSIGNAPI_SIGNCOMBINATIONTRACK_H_
+#define HEADER_FILES_ROADSIGNAPI_SIGNCOMBINATIONTRACK_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "RoadSignAPI/DetectedSignCombination.h"
+
+namespace RoadSignAPI
+{
+	/**
+	 * What happened to a SignCombinationTrack in the lastly processed frame.
+	 * Consumers only interested in changes can skip all tracks which are
+	 * UNCHANGED or MISSED.
+	 */
+	enum class SignCombinationTrackState
+	{
+		/**
+		 * The track was created in this frame.
+		 */
+		NEW,
+
+		/**
+		 * The pole was seen again and its signs changed or it moved by
+		 * more than the report threshold since it was last reported.
+		 */
+		UPDATED,
+
+		/**
+		 * The pole was seen again, nothing worth reporting changed.
+		 */
+		UNCHANGED,
+
+		/**
+		 * The pole was not seen in this frame, but the track did not
+		 * expire yet.
+		 */
+		MISSED
+	};
+
+	/**
+	 * A pole (i.e. a DetectedSignCombination) followed over consecutive
+	 * frames by the ClassifiedSignsGrouper.
+	 */
+	struct SignCombinationTrack
+	{
+		/**
+		 * Stable ID of the track, never 0 and never reused while the
+		 * RoadSignAPI is running.
+		 */
+		uint32_t trackID;
+
+		SignCombinationTrackState state;
+
+		/**
+		 * Running average of the estimated pole position X of the
+		 * combinations assigned to this track.
+		 */
+		float estimatedPolePositionX;
+
+		/**
+		 * The combination which was assigned to this track most recently.
+		 */
+		DetectedSignCombination combination;
+
+		/**
+		 * Number of frames in which the pole was seen.
+		 */
+		int hits;
+
+		/**
+		 * Number of consecutive frames in which the pole was not seen.
+		 */
+		int missedFrames;
+
+		/**
+		 * Pole position and classifier class IDs (from top to bottom) when
+		 * the track was last reported as NEW or UPDATED.
+		 */
+		int reportedPolePositionX;
+		std::vector<int> reportedClassIDs;
+	};
+}
+
+
+#endif /* HEADER_FILES_ROADSIGNAPI_SIGNCOMBINATIONTRACK_H_ */
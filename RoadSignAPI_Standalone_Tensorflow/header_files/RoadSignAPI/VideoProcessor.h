@@ -0,0 +1,245 @@
+/*
+ * VideoProcessor.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#ifndef HEADER_FILES_ROADSIGNAPI_VIDEOPROCESSOR_H_
+#define HEADER_FILES_ROADSIGNAPI_VIDEOPROCESSOR_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <opencv2/opencv.hpp>
+
+#include "RoadSignAPI/AnnotatedOutputRenderer.h"
+
+namespace RoadSignAPI
+{
+	/**
+	 * Settings of a VideoProcessor, see VideoProcessor::setOptions(...).
+	 */
+	struct VideoProcessorOptions
+	{
+		/**
+		 * Only every stride-th frame is processed. The frames in between
+		 * are only grabbed, not retrieved, which saves at least their
+		 * color conversion (and their decoding, if the backend of
+		 * cv::VideoCapture supports that).
+		 */
+		int stride = 1;
+
+		/**
+		 * Number of frames to skip at the beginning of the video.
+		 */
+		int startFrame = 0;
+
+		/**
+		 * Maximum number of frames to process, 0 for all.
+		 */
+		int maxFrames = 0;
+
+		/**
+		 * Maximum number of frames the decoding thread decodes ahead of
+		 * the processing.
+		 */
+		int decodeAheadFrames = 4;
+
+		/**
+		 * File to write the annotated frames to, empty for none. The
+		 * frames are rendered (see AnnotatedOutputRenderer) on the
+		 * processing thread and encoded on a separate thread.
+		 */
+		std::string outputFile;
+
+		/**
+		 * Codec of the output file, see cv::VideoWriter::fourcc(...).
+		 */
+		int outputFourcc = cv::VideoWriter::fourcc('m', 'p', '4', 'v');
+
+		/**
+		 * Frame rate of the output file, 0 to use the frame rate of the
+		 * input divided by the stride.
+		 */
+		double outputFrameRate = 0.0;
+
+		/**
+		 * Maximum number of annotated frames waiting to be encoded.
+		 */
+		int encodeQueueFrames = 4;
+
+		AnnotationOptions annotationOptions;
+	};
+
+	/**
+	 * Counters and times of VideoProcessor::run(...), in microseconds.
+	 */
+	struct VideoProcessorStatistics
+	{
+		uint64_t decodedFrames = 0;
+		uint64_t processedFrames = 0;
+		uint64_t encodedFrames = 0;
+
+		/**
+		 * Time the decoding thread spent grabbing and decoding frames.
+		 */
+		int64_t decodeTimeUs = 0;
+
+		/**
+		 * Time the processing thread spent in the RoadSignAPI (including
+		 * rendering and the frame callback).
+		 */
+		int64_t processTimeUs = 0;
+
+		/**
+		 * Time the encoding thread spent encoding frames.
+		 */
+		int64_t encodeTimeUs = 0;
+
+		/**
+		 * Time the processing thread waited for decoded frames: if this
+		 * is large, decoding is the bottleneck.
+		 */
+		int64_t decodeWaitTimeUs = 0;
+
+		/**
+		 * Time the processing thread waited for the encoding thread: if
+		 * this is large, encoding is the bottleneck.
+		 */
+		int64_t encodeWaitTimeUs = 0;
+
+		int64_t totalTimeUs = 0;
+	};
+
+	/**
+	 * @brief Runs the RoadSignAPI on a video file or stream.
+	 *
+	 * Decoding, processing and encoding of the annotated output run on
+	 * three threads, so they overlap instead of adding up: a decoding
+	 * thread decodes up to decodeAheadFrames frames ahead, the calling
+	 * thread feeds them into the static RoadSignAPI instance and an
+	 * (optional) encoding thread writes the annotated frames. The frame
+	 * buffers are handed around between the threads and reused, so no
+	 * frame is allocated after the first ones.
+	 *
+	 * The static interface of the RoadSignAPI needs to be initialized
+	 * (staticInit(...)) before run(...) is called. The results of each
+	 * frame can be read from the frame callback, which is called on the
+	 * processing thread right after the frame was processed.
+	 */
+	class VideoProcessor
+	{
+		public:
+			/**
+			 * Called for every processed frame with its index in the
+			 * video (counting skipped frames) and the decoded frame.
+			 */
+			typedef std::function<void(uint64_t frameIndex,
+					const cv::Mat& frame)> FrameCallback;
+
+		private:
+			/**
+			 * A frame buffer travelling between the threads.
+			 */
+			struct VideoFrame
+			{
+				uint64_t frameIndex = 0;
+				cv::Mat image;
+			};
+
+			/**
+			 * Blocking queue between two of the threads. close() wakes up
+			 * all waiting threads, pop(...) then fails once the queue is
+			 * empty and push(...) fails right away.
+			 */
+			class FrameChannel
+			{
+				private:
+					std::deque<VideoFrame> frames;
+					bool closed = false;
+					std::mutex mutex;
+					std::condition_variable framesAvailable;
+
+				public:
+					bool push(VideoFrame frame);
+
+					bool pop(VideoFrame* frame);
+
+					void close();
+
+					void reset();
+			};
+
+			cv::VideoCapture capture;
+
+			cv::VideoWriter writer;
+
+			VideoProcessorOptions options;
+
+			VideoProcessorStatistics statistics;
+
+			FrameCallback frameCallback;
+
+			/**
+			 * Frame rate the output file is written with, determined by
+			 * run(...) before the threads are started.
+			 */
+			double outputFrameRate;
+
+			/**
+			 * Decoded frames, and the buffers the decoding thread
+			 * decodes into (their number bounds the decode-ahead).
+			 */
+			FrameChannel decodedFrames;
+			FrameChannel freeDecodeBuffers;
+
+			/**
+			 * Annotated frames, and the buffers they are rendered into.
+			 */
+			FrameChannel annotatedFrames;
+			FrameChannel freeEncodeBuffers;
+
+			std::thread decoder;
+			std::thread encoder;
+
+			/**
+			 * Set by the processing thread to stop the decoding thread
+			 * early (stop requested or maximum number of frames reached).
+			 */
+			std::atomic<bool> stopDecoding;
+
+			void decodeFrames();
+
+			void encodeFrames();
+
+			bool openWriter(int width, int height);
+
+			void stopThreads();
+
+		public:
+			bool open(const std::string& input);
+
+			void setOptions(const VideoProcessorOptions& options);
+
+			void setFrameCallback(FrameCallback frameCallback);
+
+			bool run(const std::atomic<bool>* stopRequested = nullptr);
+
+			const VideoProcessorStatistics& getStatistics() const;
+
+			VideoProcessor();
+
+			~VideoProcessor();
+	};
+}
+
+
+#endif /* HEADER_FILES_ROADSIGNAPI_VIDEOPROCESSOR_H_ */
@@ -0,0 +1,458 @@
+/*
+ * FrameTrace.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#include "FilterManagementLibrary/FrameTrace.h"
+#include "FilterManagementLibrary/Logger.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include <algorithm>
+
+static const uint32_t FRAME_TRACE_MAGIC = 0x43525446; // "FTRC"
+static const uint32_t FRAME_TRACE_VERSION = 1;
+
+static_assert(sizeof(FilterManagementLibrary::PipeSystem::PipeFilterTiming) ==
+		2 * sizeof(int64_t), "PipeFilterTiming is written as is");
+static_assert(sizeof(FilterManagementLibrary::FrameTraceRecordHeader) % 8 == 0,
+		"FrameTraceRecordHeader breaks the alignment");
+
+/**
+ * @brief Constructor of FrameTraceWriter, open(...) needs to be called
+ * before anything can be traced.
+ */
+FilterManagementLibrary::FrameTraceWriter::FrameTraceWriter() :
+		file(NULL), recordSize(0), filterCount(0), counterCount(0),
+		flushPending(false), stopping(false), writeFailed(false),
+		recordCount(0), droppedRecordCount(0)
+{
+}
+
+/**
+ * @brief Destructor of FrameTraceWriter, calls close().
+ */
+FilterManagementLibrary::FrameTraceWriter::~FrameTraceWriter()
+{
+	this->close();
+}
+
+/**
+ * @brief Creates a new trace file (an existing file is replaced) and
+ * starts the thread writing it.
+ *
+ * @param const std::string& path path of the file
+ *
+ * @param const std::vector<std::string>& filterNames names of the filters,
+ * in the order of the timings passed to append(...)
+ *
+ * @param const std::vector<std::string>& counterNames names of the
+ * counters, in the order of the counters passed to append(...)
+ *
+ * @param size_t bufferSize size of each of the two buffers in bytes, at
+ * least one record is buffered
+ *
+ * @return bool true on success, false otherwise
+ */
+bool FilterManagementLibrary::FrameTraceWriter::open(const std::string& path,
+		const std::vector<std::string>& filterNames,
+		const std::vector<std::string>& counterNames, size_t bufferSize)
+{
+	this->close();
+
+	this->file = fopen(path.c_str(), "wb");
+	if(this->file == NULL)
+	{
+		Logger::printfln("FrameTraceWriter: could not open %s: %s",
+				path.c_str(), strerror(errno));
+		return false;
+	}
+
+	this->path = path;
+	this->filterCount = filterNames.size();
+	this->counterCount = counterNames.size();
+	this->recordSize = sizeof(FrameTraceRecordHeader) +
+			this->filterCount * sizeof(PipeSystem::PipeFilterTiming) +
+			this->counterCount * sizeof(int64_t);
+
+	std::vector<uint8_t> names;
+	for(const std::vector<std::string>* nameList : {&filterNames, &counterNames})
+	{
+		for(const std::string& name : *nameList)
+		{
+			names.insert(names.end(), name.c_str(),
+					name.c_str() + name.size() + 1);
+		}
+	}
+	names.resize((names.size() + 7) / 8 * 8, 0);
+
+	FrameTraceFileHeader header;
+	header.magic = FRAME_TRACE_MAGIC;
+	header.version = FRAME_TRACE_VERSION;
+	header.filterCount = this->filterCount;
+	header.counterCount = this->counterCount;
+	header.namesSize = names.size();
+
+	if(fwrite(&header, sizeof(header), 1, this->file) != 1 ||
+			!this->write(names))
+	{
+		Logger::printfln("FrameTraceWriter: writing %s failed",
+				path.c_str());
+		fclose(this->file);
+		this->file = NULL;
+		return false;
+	}
+
+	const size_t capacity = std::max(bufferSize, this->recordSize);
+	this->activeBuffer.clear();
+	this->activeBuffer.reserve(capacity);
+	this->flushBuffer.clear();
+	this->flushBuffer.reserve(capacity);
+
+	this->flushPending = false;
+	this->stopping = false;
+	this->writeFailed = false;
+	this->recordCount = 0;
+	this->droppedRecordCount = 0;
+
+	this->flushThread = std::thread(&FrameTraceWriter::runFlushThread, this);
+
+	return true;
+}
+
+/**
+ * @brief Writes a buffer to the file.
+ */
+bool FilterManagementLibrary::FrameTraceWriter::write(
+		const std::vector<uint8_t>& buffer)
+{
+	return buffer.empty() ||
+			fwrite(buffer.data(), 1, buffer.size(), this->file) ==
+					buffer.size();
+}
+
+/**
+ * @brief Body of the background thread, writes flushBuffer whenever
+ * append(...) handed it over.
+ */
+void FilterManagementLibrary::FrameTraceWriter::runFlushThread()
+{
+	std::unique_lock<std::mutex> lock(this->mutex);
+
+	while(true)
+	{
+		this->flushCondition.wait(lock, [this]
+				{
+					return this->flushPending || this->stopping;
+				});
+
+		if(!this->flushPending)
+			return;
+
+		// append(...) does not touch flushBuffer while flushPending is set
+		lock.unlock();
+		const bool written = this->write(this->flushBuffer);
+		lock.lock();
+
+		if(!written && !this->writeFailed)
+		{
+			Logger::printfln("FrameTraceWriter: writing %s failed: %s",
+					this->path.c_str(), strerror(errno));
+			this->writeFailed = true;
+		}
+
+		this->flushBuffer.clear();
+		this->flushPending = false;
+	}
+}
+
+/**
+ * @brief Appends the record of a frame to the trace.
+ *
+ * Does not allocate memory or access the file.
+ *
+ * @param const FrameTraceRecordHeader& frame times and flags of the frame
+ *
+ * @param const PipeFilterTiming* filterTimings times of as many filters
+ * as names were passed to open(...)
+ *
+ * @param const int64_t* counters values of as many counters as names
+ * were passed to open(...)
+ *
+ * @return bool true if the record was buffered, false if the writer is
+ * not open or the record was dropped, because the background thread is
+ * still writing the previous buffer
+ */
+bool FilterManagementLibrary::FrameTraceWriter::append(
+		const FrameTraceRecordHeader& frame,
+		const PipeSystem::PipeFilterTiming* filterTimings,
+		const int64_t* counters)
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+
+	if(this->file == NULL)
+		return false;
+
+	if(this->activeBuffer.size() + this->recordSize >
+			this->activeBuffer.capacity())
+	{
+		if(this->flushPending)
+		{
+			this->droppedRecordCount++;
+			return false;
+		}
+
+		this->activeBuffer.swap(this->flushBuffer);
+		this->flushPending = true;
+		this->flushCondition.notify_one();
+	}
+
+	const uint8_t* frameBytes = reinterpret_cast<const uint8_t*>(&frame);
+	this->activeBuffer.insert(this->activeBuffer.end(), frameBytes,
+			frameBytes + sizeof(frame));
+
+	const uint8_t* timingBytes =
+			reinterpret_cast<const uint8_t*>(filterTimings);
+	this->activeBuffer.insert(this->activeBuffer.end(), timingBytes,
+			timingBytes + this->filterCount *
+					sizeof(PipeSystem::PipeFilterTiming));
+
+	const uint8_t* counterBytes = reinterpret_cast<const uint8_t*>(counters);
+	this->activeBuffer.insert(this->activeBuffer.end(), counterBytes,
+			counterBytes + this->counterCount * sizeof(int64_t));
+
+	this->recordCount++;
+	return true;
+}
+
+/**
+ * @brief Writes all buffered records, stops the background thread and
+ * closes the file.
+ *
+ * @return bool true if all records were written, false if writing failed
+ * (or the writer was not open)
+ */
+bool FilterManagementLibrary::FrameTraceWriter::close()
+{
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+
+		if(this->file == NULL)
+			return false;
+
+		this->stopping = true;
+		this->flushCondition.notify_one();
+	}
+
+	// Writes a pending flushBuffer before it returns
+	this->flushThread.join();
+
+	bool success = !this->writeFailed && this->write(this->activeBuffer);
+
+	if(fclose(this->file) != 0)
+		success = false;
+
+	std::lock_guard<std::mutex> lock(this->mutex);
+
+	this->file = NULL;
+	this->activeBuffer.clear();
+
+	if(this->droppedRecordCount > 0)
+	{
+		Logger::printfln("FrameTraceWriter: dropped %llu records of %s",
+				(unsigned long long) this->droppedRecordCount,
+				this->path.c_str());
+	}
+
+	return success;
+}
+
+/**
+ * @brief Returns true if a trace file is open.
+ */
+bool FilterManagementLibrary::FrameTraceWriter::isOpen() const
+{
+	return this->file != NULL;
+}
+
+/**
+ * @brief Returns the number of records appended since open(...).
+ */
+uint64_t FilterManagementLibrary::FrameTraceWriter::getRecordCount()
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	return this->recordCount;
+}
+
+/**
+ * @brief Returns the number of records dropped since open(...), see
+ * append(...).
+ */
+uint64_t FilterManagementLibrary::FrameTraceWriter::getDroppedRecordCount()
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	return this->droppedRecordCount;
+}
+
+/**
+ * @brief Constructor of FrameTraceReader, use open(...) to read a trace.
+ */
+FilterManagementLibrary::FrameTraceReader::FrameTraceReader() : file(NULL)
+{
+}
+
+/**
+ * @brief Destructor of FrameTraceReader, calls close().
+ */
+FilterManagementLibrary::FrameTraceReader::~FrameTraceReader()
+{
+	this->close();
+}
+
+/**
+ * @brief Opens a trace file written by FrameTraceWriter and reads the
+ * names of its filters and counters.
+ *
+ * @param const std::string& path path of the file
+ *
+ * @return bool true on success, false if the file can not be opened or
+ * is no trace
+ */
+bool FilterManagementLibrary::FrameTraceReader::open(const std::string& path)
+{
+	this->close();
+
+	this->file = fopen(path.c_str(), "rb");
+	if(this->file == NULL)
+	{
+		Logger::printfln("FrameTraceReader: could not open %s: %s",
+				path.c_str(), strerror(errno));
+		return false;
+	}
+
+	FrameTraceFileHeader header;
+	std::vector<char> names;
+
+	bool valid = fread(&header, sizeof(header), 1, this->file) == 1 &&
+			header.magic == FRAME_TRACE_MAGIC &&
+			header.version == FRAME_TRACE_VERSION &&
+			header.namesSize < (1 << 24);
+
+	if(valid)
+	{
+		names.resize(header.namesSize + 1, '\0');
+		valid = fread(names.data(), 1, header.namesSize, this->file) ==
+				header.namesSize;
+	}
+
+	const uint32_t nameCount = header.filterCount + header.counterCount;
+
+	for(size_t offset = 0; valid && this->filterNames.size() +
+			this->counterNames.size() < nameCount; )
+	{
+		if(offset >= header.namesSize)
+		{
+			valid = false;
+			break;
+		}
+
+		const std::string name(names.data() + offset);
+		offset += name.size() + 1;
+
+		if(this->filterNames.size() < header.filterCount)
+			this->filterNames.push_back(name);
+		else
+			this->counterNames.push_back(name);
+	}
+
+	if(!valid)
+	{
+		Logger::printfln("FrameTraceReader: %s is no trace", path.c_str());
+		this->close();
+		return false;
+	}
+
+	this->record.resize(sizeof(FrameTraceRecordHeader) +
+			header.filterCount * sizeof(PipeSystem::PipeFilterTiming) +
+			header.counterCount * sizeof(int64_t));
+
+	return true;
+}
+
+/**
+ * @brief Closes the trace file.
+ */
+void FilterManagementLibrary::FrameTraceReader::close()
+{
+	if(this->file != NULL)
+		fclose(this->file);
+
+	this->file = NULL;
+	this->filterNames.clear();
+	this->counterNames.clear();
+	this->record.clear();
+}
+
+/**
+ * @brief Returns the names of the filters, in the order of the timings
+ * readNext(...) returns.
+ */
+const std::vector<std::string>&
+		FilterManagementLibrary::FrameTraceReader::getFilterNames() const
+{
+	return this->filterNames;
+}
+
+/**
+ * @brief Returns the names of the counters, in the order of the counters
+ * readNext(...) returns.
+ */
+const std::vector<std::string>&
+		FilterManagementLibrary::FrameTraceReader::getCounterNames() const
+{
+	return this->counterNames;
+}
+
+/**
+ * @brief Reads the next record of the trace.
+ *
+ * @param FrameTraceRecordHeader* frame receives times and flags of the
+ * frame
+ *
+ * @param std::vector<PipeFilterTiming>* filterTimings receives the times
+ * of the filters
+ *
+ * @param std::vector<int64_t>* counters receives the counters
+ *
+ * @return bool true on success, false at the end of the trace (an
+ * incomplete last record is ignored)
+ */
+bool FilterManagementLibrary::FrameTraceReader::readNext(
+		FrameTraceRecordHeader* frame,
+		std::vector<PipeSystem::PipeFilterTiming>* filterTimings,
+		std::vector<int64_t>* counters)
+{
+	if(this->file == NULL || fread(this->record.data(), 1,
+			this->record.size(), this->file) != this->record.size())
+	{
+		return false;
+	}
+
+	const uint8_t* data = this->record.data();
+
+	memcpy(frame, data, sizeof(FrameTraceRecordHeader));
+	data += sizeof(FrameTraceRecordHeader);
+
+	filterTimings->resize(this->filterNames.size());
+	memcpy(filterTimings->data(), data, filterTimings->size() *
+			sizeof(PipeSystem::PipeFilterTiming));
+	data += filterTimings->size() * sizeof(PipeSystem::PipeFilterTiming);
+
+	counters->resize(this->counterNames.size());
+	memcpy(counters->data(), data, counters->size() * sizeof(int64_t));
+
+	return true;
+}
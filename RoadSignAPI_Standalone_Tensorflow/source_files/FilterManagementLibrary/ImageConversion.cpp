@@ -0,0 +1,818 @@
+/*
+ * ImageConversion.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ *
+ *      The scalar arithmetic is taken from yuv2rgb.cc and rgb2yuv.cc of the
+ *      Tensorflow Android example (Apache License 2.0).
+ */
+
+#include "FilterManagementLibrary/ImageConversion.h"
+
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+	#define FML_IMAGE_CONVERSION_X86
+	#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+	#define FML_IMAGE_CONVERSION_NEON
+	#include <arm_neon.h>
+#endif
+
+typedef FilterManagementLibrary::ImageConversion::PixelFormat PixelFormat;
+typedef FilterManagementLibrary::ImageConversion::Kernel Kernel;
+
+// This value is 2 ^ 18 - 1, and is used to clamp the RGB values before their
+// ranges are normalized to eight bits.
+static const int kMaxChannelValue = 262143;
+
+/**
+ * @brief Scalar BT.601 conversion of a row of Y, U and V samples.
+ *
+ * Same arithmetic as YUV2RGB(...) of yuv2rgb.cc. All other kernels
+ * need to produce exactly the same output as this one.
+ *
+ * @param const uint8_t* yRow luma samples, one per pixel
+ * @param const uint8_t* uRow U samples, one per pixel
+ * @param const uint8_t* vRow V samples, one per pixel
+ * @param uint8_t* dstRow packed output pixels
+ * @param int width number of pixels to convert
+ * @param PixelFormat format memory layout of the output pixels
+ */
+void FilterManagementLibrary::ImageConversion::convertYUVRowScalar(
+		const uint8_t* yRow, const uint8_t* uRow, const uint8_t* vRow,
+		uint8_t* dstRow, int width, PixelFormat format)
+{
+	for(int x = 0; x < width; x++)
+	{
+		int nY = yRow[x] - 16;
+		int nU = uRow[x] - 128;
+		int nV = vRow[x] - 128;
+		if(nY < 0) nY = 0;
+
+		// This is the floating point equivalent. We do the conversion in
+		// integer because some Android devices do not have floating point
+		// in hardware.
+		// nR = (int)(1.164 * nY + 1.596 * nV);
+		// nG = (int)(1.164 * nY - 0.813 * nV - 0.391 * nU);
+		// nB = (int)(1.164 * nY + 2.018 * nU);
+		int nR = 1192 * nY + 1634 * nV;
+		int nG = 1192 * nY - 833 * nV - 400 * nU;
+		int nB = 1192 * nY + 2066 * nU;
+
+		nR = std::min(kMaxChannelValue, std::max(0, nR)) >> 10;
+		nG = std::min(kMaxChannelValue, std::max(0, nG)) >> 10;
+		nB = std::min(kMaxChannelValue, std::max(0, nB)) >> 10;
+
+		switch(format)
+		{
+			case PixelFormat::BGR:
+			{
+				dstRow[3 * x] = static_cast<uint8_t>(nB);
+				dstRow[3 * x + 1] = static_cast<uint8_t>(nG);
+				dstRow[3 * x + 2] = static_cast<uint8_t>(nR);
+			}
+			break;
+			case PixelFormat::BGRA:
+			{
+				dstRow[4 * x] = static_cast<uint8_t>(nB);
+				dstRow[4 * x + 1] = static_cast<uint8_t>(nG);
+				dstRow[4 * x + 2] = static_cast<uint8_t>(nR);
+				dstRow[4 * x + 3] = 0xff;
+			}
+			break;
+			case PixelFormat::RGBA:
+			{
+				dstRow[4 * x] = static_cast<uint8_t>(nR);
+				dstRow[4 * x + 1] = static_cast<uint8_t>(nG);
+				dstRow[4 * x + 2] = static_cast<uint8_t>(nB);
+				dstRow[4 * x + 3] = 0xff;
+			}
+			break;
+		}
+	}
+}
+
+static int bytesPerPixel(PixelFormat format)
+{
+	return format == PixelFormat::BGR ? 3 : 4;
+}
+
+/**
+ * @brief Scalar repack of a row of BGR pixels into the given format.
+ *
+ * @param const uint8_t* bgrRow 3 byte BGR pixels (OpenCV 8UC3)
+ * @param uint8_t* dstRow packed output pixels
+ * @param int width number of pixels to convert
+ * @param PixelFormat format memory layout of the output pixels
+ */
+void FilterManagementLibrary::ImageConversion::convertBGRRowScalar(
+		const uint8_t* bgrRow, uint8_t* dstRow, int width, PixelFormat format)
+{
+	switch(format)
+	{
+		case PixelFormat::BGR:
+		{
+			memcpy(dstRow, bgrRow, 3 * width);
+		}
+		break;
+		case PixelFormat::BGRA:
+		{
+			for(int x = 0; x < width; x++)
+			{
+				dstRow[4 * x] = bgrRow[3 * x];
+				dstRow[4 * x + 1] = bgrRow[3 * x + 1];
+				dstRow[4 * x + 2] = bgrRow[3 * x + 2];
+				dstRow[4 * x + 3] = 0xff;
+			}
+		}
+		break;
+		case PixelFormat::RGBA:
+		{
+			for(int x = 0; x < width; x++)
+			{
+				dstRow[4 * x] = bgrRow[3 * x + 2];
+				dstRow[4 * x + 1] = bgrRow[3 * x + 1];
+				dstRow[4 * x + 2] = bgrRow[3 * x];
+				dstRow[4 * x + 3] = 0xff;
+			}
+		}
+		break;
+	}
+}
+
+#ifdef FML_IMAGE_CONVERSION_X86
+
+/**
+ * SSE4.1 kernel, converts 4 pixels per iteration in 32 bit lanes.
+ * The remaining pixels are converted by the scalar kernel.
+ */
+__attribute__((target("sse4.1")))
+static void convertYUVRowSSE41(const uint8_t* yRow, const uint8_t* uRow,
+		const uint8_t* vRow, uint8_t* dstRow, int width, PixelFormat format)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i offsetY = _mm_set1_epi32(16);
+	const __m128i offsetUV = _mm_set1_epi32(128);
+	const __m128i maxValue = _mm_set1_epi32(kMaxChannelValue);
+	const __m128i coeffY = _mm_set1_epi32(1192);
+	const __m128i coeffRV = _mm_set1_epi32(1634);
+	const __m128i coeffGV = _mm_set1_epi32(833);
+	const __m128i coeffGU = _mm_set1_epi32(400);
+	const __m128i coeffBU = _mm_set1_epi32(2066);
+	const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xff000000));
+	// Drops every 4th byte (alpha) of 4 packed BGRA pixels
+	const __m128i bgraToBGR = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10,
+			12, 13, 14, -1, -1, -1, -1);
+
+	int x = 0;
+	for(; x + 4 <= width; x += 4)
+	{
+		int32_t packedY, packedU, packedV;
+		memcpy(&packedY, yRow + x, 4);
+		memcpy(&packedU, uRow + x, 4);
+		memcpy(&packedV, vRow + x, 4);
+
+		__m128i nY = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(packedY));
+		__m128i nU = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(packedU));
+		__m128i nV = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(packedV));
+
+		nY = _mm_max_epi32(_mm_sub_epi32(nY, offsetY), zero);
+		nU = _mm_sub_epi32(nU, offsetUV);
+		nV = _mm_sub_epi32(nV, offsetUV);
+
+		const __m128i scaledY = _mm_mullo_epi32(nY, coeffY);
+
+		__m128i nR = _mm_add_epi32(scaledY, _mm_mullo_epi32(nV, coeffRV));
+		__m128i nG = _mm_sub_epi32(_mm_sub_epi32(scaledY,
+				_mm_mullo_epi32(nV, coeffGV)), _mm_mullo_epi32(nU, coeffGU));
+		__m128i nB = _mm_add_epi32(scaledY, _mm_mullo_epi32(nU, coeffBU));
+
+		nR = _mm_srai_epi32(_mm_min_epi32(_mm_max_epi32(nR, zero), maxValue), 10);
+		nG = _mm_srai_epi32(_mm_min_epi32(_mm_max_epi32(nG, zero), maxValue), 10);
+		nB = _mm_srai_epi32(_mm_min_epi32(_mm_max_epi32(nB, zero), maxValue), 10);
+
+		const __m128i first = format == PixelFormat::RGBA ? nR : nB;
+		const __m128i third = format == PixelFormat::RGBA ? nB : nR;
+
+		__m128i packed = _mm_or_si128(_mm_or_si128(first,
+				_mm_slli_epi32(nG, 8)),
+				_mm_or_si128(_mm_slli_epi32(third, 16), alpha));
+
+		if(format == PixelFormat::BGR)
+		{
+			packed = _mm_shuffle_epi8(packed, bgraToBGR);
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(dstRow + 3 * x),
+					packed);
+			int32_t lastBytes = _mm_cvtsi128_si32(_mm_srli_si128(packed, 8));
+			memcpy(dstRow + 3 * x + 8, &lastBytes, 4);
+		}
+		else
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dstRow + 4 * x),
+					packed);
+		}
+	}
+
+	FilterManagementLibrary::ImageConversion::convertYUVRowScalar(
+			yRow + x, uRow + x, vRow + x,
+			dstRow + x * bytesPerPixel(format), width - x, format);
+}
+
+/**
+ * SSE4.1 repack of BGR pixels, expands 4 pixels per iteration with a
+ * single byte shuffle. Also used by the AVX2 kernel set, as the shuffle
+ * does not cross 128 bit lanes anyway.
+ */
+__attribute__((target("sse4.1")))
+static void convertBGRRowSSE41(const uint8_t* bgrRow, uint8_t* dstRow,
+		int width, PixelFormat format)
+{
+	if(format == PixelFormat::BGR)
+	{
+		memcpy(dstRow, bgrRow, 3 * width);
+		return;
+	}
+
+	const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xff000000));
+	const __m128i expand = format == PixelFormat::RGBA ?
+			_mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1,
+					11, 10, 9, -1) :
+			_mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1,
+					9, 10, 11, -1);
+
+	int x = 0;
+	// Each load reads 16 bytes of which only 12 are used, so stop early
+	// enough to not read past the end of the row.
+	for(; 3 * x + 16 <= 3 * width; x += 4)
+	{
+		__m128i pixels = _mm_loadu_si128(
+				reinterpret_cast<const __m128i*>(bgrRow + 3 * x));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dstRow + 4 * x),
+				_mm_or_si128(_mm_shuffle_epi8(pixels, expand), alpha));
+	}
+
+	FilterManagementLibrary::ImageConversion::convertBGRRowScalar(
+			bgrRow + 3 * x, dstRow + 4 * x, width - x, format);
+}
+
+/**
+ * AVX2 kernel, converts 8 pixels per iteration in 32 bit lanes.
+ * The remaining pixels are converted by the scalar kernel.
+ */
+__attribute__((target("avx2")))
+static void convertYUVRowAVX2(const uint8_t* yRow, const uint8_t* uRow,
+		const uint8_t* vRow, uint8_t* dstRow, int width, PixelFormat format)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i offsetY = _mm256_set1_epi32(16);
+	const __m256i offsetUV = _mm256_set1_epi32(128);
+	const __m256i maxValue = _mm256_set1_epi32(kMaxChannelValue);
+	const __m256i coeffY = _mm256_set1_epi32(1192);
+	const __m256i coeffRV = _mm256_set1_epi32(1634);
+	const __m256i coeffGV = _mm256_set1_epi32(833);
+	const __m256i coeffGU = _mm256_set1_epi32(400);
+	const __m256i coeffBU = _mm256_set1_epi32(2066);
+	const __m256i alpha = _mm256_set1_epi32(static_cast<int>(0xff000000));
+	const __m128i bgraToBGR = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10,
+			12, 13, 14, -1, -1, -1, -1);
+
+	int x = 0;
+	for(; x + 8 <= width; x += 8)
+	{
+		__m256i nY = _mm256_cvtepu8_epi32(_mm_loadl_epi64(
+				reinterpret_cast<const __m128i*>(yRow + x)));
+		__m256i nU = _mm256_cvtepu8_epi32(_mm_loadl_epi64(
+				reinterpret_cast<const __m128i*>(uRow + x)));
+		__m256i nV = _mm256_cvtepu8_epi32(_mm_loadl_epi64(
+				reinterpret_cast<const __m128i*>(vRow + x)));
+
+		nY = _mm256_max_epi32(_mm256_sub_epi32(nY, offsetY), zero);
+		nU = _mm256_sub_epi32(nU, offsetUV);
+		nV = _mm256_sub_epi32(nV, offsetUV);
+
+		const __m256i scaledY = _mm256_mullo_epi32(nY, coeffY);
+
+		__m256i nR = _mm256_add_epi32(scaledY,
+				_mm256_mullo_epi32(nV, coeffRV));
+		__m256i nG = _mm256_sub_epi32(_mm256_sub_epi32(scaledY,
+				_mm256_mullo_epi32(nV, coeffGV)),
+				_mm256_mullo_epi32(nU, coeffGU));
+		__m256i nB = _mm256_add_epi32(scaledY,
+				_mm256_mullo_epi32(nU, coeffBU));
+
+		nR = _mm256_srai_epi32(_mm256_min_epi32(
+				_mm256_max_epi32(nR, zero), maxValue), 10);
+		nG = _mm256_srai_epi32(_mm256_min_epi32(
+				_mm256_max_epi32(nG, zero), maxValue), 10);
+		nB = _mm256_srai_epi32(_mm256_min_epi32(
+				_mm256_max_epi32(nB, zero), maxValue), 10);
+
+		const __m256i first = format == PixelFormat::RGBA ? nR : nB;
+		const __m256i third = format == PixelFormat::RGBA ? nB : nR;
+
+		__m256i packed = _mm256_or_si256(_mm256_or_si256(first,
+				_mm256_slli_epi32(nG, 8)),
+				_mm256_or_si256(_mm256_slli_epi32(third, 16), alpha));
+
+		if(format == PixelFormat::BGR)
+		{
+			__m128i low = _mm_shuffle_epi8(
+					_mm256_castsi256_si128(packed), bgraToBGR);
+			__m128i high = _mm_shuffle_epi8(
+					_mm256_extracti128_si256(packed, 1), bgraToBGR);
+
+			// 12 valid bytes of the low half, then 12 of the high half
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dstRow + 3 * x),
+					_mm_or_si128(low, _mm_slli_si128(high, 12)));
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(dstRow + 3 * x + 16),
+					_mm_srli_si128(high, 4));
+		}
+		else
+		{
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dstRow + 4 * x),
+					packed);
+		}
+	}
+
+	FilterManagementLibrary::ImageConversion::convertYUVRowScalar(
+			yRow + x, uRow + x, vRow + x,
+			dstRow + x * bytesPerPixel(format), width - x, format);
+}
+
+#endif
+
+#ifdef FML_IMAGE_CONVERSION_NEON
+
+/**
+ * Converts 4 lanes of Y, U and V values (already offset) to R, G and B.
+ */
+static inline void convertYUVLanesNEON(int32x4_t nY, int32x4_t nU,
+		int32x4_t nV, uint16x4_t* r, uint16x4_t* g, uint16x4_t* b)
+{
+	const int32x4_t zero = vdupq_n_s32(0);
+	const int32x4_t maxValue = vdupq_n_s32(kMaxChannelValue);
+
+	const int32x4_t scaledY = vmulq_n_s32(nY, 1192);
+
+	int32x4_t nR = vmlaq_n_s32(scaledY, nV, 1634);
+	int32x4_t nG = vmlsq_n_s32(vmlsq_n_s32(scaledY, nV, 833), nU, 400);
+	int32x4_t nB = vmlaq_n_s32(scaledY, nU, 2066);
+
+	nR = vshrq_n_s32(vminq_s32(vmaxq_s32(nR, zero), maxValue), 10);
+	nG = vshrq_n_s32(vminq_s32(vmaxq_s32(nG, zero), maxValue), 10);
+	nB = vshrq_n_s32(vminq_s32(vmaxq_s32(nB, zero), maxValue), 10);
+
+	*r = vmovn_u32(vreinterpretq_u32_s32(nR));
+	*g = vmovn_u32(vreinterpretq_u32_s32(nG));
+	*b = vmovn_u32(vreinterpretq_u32_s32(nB));
+}
+
+/**
+ * NEON kernel, converts 8 pixels per iteration and uses interleaving
+ * stores for the packed output. The remaining pixels are converted by
+ * the scalar kernel.
+ */
+static void convertYUVRowNEON(const uint8_t* yRow, const uint8_t* uRow,
+		const uint8_t* vRow, uint8_t* dstRow, int width, PixelFormat format)
+{
+	const int16x8_t offsetY = vdupq_n_s16(16);
+	const int16x8_t offsetUV = vdupq_n_s16(128);
+	const int16x8_t zero = vdupq_n_s16(0);
+
+	int x = 0;
+	for(; x + 8 <= width; x += 8)
+	{
+		int16x8_t nY = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(yRow + x)));
+		int16x8_t nU = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(uRow + x)));
+		int16x8_t nV = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(vRow + x)));
+
+		nY = vmaxq_s16(vsubq_s16(nY, offsetY), zero);
+		nU = vsubq_s16(nU, offsetUV);
+		nV = vsubq_s16(nV, offsetUV);
+
+		uint16x4_t rLow, gLow, bLow, rHigh, gHigh, bHigh;
+		convertYUVLanesNEON(vmovl_s16(vget_low_s16(nY)),
+				vmovl_s16(vget_low_s16(nU)), vmovl_s16(vget_low_s16(nV)),
+				&rLow, &gLow, &bLow);
+		convertYUVLanesNEON(vmovl_s16(vget_high_s16(nY)),
+				vmovl_s16(vget_high_s16(nU)), vmovl_s16(vget_high_s16(nV)),
+				&rHigh, &gHigh, &bHigh);
+
+		const uint8x8_t r = vmovn_u16(vcombine_u16(rLow, rHigh));
+		const uint8x8_t g = vmovn_u16(vcombine_u16(gLow, gHigh));
+		const uint8x8_t b = vmovn_u16(vcombine_u16(bLow, bHigh));
+
+		switch(format)
+		{
+			case PixelFormat::BGR:
+			{
+				uint8x8x3_t pixels;
+				pixels.val[0] = b;
+				pixels.val[1] = g;
+				pixels.val[2] = r;
+				vst3_u8(dstRow + 3 * x, pixels);
+			}
+			break;
+			case PixelFormat::BGRA:
+			{
+				uint8x8x4_t pixels;
+				pixels.val[0] = b;
+				pixels.val[1] = g;
+				pixels.val[2] = r;
+				pixels.val[3] = vdup_n_u8(0xff);
+				vst4_u8(dstRow + 4 * x, pixels);
+			}
+			break;
+			case PixelFormat::RGBA:
+			{
+				uint8x8x4_t pixels;
+				pixels.val[0] = r;
+				pixels.val[1] = g;
+				pixels.val[2] = b;
+				pixels.val[3] = vdup_n_u8(0xff);
+				vst4_u8(dstRow + 4 * x, pixels);
+			}
+			break;
+		}
+	}
+
+	FilterManagementLibrary::ImageConversion::convertYUVRowScalar(
+			yRow + x, uRow + x, vRow + x,
+			dstRow + x * bytesPerPixel(format), width - x, format);
+}
+
+/**
+ * NEON repack of BGR pixels, 8 pixels per iteration using
+ * deinterleaving loads and interleaving stores.
+ */
+static void convertBGRRowNEON(const uint8_t* bgrRow, uint8_t* dstRow,
+		int width, PixelFormat format)
+{
+	if(format == PixelFormat::BGR)
+	{
+		memcpy(dstRow, bgrRow, 3 * width);
+		return;
+	}
+
+	const bool swapRedBlue = format == PixelFormat::RGBA;
+
+	int x = 0;
+	for(; x + 8 <= width; x += 8)
+	{
+		uint8x8x3_t bgr = vld3_u8(bgrRow + 3 * x);
+		uint8x8x4_t pixels;
+		pixels.val[0] = swapRedBlue ? bgr.val[2] : bgr.val[0];
+		pixels.val[1] = bgr.val[1];
+		pixels.val[2] = swapRedBlue ? bgr.val[0] : bgr.val[2];
+		pixels.val[3] = vdup_n_u8(0xff);
+		vst4_u8(dstRow + 4 * x, pixels);
+	}
+
+	FilterManagementLibrary::ImageConversion::convertBGRRowScalar(
+			bgrRow + 3 * x, dstRow + 4 * x, width - x, format);
+}
+
+#endif
+
+typedef void (*YUVRowKernel)(const uint8_t*, const uint8_t*, const uint8_t*,
+		uint8_t*, int, PixelFormat);
+
+typedef void (*BGRRowKernel)(const uint8_t*, uint8_t*, int, PixelFormat);
+
+/**
+ * Implementations of all row functions belonging to one Kernel.
+ */
+struct RowKernelSet
+{
+	YUVRowKernel yuvRow;
+	BGRRowKernel bgrRow;
+};
+
+/**
+ * Resolves Kernel::AUTO to the fastest kernel the executing CPU supports.
+ */
+static Kernel detectBestKernel()
+{
+	#if defined(FML_IMAGE_CONVERSION_NEON)
+		return Kernel::NEON;
+	#elif defined(FML_IMAGE_CONVERSION_X86)
+		if(__builtin_cpu_supports("avx2"))
+			return Kernel::AVX2;
+		if(__builtin_cpu_supports("sse4.1"))
+			return Kernel::SSE41;
+		return Kernel::SCALAR;
+	#else
+		return Kernel::SCALAR;
+	#endif
+}
+
+/**
+ * Fills the implementations of the given kernel.
+ *
+ * @return bool false if the kernel is not supported by this build
+ * or the executing CPU
+ */
+static bool lookupKernelSet(Kernel kernel, RowKernelSet* kernelSet)
+{
+	switch(kernel)
+	{
+		case Kernel::SCALAR:
+		{
+			kernelSet->yuvRow = &FilterManagementLibrary::ImageConversion::
+					convertYUVRowScalar;
+			kernelSet->bgrRow = &FilterManagementLibrary::ImageConversion::
+					convertBGRRowScalar;
+		}
+		return true;
+		#ifdef FML_IMAGE_CONVERSION_X86
+		case Kernel::SSE41:
+		{
+			if(!__builtin_cpu_supports("sse4.1"))
+				return false;
+			kernelSet->yuvRow = &convertYUVRowSSE41;
+			kernelSet->bgrRow = &convertBGRRowSSE41;
+		}
+		return true;
+		case Kernel::AVX2:
+		{
+			if(!__builtin_cpu_supports("avx2"))
+				return false;
+			kernelSet->yuvRow = &convertYUVRowAVX2;
+			kernelSet->bgrRow = &convertBGRRowSSE41;
+		}
+		return true;
+		#endif
+		#ifdef FML_IMAGE_CONVERSION_NEON
+		case Kernel::NEON:
+		{
+			kernelSet->yuvRow = &convertYUVRowNEON;
+			kernelSet->bgrRow = &convertBGRRowNEON;
+		}
+		return true;
+		#endif
+		default:
+		return false;
+	}
+}
+
+/**
+ * Currently used kernel. Initialized with the best kernel the executing
+ * CPU supports on first use (thread safe since C++11).
+ */
+struct ActiveRowKernel
+{
+	Kernel kernel;
+	RowKernelSet functions;
+
+	ActiveRowKernel() : kernel(detectBestKernel())
+	{
+		lookupKernelSet(kernel, &functions);
+	}
+};
+
+static ActiveRowKernel& activeRowKernel()
+{
+	static ActiveRowKernel activeKernel;
+	return activeKernel;
+}
+
+/**
+ * @brief Selects the row kernel used by convertYUVRow(...) and
+ * convertBGRRow(...).
+ *
+ * Kernel::AUTO selects the fastest kernel the executing CPU supports
+ * (which happens automatically on first use). Forcing a specific kernel
+ * is mainly meant for comparing their outputs and timings.
+ *
+ * @param Kernel kernel the kernel to use
+ *
+ * @return bool true if the kernel is supported on this CPU and was
+ * selected, false otherwise (the active kernel is not changed then)
+ */
+bool FilterManagementLibrary::ImageConversion::selectKernel(Kernel kernel)
+{
+	if(kernel == Kernel::AUTO)
+		kernel = detectBestKernel();
+
+	RowKernelSet functions;
+	if(!lookupKernelSet(kernel, &functions))
+		return false;
+
+	ActiveRowKernel& activeKernel = activeRowKernel();
+	activeKernel.kernel = kernel;
+	activeKernel.functions = functions;
+	return true;
+}
+
+/**
+ * @brief Returns the row kernel which is currently used by convertYUVRow(...).
+ *
+ * @return Kernel the active kernel (never Kernel::AUTO)
+ */
+FilterManagementLibrary::ImageConversion::Kernel
+	FilterManagementLibrary::ImageConversion::getActiveKernel()
+{
+	return activeRowKernel().kernel;
+}
+
+/**
+ * @brief Returns a printable name of the given kernel.
+ *
+ * @return const char* name of the kernel, i.e. for logging
+ */
+const char* FilterManagementLibrary::ImageConversion::getKernelName(
+		Kernel kernel)
+{
+	switch(kernel)
+	{
+		case Kernel::AUTO: return "auto";
+		case Kernel::SCALAR: return "scalar";
+		case Kernel::SSE41: return "sse4.1";
+		case Kernel::AVX2: return "avx2";
+		case Kernel::NEON: return "neon";
+	}
+	return "unknown";
+}
+
+/**
+ * @brief Converts a row of Y, U and V samples to packed RGB pixels.
+ *
+ * Expects one U and one V sample per pixel (callers working on subsampled
+ * chroma planes gather / duplicate them first). Uses the fastest row
+ * kernel available, see selectKernel(...).
+ *
+ * @param const uint8_t* yRow luma samples, one per pixel
+ * @param const uint8_t* uRow U samples, one per pixel
+ * @param const uint8_t* vRow V samples, one per pixel
+ * @param uint8_t* dstRow packed output pixels (3 or 4 bytes per pixel,
+ * depending on format)
+ * @param int width number of pixels to convert
+ * @param PixelFormat format memory layout of the output pixels
+ */
+void FilterManagementLibrary::ImageConversion::convertYUVRow(
+		const uint8_t* yRow, const uint8_t* uRow, const uint8_t* vRow,
+		uint8_t* dstRow, int width, PixelFormat format)
+{
+	activeRowKernel().functions.yuvRow(yRow, uRow, vRow, dstRow, width, format);
+}
+
+/**
+ * @brief Repacks a row of BGR pixels (OpenCV 8UC3) into the given format.
+ *
+ * Uses the fastest row kernel available, see selectKernel(...).
+ *
+ * @param const uint8_t* bgrRow 3 byte BGR pixels
+ * @param uint8_t* dstRow packed output pixels (3 or 4 bytes per pixel,
+ * depending on format)
+ * @param int width number of pixels to convert
+ * @param PixelFormat format memory layout of the output pixels
+ */
+void FilterManagementLibrary::ImageConversion::convertBGRRow(
+		const uint8_t* bgrRow, uint8_t* dstRow, int width, PixelFormat format)
+{
+	activeRowKernel().functions.bgrRow(bgrRow, dstRow, width, format);
+}
+
+/**
+ * @brief Converts a YUV 4:2:0 image with arbitrary strides to ARGB8888.
+ *
+ * Port of ConvertYUV420ToARGB8888(...) of yuv2rgb.cc, accepting a Y plane
+ * and separate U and V planes with arbitrary row and pixel strides
+ * (which also covers interleaved chroma planes).
+ * Output pixels are 0xAARRGGBB integers (PixelFormat::BGRA).
+ */
+void FilterManagementLibrary::ImageConversion::convertYUV420ToARGB8888(
+		const uint8_t* const yData, const uint8_t* const uData,
+		const uint8_t* const vData, uint32_t* const output,
+		const int width, const int height,
+		const int yRowStride, const int uvRowStride,
+		const int uvPixelStride)
+{
+	std::vector<uint8_t> chromaRows(2 * width);
+	uint8_t* uSamples = &chromaRows[0];
+	uint8_t* vSamples = uSamples + width;
+
+	for(int y = 0; y < height; y++)
+	{
+		const uint8_t* pY = yData + yRowStride * y;
+
+		const int uvRowStart = uvRowStride * (y >> 1);
+		const uint8_t* pU = uData + uvRowStart;
+		const uint8_t* pV = vData + uvRowStart;
+
+		// Chroma of a row only changes every second row
+		if(!(y & 1))
+		{
+			for(int x = 0; x < width; x++)
+			{
+				const int uvOffset = (x >> 1) * uvPixelStride;
+				uSamples[x] = pU[uvOffset];
+				vSamples[x] = pV[uvOffset];
+			}
+		}
+
+		convertYUVRow(pY, uSamples, vSamples,
+				reinterpret_cast<uint8_t*>(output + y * width),
+				width, PixelFormat::BGRA);
+	}
+}
+
+/**
+ * @brief Converts a YUV 4:2:0 semi-planar image to ARGB8888.
+ *
+ * Port of ConvertYUV420SPToARGB8888(...) of yuv2rgb.cc, accepting a Y plane
+ * followed by an interleaved chroma plane in V, U order (NV21), or in
+ * U, V order on Apple platforms (like the original).
+ * Output pixels are 0xAARRGGBB integers (PixelFormat::BGRA).
+ */
+void FilterManagementLibrary::ImageConversion::convertYUV420SPToARGB8888(
+		const uint8_t* const yData, const uint8_t* const uvData,
+		uint32_t* const output, const int width, const int height)
+{
+	#ifdef __APPLE__
+		convertYUV420ToARGB8888(yData, uvData, uvData + 1, output,
+				width, height, width, width, 2);
+	#else
+		convertYUV420ToARGB8888(yData, uvData + 1, uvData, output,
+				width, height, width, width, 2);
+	#endif
+}
+
+static inline void writeYUV(const int x, const int y, const int width,
+		const int r8, const int g8, const int b8,
+		uint8_t* const pY, uint8_t* const pUV)
+{
+	// Using formulas from http://msdn.microsoft.com/en-us/library/ms893078
+	*pY = ((66 * r8 + 129 * g8 + 25 * b8 + 128) >> 8) + 16;
+
+	// Odd widths get rounded up so that UV blocks on the side don't get
+	// cut off.
+	const int blocksPerRow = (width + 1) / 2;
+
+	// 2 bytes per UV block
+	const int offset = 2 * (((y / 2) * blocksPerRow + (x / 2)));
+
+	// U and V are the average values of all 4 pixels in the block.
+	if(!(x & 1) && !(y & 1))
+	{
+		// Explicitly clear the block if this is the first pixel in it.
+		pUV[offset] = 0;
+		pUV[offset + 1] = 0;
+	}
+
+	#ifdef __APPLE__
+		const int uOffset = 0;
+		const int vOffset = 1;
+	#else
+		const int uOffset = 1;
+		const int vOffset = 0;
+	#endif
+
+	// V (with divide by 4 factored in)
+	pUV[offset + vOffset] += ((112 * r8 - 94 * g8 - 18 * b8 + 128) >> 10) + 32;
+
+	// U (with divide by 4 factored in)
+	pUV[offset + uOffset] += ((-38 * r8 - 74 * g8 + 112 * b8 + 128) >> 10) + 32;
+}
+
+/**
+ * @brief Converts an ARGB8888 image to YUV 4:2:0 semi-planar (NV21).
+ *
+ * Port of ConvertARGB8888ToYUV420SP(...) of rgb2yuv.cc. Only a scalar
+ * version exists, as this direction is just used by tools (i.e. to
+ * produce camera like frames from image files).
+ * output needs to hold width * height + 2 * ((width + 1) / 2) *
+ * ((height + 1) / 2) bytes.
+ */
+void FilterManagementLibrary::ImageConversion::convertARGB8888ToYUV420SP(
+		const uint32_t* const input, uint8_t* const output,
+		const int width, const int height)
+{
+	uint8_t* pY = output;
+	uint8_t* pUV = output + (width * height);
+	const uint32_t* in = input;
+
+	for(int y = 0; y < height; y++)
+	{
+		for(int x = 0; x < width; x++)
+		{
+			const uint32_t rgb = *in++;
+			#ifdef __APPLE__
+				const int nB = (rgb >> 8) & 0xFF;
+				const int nG = (rgb >> 16) & 0xFF;
+				const int nR = (rgb >> 24) & 0xFF;
+			#else
+				const int nR = (rgb >> 16) & 0xFF;
+				const int nG = (rgb >> 8) & 0xFF;
+				const int nB = rgb & 0xFF;
+			#endif
+			writeYUV(x, y, width, nR, nG, nB, pY++, pUV);
+		}
+	}
+}
@@ -0,0 +1,192 @@
+/*
+ * LatencyHistogram.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#include "FilterManagementLibrary/LatencyHistogram.h"
+
+#include <string.h>
+
+/**
+ * @brief Constructor of LatencyHistogram, creates an empty histogram.
+ */
+FilterManagementLibrary::LatencyHistogram::LatencyHistogram()
+{
+	this->reset();
+}
+
+/**
+ * @brief Returns the bucket a value is counted in.
+ *
+ * Values below SUB_BUCKET_COUNT have a bucket of their own. Above, the
+ * position of the highest set bit selects the power of two and the
+ * SUB_BUCKET_BITS bits below it select the linear bucket within it.
+ */
+int FilterManagementLibrary::LatencyHistogram::getBucketIndex(int64_t valueUs)
+{
+	if(valueUs < SUB_BUCKET_COUNT)
+		return valueUs < 0 ? 0 : (int) valueUs;
+
+	const uint64_t value = valueUs;
+	const int highestBit = 63 - __builtin_clzll(value);
+	const int shift = highestBit - SUB_BUCKET_BITS;
+	const int index = (highestBit - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT +
+			(int) ((value >> shift) & (SUB_BUCKET_COUNT - 1));
+
+	return index < BUCKET_COUNT ? index : BUCKET_COUNT - 1;
+}
+
+/**
+ * @brief Returns the largest value counted in the given bucket.
+ */
+int64_t FilterManagementLibrary::LatencyHistogram::getBucketUpperBound(
+		int bucketIndex)
+{
+	if(bucketIndex < SUB_BUCKET_COUNT)
+		return bucketIndex;
+
+	const int shift = bucketIndex / SUB_BUCKET_COUNT - 1;
+	const int64_t subBucket = bucketIndex % SUB_BUCKET_COUNT;
+
+	return ((SUB_BUCKET_COUNT + subBucket + 1) << shift) - 1;
+}
+
+/**
+ * @brief Counts a duration.
+ *
+ * @param int64_t valueUs duration in microseconds, negative values are
+ * counted as 0
+ */
+void FilterManagementLibrary::LatencyHistogram::record(int64_t valueUs)
+{
+	if(valueUs < 0)
+		valueUs = 0;
+
+	this->counts[getBucketIndex(valueUs)]++;
+
+	if(this->count == 0 || valueUs < this->minimum)
+		this->minimum = valueUs;
+	if(this->count == 0 || valueUs > this->maximum)
+		this->maximum = valueUs;
+
+	this->count++;
+	this->total += valueUs;
+}
+
+/**
+ * @brief Adds all durations counted by another histogram.
+ *
+ * @param const LatencyHistogram& other the histogram to add
+ */
+void FilterManagementLibrary::LatencyHistogram::merge(
+		const LatencyHistogram& other)
+{
+	if(other.count == 0)
+		return;
+
+	for(int i = 0; i < BUCKET_COUNT; i++)
+	{
+		this->counts[i] += other.counts[i];
+	}
+
+	if(this->count == 0 || other.minimum < this->minimum)
+		this->minimum = other.minimum;
+	if(this->count == 0 || other.maximum > this->maximum)
+		this->maximum = other.maximum;
+
+	this->count += other.count;
+	this->total += other.total;
+}
+
+/**
+ * @brief Removes all counted durations.
+ */
+void FilterManagementLibrary::LatencyHistogram::reset()
+{
+	memset(this->counts, 0, sizeof(this->counts));
+	this->count = 0;
+	this->total = 0;
+	this->minimum = 0;
+	this->maximum = 0;
+}
+
+/**
+ * @brief Returns the number of counted durations.
+ */
+uint64_t FilterManagementLibrary::LatencyHistogram::getCount() const
+{
+	return this->count;
+}
+
+/**
+ * @brief Returns the smallest counted duration in microseconds, 0 if the
+ * histogram is empty.
+ */
+int64_t FilterManagementLibrary::LatencyHistogram::getMinimum() const
+{
+	return this->minimum;
+}
+
+/**
+ * @brief Returns the largest counted duration in microseconds, 0 if the
+ * histogram is empty.
+ */
+int64_t FilterManagementLibrary::LatencyHistogram::getMaximum() const
+{
+	return this->maximum;
+}
+
+/**
+ * @brief Returns the exact mean of the counted durations in microseconds,
+ * 0 if the histogram is empty.
+ */
+double FilterManagementLibrary::LatencyHistogram::getMean() const
+{
+	return this->count == 0 ? 0.0 : (double) this->total / this->count;
+}
+
+/**
+ * @brief Returns the duration below or equal to which the given
+ * percentage of the counted durations are.
+ *
+ * The result is the upper bound of the bucket the percentile falls into
+ * (but never more than the largest counted duration), so it
+ * overestimates by at most 12.5%.
+ *
+ * @param double percentile percentage between 0 and 100, i.e. 99 for
+ * the p99 latency
+ *
+ * @return int64_t duration in microseconds, 0 if the histogram is empty
+ */
+int64_t FilterManagementLibrary::LatencyHistogram::getPercentile(
+		double percentile) const
+{
+	if(this->count == 0)
+		return 0;
+
+	if(percentile <= 0.0)
+		return this->minimum;
+
+	uint64_t rank = (uint64_t) (percentile / 100.0 * this->count + 0.5);
+	if(rank < 1)
+		rank = 1;
+	if(rank >= this->count)
+		return this->maximum;
+
+	uint64_t seen = 0;
+
+	for(int i = 0; i < BUCKET_COUNT; i++)
+	{
+		seen += this->counts[i];
+
+		if(seen >= rank)
+		{
+			const int64_t upperBound = getBucketUpperBound(i);
+			return upperBound < this->maximum ? upperBound : this->maximum;
+		}
+	}
+
+	return this->maximum;
+}
@@ -0,0 +1,387 @@
+/*
+ * MemoryAccounting.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#include "FilterManagementLibrary/MemoryAccounting.h"
+#include "FilterManagementLibrary/Logger.h"
+
+#include <atomic>
+
+#include <opencv2/opencv.hpp>
+
+struct FilterManagementLibrary::MemoryAccountState
+{
+	MemoryAccountState* parent = NULL;
+
+	std::atomic<int64_t> currentBytes;
+	std::atomic<int64_t> peakBytes;
+	std::atomic<int64_t> liveAllocations;
+	std::atomic<uint64_t> totalAllocations;
+
+	/**
+	 * One for the MemoryAccount, one per charged allocation and one per
+	 * child account.
+	 */
+	std::atomic<int64_t> references;
+
+	MemoryAccountState() : currentBytes(0), peakBytes(0), liveAllocations(0),
+			totalAllocations(0), references(1)
+	{
+	}
+};
+
+namespace
+{
+	// A plain pointer, so no thread exit handling is needed
+	thread_local FilterManagementLibrary::MemoryAccount* currentAccount = NULL;
+
+	/**
+	 * Adds bytes and allocations to an account and all of its parents.
+	 */
+	void addToAccounts(FilterManagementLibrary::MemoryAccountState* state,
+			int64_t bytes, int64_t allocations)
+	{
+		for(; state != NULL; state = state->parent)
+		{
+			const int64_t currentBytes = state->currentBytes.fetch_add(bytes,
+					std::memory_order_relaxed) + bytes;
+			state->liveAllocations.fetch_add(allocations,
+					std::memory_order_relaxed);
+
+			if(allocations > 0)
+			{
+				state->totalAllocations.fetch_add(allocations,
+						std::memory_order_relaxed);
+			}
+
+			int64_t peakBytes = state->peakBytes.load(
+					std::memory_order_relaxed);
+			while(currentBytes > peakBytes &&
+					!state->peakBytes.compare_exchange_weak(peakBytes,
+							currentBytes, std::memory_order_relaxed))
+			{
+			}
+		}
+	}
+
+	void releaseReference(FilterManagementLibrary::MemoryAccountState* state)
+	{
+		while(state != NULL && state->references.fetch_sub(1) == 1)
+		{
+			FilterManagementLibrary::MemoryAccountState* parent =
+					state->parent;
+			delete state;
+			state = parent;
+		}
+	}
+
+	/**
+	 * Allocates the buffers of cv::Mat like the standard allocator of
+	 * OpenCV and charges them to the current account.
+	 * Buffers which are not owned by the cv::Mat (passed to its
+	 * constructor) are not charged.
+	 */
+	class AccountingMatAllocator : public cv::MatAllocator
+	{
+		private:
+			cv::MatAllocator* stdAllocator;
+
+		public:
+			AccountingMatAllocator() :
+				stdAllocator(cv::Mat::getStdAllocator())
+			{
+			}
+
+			cv::UMatData* allocate(int dims, const int* sizes, int type,
+					void* data, size_t* step, int flags,
+					cv::UMatUsageFlags usageFlags) const override
+			{
+				cv::UMatData* u = this->stdAllocator->allocate(dims, sizes,
+						type, data, step, flags, usageFlags);
+
+				if(u == NULL || data != NULL)
+					return u;
+
+				u->userdata = FilterManagementLibrary::MemoryAccount::charge(
+						FilterManagementLibrary::MemoryAccount::
+						getOpenCVAccount(), u->size);
+
+				// Makes OpenCV free the buffer through this allocator
+				u->currAllocator = this;
+				u->prevAllocator = this;
+
+				return u;
+			}
+
+			bool allocate(cv::UMatData* u, int accessFlags,
+					cv::UMatUsageFlags usageFlags) const override
+			{
+				return this->stdAllocator->allocate(u, accessFlags,
+						usageFlags);
+			}
+
+			void deallocate(cv::UMatData* u) const override
+			{
+				if(u == NULL)
+					return;
+
+				FilterManagementLibrary::MemoryAccount::release(
+						FilterManagementLibrary::MemoryAccount::
+						getOpenCVAccount(),
+						static_cast<FilterManagementLibrary::
+						MemoryAccountState*>(u->userdata), u->size);
+
+				u->userdata = NULL;
+				u->currAllocator = this->stdAllocator;
+				u->prevAllocator = this->stdAllocator;
+
+				this->stdAllocator->deallocate(u);
+			}
+	};
+}
+
+/**
+ * @brief Constructor of MemoryAccount.
+ *
+ * @param const std::string& name name of the component, for reports
+ *
+ * @param MemoryAccount* parent account all allocations are charged to as
+ * well, NULL if none. See setParent(...).
+ */
+FilterManagementLibrary::MemoryAccount::MemoryAccount(const std::string& name,
+		MemoryAccount* parent) : name(name), state(new MemoryAccountState())
+{
+	this->setParent(parent);
+}
+
+/**
+ * @brief Returns the name passed to the constructor.
+ */
+const std::string& FilterManagementLibrary::MemoryAccount::getName() const
+{
+	return this->name;
+}
+
+/**
+ * @brief Sets the account all allocations charged to this account are
+ * charged to as well, i.e. the pipeline a model is part of.
+ *
+ * The allocations not freed yet are moved from the previous parent to the
+ * new one. Must not be called while allocations are charged to the
+ * account.
+ *
+ * @param MemoryAccount* parent the new parent, NULL if none. Must not be
+ * the account itself or one of its children.
+ */
+void FilterManagementLibrary::MemoryAccount::setParent(MemoryAccount* parent)
+{
+	MemoryAccountState* parentState = parent != NULL ? parent->state : NULL;
+
+	for(MemoryAccountState* state = parentState; state != NULL;
+			state = state->parent)
+	{
+		if(state == this->state)
+		{
+			Logger::printfln("MemoryAccount %s: parent would form a cycle",
+					this->name.c_str());
+			return;
+		}
+	}
+
+	const int64_t bytes = this->state->currentBytes.load();
+	const int64_t allocations = this->state->liveAllocations.load();
+
+	if(this->state->parent != NULL)
+	{
+		addToAccounts(this->state->parent, -bytes, -allocations);
+		releaseReference(this->state->parent);
+	}
+
+	this->state->parent = parentState;
+
+	if(parentState != NULL)
+	{
+		parentState->references++;
+		addToAccounts(parentState, bytes, allocations);
+	}
+}
+
+/**
+ * @brief Returns the current counters of the account (including the
+ * allocations charged to its children).
+ */
+FilterManagementLibrary::MemoryUsage
+		FilterManagementLibrary::MemoryAccount::getUsage() const
+{
+	MemoryUsage usage;
+	usage.currentBytes = this->state->currentBytes.load();
+	usage.peakBytes = this->state->peakBytes.load();
+	usage.liveAllocations = this->state->liveAllocations.load();
+	usage.totalAllocations = this->state->totalAllocations.load();
+	return usage;
+}
+
+/**
+ * @brief Sets the peak to the current number of bytes, i.e. to measure
+ * the peak of a single frame.
+ */
+void FilterManagementLibrary::MemoryAccount::resetPeak()
+{
+	this->state->peakBytes = this->state->currentBytes.load();
+}
+
+/**
+ * @brief Returns the account the allocations of the calling thread are
+ * charged to, NULL if none. See MemoryAccountScope.
+ */
+FilterManagementLibrary::MemoryAccount*
+		FilterManagementLibrary::MemoryAccount::getCurrent()
+{
+	return currentAccount;
+}
+
+/**
+ * @brief Charges an allocation to a subsystem account and the current
+ * account of the calling thread (if any), used by the allocators.
+ *
+ * @param MemoryAccount* subsystem i.e. getTensorflowAccount()
+ *
+ * @param int64_t bytes size of the allocation
+ *
+ * @return MemoryAccountState* the account to pass to release(...) once
+ * the allocation is freed, NULL if only the subsystem was charged
+ */
+FilterManagementLibrary::MemoryAccountState*
+		FilterManagementLibrary::MemoryAccount::charge(
+				MemoryAccount* subsystem, int64_t bytes)
+{
+	addToAccounts(subsystem->state, bytes, 1);
+
+	MemoryAccount* account = currentAccount;
+	if(account == NULL || account == subsystem)
+		return NULL;
+
+	account->state->references++;
+	addToAccounts(account->state, bytes, 1);
+
+	return account->state;
+}
+
+/**
+ * @brief Subtracts an allocation charged by charge(...) again.
+ *
+ * May be called from any thread, also after the MemoryAccount was
+ * destroyed.
+ *
+ * @param MemoryAccount* subsystem the subsystem passed to charge(...)
+ *
+ * @param MemoryAccountState* account returned by charge(...)
+ *
+ * @param int64_t bytes size of the allocation
+ */
+void FilterManagementLibrary::MemoryAccount::release(MemoryAccount* subsystem,
+		MemoryAccountState* account, int64_t bytes)
+{
+	addToAccounts(subsystem->state, -bytes, -1);
+
+	if(account != NULL)
+	{
+		addToAccounts(account, -bytes, -1);
+		releaseReference(account);
+	}
+}
+
+/**
+ * @brief Returns the account of all allocations of the Tensorflow CPU
+ * allocator.
+ */
+FilterManagementLibrary::MemoryAccount*
+		FilterManagementLibrary::MemoryAccount::getTensorflowAccount()
+{
+	// Never destroyed, tensors may be freed during the static destruction
+	static MemoryAccount* account = new MemoryAccount("tensorflow");
+	return account;
+}
+
+/**
+ * @brief Returns the account of all cv::Mat buffers allocated since
+ * enableOpenCVAccounting() was called.
+ */
+FilterManagementLibrary::MemoryAccount*
+		FilterManagementLibrary::MemoryAccount::getOpenCVAccount()
+{
+	static MemoryAccount* account = new MemoryAccount("opencv");
+	return account;
+}
+
+/**
+ * @brief Makes cv::Mat allocate its buffers through an allocator charging
+ * them to the current account, by replacing the default allocator of
+ * OpenCV. Buffers allocated before are not counted.
+ *
+ * Costs a few atomic operations per allocated cv::Mat. Calling it again
+ * does nothing.
+ */
+void FilterManagementLibrary::MemoryAccount::enableOpenCVAccounting()
+{
+	// Never destroyed, the cv::Mats allocated by it need it to be freed
+	static AccountingMatAllocator* allocator = new AccountingMatAllocator();
+	cv::Mat::setDefaultAllocator(allocator);
+}
+
+/**
+ * @brief Destructor of MemoryAccount.
+ *
+ * The counters are kept until all allocations charged to the account
+ * are freed.
+ */
+FilterManagementLibrary::MemoryAccount::~MemoryAccount()
+{
+	releaseReference(this->state);
+}
+
+/**
+ * @brief Charges the following allocations of the calling thread to
+ * account.
+ *
+ * @param MemoryAccount* account needs to stay valid until the scope ends,
+ * NULL charges the allocations to the subsystem accounts only
+ */
+FilterManagementLibrary::MemoryAccountScope::MemoryAccountScope(
+		MemoryAccount* account) : previousAccount(currentAccount)
+{
+	currentAccount = account;
+}
+
+/**
+ * @brief Restores the account which was current before the scope.
+ */
+FilterManagementLibrary::MemoryAccountScope::~MemoryAccountScope()
+{
+	currentAccount = this->previousAccount;
+}
+
+/**
+ * @brief Charges bytes to subsystem and the current account of the
+ * calling thread.
+ *
+ * @param MemoryAccount* subsystem i.e. getTensorflowAccount()
+ *
+ * @param int64_t bytes the (estimated) size of the memory
+ */
+FilterManagementLibrary::MemoryAccountCharge::MemoryAccountCharge(
+		MemoryAccount* subsystem, int64_t bytes) : subsystem(subsystem),
+		account(MemoryAccount::charge(subsystem, bytes)), bytes(bytes)
+{
+}
+
+/**
+ * @brief Subtracts the bytes again.
+ */
+FilterManagementLibrary::MemoryAccountCharge::~MemoryAccountCharge()
+{
+	MemoryAccount::release(this->subsystem, this->account, this->bytes);
+}
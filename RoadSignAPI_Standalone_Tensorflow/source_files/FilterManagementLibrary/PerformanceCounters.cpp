@@ -0,0 +1,251 @@
+/*
+ * PerformanceCounters.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#include "FilterManagementLibrary/PerformanceCounters.h"
+#include "FilterManagementLibrary/Logger.h"
+
+#include <errno.h>
+#include <string.h>
+
+#ifdef __linux__
+	#include <linux/perf_event.h>
+	#include <sys/ioctl.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+#endif
+
+/**
+ * @brief Returns the instructions per cycle, 0 if no cycles were counted.
+ */
+double FilterManagementLibrary::PerformanceCounterValues::
+		getInstructionsPerCycle() const
+{
+	return this->cycles == 0 ? 0.0 :
+			(double) this->instructions / this->cycles;
+}
+
+/**
+ * @brief Returns the last level cache misses per 1000 instructions.
+ */
+double FilterManagementLibrary::PerformanceCounterValues::
+		getCacheMissesPerKiloInstruction() const
+{
+	return this->instructions == 0 ? 0.0 :
+			1000.0 * this->cacheMisses / this->instructions;
+}
+
+/**
+ * @brief Returns the branch misses per 1000 instructions.
+ */
+double FilterManagementLibrary::PerformanceCounterValues::
+		getBranchMissesPerKiloInstruction() const
+{
+	return this->instructions == 0 ? 0.0 :
+			1000.0 * this->branchMisses / this->instructions;
+}
+
+/**
+ * @brief Constructor of PerformanceCounters, the counters are opened by
+ * open().
+ */
+FilterManagementLibrary::PerformanceCounters::PerformanceCounters() :
+		groupFD(-1), openedCounterCount(0)
+{
+	for(int i = 0; i < COUNTER_COUNT; i++)
+	{
+		this->counterFDs[i] = -1;
+		this->groupIndices[i] = -1;
+	}
+}
+
+/**
+ * @brief Opens the counters of the calling thread as one group and
+ * starts them.
+ *
+ * Counters which can not be opened are left out of the group.
+ *
+ * @return bool true if at least one counter was opened, false otherwise
+ */
+bool FilterManagementLibrary::PerformanceCounters::open()
+{
+#ifdef __linux__
+	static const uint64_t counterConfigs[COUNTER_COUNT] = {
+			PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+			PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+
+	int error = 0;
+
+	for(int i = 0; i < COUNTER_COUNT; i++)
+	{
+		struct perf_event_attr attributes;
+		memset(&attributes, 0, sizeof(attributes));
+
+		attributes.type = PERF_TYPE_HARDWARE;
+		attributes.size = sizeof(attributes);
+		attributes.config = counterConfigs[i];
+		attributes.read_format = PERF_FORMAT_GROUP |
+				PERF_FORMAT_TOTAL_TIME_ENABLED |
+				PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+		// Started together with the leader. The kernel is excluded, so
+		// the default perf_event_paranoid setting allows the counters.
+		attributes.disabled = this->groupFD == -1 ? 1 : 0;
+		attributes.exclude_kernel = 1;
+		attributes.exclude_hv = 1;
+
+		const int fd = syscall(__NR_perf_event_open, &attributes, 0, -1,
+				this->groupFD, 0);
+
+		if(fd < 0)
+		{
+			error = errno;
+			continue;
+		}
+
+		if(this->groupFD == -1)
+			this->groupFD = fd;
+
+		this->counterFDs[i] = fd;
+		this->groupIndices[i] = this->openedCounterCount++;
+	}
+
+	if(this->groupFD == -1)
+	{
+		Logger::printfln("PerformanceCounters: perf_event_open failed: %s",
+				strerror(error));
+		return false;
+	}
+
+	ioctl(this->groupFD, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+	ioctl(this->groupFD, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+
+	return true;
+#else
+	Logger::printfln("PerformanceCounters: not supported on this platform");
+	return false;
+#endif
+}
+
+/**
+ * @brief Reads the current values of all counters of the group, scaled
+ * by the share of time the group was running.
+ *
+ * @param PerformanceCounterReading* reading receives the values, valid is
+ * false if they could not be read
+ *
+ * @return bool reading->valid
+ */
+bool FilterManagementLibrary::PerformanceCounters::readValues(
+		PerformanceCounterReading* reading)
+{
+	reading->valid = false;
+
+#ifdef __linux__
+	if(this->groupFD == -1)
+		return false;
+
+	// nr, time enabled, time running, one value per counter
+	uint64_t buffer[3 + COUNTER_COUNT];
+	const ssize_t size = ::read(this->groupFD, buffer, sizeof(buffer));
+
+	if(size < (ssize_t) ((3 + this->openedCounterCount) * sizeof(uint64_t)))
+		return false;
+
+	const uint64_t timeEnabled = buffer[1];
+	const uint64_t timeRunning = buffer[2];
+	const double scale = timeRunning == 0 ? 0.0 :
+			(double) timeEnabled / timeRunning;
+
+	for(int i = 0; i < COUNTER_COUNT; i++)
+	{
+		reading->values[i] = this->groupIndices[i] < 0 ? 0 :
+				(uint64_t) (buffer[3 + this->groupIndices[i]] * scale);
+	}
+
+	reading->valid = true;
+#endif
+
+	return reading->valid;
+}
+
+/**
+ * @brief Returns the counters of the calling thread, opened on the first
+ * call of the thread.
+ */
+FilterManagementLibrary::PerformanceCounters*
+		FilterManagementLibrary::PerformanceCounters::getThreadCounters()
+{
+	// A plain pointer, so no thread exit handling is needed
+	static thread_local PerformanceCounters* threadCounters = NULL;
+
+	if(threadCounters == NULL)
+	{
+		threadCounters = new PerformanceCounters();
+		threadCounters->open();
+	}
+
+	return threadCounters;
+}
+
+/**
+ * @brief Reads the counters of the calling thread, to measure the code
+ * following until accumulate(...) is called.
+ *
+ * @param PerformanceCounterReading* reading receives the values
+ */
+void FilterManagementLibrary::PerformanceCounters::read(
+		PerformanceCounterReading* reading)
+{
+	getThreadCounters()->readValues(reading);
+}
+
+/**
+ * @brief Adds the counts of the calling thread since a reading to values.
+ *
+ * Needs to be called on the thread start was read on.
+ *
+ * @param const PerformanceCounterReading& start reading taken by
+ * read(...) before the measured code
+ *
+ * @param PerformanceCounterValues* values the counts are added to this,
+ * samples is incremented. Left untouched if the counters are not
+ * available.
+ */
+void FilterManagementLibrary::PerformanceCounters::accumulate(
+		const PerformanceCounterReading& start,
+		PerformanceCounterValues* values)
+{
+	if(!start.valid)
+		return;
+
+	PerformanceCounterReading end;
+	if(!getThreadCounters()->readValues(&end))
+		return;
+
+	uint64_t deltas[COUNTER_COUNT];
+	for(int i = 0; i < COUNTER_COUNT; i++)
+	{
+		// The scaling may make the values decrease slightly
+		deltas[i] = end.values[i] > start.values[i] ?
+				end.values[i] - start.values[i] : 0;
+	}
+
+	values->cycles += deltas[COUNTER_CYCLES];
+	values->instructions += deltas[COUNTER_INSTRUCTIONS];
+	values->cacheMisses += deltas[COUNTER_CACHE_MISSES];
+	values->branchMisses += deltas[COUNTER_BRANCH_MISSES];
+	values->samples++;
+}
+
+/**
+ * @brief Returns true if at least one counter can be read on the calling
+ * thread.
+ */
+bool FilterManagementLibrary::PerformanceCounters::isAvailable()
+{
+	return getThreadCounters()->groupFD != -1;
+}
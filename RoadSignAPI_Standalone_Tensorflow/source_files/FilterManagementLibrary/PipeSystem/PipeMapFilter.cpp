@@ -0,0 +1,99 @@
+/*
+ * PipeMapFilter.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#include "FilterManagementLibrary/PipeSystem/PipeMapFilter.h"
+#include "FilterManagementLibrary/Logger.h"
+
+/**
+ * @brief Standard constructor of PipeMapFilter.
+ */
+FilterManagementLibrary::PipeSystem::PipeMapFilter::PipeMapFilter() :
+		runItem([this](int itemIndex, int workerIndex)
+		{
+			this->itemResults[itemIndex] =
+					this->processItem(itemIndex, workerIndex);
+		})
+{
+}
+
+/**
+ * @brief Called once before the items are processed.
+ *
+ * Derived filters override this to prepare one result slot per item and
+ * one scratch buffer per worker.
+ *
+ * @param int itemCount number of items, as returned by getItemCount()
+ *
+ * @param int workerCount number of threads processing the items, i.e.
+ * the worker indices passed to processItem(...) are below this
+ *
+ * @return bool true, if false is returned, no item is processed and the
+ * filter fails
+ */
+bool FilterManagementLibrary::PipeSystem::PipeMapFilter::beginItems(
+		int itemCount, int workerCount)
+{
+	return true;
+}
+
+/**
+ * @brief The process function of all map filters.
+ *
+ * Calls beginItems(...), processItem(...) for every item (distributed
+ * over the worker threads of the pipe) and endItems(), see the class
+ * description.
+ *
+ * @return bool true if beginItems(...), all processItem(...) calls and
+ * endItems() returned true, false otherwise.
+ */
+bool FilterManagementLibrary::PipeSystem::PipeMapFilter::process()
+{
+	const int itemCount = this->getItemCount();
+
+	PipeWorkerPool* workerPool = this->getWorkerPool();
+
+	const bool parallel = workerPool != nullptr &&
+			workerPool->getThreadCount() > 0 &&
+			itemCount >= this->minParallelItems;
+
+	const int workerCount = parallel ? workerPool->getThreadCount() + 1 : 1;
+
+	if(!this->beginItems(itemCount, workerCount))
+		return false;
+
+	this->itemResults.assign(itemCount, 0);
+
+	if(parallel)
+		workerPool->run(itemCount, this->runItem);
+	else
+	{
+		for(int i = 0; i < itemCount; i++)
+		{
+			this->runItem(i, 0);
+		}
+	}
+
+	for(int i = 0; i < itemCount; i++)
+	{
+		if(!this->itemResults[i])
+		{
+			Logger::printfln("Filter %d failed to process item %d",
+					this->getFilterID(), i);
+			return false;
+		}
+	}
+
+	return this->endItems();
+}
+
+/**
+ * @brief Standard destructor of PipeMapFilter. Has no functionality yet.
+ */
+FilterManagementLibrary::PipeSystem::PipeMapFilter::~PipeMapFilter()
+{
+
+}
@@ -0,0 +1,235 @@
+/*
+ * PipeWorkerPool.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#include "FilterManagementLibrary/PipeSystem/PipeWorkerPool.h"
+#include "FilterManagementLibrary/Logger.h"
+
+#include <system_error>
+
+namespace
+{
+	// Pool and thread index of the task the current thread is running,
+	// so nested calls to run(...) can keep the thread index
+	thread_local const FilterManagementLibrary::PipeSystem::PipeWorkerPool*
+			currentPool = nullptr;
+	thread_local int currentThreadIndex = 0;
+}
+
+/**
+ * @brief Creates the worker threads.
+ *
+ * A running pool is stopped first.
+ *
+ * @param int threadCount number of threads to create in addition to the
+ * thread calling run(...). With 0 threads, run(...) runs all tasks on the
+ * calling thread.
+ *
+ * @return bool true if all threads were created, false otherwise (the
+ * pool is stopped then)
+ */
+bool FilterManagementLibrary::PipeSystem::PipeWorkerPool::start(
+		int threadCount)
+{
+	this->stop();
+
+	try
+	{
+		for(int i = 0; i < threadCount; i++)
+		{
+			this->workers.push_back(
+					std::thread(&PipeWorkerPool::workerLoop, this, i + 1));
+		}
+	}
+	catch(const std::system_error& error)
+	{
+		Logger::printfln("PipeWorkerPool: failed to create thread: %s",
+				error.what());
+		this->stop();
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Wakes up and joins all worker threads.
+ *
+ * Must not be called while run(...) is running.
+ *
+ * @return void
+ */
+void FilterManagementLibrary::PipeSystem::PipeWorkerPool::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->stopping = true;
+	}
+	this->tasksAvailable.notify_all();
+
+	for(std::thread& worker : this->workers)
+	{
+		worker.join();
+	}
+
+	this->workers.clear();
+	this->stopping = false;
+}
+
+/**
+ * @brief Returns the number of worker threads (without the calling
+ * thread).
+ */
+int FilterManagementLibrary::PipeSystem::PipeWorkerPool::getThreadCount()
+		const
+{
+	return this->workers.size();
+}
+
+/**
+ * @brief Runs task(0, ...) ... task(taskCount - 1, ...) on the worker
+ * threads and the calling thread.
+ *
+ * Returns when all tasks are finished. The tasks must not depend on each
+ * other, they may run in any order and at the same time. The second
+ * argument of task is the index of the thread running it: 0 for the
+ * calling thread, 1 ... getThreadCount() for the worker threads. Tasks
+ * running at the same time never get the same thread index, so it can
+ * be used to select scratch buffers.
+ *
+ * Calls from a task of this pool run all tasks on the calling thread,
+ * with the thread index of the calling task. Calls from other threads
+ * wait until the running batch is finished.
+ *
+ * @param int taskCount number of tasks
+ *
+ * @param const std::function<void(int, int)>& task called with the index
+ * of each task and the index of the thread running it
+ *
+ * @return void
+ */
+void FilterManagementLibrary::PipeSystem::PipeWorkerPool::run(int taskCount,
+		const std::function<void(int, int)>& task)
+{
+	if(taskCount <= 0)
+		return;
+
+	// Nested call from a task of the running batch: the calling thread is
+	// busy with that task anyway, so its thread index is not used by others
+	if(currentPool == this)
+	{
+		const int threadIndex = currentThreadIndex;
+		for(int i = 0; i < taskCount; i++)
+		{
+			task(i, threadIndex);
+		}
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(this->mutex);
+
+	// Batch of another thread, it already uses all thread indices
+	while(this->task != nullptr)
+	{
+		this->batchFinished.wait(lock);
+	}
+
+	this->task = &task;
+	this->taskMemoryAccount = MemoryAccount::getCurrent();
+	this->taskCount = taskCount;
+	this->nextTask = 0;
+	this->unfinishedTasks = taskCount;
+
+	if(!this->workers.empty() && taskCount > 1)
+		this->tasksAvailable.notify_all();
+
+	// Help out instead of just waiting
+	while(this->runNextTask(&lock, 0))
+	{
+	}
+
+	while(this->unfinishedTasks > 0)
+	{
+		this->tasksFinished.wait(lock);
+	}
+
+	this->task = nullptr;
+	this->taskCount = 0;
+
+	this->batchFinished.notify_one();
+}
+
+/**
+ * @brief Takes the next task of the current batch (if any) and runs it
+ * with the mutex unlocked.
+ *
+ * @param std::unique_lock<std::mutex>* lock lock on the mutex, locked
+ * again when the function returns
+ *
+ * @param int workerIndex index of the calling thread, see run(...)
+ *
+ * @return bool true if a task was run, false if all tasks of the batch
+ * were already handed out
+ */
+bool FilterManagementLibrary::PipeSystem::PipeWorkerPool::runNextTask(
+		std::unique_lock<std::mutex>* lock, int workerIndex)
+{
+	if(this->nextTask >= this->taskCount)
+		return false;
+
+	const int taskIndex = this->nextTask++;
+	const std::function<void(int, int)>* task = this->task;
+	MemoryAccount* memoryAccount = this->taskMemoryAccount;
+
+	lock->unlock();
+	{
+		MemoryAccountScope memoryAccountScope(memoryAccount);
+
+		const PipeWorkerPool* previousPool = currentPool;
+		const int previousThreadIndex = currentThreadIndex;
+		currentPool = this;
+		currentThreadIndex = workerIndex;
+
+		(*task)(taskIndex, workerIndex);
+
+		currentPool = previousPool;
+		currentThreadIndex = previousThreadIndex;
+	}
+	lock->lock();
+
+	if(--this->unfinishedTasks == 0)
+		this->tasksFinished.notify_one();
+
+	return true;
+}
+
+/**
+ * @brief Main function of each worker thread: runs tasks until the pool
+ * is stopped.
+ *
+ * @param int workerIndex index of the thread passed to the tasks
+ *
+ * @return void
+ */
+void FilterManagementLibrary::PipeSystem::PipeWorkerPool::workerLoop(
+		int workerIndex)
+{
+	std::unique_lock<std::mutex> lock(this->mutex);
+
+	while(!this->stopping)
+	{
+		if(!this->runNextTask(&lock, workerIndex))
+			this->tasksAvailable.wait(lock);
+	}
+}
+
+/**
+ * @brief Destructor of PipeWorkerPool, stops the worker threads.
+ */
+FilterManagementLibrary::PipeSystem::PipeWorkerPool::~PipeWorkerPool()
+{
+	this->stop();
+}
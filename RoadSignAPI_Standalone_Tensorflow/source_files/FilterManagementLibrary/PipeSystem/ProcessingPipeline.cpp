@@ -1,270 +1,774 @@
-/*
- * ProcessingPipeline.cpp
- *
- *  Created on: 03.06.2018
- *      Author: Patrick Langer
- */
-
-
-#include "FilterManagementLibrary/PipeSystem/ProcessingPipeline.h"
-#include "FilterManagementLibrary/Logger.h"
-
-
-/**
- * @brief Standard constructor of ProcessingPipeline
- *
- * The ProcessingPipeline needs to know the PipeWorkingDataSet on which
- * all operations of the filters will be performed and the
- * PipeRegisteredFilters struct which will contain the ID's of the filters
- * registered to the pipe. Pointers to these coressponding objects need
- * to be passed to this constructor. They will be passed to all
- * registered filters.
- * Also via manageExternalAllocatedRessources, it can be determined whether
- * the ProcessingPipeline will "take ownership" of all those variables
- * allocated on the heap (PipeWorkingDataSet, PipeRegisteredFilters and
- * all registered Filters themselves), which means it will delete them
- * on destruction.
- * All other class members will be initialised to their defult values.
- *
- * @param PipeWorkingDataSet* a pointer to an object of a struct derived from
- * PipeWorkingDataSet. This is the data set the filters work on and
- * will be passed to all registered filters.
- *
- * @param PipeRegisteredFilters* a pointer to an object of a struct derived from
- * PipeRegisteredFilters. The struct should contain (integer) values to
- * the ID's of all registered Filters. The filters need this for their
- * invokeNext(const int filterID) function to know the ID of the filter
- * they want to invoke next.
- *
- * @param bool manageExternalAllocatedRessources indicate whether the
- * ProcessingPipeline shall take ownership of all variables passed to
- * it which were allocated on the heap, therefore deleting them on destruction.
- */
-FilterManagementLibrary::PipeSystem::ProcessingPipeline::ProcessingPipeline(
-		PipeWorkingDataSet* workingDataSet,
-		PipeRegisteredFilters* pipeRegisteredFiltersHeader,
-		bool manageExternallyAllocatedRessources) :
-		workingDataSet(workingDataSet),
-		pipeRegisteredFiltersHeader(pipeRegisteredFiltersHeader),
-		manageExternalAllocatedRessources(manageExternalAllocatedRessources),
-		currentFilterID(0), lastError(ErrorType::ERROR_NONE)
-
-{
-
-}
-
-/**
- * @brief Registers a filter onto the ProcessingPipeline.
- *
- * Each filter which shall be included into the ProcessingPipeline needs
- * to be registered to it using this function.
- *
- * @param PipeFilter* filter pointer to the filter to register
- * @param int filterID a pointer to an integer whose value will be changed
- * in this function. It will contain the ID of the newly registered filter
- * afterwards.
- *
- * @return void
- */
-void FilterManagementLibrary::PipeSystem::ProcessingPipeline::registerFilter
-		(PipeFilter* filter, int* filterID)
-{
-	*filterID = this->registeredFilters.size();
-
-	filter->setCredentials(*filterID,
-			this->pipeRegisteredFiltersHeader, this->workingDataSet);
-	this->registeredFilters.push_back(filter);
-}
-
-/**oracion
- * @brief Set up the pipe and it's filters.
- *
- * Will iterate over all filters and call initByPipeSetup() on them.
- * On failure, lastError will be set accordingly.
- *
- * @return bool true if all filters return true in their initByPipeSetup()
- * functions, false otherwise.
- */
-bool FilterManagementLibrary::PipeSystem::ProcessingPipeline::setup()
-{
-	Logger::printfln("Setting up pipe");
-	for(PipeFilter* filter : this->registeredFilters)
-	{
-		Logger::printfln("Setting up Filter %d", filter->getFilterID());
-		if(filter->initByPipeSetup())
-		{
-			Logger::printfln("Filter %d set up successfully",
-					filter->getFilterID());
-		}
-		else
-		{
-			Logger::printfln("Failed to set up Filter %d, aborting",
-					filter->getFilterID());
-			this->lastError = ErrorType::ERROR_FILTER_SETUP_FAILED;
-			return false;
-		}
-	}
-
-	return true;
-}
-
-
-
-/**
- * @brief Process the PipeWorkingDataSet.
- *
- * Will iterate over all filters and call their process() functions, which
- * means the DataSet will be processed.
- * Each filter will (should !) indicate either if the processing has been finished,
- * or if (and which) a filter shall be invoked next, as long as their
- * process function returns true.
- * Otherwise, if a filter returns false, this means the current dataset couldn't
- * be processed.
- * Either way, in any case of failure, lastError will be set accordingly.
- *
- * @return bool true if all filters return true in their process()
- * functions AND either indicate which filter to invoke next or that the
- * processing is finished, false otherwise.
- */
-bool FilterManagementLibrary::PipeSystem::ProcessingPipeline::
-	processCurrentDataSet()
-{
-	this->processingFinishied = false;
-	PipeFilter* currentFilter;
-
-	// First filter is always ID 0!
-	currentFilter = this->registeredFilters[0];
-	currentFilter->reset();
-
-	bool success = false;
-
-	success = currentFilter->process();
-
-	if(success)
-	{
-		if(currentFilter->hasMarkedProcessingFinished())
-		{
-			//FilterManagementLibrary::Logger::
-			//				printfln("Filter %d indicated working data "
-			//						"has been fully processed successfully!",
-			//						this->currentFilterID);
-			return true;
-		}
-	}
-	else
-		return false;
-
-
-	while(!this->processingFinishied &&
-			currentFilter->hasMarkedNextDesiredFilter())
-	{
-		// Check if the ID of the next desired Filter
-		// is within the range of our List of registered Filters
-		if(currentFilter->getNextDesiredFilter() <
-				this->registeredFilters.size() &&
-				currentFilter->getNextDesiredFilter() > 0)
-		{
-			this->currentFilterID = currentFilter->getNextDesiredFilter();
-			currentFilter = this->registeredFilters[this->currentFilterID];
-
-			// Mandatory!
-			currentFilter->reset();
-
-			//FilterManagementLibrary::Logger::
-			//	printfln("Invoking Filter %d", this->currentFilterID);
-
-			if(currentFilter->process())
-			{
-				//FilterManagementLibrary::Logger::
-				//	printfln("Filter %d successfully finished it's operations",
-				//		this->currentFilterID);
-			}
-			else
-			{
-				FilterManagementLibrary::Logger::
-					printfln("Processing failed: Filter %d indicated failure",
-							this->currentFilterID);
-				this->lastError = ProcessingPipeline::ErrorType::
-						ERROR_FILTER_INDICATED_FAILURE;
-				return false;
-			}
-
-			this->processingFinishied =
-					currentFilter->hasMarkedProcessingFinished();
-		}
-		else
-		{
-			FilterManagementLibrary::Logger::
-					printfln("Filter %d wanted to invoke Filter %d\
-							 althoguh this ID is not assigned.",
-									this->currentFilterID,
-									currentFilter->getNextDesiredFilter());
-			this->lastError = ProcessingPipeline::ErrorType::
-										ERROR_FILTER_INDICATED_FAILURE;
-			return false;
-		}
-	}
-
-	if(!this->processingFinishied &&
-			!currentFilter->hasMarkedNextDesiredFilter())
-	{
-		// currentFilter successfully finished it's calculations,
-		// but did neither indicated a next filter nor that the
-		// workingDataSet is fully processed.
-		// Has to be a logic error !
-
-		FilterManagementLibrary::Logger::
-			printfln("Logic fault, Filter %d finished it's operations\
-					but neither indicated it the workingDataSet is \
-					fully processed, nor which Filter shall\
-					be invoked next", this->currentFilterID);
-		this->lastError = ProcessingPipeline::ErrorType::ERROR_LOGIC_FAULT;
-		return false;
-	}
-	else
-	{
-		// Processing has to be finished successfully!
-		//FilterManagementLibrary::Logger::
-		//	printfln("Filter %d indicated working data\
-		//			has been fully processed successfully!",
-		//			this->currentFilterID);
-		return true;
-	}
-}
-
-
-/**
- * @brief Returns an (enum) ID of the last error that happened.
- *
- * @return ProcessingPipeline::ErrorType the enum value of the last error
- * that happened.
- */
-FilterManagementLibrary::PipeSystem::ProcessingPipeline::ErrorType
-	FilterManagementLibrary::PipeSystem::ProcessingPipeline::getLastError() const
-{
-	return this->lastError;
-}
-
-/**
- * @brief Destructor of ProcessingPipeline.
- *
- * If manageExternalAllocatedRessources was set to true in constructor,
- * all variables on the heap (PipeWorkingDataSet, PipeRegisteredFilters,
- * the filters itselves) will be deleted.
- * Otherwise the destructor does do nothing.
- *
- * @return ProcessingPipeline::ErrorType the enum value of the last error
- * that happened.
- */
-FilterManagementLibrary::PipeSystem::ProcessingPipeline::~ProcessingPipeline()
-{
-	if(this->manageExternalAllocatedRessources)
-	{
-		for(PipeFilter* filter : this->registeredFilters)
-		{
-			delete filter;
-		}
-		delete this->workingDataSet;
-		delete this->pipeRegisteredFiltersHeader;
-	}
-}
+/*
+ * ProcessingPipeline.cpp
+ *
+ *  Created on: 03.06.2018
+ *      Author: Patrick Langer
+ */
+
+
+#include "FilterManagementLibrary/PipeSystem/ProcessingPipeline.h"
+#include "FilterManagementLibrary/Logger.h"
+#include "FilterManagementLibrary/Utilities.h"
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <string>
+
+
+/**
+ * @brief Standard constructor of ProcessingPipeline
+ *
+ * The ProcessingPipeline needs to know the PipeWorkingDataSet on which
+ * all operations of the filters will be performed and the
+ * PipeRegisteredFilters struct which will contain the ID's of the filters
+ * registered to the pipe. Pointers to these coressponding objects need
+ * to be passed to this constructor. They will be passed to all
+ * registered filters.
+ * Also via manageExternalAllocatedRessources, it can be determined whether
+ * the ProcessingPipeline will "take ownership" of all those variables
+ * allocated on the heap (PipeWorkingDataSet, PipeRegisteredFilters and
+ * all registered Filters themselves), which means it will delete them
+ * on destruction.
+ * All other class members will be initialised to their defult values.
+ *
+ * @param PipeWorkingDataSet* a pointer to an object of a struct derived from
+ * PipeWorkingDataSet. This is the data set the filters work on and
+ * will be passed to all registered filters.
+ *
+ * @param PipeRegisteredFilters* a pointer to an object of a struct derived from
+ * PipeRegisteredFilters. The struct should contain (integer) values to
+ * the ID's of all registered Filters. The filters need this for their
+ * invokeNext(const int filterID) function to know the ID of the filter
+ * they want to invoke next.
+ *
+ * @param bool manageExternalAllocatedRessources indicate whether the
+ * ProcessingPipeline shall take ownership of all variables passed to
+ * it which were allocated on the heap, therefore deleting them on destruction.
+ */
+FilterManagementLibrary::PipeSystem::ProcessingPipeline::ProcessingPipeline(
+		PipeWorkingDataSet* workingDataSet,
+		PipeRegisteredFilters* pipeRegisteredFiltersHeader,
+		bool manageExternallyAllocatedRessources) :
+		workingDataSet(workingDataSet),
+		pipeRegisteredFiltersHeader(pipeRegisteredFiltersHeader),
+		manageExternalAllocatedRessources(manageExternalAllocatedRessources),
+		currentFilterID(0), lastError(ErrorType::ERROR_NONE),
+		memoryAccount("pipeline")
+
+{
+
+}
+
+/**
+ * @brief Registers a filter onto the ProcessingPipeline.
+ *
+ * Each filter which shall be included into the ProcessingPipeline needs
+ * to be registered to it using this function.
+ *
+ * @param PipeFilter* filter pointer to the filter to register
+ * @param int filterID a pointer to an integer whose value will be changed
+ * in this function. It will contain the ID of the newly registered filter
+ * afterwards.
+ *
+ * @return void
+ */
+void FilterManagementLibrary::PipeSystem::ProcessingPipeline::registerFilter
+		(PipeFilter* filter, int* filterID)
+{
+	*filterID = this->registeredFilters.size();
+
+	filter->setCredentials(*filterID,
+			this->pipeRegisteredFiltersHeader, this->workingDataSet,
+			&this->workerPool);
+	this->registeredFilters.push_back(filter);
+	this->filterStatistics.push_back(PipeFilterStatistics());
+	this->dataSetTimings.push_back(PipeFilterTiming());
+}
+
+/**oracion
+ * @brief Set up the pipe and it's filters.
+ *
+ * Will iterate over all filters and call initByPipeSetup() on them.
+ * In DAG scheduling mode, the schedule is built afterwards from the data
+ * flow the filters declared (see buildSchedule()).
+ * On failure, lastError will be set accordingly.
+ *
+ * @return bool true if all filters return true in their initByPipeSetup()
+ * functions (and the schedule could be built), false otherwise.
+ */
+bool FilterManagementLibrary::PipeSystem::ProcessingPipeline::setup()
+{
+	Logger::printfln("Setting up pipe");
+	for(PipeFilter* filter : this->registeredFilters)
+	{
+		Logger::printfln("Setting up Filter %d", filter->getFilterID());
+		if(filter->initByPipeSetup())
+		{
+			Logger::printfln("Filter %d set up successfully",
+					filter->getFilterID());
+		}
+		else
+		{
+			Logger::printfln("Failed to set up Filter %d, aborting",
+					filter->getFilterID());
+			this->lastError = ErrorType::ERROR_FILTER_SETUP_FAILED;
+			return false;
+		}
+	}
+
+	if(this->schedulingMode == SchedulingMode::SCHEDULING_DAG &&
+			!this->buildSchedule())
+	{
+		this->lastError = ErrorType::ERROR_SCHEDULE_INVALID;
+		return false;
+	}
+
+	// Without workers everything still runs on the calling thread
+	this->workerPool.start(this->workerThreadCount);
+
+	this->isSetUp = true;
+	return true;
+}
+
+/**
+ * @brief Selects how the filters are scheduled.
+ *
+ * In SCHEDULING_DYNAMIC mode (the default), the filters decide which
+ * filter runs next, starting with filter 0.
+ * In SCHEDULING_DAG mode, the pipe builds a static schedule from the
+ * inputs and outputs the filters declared: every filter runs after the
+ * filters producing its inputs, filters which don't depend on each other
+ * run concurrently on a PipeWorkerPool.
+ * May be called before or after setup(), but not while a data set is
+ * processed.
+ *
+ * @param SchedulingMode schedulingMode the mode to use
+ *
+ * @param int workerThreadCount number of worker threads, see
+ * setWorkerThreadCount(...)
+ *
+ * @return bool true on success, false if the schedule could not be built
+ * (the pipe stays in SCHEDULING_DYNAMIC mode then)
+ */
+bool FilterManagementLibrary::PipeSystem::ProcessingPipeline::
+		setSchedulingMode(SchedulingMode schedulingMode,
+		int workerThreadCount)
+{
+	this->schedulingMode = schedulingMode;
+
+	if(this->schedulingMode == SchedulingMode::SCHEDULING_DAG &&
+			this->isSetUp && !this->buildSchedule())
+	{
+		this->schedulingMode = SchedulingMode::SCHEDULING_DYNAMIC;
+		this->lastError = ErrorType::ERROR_SCHEDULE_INVALID;
+		return false;
+	}
+
+	return this->setWorkerThreadCount(workerThreadCount);
+}
+
+/**
+ * @brief Sets the number of worker threads of the pipe.
+ *
+ * The workers run independent filters in DAG scheduling mode and the
+ * items of PipeMapFilters (in any mode), in addition to the thread
+ * calling processCurrentDataSet(). With 0 workers, everything runs on
+ * the calling thread.
+ * May be called before or after setup(), but not while a data set is
+ * processed.
+ *
+ * @param int workerThreadCount number of worker threads
+ *
+ * @return bool true on success, false if the threads could not be
+ * created (everything runs on the calling thread then)
+ */
+bool FilterManagementLibrary::PipeSystem::ProcessingPipeline::
+		setWorkerThreadCount(int workerThreadCount)
+{
+	this->workerThreadCount = std::max(workerThreadCount, 0);
+
+	if(!this->isSetUp)
+		return true;
+
+	return this->workerPool.start(this->workerThreadCount);
+}
+
+/**
+ * @brief Returns the scheduling mode, see setSchedulingMode(...).
+ */
+FilterManagementLibrary::PipeSystem::ProcessingPipeline::SchedulingMode
+		FilterManagementLibrary::PipeSystem::ProcessingPipeline::
+		getSchedulingMode() const
+{
+	return this->schedulingMode;
+}
+
+/**
+ * @brief Returns the static schedule of the DAG scheduling mode.
+ *
+ * @return const std::vector<std::vector<int> >* the IDs of the filters of
+ * each level; empty if the schedule was not built (yet).
+ */
+const std::vector<std::vector<int> >*
+		FilterManagementLibrary::PipeSystem::ProcessingPipeline::
+		getScheduleLevels() const
+{
+	return &this->scheduleLevels;
+}
+
+/**
+ * @brief Builds the static schedule for DAG scheduling mode.
+ *
+ * A filter depends on the filters which declared its inputs as outputs.
+ * Inputs no filter declares as output are provided from outside the
+ * pipe. The filters are assigned to levels, so that all dependencies of
+ * a filter lie in earlier levels (Kahn's algorithm).
+ *
+ * @return bool true on success, false if a data is declared as output by
+ * more than one filter, a filter declares no output or the dependencies
+ * contain a cycle.
+ */
+bool FilterManagementLibrary::PipeSystem::ProcessingPipeline::buildSchedule()
+{
+	const int filterCount = this->registeredFilters.size();
+
+	this->scheduleLevels.clear();
+	this->filterDependents.assign(filterCount, std::vector<int>());
+
+	std::map<std::string, int> producers;
+
+	for(int filterID = 0; filterID < filterCount; filterID++)
+	{
+		const PipeFilter* filter = this->registeredFilters[filterID];
+
+		if(filter->declaredOutputs.empty())
+		{
+			Logger::printfln("Filter %d declares no outputs, "
+					"can't be scheduled", filterID);
+			return false;
+		}
+
+		for(const std::string& output : filter->declaredOutputs)
+		{
+			if(!producers.insert(std::make_pair(output, filterID)).second)
+			{
+				Logger::printfln("Filters %d and %d both declare %s "
+						"as output", producers[output], filterID,
+						output.c_str());
+				return false;
+			}
+		}
+	}
+
+	std::vector<int> dependencyCounts(filterCount, 0);
+
+	for(int filterID = 0; filterID < filterCount; filterID++)
+	{
+		for(const std::string& input :
+				this->registeredFilters[filterID]->declaredInputs)
+		{
+			std::map<std::string, int>::const_iterator producer =
+					producers.find(input);
+
+			if(producer == producers.end())
+			{
+				Logger::printfln("Filter %d reads %s, which is provided "
+						"from outside the pipe", filterID, input.c_str());
+				continue;
+			}
+
+			// Filters may modify their own outputs in place
+			std::vector<int>* dependents =
+					&this->filterDependents[producer->second];
+
+			if(producer->second != filterID &&
+					std::find(dependents->begin(), dependents->end(),
+							filterID) == dependents->end())
+			{
+				dependents->push_back(filterID);
+				dependencyCounts[filterID]++;
+			}
+		}
+	}
+
+	std::vector<int> level;
+	int scheduledFilters = 0;
+
+	for(int filterID = 0; filterID < filterCount; filterID++)
+	{
+		if(dependencyCounts[filterID] == 0)
+			level.push_back(filterID);
+	}
+
+	while(!level.empty())
+	{
+		this->scheduleLevels.push_back(level);
+		scheduledFilters += level.size();
+
+		std::string filterIDs;
+		std::vector<int> nextLevel;
+
+		for(int filterID : level)
+		{
+			filterIDs += " " + std::to_string(filterID);
+
+			for(int dependent : this->filterDependents[filterID])
+			{
+				if(--dependencyCounts[dependent] == 0)
+					nextLevel.push_back(dependent);
+			}
+		}
+
+		Logger::printfln("Schedule level %d: filters%s",
+				(int) this->scheduleLevels.size() - 1, filterIDs.c_str());
+
+		std::sort(nextLevel.begin(), nextLevel.end());
+		level.swap(nextLevel);
+	}
+
+	if(scheduledFilters != filterCount)
+	{
+		Logger::printfln("The declared data flow of the filters "
+				"contains a cycle");
+		this->scheduleLevels.clear();
+		return false;
+	}
+
+	this->skippedFilters.assign(filterCount, 0);
+	this->filterResults.assign(filterCount, 0);
+	this->runnableFilters.reserve(filterCount);
+
+	return true;
+}
+
+
+
+/**
+ * @brief Process the PipeWorkingDataSet.
+ *
+ * Will iterate over all filters and call their process() functions, which
+ * means the DataSet will be processed.
+ * Each filter will (should !) indicate either if the processing has been finished,
+ * or if (and which) a filter shall be invoked next, as long as their
+ * process function returns true.
+ * Otherwise, if a filter returns false, this means the current dataset couldn't
+ * be processed.
+ * Either way, in any case of failure, lastError will be set accordingly.
+ *
+ * In DAG scheduling mode, the filters run as described in
+ * processCurrentDataSetByDAG() instead.
+ * The duration of every call is recorded (see getDataSetLatency()), as
+ * well as when each filter ran (see getLastDataSetTimings()). Memory the
+ * filters allocate is charged to the account of the pipe (see
+ * getMemoryAccount()).
+ *
+ * @return bool true if all filters return true in their process()
+ * functions AND either indicate which filter to invoke next or that the
+ * processing is finished, false otherwise.
+ */
+bool FilterManagementLibrary::PipeSystem::ProcessingPipeline::
+	processCurrentDataSet()
+{
+	const int64_t startTimeUs = Utilities::getTimeUs();
+
+	MemoryAccountScope memoryAccountScope(&this->memoryAccount);
+
+	std::fill(this->dataSetTimings.begin(), this->dataSetTimings.end(),
+			PipeFilterTiming());
+
+	bool success;
+
+	if(this->schedulingMode == SchedulingMode::SCHEDULING_DAG &&
+			this->isSetUp)
+	{
+		success = this->processCurrentDataSetByDAG();
+	}
+	else
+		success = this->processCurrentDataSetDynamically();
+
+	this->dataSetLatency.record(Utilities::getTimeUs() - startTimeUs);
+
+	return success;
+}
+
+/**
+ * @brief Processes the PipeWorkingDataSet in SCHEDULING_DYNAMIC mode,
+ * see processCurrentDataSet().
+ */
+bool FilterManagementLibrary::PipeSystem::ProcessingPipeline::
+	processCurrentDataSetDynamically()
+{
+	this->processingFinishied = false;
+	PipeFilter* currentFilter;
+
+	// First filter is always ID 0!
+	currentFilter = this->registeredFilters[0];
+
+	bool success = false;
+
+	success = this->invokeFilter(currentFilter);
+
+	if(success)
+	{
+		if(currentFilter->hasMarkedProcessingFinished())
+		{
+			//FilterManagementLibrary::Logger::
+			//				printfln("Filter %d indicated working data "
+			//						"has been fully processed successfully!",
+			//						this->currentFilterID);
+			return true;
+		}
+	}
+	else
+		return false;
+
+
+	while(!this->processingFinishied &&
+			currentFilter->hasMarkedNextDesiredFilter())
+	{
+		// Check if the ID of the next desired Filter
+		// is within the range of our List of registered Filters
+		if(currentFilter->getNextDesiredFilter() <
+				this->registeredFilters.size() &&
+				currentFilter->getNextDesiredFilter() > 0)
+		{
+			this->currentFilterID = currentFilter->getNextDesiredFilter();
+			currentFilter = this->registeredFilters[this->currentFilterID];
+
+			//FilterManagementLibrary::Logger::
+			//	printfln("Invoking Filter %d", this->currentFilterID);
+
+			if(this->invokeFilter(currentFilter))
+			{
+				//FilterManagementLibrary::Logger::
+				//	printfln("Filter %d successfully finished it's operations",
+				//		this->currentFilterID);
+			}
+			else
+			{
+				FilterManagementLibrary::Logger::
+					printfln("Processing failed: Filter %d indicated failure",
+							this->currentFilterID);
+				this->lastError = ProcessingPipeline::ErrorType::
+						ERROR_FILTER_INDICATED_FAILURE;
+				return false;
+			}
+
+			this->processingFinishied =
+					currentFilter->hasMarkedProcessingFinished();
+		}
+		else
+		{
+			FilterManagementLibrary::Logger::
+					printfln("Filter %d wanted to invoke Filter %d\
+							 althoguh this ID is not assigned.",
+									this->currentFilterID,
+									currentFilter->getNextDesiredFilter());
+			this->lastError = ProcessingPipeline::ErrorType::
+										ERROR_FILTER_INDICATED_FAILURE;
+			return false;
+		}
+	}
+
+	if(!this->processingFinishied &&
+			!currentFilter->hasMarkedNextDesiredFilter())
+	{
+		// currentFilter successfully finished it's calculations,
+		// but did neither indicated a next filter nor that the
+		// workingDataSet is fully processed.
+		// Has to be a logic error !
+
+		FilterManagementLibrary::Logger::
+			printfln("Logic fault, Filter %d finished it's operations\
+					but neither indicated it the workingDataSet is \
+					fully processed, nor which Filter shall\
+					be invoked next", this->currentFilterID);
+		this->lastError = ProcessingPipeline::ErrorType::ERROR_LOGIC_FAULT;
+		return false;
+	}
+	else
+	{
+		// Processing has to be finished successfully!
+		//FilterManagementLibrary::Logger::
+		//	printfln("Filter %d indicated working data\
+		//			has been fully processed successfully!",
+		//			this->currentFilterID);
+		return true;
+	}
+}
+
+
+/**
+ * @brief Processes the PipeWorkingDataSet following the static schedule.
+ *
+ * Runs the levels built by buildSchedule() one after another. The filters
+ * of a level run concurrently on the worker pool. If a filter indicates
+ * that the processing is finished, all filters depending on it (directly
+ * or indirectly) are skipped for this data set, other branches still run.
+ * Which filter a filter wants to invoke next is ignored.
+ *
+ * @return bool true if all filters which ran returned true in their
+ * process() functions, false otherwise.
+ */
+bool FilterManagementLibrary::PipeSystem::ProcessingPipeline::
+		processCurrentDataSetByDAG()
+{
+	std::fill(this->skippedFilters.begin(), this->skippedFilters.end(), 0);
+
+	const std::function<void(int, int)> runFilter =
+			[this](int index, int workerIndex)
+	{
+		const int filterID = this->runnableFilters[index];
+		this->filterResults[filterID] =
+				this->invokeFilter(this->registeredFilters[filterID]);
+	};
+
+	for(const std::vector<int>& level : this->scheduleLevels)
+	{
+		this->runnableFilters.clear();
+
+		for(int filterID : level)
+		{
+			if(this->skippedFilters[filterID])
+			{
+				for(int dependent : this->filterDependents[filterID])
+				{
+					this->skippedFilters[dependent] = 1;
+				}
+			}
+			else
+				this->runnableFilters.push_back(filterID);
+		}
+
+		this->workerPool.run(this->runnableFilters.size(), runFilter);
+
+		for(int filterID : this->runnableFilters)
+		{
+			if(!this->filterResults[filterID])
+			{
+				FilterManagementLibrary::Logger::
+					printfln("Processing failed: Filter %d indicated failure",
+							filterID);
+				this->lastError = ProcessingPipeline::ErrorType::
+						ERROR_FILTER_INDICATED_FAILURE;
+				return false;
+			}
+
+			if(this->registeredFilters[filterID]->
+					hasMarkedProcessingFinished())
+			{
+				for(int dependent : this->filterDependents[filterID])
+				{
+					this->skippedFilters[dependent] = 1;
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+/**
+ * @brief Invokes a single filter on the current data set.
+ *
+ * Resets the filter and calls its process() function, unless the filter
+ * declares that its input is empty (PipeFilter::isInputEmpty()): then
+ * only onInputEmpty() is called, which hands over to the next filter
+ * without doing any work. Both cases are counted in filterStatistics
+ * and dataSetTimings. If enabled, process() is measured with the
+ * hardware counters, too.
+ *
+ * @param PipeFilter* filter the filter to invoke
+ *
+ * @return bool false if process() returned false, true otherwise
+ */
+bool FilterManagementLibrary::PipeSystem::ProcessingPipeline::invokeFilter(
+		PipeFilter* filter)
+{
+	PipeFilterStatistics* statistics =
+			&this->filterStatistics[filter->getFilterID()];
+	PipeFilterTiming* timing = &this->dataSetTimings[filter->getFilterID()];
+
+	// Mandatory!
+	filter->reset();
+	statistics->invocations++;
+
+	if(filter->isInputEmpty())
+	{
+		statistics->skips++;
+		filter->onInputEmpty();
+		timing->startTimeUs = timing->endTimeUs = Utilities::getTimeUs();
+		return true;
+	}
+
+	PerformanceCounterReading counterStart;
+	if(this->performanceCountersEnabled)
+	{
+		filter->sectionCounters = &statistics->sectionCounters;
+		PerformanceCounters::read(&counterStart);
+	}
+	else
+		filter->sectionCounters = nullptr;
+
+	timing->startTimeUs = Utilities::getTimeUs();
+	const bool success = filter->process();
+	timing->endTimeUs = Utilities::getTimeUs();
+
+	if(this->performanceCountersEnabled)
+	{
+		PerformanceCounters::accumulate(counterStart,
+				&statistics->processCounters);
+	}
+
+	statistics->processingTime.record(timing->endTimeUs -
+			timing->startTimeUs);
+
+	return success;
+}
+
+/**
+ * @brief Returns the counters of all registered filters.
+ *
+ * @return const std::vector<PipeFilterStatistics>* pointer to the
+ * counters, indexed by filter ID
+ */
+const std::vector<FilterManagementLibrary::PipeSystem::PipeFilterStatistics>*
+		FilterManagementLibrary::PipeSystem::ProcessingPipeline::
+		getFilterStatistics() const
+{
+	return &this->filterStatistics;
+}
+
+/**
+ * @brief Returns the durations of all processCurrentDataSet() calls
+ * (successful or not) since the pipe was created or the statistics were
+ * reset.
+ *
+ * @return const LatencyHistogram* pointer to the histogram
+ */
+const FilterManagementLibrary::LatencyHistogram*
+		FilterManagementLibrary::PipeSystem::ProcessingPipeline::
+		getDataSetLatency() const
+{
+	return &this->dataSetLatency;
+}
+
+/**
+ * @brief Returns when the registered filters ran on the last data set.
+ *
+ * Only valid until the next data set is processed. In DAG scheduling mode
+ * the intervals of the filters of a level overlap.
+ *
+ * @return const std::vector<PipeFilterTiming>* pointer to the times,
+ * indexed by filter ID
+ */
+const std::vector<FilterManagementLibrary::PipeSystem::PipeFilterTiming>*
+		FilterManagementLibrary::PipeSystem::ProcessingPipeline::
+		getLastDataSetTimings() const
+{
+	return &this->dataSetTimings;
+}
+
+/**
+ * @brief Resets the counters and histograms of all registered filters
+ * and the data set latency histogram.
+ *
+ * @return void
+ */
+void FilterManagementLibrary::PipeSystem::ProcessingPipeline::
+		resetFilterStatistics()
+{
+	for(PipeFilterStatistics& statistics : this->filterStatistics)
+	{
+		statistics = PipeFilterStatistics();
+	}
+
+	this->dataSetLatency.reset();
+}
+
+/**
+ * @brief Enables measuring the filters with hardware counters (cycles,
+ * instructions, cache and branch misses), see PerformanceCounters.
+ *
+ * The counts are added to PipeFilterStatistics::processCounters and
+ * sectionCounters of each filter. Reading the counters costs a few
+ * microseconds per filter invocation, so they are disabled by default.
+ * May not be called while a data set is processed.
+ *
+ * @param bool enabled whether to measure the filters
+ *
+ * @return bool true on success, false if the counters are not available
+ * (on the calling thread; they stay disabled then)
+ */
+bool FilterManagementLibrary::PipeSystem::ProcessingPipeline::
+		setPerformanceCountersEnabled(bool enabled)
+{
+	this->performanceCountersEnabled = enabled &&
+			PerformanceCounters::isAvailable();
+
+	return this->performanceCountersEnabled == enabled;
+}
+
+/**
+ * @brief Returns whether the filters are measured with hardware counters,
+ * see setPerformanceCountersEnabled(...).
+ */
+bool FilterManagementLibrary::PipeSystem::ProcessingPipeline::
+		arePerformanceCountersEnabled() const
+{
+	return this->performanceCountersEnabled;
+}
+
+/**
+ * @brief Returns the account the memory allocated while processing data
+ * sets is charged to, i.e. the buffers of the working data set.
+ *
+ * Accounts of components of the pipe (like the models of its filters)
+ * can be added as children (see MemoryAccount::setParent(...)), so the
+ * account covers the whole pipe.
+ *
+ * @return MemoryAccount* pointer to the account
+ */
+FilterManagementLibrary::MemoryAccount*
+		FilterManagementLibrary::PipeSystem::ProcessingPipeline::
+		getMemoryAccount()
+{
+	return &this->memoryAccount;
+}
+
+/**
+ * @brief Returns an (enum) ID of the last error that happened.
+ *
+ * @return ProcessingPipeline::ErrorType the enum value of the last error
+ * that happened.
+ */
+FilterManagementLibrary::PipeSystem::ProcessingPipeline::ErrorType
+	FilterManagementLibrary::PipeSystem::ProcessingPipeline::getLastError() const
+{
+	return this->lastError;
+}
+
+/**
+ * @brief Destructor of ProcessingPipeline.
+ *
+ * If manageExternalAllocatedRessources was set to true in constructor,
+ * all variables on the heap (PipeWorkingDataSet, PipeRegisteredFilters,
+ * the filters itselves) will be deleted.
+ * Otherwise the destructor does do nothing.
+ *
+ * @return ProcessingPipeline::ErrorType the enum value of the last error
+ * that happened.
+ */
+FilterManagementLibrary::PipeSystem::ProcessingPipeline::~ProcessingPipeline()
+{
+	if(this->manageExternalAllocatedRessources)
+	{
+		for(PipeFilter* filter : this->registeredFilters)
+		{
+			delete filter;
+		}
+		delete this->workingDataSet;
+		delete this->pipeRegisteredFiltersHeader;
+	}
+}
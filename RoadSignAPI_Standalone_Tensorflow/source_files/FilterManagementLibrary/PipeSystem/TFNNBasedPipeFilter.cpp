@@ -1,288 +1,794 @@
-/*
- * TFNNBasedPipeFilter.cpp
- *
- *  Created on: 03.06.2018
- *      Author: Patrick Langer
- */
-
-
-#include "FilterManagementLibrary/PipeSystem/TFNNBasedPipeFilter.h"
-#include "FilterManagementLibrary/Logger.h"
-
-
-/**
- * @brief Standard constructor of TFNNBasedPipeFilter
- *
- * The TFNNBasedPipeFilter will use a TensorflowNNInstance to load and instantiate
- * Tensorflow model (and a corresponding session). For this, it needs
- * to tell the TensorflowNNInstance a description of a model to use
- * (TensorflowNNModelDescription) and how many threads Tensorflow is allowed
- * to use for computation.
- *
- * @param TensorflowNNModelDescription nnModelDescription a description of
- * the Tensorflow model which will be used by the filter.
- *
- * @param int numThreads number of threads Tensorflow is allowed to use
- * for computation.
- */
-FilterManagementLibrary::PipeSystem::TFNNBasedPipeFilter::TFNNBasedPipeFilter(
-		TFIntegration::TensorflowNNModelDescription nnModelDescription,
-		int numThreads) : tfNNInstance(nnModelDescription, numThreads)
-{
-
-}
-
-
-/**
- * @brief Applies an image vector to the TensorflowNNInstance
- *
- * This takes a 3D uint8_t vector and will call the TensorflowNNInstance's
- * applyImageInputVector(...)function accordingly, which will set the data on
- * the input Tensor of the model. It originally was intended to be used
- * for 3 Channel RGB images, as the TensorflowNNInstance's function
- * may scale the input as needed (i.e. normalization using floats and
- * a mean and std value).
- *
- * @param uint8_t*** image 3D array of uint8_t values which will be
- * applied to the model
- *
- * @param int height height of the image (columns of the vector)
- * @param int width width of the image (rows of the vector)
- * @param int channels channels of the image (depth of the vector)
- *
- * @return bool true if the vector was successfully applied to the model,
- * false otherwise
- */
-bool FilterManagementLibrary::PipeSystem::
-	TFNNBasedPipeFilter::applyNNImageInputVector(uint8_t*** image,
-				const int height, const int width,
-				const int channels)
-{
-	return this->tfNNInstance.
-			applyImageInputVector(image,height, width, channels);
-}
-
-/**
- * @brief Let's the neuronal network evaluate the given input.
- *
- * An input vector should have been applied to the neuronal network
- * (the TensorflowNNInstance) beforehand, by any means.
- * This will call the TensorflowNNInstance's runInference() function
- * accordingly and will call the onNNEvaluationFinished() callback function
- * on success (synchronously).
- *
- * @return bool true if the inference (TensorflowNNInstance) was successfull,
- * false otherwise.
- */
-bool FilterManagementLibrary::PipeSystem::
-	TFNNBasedPipeFilter::evaluateInputVectorByNN()
-{
-	if(this->tfNNInstance.runInference())
-		{
-			//FilterManagementLibrary::Logger::printfln("Inference success\n");
-			this->onNNEvaluationFinished(this->tfNNInstance.getResultContainer());
-			return true;
-		}
-		else
-		{
-			FilterManagementLibrary::Logger::printfln("Inference failed\n");
-			return false;
-		}
-}
-
-/**
- * @brief Returns the input tensor of the underlaying neuronal network.
- *
- * As we want to hide the object of TensorflowNNInstance from a
- * derived filter, we provide this function to directly access the input tensor
- * of the underlaying tensorflow neuronal network.
- *
- * @return tensorflow::Tensor* pointer to the input tensor
- */
-tensorflow::Tensor* FilterManagementLibrary::PipeSystem::
-						TFNNBasedPipeFilter::getNNInputTensor()
-{
-	return this->tfNNInstance.getInputTensor();
-}
-
-
-/**
- * @brief Returns the model description of the underlaying neuronal network.
- *
- * As we want to hide the object of TensorflowNNInstance from a
- * derived filter, we provide this function to a const pointer
- * to the model description of the underlaying neuronal network.
- *
- * @return FilterManagementLibrary::TFIntegration::TensorflowNNModelDescription*
- * pointer to the model description.
- */
-const FilterManagementLibrary::TFIntegration::
-				TensorflowNNModelDescription*
-				FilterManagementLibrary::
-				PipeSystem::TFNNBasedPipeFilter::getNNModelDescription() const
-{
-	return this->tfNNInstance.getModelDescription();
-}
-
-/**
- * @brief Set's up the Tensorflow model of the TensorflowNNInstance.
- *
- * This will call TensorflowNNInstance's setupModelFromFile() function
- * accordingly, which will try to load and build the Tensorflow model
- * from the given TensorflowNNModelDescription (passed to constructor)
- *
- * @return bool true if network model was setup successfully, false otherwise
- */
-bool FilterManagementLibrary::PipeSystem::
-	TFNNBasedPipeFilter::setupModelFromFile()
-{
-
-	if(this->tfNNInstance.setupModelFromFile())
-	{
-		return true;
-	}
-	else
-	{
-
-		switch(this->tfNNInstance.getLastError())
-		{
-			case FilterManagementLibrary::TFIntegration::
-				TensorflowNNInstance::ErrorType::ERROR_INVALID_MODEL_FILE:
-			{
-				Logger::printfln("Setting up model failed:\
-						 Model file not found");
-			}
-			break;
-			case FilterManagementLibrary::TFIntegration::
-				TensorflowNNInstance::ErrorType::ERROR_COULD_NOT_LOAD_MODEL:
-			{
-				Logger::printfln("Setting up model failed: Model could not be\
-						 loaded (invalid format or missing permissions");
-
-			}
-			break;
-			case FilterManagementLibrary::TFIntegration::TensorflowNNInstance::
-				ErrorType::ERROR_COULD_NOT_ADD_GRAPH_TO_SESSION:
-			{
-				Logger::printfln("Setting up model failed: \
-										Could not add graph to session");
-			}
-			break;
-			case FilterManagementLibrary::TFIntegration::TensorflowNNInstance::
-				ErrorType::ERROR_FAILED_TO_CONSTRUCT_NEW_SESSION:
-			{
-				Logger::printfln("Setting up model failed: \
-										Failed to add graph to session.");
-			}
-			break;
-		}
-		return false;
-	}
-}
-
-#ifdef __ANDROID__
-/**
- * @brief Set's up the Tensorflow model of the TensorflowNNInstance.
- *
- * CAUTION: THIS FUNCTION IS ONLY AVAILABLE UNDER ANDROID ENVIRONMENTS!
- * This will call TensorflowNNInstance's setupModelFromAssets() function
- * accordingly, which will try to load and build the Tensorflow model
- * from the given TensorflowNNModelDescription (passed to constructor).
- * In contrast to setupModelFromFile(), the modelFile given in the
- * {@link TensorflowNNModelDescription} will be threated as an android
- * assets file and loaded via an AssetsManager which needs to be passed
- * to this function.
- *
- * @param const AAssetManager* assetManager Pointer to an AssetManager which,
- * by any means, needs to to be passed from the Java side of the code.
- *
- * @return bool true if network model was setup successfully, false otherwise
- */
-bool FilterManagementLibrary::PipeSystem::
-	TFNNBasedPipeFilter::setupModelFromAssets(
-			AAssetManager* const assetManager)
-{
-
-	if(this->tfNNInstance.setupModelFromAssets(assetManager))
-	{
-		return true;
-	}
-	else
-	{
-
-		switch(this->tfNNInstance.getLastError())
-		{
-			case FilterManagementLibrary::TFIntegration::
-				TensorflowNNInstance::ErrorType::ERROR_INVALID_MODEL_FILE:
-			{
-				Logger::printfln("Setting up model failed:\
-						 Model file not found");
-			}
-			break;
-			case FilterManagementLibrary::TFIntegration::
-				TensorflowNNInstance::ErrorType::ERROR_COULD_NOT_LOAD_MODEL:
-			{
-				Logger::printfln("Setting up model failed: Model could not be\
-						 loaded (invalid format or missing permissions");
-
-			}
-			break;
-			case FilterManagementLibrary::TFIntegration::TensorflowNNInstance::
-				ErrorType::ERROR_COULD_NOT_ADD_GRAPH_TO_SESSION:
-			{
-				Logger::printfln("Setting up model failed: \
-										Could not add graph to session");
-			}
-			break;
-			case FilterManagementLibrary::TFIntegration::TensorflowNNInstance::
-				ErrorType::ERROR_FAILED_TO_CONSTRUCT_NEW_SESSION:
-			{
-				Logger::printfln("Setting up model failed: \
-										Failed to add graph to session.");
-			}
-			break;
-		}
-		return false;
-	}
-}
-#endif
-
-/**
- * @brief Allows to change ONLY the model file path set in the model description.
- *
- * Can be used to adjust the path of the model file of the
- * TensorflowNNModelDescription at run-time.
- * TensorflowNNInstance's adjustModelFile(...) function will
- * be called accordingly.
- *
- * @param std::string new path to the modelFile to use.
- * @return void
- */
-void FilterManagementLibrary::PipeSystem::
-	TFNNBasedPipeFilter::adjustModelFile(std::string modelFile)
-{
-	this->tfNNInstance.adjustModelFile(modelFile);
-}
-
-/**
- * @brief Returns the last error that happened concerning the neuronal instance
- *
- * @return TensorflowNNInstance::ErrorType the enum value of the last error
- * that happened concering the TensorflowNNInstance
- */
-FilterManagementLibrary::TFIntegration::TensorflowNNInstance::ErrorType
-		FilterManagementLibrary::PipeSystem::TFNNBasedPipeFilter::
-		getNeuralNetLastError() const
-{
-	return this->tfNNInstance.getLastError();
-}
-
-/**
- * @brief Destructor of TFNNBasedPipeFilter. Does nothing by now.
- */
-FilterManagementLibrary::PipeSystem::
-			TFNNBasedPipeFilter::~TFNNBasedPipeFilter()
-{
-
-}
-
+/*
+ * TFNNBasedPipeFilter.cpp
+ *
+ *  Created on: 03.06.2018
+ *      Author: Patrick Langer
+ */
+
+
+#include "FilterManagementLibrary/PipeSystem/TFNNBasedPipeFilter.h"
+#include "FilterManagementLibrary/Logger.h"
+#include "FilterManagementLibrary/Utilities.h"
+
+#include <system_error>
+
+
+/**
+ * @brief Standard constructor of TFNNBasedPipeFilter
+ *
+ * The TFNNBasedPipeFilter will use a TensorflowNNInstance to load and instantiate
+ * Tensorflow model (and a corresponding session). For this, it needs
+ * to tell the TensorflowNNInstance a description of a model to use
+ * (TensorflowNNModelDescription) and how many threads Tensorflow is allowed
+ * to use for computation.
+ *
+ * @param TensorflowNNModelDescription nnModelDescription a description of
+ * the Tensorflow model which will be used by the filter.
+ *
+ * @param int numThreads number of threads Tensorflow is allowed to use
+ * for computation.
+ */
+FilterManagementLibrary::PipeSystem::TFNNBasedPipeFilter::TFNNBasedPipeFilter(
+		TFIntegration::TensorflowNNModelDescription nnModelDescription,
+		int numThreads) : memoryAccount(nnModelDescription.modelFile),
+		numThreads(numThreads),
+		modelSwapState(ModelSwapState::MODEL_SWAP_NONE)
+{
+	this->addModelVariant(nnModelDescription);
+}
+
+/**
+ * @brief Returns the instance of the currently selected model variant.
+ */
+FilterManagementLibrary::TFIntegration::TensorflowNNInstance*
+		FilterManagementLibrary::PipeSystem::TFNNBasedPipeFilter::
+		getActiveNNInstance() const
+{
+	return this->tfNNInstances[this->activeModelVariant].get();
+}
+
+
+/**
+ * @brief Applies an image vector to the TensorflowNNInstance
+ *
+ * This takes a 3D uint8_t vector and will call the TensorflowNNInstance's
+ * applyImageInputVector(...)function accordingly, which will set the data on
+ * the input Tensor of the model. It originally was intended to be used
+ * for 3 Channel RGB images, as the TensorflowNNInstance's function
+ * may scale the input as needed (i.e. normalization using floats and
+ * a mean and std value).
+ *
+ * @param uint8_t*** image 3D array of uint8_t values which will be
+ * applied to the model
+ *
+ * @param int height height of the image (columns of the vector)
+ * @param int width width of the image (rows of the vector)
+ * @param int channels channels of the image (depth of the vector)
+ *
+ * @return bool true if the vector was successfully applied to the model,
+ * false otherwise
+ */
+bool FilterManagementLibrary::PipeSystem::
+	TFNNBasedPipeFilter::applyNNImageInputVector(uint8_t*** image,
+				const int height, const int width,
+				const int channels)
+{
+	return this->getActiveNNInstance()->
+			applyImageInputVector(image,height, width, channels);
+}
+
+/**
+ * @brief Let's the neuronal network evaluate the given input.
+ *
+ * An input vector should have been applied to the neuronal network
+ * (the TensorflowNNInstance) beforehand, by any means.
+ * This will call the TensorflowNNInstance's runInference() function
+ * accordingly and will call the onNNEvaluationFinished() callback function
+ * on success (synchronously).
+ * If outputs are replayed (see setOutputReplay(...)), the outputs recorded
+ * for the current input are passed to onNNEvaluationFinished() instead of
+ * running the model. If they are recorded (see setOutputRecorder(...)),
+ * the outputs are written to the recording after the inference.
+ * The inference is measured as counted section (see
+ * PipeFilter::beginCountedSection()), memory it allocates on the calling
+ * thread is charged to the account of the model (see getMemoryAccount()).
+ *
+ * @return bool true if the inference (TensorflowNNInstance) was successfull,
+ * false otherwise (also if no outputs were recorded for the input).
+ */
+bool FilterManagementLibrary::PipeSystem::
+	TFNNBasedPipeFilter::evaluateInputVectorByNN()
+{
+	TFIntegration::TensorflowNNInstance* tfNNInstance =
+			this->getActiveNNInstance();
+
+	if(this->outputRecording != NULL)
+	{
+		const uint64_t inputHash = this->getInputHash();
+
+		if(!this->outputRecording->findRecord(inputHash,
+				&this->replayedOutputTensors))
+		{
+			Logger::printfln("No recorded outputs for input %016llx",
+					(unsigned long long) inputHash);
+			return false;
+		}
+
+		this->inferenceCount++;
+		this->onNNEvaluationFinished(TFIntegration::TensorflowResultContainer(
+				&this->replayedOutputTensors,
+				tfNNInstance->getModelDescription()->outputLayerNames));
+		return true;
+	}
+
+	bool inferenceSucceeded;
+	{
+		MemoryAccountScope memoryAccountScope(&this->memoryAccount);
+
+		this->beginCountedSection();
+		inferenceSucceeded = tfNNInstance->runInference();
+		this->endCountedSection();
+	}
+
+	if(inferenceSucceeded)
+		{
+			//FilterManagementLibrary::Logger::printfln("Inference success\n");
+			if(this->outputRecorder != NULL &&
+					!this->outputRecorder->record(this->getInputHash(),
+							tfNNInstance->getResultContainer(),
+							tfNNInstance->getModelDescription()->
+							outputLayerNames.size()))
+			{
+				Logger::printfln("Recording the outputs failed");
+			}
+
+			this->inferenceCount++;
+			this->onNNEvaluationFinished(tfNNInstance->getResultContainer());
+			return true;
+		}
+		else
+		{
+			FilterManagementLibrary::Logger::printfln("Inference failed\n");
+			return false;
+		}
+}
+
+/**
+ * @brief Returns the input tensor of the underlaying neuronal network.
+ *
+ * As we want to hide the object of TensorflowNNInstance from a
+ * derived filter, we provide this function to directly access the input tensor
+ * of the underlaying tensorflow neuronal network.
+ *
+ * @return tensorflow::Tensor* pointer to the input tensor
+ */
+tensorflow::Tensor* FilterManagementLibrary::PipeSystem::
+						TFNNBasedPipeFilter::getNNInputTensor()
+{
+	return this->getActiveNNInstance()->getInputTensor();
+}
+
+
+/**
+ * @brief Returns the input quantization table of the underlaying neuronal network.
+ *
+ * Only valid if the underlaying model expects tensorflow::DT_INT8 input.
+ * See TensorflowNNInstance::getInputQuantizationTable() for a more
+ * detailed description.
+ *
+ * @return const int8_t* pointer to the 256 entries of the table.
+ */
+const int8_t* FilterManagementLibrary::PipeSystem::
+						TFNNBasedPipeFilter::getNNInputQuantizationTable() const
+{
+	return this->getActiveNNInstance()->getInputQuantizationTable();
+}
+
+/**
+ * @brief Returns the model description of the underlaying neuronal network.
+ *
+ * As we want to hide the object of TensorflowNNInstance from a
+ * derived filter, we provide this function to a const pointer
+ * to the model description of the underlaying neuronal network.
+ *
+ * @return FilterManagementLibrary::TFIntegration::TensorflowNNModelDescription*
+ * pointer to the model description.
+ */
+const FilterManagementLibrary::TFIntegration::
+				TensorflowNNModelDescription*
+				FilterManagementLibrary::
+				PipeSystem::TFNNBasedPipeFilter::getNNModelDescription() const
+{
+	return this->getActiveNNInstance()->getModelDescription();
+}
+
+/**
+ * @brief Logs why setting up a model failed.
+ *
+ * @param TensorflowNNInstance::ErrorType error the last error of the
+ * TensorflowNNInstance
+ */
+void FilterManagementLibrary::PipeSystem::TFNNBasedPipeFilter::logSetupError(
+		TFIntegration::TensorflowNNInstance::ErrorType error)
+{
+	switch(error)
+	{
+		case FilterManagementLibrary::TFIntegration::
+			TensorflowNNInstance::ErrorType::ERROR_INVALID_MODEL_FILE:
+		{
+			Logger::printfln("Setting up model failed:\
+					 Model file not found");
+		}
+		break;
+		case FilterManagementLibrary::TFIntegration::
+			TensorflowNNInstance::ErrorType::ERROR_COULD_NOT_LOAD_MODEL:
+		{
+			Logger::printfln("Setting up model failed: Model could not be\
+					 loaded (invalid format or missing permissions");
+
+		}
+		break;
+		case FilterManagementLibrary::TFIntegration::TensorflowNNInstance::
+			ErrorType::ERROR_COULD_NOT_ADD_GRAPH_TO_SESSION:
+		{
+			Logger::printfln("Setting up model failed: \
+									Could not add graph to session");
+		}
+		break;
+		case FilterManagementLibrary::TFIntegration::TensorflowNNInstance::
+			ErrorType::ERROR_FAILED_TO_CONSTRUCT_NEW_SESSION:
+		{
+			Logger::printfln("Setting up model failed: \
+									Failed to add graph to session.");
+		}
+		break;
+	}
+}
+
+/**
+ * @brief Set's up the Tensorflow models of the TensorflowNNInstances.
+ *
+ * This will call TensorflowNNInstance's setupModelFromFile() function
+ * accordingly for every model variant which is not set up yet, which will
+ * try to load and build the Tensorflow model from the given
+ * TensorflowNNModelDescription (passed to constructor or
+ * addModelVariant(...)).
+ *
+ * @return bool true if all network models were setup successfully,
+ * false otherwise
+ */
+bool FilterManagementLibrary::PipeSystem::
+	TFNNBasedPipeFilter::setupModelFromFile()
+{
+	// Replayed outputs do not need the models
+	if(this->outputRecording != NULL)
+	{
+		this->modelVariantLoaded.assign(this->tfNNInstances.size(), true);
+		return true;
+	}
+
+	MemoryAccountScope memoryAccountScope(&this->memoryAccount);
+
+	for(unsigned int i = 0; i < this->tfNNInstances.size(); i++)
+	{
+		if(this->modelVariantLoaded[i])
+			continue;
+
+		if(!this->tfNNInstances[i]->setupModelFromFile())
+		{
+			logSetupError(this->tfNNInstances[i]->getLastError());
+			return false;
+		}
+
+		this->modelVariantLoaded[i] = true;
+	}
+
+	return true;
+}
+
+#ifdef __ANDROID__
+/**
+ * @brief Set's up the Tensorflow models of the TensorflowNNInstances.
+ *
+ * CAUTION: THIS FUNCTION IS ONLY AVAILABLE UNDER ANDROID ENVIRONMENTS!
+ * This will call TensorflowNNInstance's setupModelFromAssets() function
+ * accordingly for every model variant which is not set up yet, which will
+ * try to load and build the Tensorflow model from the given
+ * TensorflowNNModelDescription (passed to constructor or
+ * addModelVariant(...)).
+ * In contrast to setupModelFromFile(), the modelFile given in the
+ * {@link TensorflowNNModelDescription} will be threated as an android
+ * assets file and loaded via an AssetsManager which needs to be passed
+ * to this function.
+ *
+ * @param const AAssetManager* assetManager Pointer to an AssetManager which,
+ * by any means, needs to to be passed from the Java side of the code.
+ *
+ * @return bool true if all network models were setup successfully,
+ * false otherwise
+ */
+bool FilterManagementLibrary::PipeSystem::
+	TFNNBasedPipeFilter::setupModelFromAssets(
+			AAssetManager* const assetManager)
+{
+	if(this->outputRecording != NULL)
+	{
+		this->modelVariantLoaded.assign(this->tfNNInstances.size(), true);
+		return true;
+	}
+
+	MemoryAccountScope memoryAccountScope(&this->memoryAccount);
+
+	for(unsigned int i = 0; i < this->tfNNInstances.size(); i++)
+	{
+		if(this->modelVariantLoaded[i])
+			continue;
+
+		if(!this->tfNNInstances[i]->setupModelFromAssets(assetManager))
+		{
+			logSetupError(this->tfNNInstances[i]->getLastError());
+			return false;
+		}
+
+		this->modelVariantLoaded[i] = true;
+	}
+
+	return true;
+}
+#endif
+
+/**
+ * @brief Allows to change ONLY the model file path set in the model description.
+ *
+ * Can be used to adjust the path of the model file of the
+ * TensorflowNNModelDescription at run-time.
+ * TensorflowNNInstance's adjustModelFile(...) function will
+ * be called accordingly.
+ *
+ * @param std::string new path to the modelFile to use.
+ * @return void
+ */
+void FilterManagementLibrary::PipeSystem::
+	TFNNBasedPipeFilter::adjustModelFile(std::string modelFile)
+{
+	this->getActiveNNInstance()->adjustModelFile(modelFile);
+}
+
+/**
+ * @brief Adds another variant of the model, i.e. with a different input
+ * size or quantized.
+ *
+ * The variant is set up by the next setupModelFromFile() /
+ * setupModelFromAssets(...) call, afterwards it can be selected using
+ * selectModelVariant(...). Should not be called while the pipe is
+ * processing a data set.
+ *
+ * @param TensorflowNNModelDescription nnModelDescription a description
+ * of the model variant, its outputs need to be the same as the ones of
+ * the other variants
+ *
+ * @return int index of the variant
+ */
+int FilterManagementLibrary::PipeSystem::TFNNBasedPipeFilter::addModelVariant(
+		TFIntegration::TensorflowNNModelDescription nnModelDescription)
+{
+	MemoryAccountScope memoryAccountScope(&this->memoryAccount);
+
+	this->tfNNInstances.push_back(
+			std::unique_ptr<TFIntegration::TensorflowNNInstance>(
+					new TFIntegration::TensorflowNNInstance(
+							nnModelDescription, this->numThreads)));
+	this->modelVariantLoaded.push_back(false);
+
+	return this->tfNNInstances.size() - 1;
+}
+
+/**
+ * @brief Selects the model variant used for the following inferences.
+ *
+ * Calls onModelVariantChanged() if the variant changes, so derived
+ * filters can adapt to it. Must not be called while the pipe is
+ * processing a data set.
+ *
+ * @param int modelVariant index returned by addModelVariant(...), 0 for
+ * the model passed to the constructor
+ *
+ * @return bool true on success, false if there is no such variant or it
+ * is not set up
+ */
+bool FilterManagementLibrary::PipeSystem::
+	TFNNBasedPipeFilter::selectModelVariant(int modelVariant)
+{
+	if(modelVariant < 0 || modelVariant >= (int) this->tfNNInstances.size() ||
+			!this->modelVariantLoaded[modelVariant])
+	{
+		Logger::printfln("Model variant %d is not available", modelVariant);
+		return false;
+	}
+
+	if(modelVariant != this->activeModelVariant)
+	{
+		this->activeModelVariant = modelVariant;
+		this->onModelVariantChanged();
+	}
+
+	return true;
+}
+
+/**
+ * @brief Returns the index of the selected model variant.
+ */
+int FilterManagementLibrary::PipeSystem::TFNNBasedPipeFilter::getModelVariant()
+		const
+{
+	return this->activeModelVariant;
+}
+
+/**
+ * @brief Returns the number of model variants (including the one passed
+ * to the constructor).
+ */
+int FilterManagementLibrary::PipeSystem::
+	TFNNBasedPipeFilter::getModelVariantCount() const
+{
+	return this->tfNNInstances.size();
+}
+
+/**
+ * @brief Called after selectModelVariant(...) switched to another model
+ * variant. Does nothing by default.
+ */
+void FilterManagementLibrary::PipeSystem::
+	TFNNBasedPipeFilter::onModelVariantChanged()
+{
+
+}
+
+/**
+ * @brief Replaces a model variant by a new model without stopping the pipe.
+ *
+ * The new model is loaded from file (see setupModelFromFile()) and warmed
+ * up (see TensorflowNNInstance::warmUp()) on a separate thread, while the
+ * previous model keeps being used. Once it is ready, the next
+ * applyPendingModelSwap() call swaps it in. Only one model can be
+ * replaced at a time.
+ *
+ * @param int modelVariant index of the variant to replace, 0 for the
+ * model passed to the constructor
+ *
+ * @param TensorflowNNModelDescription nnModelDescription a description of
+ * the new model, its outputs need to be the same as the ones of the
+ * model it replaces
+ *
+ * @return bool true if loading the model was started, false if there is
+ * no such variant, another model is still being replaced or the loading
+ * thread could not be created
+ */
+bool FilterManagementLibrary::PipeSystem::TFNNBasedPipeFilter::
+	replaceModelVariantFromFile(int modelVariant,
+			TFIntegration::TensorflowNNModelDescription nnModelDescription)
+{
+	return this->startModelLoader(modelVariant, nnModelDescription,
+			[](TFIntegration::TensorflowNNInstance* nnInstance)
+			{
+				return nnInstance->setupModelFromFile();
+			});
+}
+
+#ifdef __ANDROID__
+/**
+ * @brief Replaces a model variant by a new model from the Android assets
+ * without stopping the pipe.
+ *
+ * CAUTION: THIS FUNCTION IS ONLY AVAILABLE UNDER ANDROID ENVIRONMENTS!
+ * See replaceModelVariantFromFile(...), the new model is loaded like
+ * setupModelFromAssets(...) does.
+ *
+ * @param int modelVariant index of the variant to replace
+ *
+ * @param TensorflowNNModelDescription nnModelDescription a description of
+ * the new model
+ *
+ * @param const AAssetManager* assetManager needs to stay valid until the
+ * model is loaded
+ *
+ * @return bool true if loading the model was started, false otherwise
+ */
+bool FilterManagementLibrary::PipeSystem::TFNNBasedPipeFilter::
+	replaceModelVariantFromAssets(int modelVariant,
+			TFIntegration::TensorflowNNModelDescription nnModelDescription,
+			AAssetManager* const assetManager)
+{
+	return this->startModelLoader(modelVariant, nnModelDescription,
+			[assetManager](TFIntegration::TensorflowNNInstance* nnInstance)
+			{
+				return nnInstance->setupModelFromAssets(assetManager);
+			});
+}
+#endif
+
+/**
+ * @brief Starts the thread loading a new model for a model variant,
+ * see replaceModelVariantFromFile(...).
+ *
+ * @param int modelVariant index of the variant to replace
+ *
+ * @param TensorflowNNModelDescription nnModelDescription a description of
+ * the new model
+ *
+ * @param std::function setupModel sets up the model of the new instance
+ *
+ * @return bool true if the thread was started, false otherwise
+ */
+bool FilterManagementLibrary::PipeSystem::TFNNBasedPipeFilter::
+	startModelLoader(int modelVariant,
+			TFIntegration::TensorflowNNModelDescription nnModelDescription,
+			std::function<bool(TFIntegration::TensorflowNNInstance*)>
+			setupModel)
+{
+	if(modelVariant < 0 || modelVariant >= (int) this->tfNNInstances.size())
+	{
+		Logger::printfln("Model variant %d does not exist", modelVariant);
+		return false;
+	}
+
+	const ModelSwapState state = this->modelSwapState.load();
+	if(state == ModelSwapState::MODEL_SWAP_LOADING ||
+			state == ModelSwapState::MODEL_SWAP_READY)
+	{
+		Logger::printfln("Another model is still being replaced");
+		return false;
+	}
+
+	// The previous loading thread is done, at most it still closes the
+	// model it replaced
+	if(this->modelLoader.joinable())
+		this->modelLoader.join();
+
+	this->pendingModelVariant = modelVariant;
+	this->modelSwapState = ModelSwapState::MODEL_SWAP_LOADING;
+
+	MemoryAccountScope memoryAccountScope(&this->memoryAccount);
+
+	std::unique_ptr<TFIntegration::TensorflowNNInstance> nnInstance(
+			new TFIntegration::TensorflowNNInstance(
+					nnModelDescription, this->numThreads));
+
+	try
+	{
+		this->modelLoader = std::thread(&TFNNBasedPipeFilter::runModelLoader,
+				this, std::move(nnInstance), setupModel);
+	}
+	catch(const std::system_error& error)
+	{
+		Logger::printfln("Failed to create model loading thread: %s",
+				error.what());
+		this->modelSwapState = ModelSwapState::MODEL_SWAP_FAILED;
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Body of the model loading thread.
+ *
+ * Sets up and warms up the new model (charged to the account of the
+ * filter), hands it over to applyPendingModelSwap() and waits until it
+ * was swapped in. The model it replaced is no longer used by then (the
+ * swap happens between two data sets), so it is closed here instead of
+ * on the thread processing the data sets.
+ *
+ * @param std::unique_ptr<TensorflowNNInstance> nnInstance the new model
+ *
+ * @param std::function setupModel sets up the model of nnInstance
+ */
+void FilterManagementLibrary::PipeSystem::TFNNBasedPipeFilter::runModelLoader(
+		std::unique_ptr<TFIntegration::TensorflowNNInstance> nnInstance,
+		std::function<bool(TFIntegration::TensorflowNNInstance*)> setupModel)
+{
+	const int64_t startTimeUs = Utilities::getTimeUs();
+
+	MemoryAccountScope memoryAccountScope(&this->memoryAccount);
+
+	bool loaded = setupModel(nnInstance.get());
+
+	if(!loaded)
+		logSetupError(nnInstance->getLastError());
+	else if(!nnInstance->warmUp())
+	{
+		Logger::printfln("Replacing model failed: warm-up inference failed");
+		loaded = false;
+	}
+
+	std::unique_lock<std::mutex> lock(this->modelSwapMutex);
+
+	if(!loaded)
+	{
+		this->modelSwapState = ModelSwapState::MODEL_SWAP_FAILED;
+		return;
+	}
+
+	Logger::printfln("New model for variant %d loaded in %lld ms",
+			this->pendingModelVariant,
+			(long long) ((Utilities::getTimeUs() - startTimeUs) / 1000));
+
+	this->pendingNNInstance = std::move(nnInstance);
+	this->modelSwapState = ModelSwapState::MODEL_SWAP_READY;
+
+	this->modelSwapCondition.wait(lock, [this]
+			{
+				return this->retiredNNInstance || this->cancelModelSwap;
+			});
+
+	std::unique_ptr<TFIntegration::TensorflowNNInstance> retiredNNInstance =
+			std::move(this->retiredNNInstance);
+
+	lock.unlock();
+
+	// Closes the session of the replaced model
+	retiredNNInstance.reset();
+}
+
+/**
+ * @brief Swaps in the model loaded by replaceModelVariantFromFile(...),
+ * if it is ready.
+ *
+ * Has to be called between two data sets, as the model it replaces must
+ * not be in use anymore. Calls onModelVariantChanged() if the selected
+ * model variant was replaced, so derived filters can adapt to the new
+ * model. Cheap if there is nothing to swap, so it can be called for
+ * every data set.
+ *
+ * @return bool true if a model was swapped in, false otherwise
+ */
+bool FilterManagementLibrary::PipeSystem::
+	TFNNBasedPipeFilter::applyPendingModelSwap()
+{
+	if(this->modelSwapState.load() != ModelSwapState::MODEL_SWAP_READY)
+		return false;
+
+	int modelVariant;
+	{
+		std::lock_guard<std::mutex> lock(this->modelSwapMutex);
+
+		modelVariant = this->pendingModelVariant;
+
+		this->tfNNInstances[modelVariant].swap(this->pendingNNInstance);
+		this->retiredNNInstance = std::move(this->pendingNNInstance);
+		this->modelVariantLoaded[modelVariant] = true;
+		this->modelSwapState = ModelSwapState::MODEL_SWAP_DONE;
+	}
+	this->modelSwapCondition.notify_one();
+
+	Logger::printfln("Swapped in new model for variant %d", modelVariant);
+
+	if(modelVariant == this->activeModelVariant)
+		this->onModelVariantChanged();
+
+	return true;
+}
+
+/**
+ * @brief Returns the state of the lastly started model replacement, see
+ * replaceModelVariantFromFile(...).
+ */
+FilterManagementLibrary::PipeSystem::TFNNBasedPipeFilter::ModelSwapState
+		FilterManagementLibrary::PipeSystem::TFNNBasedPipeFilter::
+		getModelSwapState() const
+{
+	return this->modelSwapState.load();
+}
+
+/**
+ * @brief Returns the account the models of all variants are charged to.
+ *
+ * Covers the graphs and weights of the models and what the inferences
+ * allocate on the calling thread. Tensorflow allocates most intermediate
+ * results of an inference on its own threads, they are only charged to
+ * MemoryAccount::getTensorflowAccount().
+ *
+ * @return MemoryAccount* pointer to the account, named like the model
+ * file passed to the constructor
+ */
+FilterManagementLibrary::MemoryAccount*
+		FilterManagementLibrary::PipeSystem::TFNNBasedPipeFilter::
+		getMemoryAccount()
+{
+	return &this->memoryAccount;
+}
+
+/**
+ * @brief Returns the number of inferences (or replayed outputs) since
+ * the filter was created, i.e. to count the inferences of a frame.
+ */
+uint64_t FilterManagementLibrary::PipeSystem::TFNNBasedPipeFilter::
+		getInferenceCount() const
+{
+	return this->inferenceCount;
+}
+
+/**
+ * @brief Records the outputs of all following inferences.
+ *
+ * Must not be called while the pipe is processing a data set.
+ *
+ * @param TensorflowOutputRecorder* outputRecorder opened recorder, which
+ * needs to stay valid until it is unset again (NULL stops recording). May
+ * be shared with other filters using the same model.
+ */
+void FilterManagementLibrary::PipeSystem::TFNNBasedPipeFilter::
+		setOutputRecorder(TFIntegration::TensorflowOutputRecorder*
+				outputRecorder)
+{
+	this->outputRecorder = outputRecorder;
+}
+
+/**
+ * @brief Replays recorded outputs instead of running the model.
+ *
+ * If set before the models are set up (setupModelFromFile() /
+ * setupModelFromAssets(...)), the model files are not loaded at all.
+ * Must not be called while the pipe is processing a data set.
+ *
+ * @param const TensorflowOutputRecording* outputRecording opened
+ * recording, which needs to stay valid until it is unset again (NULL
+ * runs the model again, which needs to be set up then)
+ */
+void FilterManagementLibrary::PipeSystem::TFNNBasedPipeFilter::
+		setOutputReplay(const TFIntegration::TensorflowOutputRecording*
+				outputRecording)
+{
+	this->outputRecording = outputRecording;
+}
+
+/**
+ * @brief Identifies the current input of the selected model variant by
+ * the FNV-1a hash of its input tensor (and the index of the variant).
+ */
+uint64_t FilterManagementLibrary::PipeSystem::TFNNBasedPipeFilter::
+		getInputHash()
+{
+	const tensorflow::StringPiece inputData =
+			this->getActiveNNInstance()->getInputTensor()->tensor_data();
+
+	const uint64_t hash = Utilities::hashFNV1a(inputData.data(),
+			inputData.size());
+
+	return Utilities::hashFNV1a(&this->activeModelVariant,
+			sizeof(this->activeModelVariant), hash);
+}
+
+/**
+ * @brief Returns the last error that happened concerning the neuronal instance
+ * of the selected model variant.
+ *
+ * @return TensorflowNNInstance::ErrorType the enum value of the last error
+ * that happened concering the TensorflowNNInstance
+ */
+FilterManagementLibrary::TFIntegration::TensorflowNNInstance::ErrorType
+		FilterManagementLibrary::PipeSystem::TFNNBasedPipeFilter::
+		getNeuralNetLastError() const
+{
+	return this->getActiveNNInstance()->getLastError();
+}
+
+/**
+ * @brief Destructor of TFNNBasedPipeFilter.
+ *
+ * Waits for the model loading thread, if a model is being replaced. A new
+ * model which was not swapped in yet is discarded.
+ */
+FilterManagementLibrary::PipeSystem::
+			TFNNBasedPipeFilter::~TFNNBasedPipeFilter()
+{
+	{
+		std::lock_guard<std::mutex> lock(this->modelSwapMutex);
+		this->cancelModelSwap = true;
+	}
+	this->modelSwapCondition.notify_one();
+
+	if(this->modelLoader.joinable())
+		this->modelLoader.join();
+}
+
@@ -0,0 +1,577 @@
+/*
+ * SSDPostProcessing.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#include "FilterManagementLibrary/SSDPostProcessing.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <limits>
+
+/**
+ * @brief Computes the IoU of two boxes (ymin, xmin, ymax, xmax) with the
+ * same operations as the non maximum suppression of Tensorflow, so the
+ * same detections are suppressed.
+ */
+static inline float computeIoU(const float* a, float areaA, const float* b,
+		float areaB)
+{
+	const float intersectionYMin = std::max(a[0], b[0]);
+	const float intersectionXMin = std::max(a[1], b[1]);
+	const float intersectionYMax = std::min(a[2], b[2]);
+	const float intersectionXMax = std::min(a[3], b[3]);
+
+	const float intersectionArea =
+			std::max(intersectionYMax - intersectionYMin, 0.0f) *
+			std::max(intersectionXMax - intersectionXMin, 0.0f);
+
+	return intersectionArea / (areaA + areaB - intersectionArea);
+}
+
+/**
+ * @brief Returns the number of detections.
+ */
+int FilterManagementLibrary::SSDDetections::size() const
+{
+	return this->scores.size();
+}
+
+/**
+ * @brief Resizes all vectors to count detections.
+ *
+ * @param int count the new number of detections
+ */
+void FilterManagementLibrary::SSDDetections::resize(int count)
+{
+	this->yMin.resize(count);
+	this->xMin.resize(count);
+	this->yMax.resize(count);
+	this->xMax.resize(count);
+	this->scores.resize(count);
+	this->classIDs.resize(count);
+}
+
+/**
+ * @brief Collects the indices of all scores which exceed threshold in
+ * candidates.
+ *
+ * The scores are a matrix of rowCount x columnCount, the columns before
+ * firstColumn (i.e. the background class) are skipped. Instead of a
+ * branch per score, every index is written and the end of the list only
+ * advanced if the score exceeds the threshold.
+ *
+ * @param const float* scores row by row
+ *
+ * @param int rowCount number of rows (detections or anchors)
+ *
+ * @param int columnCount number of scores per row
+ *
+ * @param int firstColumn first column which is checked
+ *
+ * @param float threshold the score needs to exceed
+ *
+ * @return int number of candidates
+ */
+int FilterManagementLibrary::SSDPostProcessor::selectCandidates(
+		const float* scores, int rowCount, int columnCount, int firstColumn,
+		float threshold)
+{
+	this->candidates.resize(rowCount * (columnCount - firstColumn));
+	int* candidates = this->candidates.data();
+
+	int candidateCount = 0;
+	for(int row = 0; row < rowCount; row++)
+	{
+		const float* rowScores = scores + row * columnCount;
+
+		for(int column = firstColumn; column < columnCount; column++)
+		{
+			candidates[candidateCount] = row * columnCount + column;
+			candidateCount += rowScores[column] > threshold;
+		}
+	}
+
+	return candidateCount;
+}
+
+/**
+ * @brief Moves the maxDetections candidates with the highest scores to
+ * the front of rankedCandidates, sorted by descending score (ties in the
+ * order of their indices), and drops the others.
+ *
+ * Only the kept candidates are sorted completely, which is O(n log k).
+ *
+ * @param int maxDetections number of candidates to keep
+ */
+void FilterManagementLibrary::SSDPostProcessor::sortCandidates(
+		int maxDetections)
+{
+	const int keptCount = std::min<int>(std::max(maxDetections, 0),
+			this->rankedCandidates.size());
+
+	std::partial_sort(this->rankedCandidates.begin(),
+			this->rankedCandidates.begin() + keptCount,
+			this->rankedCandidates.end(),
+			[](const std::pair<float, int>& a, const std::pair<float, int>& b)
+			{
+				return a.first > b.first ||
+						(a.first == b.first && a.second < b.second);
+			});
+
+	this->rankedCandidates.resize(keptCount);
+}
+
+/**
+ * @brief Decodes the boxes of all rankedCandidates from the anchors,
+ * clips them to the image and drops the candidates whose clipped box is
+ * empty (like clip_to_window(...) of the object detection API does).
+ *
+ * candidateBoxes and candidateAreas are filled for the remaining
+ * candidates, which keep their order.
+ *
+ * @param const float* boxEncodings per anchor (ty, tx, th, tw)
+ *
+ * @param const float* anchors per anchor (ycenter, xcenter, height, width)
+ *
+ * @param int classCount number of classes, including the background
+ *
+ * @param const SSDPostProcessingParameters& parameters the scales of the
+ * box encodings are used
+ *
+ * @return int number of remaining candidates
+ */
+int FilterManagementLibrary::SSDPostProcessor::decodeCandidateBoxes(
+		const float* boxEncodings, const float* anchors, int classCount,
+		const SSDPostProcessingParameters& parameters)
+{
+	const int count = this->rankedCandidates.size();
+	this->candidateBoxes.resize(4 * count);
+	this->candidateAreas.resize(count);
+
+	float* boxes = this->candidateBoxes.data();
+	float* areas = this->candidateAreas.data();
+
+	int keptCount = 0;
+	for(int i = 0; i < count; i++)
+	{
+		const int anchor = this->rankedCandidates[i].second / classCount;
+		const float* encoding = boxEncodings + 4 * anchor;
+		const float* anchorBox = anchors + 4 * anchor;
+
+		const float yCenter = encoding[0] / parameters.yScale *
+				anchorBox[2] + anchorBox[0];
+		const float xCenter = encoding[1] / parameters.xScale *
+				anchorBox[3] + anchorBox[1];
+		const float halfHeight = 0.5f *
+				expf(encoding[2] / parameters.heightScale) * anchorBox[2];
+		const float halfWidth = 0.5f *
+				expf(encoding[3] / parameters.widthScale) * anchorBox[3];
+
+		float* box = boxes + 4 * keptCount;
+		box[0] = std::min(std::max(yCenter - halfHeight, 0.0f), 1.0f);
+		box[1] = std::min(std::max(xCenter - halfWidth, 0.0f), 1.0f);
+		box[2] = std::min(std::max(yCenter + halfHeight, 0.0f), 1.0f);
+		box[3] = std::min(std::max(xCenter + halfWidth, 0.0f), 1.0f);
+
+		areas[keptCount] = (box[2] - box[0]) * (box[3] - box[1]);
+		this->rankedCandidates[keptCount] = this->rankedCandidates[i];
+		keptCount += areas[keptCount] > 0.0f;
+	}
+
+	this->rankedCandidates.resize(keptCount);
+	return keptCount;
+}
+
+/**
+ * @brief Greedy non maximum suppression per class, fills keptCandidates.
+ *
+ * Expects rankedCandidates to be sorted by class, then by descending score
+ * (ties in the order of the anchors), with decoded boxes. A candidate is
+ * kept if its IoU with each candidate of the same class kept before does
+ * not exceed iouThreshold, until maxDetectionsPerClass are kept. This is
+ * what tf.image.non_max_suppression does per class in the postprocessing
+ * of the object detection API. Each candidate is only compared with the
+ * kept ones, of which there are at most maxDetectionsPerClass.
+ *
+ * @param int classCount number of classes, including the background
+ *
+ * @param const SSDPostProcessingParameters& parameters iouThreshold and
+ * maxDetectionsPerClass are used
+ */
+void FilterManagementLibrary::SSDPostProcessor::suppressNonMaximumCandidates(
+		int classCount, const SSDPostProcessingParameters& parameters)
+{
+	const int count = this->rankedCandidates.size();
+	const float* boxes = this->candidateBoxes.data();
+	const float* areas = this->candidateAreas.data();
+
+	this->keptCandidates.clear();
+
+	int classBegin = 0;
+	while(classBegin < count)
+	{
+		const int classID = this->rankedCandidates[classBegin].second %
+				classCount;
+
+		int classEnd = classBegin + 1;
+		while(classEnd < count &&
+				this->rankedCandidates[classEnd].second % classCount == classID)
+		{
+			classEnd++;
+		}
+
+		const int firstKept = this->keptCandidates.size();
+
+		for(int i = classBegin; i < classEnd &&
+				(int) this->keptCandidates.size() - firstKept <
+						parameters.maxDetectionsPerClass; i++)
+		{
+			bool suppressed = false;
+
+			for(int k = firstKept;
+					k < (int) this->keptCandidates.size() && !suppressed; k++)
+			{
+				const int kept = this->keptCandidates[k];
+				suppressed = computeIoU(boxes + 4 * i, areas[i],
+						boxes + 4 * kept, areas[kept]) >
+								parameters.iouThreshold;
+			}
+
+			if(!suppressed)
+				this->keptCandidates.push_back(i);
+		}
+
+		classBegin = classEnd;
+	}
+}
+
+/**
+ * @brief Selects the detections of a model which includes the
+ * postprocessing of the object detection API.
+ *
+ * The detections do not need to be sorted, the maxDetections ones with
+ * the highest scores above the threshold are returned.
+ *
+ * @param const float* boxes count boxes, each as normalized
+ * (ymin, xmin, ymax, xmax), i.e. detection_boxes
+ *
+ * @param const float* scores count scores, i.e. detection_scores
+ *
+ * @param const float* classes count class IDs (as float), i.e.
+ * detection_classes
+ *
+ * @param int count number of valid detections, i.e. num_detections
+ *
+ * @param const SSDPostProcessingParameters& parameters scoreThreshold and
+ * maxDetections are used
+ *
+ * @param SSDDetections* detections is overwritten with the selected
+ * detections
+ */
+void FilterManagementLibrary::SSDPostProcessor::decodeDetections(
+		const float* boxes, const float* scores, const float* classes,
+		int count, const SSDPostProcessingParameters& parameters,
+		SSDDetections* detections)
+{
+	const int candidateCount = this->selectCandidates(scores, count, 1, 0,
+			parameters.scoreThreshold);
+
+	this->rankedCandidates.resize(candidateCount);
+	for(int i = 0; i < candidateCount; i++)
+	{
+		const int index = this->candidates[i];
+		this->rankedCandidates[i] = std::make_pair(scores[index], index);
+	}
+
+	this->sortCandidates(parameters.maxDetections);
+
+	const int detectionCount = this->rankedCandidates.size();
+	detections->resize(detectionCount);
+
+	for(int i = 0; i < detectionCount; i++)
+	{
+		const int index = this->rankedCandidates[i].second;
+		const float* box = boxes + 4 * index;
+
+		detections->yMin[i] = box[0];
+		detections->xMin[i] = box[1];
+		detections->yMax[i] = box[2];
+		detections->xMax[i] = box[3];
+		detections->scores[i] = this->rankedCandidates[i].first;
+		detections->classIDs[i] = (int) classes[index];
+	}
+}
+
+/**
+ * @brief Decodes the raw outputs of an SSD model, so the postprocessing
+ * operations of the object detection API can be left out of the graph.
+ *
+ * The class predictions are thresholded before they are converted:
+ * the sigmoid is monotonic, so the logits are compared with the
+ * threshold converted to a logit, and only the candidates are converted
+ * (the softmax needs all classes of an anchor, so all of them are
+ * converted). Only the boxes of the candidates are decoded from the
+ * anchors and clipped to the image, then the non maximum suppression is
+ * done per class and the maxDetections detections with the highest
+ * scores are kept.
+ * The result is the same as the one of the postprocessing of the object
+ * detection API (batch_non_max_suppression with the same parameters),
+ * apart from rounding differences of the scores and boxes: an anchor may
+ * produce detections of several classes, and detections with equal
+ * scores are in the order of their classes, then of their anchors.
+ *
+ * @param const float* boxEncodings per anchor (ty, tx, th, tw), i.e.
+ * raw_outputs/box_encodings
+ *
+ * @param const float* classPredictions per anchor classCount predictions,
+ * the first one for the background, i.e. raw_outputs/class_predictions
+ *
+ * @param const float* anchors per anchor the normalized (ycenter,
+ * xcenter, height, width), see generateAnchors(...)
+ *
+ * @param int anchorCount number of anchors
+ *
+ * @param int classCount number of classes, including the background
+ *
+ * @param const SSDPostProcessingParameters& parameters
+ *
+ * @param SSDDetections* detections is overwritten with the decoded
+ * detections
+ */
+void FilterManagementLibrary::SSDPostProcessor::decodeRawOutputs(
+		const float* boxEncodings, const float* classPredictions,
+		const float* anchors, int anchorCount, int classCount,
+		const SSDPostProcessingParameters& parameters,
+		SSDDetections* detections)
+{
+	const float threshold = parameters.scoreThreshold;
+	const float* scores = classPredictions;
+	float candidateThreshold = threshold;
+
+	if(parameters.scoreConversion == SSD_SCORE_SIGMOID)
+	{
+		// Slightly below the exact logit, the converted scores are
+		// checked again below
+		if(threshold <= 0.0f)
+			candidateThreshold = -std::numeric_limits<float>::infinity();
+		else if(threshold >= 1.0f)
+			candidateThreshold = std::numeric_limits<float>::infinity();
+		else
+			candidateThreshold = logf(threshold / (1.0f - threshold)) - 1e-3f;
+	}
+	else if(parameters.scoreConversion == SSD_SCORE_SOFTMAX)
+	{
+		this->convertedScores.resize(anchorCount * classCount);
+		float* convertedScores = this->convertedScores.data();
+
+		for(int anchor = 0; anchor < anchorCount; anchor++)
+		{
+			const float* logits = classPredictions + anchor * classCount;
+			float* anchorScores = convertedScores + anchor * classCount;
+
+			const float maxLogit = *std::max_element(logits,
+					logits + classCount);
+
+			float sum = 0.0f;
+			for(int i = 0; i < classCount; i++)
+			{
+				anchorScores[i] = expf(logits[i] - maxLogit);
+				sum += anchorScores[i];
+			}
+
+			const float scale = 1.0f / sum;
+			for(int i = 0; i < classCount; i++)
+				anchorScores[i] *= scale;
+		}
+
+		scores = convertedScores;
+	}
+
+	const int candidateCount = this->selectCandidates(scores, anchorCount,
+			classCount, 1, candidateThreshold);
+
+	this->rankedCandidates.clear();
+	for(int i = 0; i < candidateCount; i++)
+	{
+		const int index = this->candidates[i];
+		float score = scores[index];
+
+		if(parameters.scoreConversion == SSD_SCORE_SIGMOID)
+		{
+			score = 1.0f / (1.0f + expf(-score));
+
+			if(!(score > threshold))
+				continue;
+		}
+
+		this->rankedCandidates.push_back(std::make_pair(score, index));
+	}
+
+	// By class, then like tf.image.non_max_suppression visits them
+	std::sort(this->rankedCandidates.begin(), this->rankedCandidates.end(),
+			[classCount](const std::pair<float, int>& a,
+					const std::pair<float, int>& b)
+			{
+				const int classA = a.second % classCount;
+				const int classB = b.second % classCount;
+
+				if(classA != classB)
+					return classA < classB;
+
+				return a.first > b.first ||
+						(a.first == b.first && a.second < b.second);
+			});
+
+	this->decodeCandidateBoxes(boxEncodings, anchors, classCount, parameters);
+	this->suppressNonMaximumCandidates(classCount, parameters);
+
+	const int detectionCount = std::min<int>(
+			std::max(parameters.maxDetections, 0),
+			this->keptCandidates.size());
+
+	// rankedCandidates are in the order of their classes, so detections
+	// with equal scores are ordered like top_k orders them in the object
+	// detection API
+	std::partial_sort(this->keptCandidates.begin(),
+			this->keptCandidates.begin() + detectionCount,
+			this->keptCandidates.end(),
+			[this](int a, int b)
+			{
+				const float scoreA = this->rankedCandidates[a].first;
+				const float scoreB = this->rankedCandidates[b].first;
+
+				return scoreA > scoreB || (scoreA == scoreB && a < b);
+			});
+
+	detections->resize(detectionCount);
+
+	for(int i = 0; i < detectionCount; i++)
+	{
+		const int candidate = this->keptCandidates[i];
+		const float* box = this->candidateBoxes.data() + 4 * candidate;
+
+		detections->yMin[i] = box[0];
+		detections->xMin[i] = box[1];
+		detections->yMax[i] = box[2];
+		detections->xMax[i] = box[3];
+		detections->scores[i] = this->rankedCandidates[candidate].first;
+		detections->classIDs[i] =
+				this->rankedCandidates[candidate].second % classCount;
+	}
+}
+
+/**
+ * @brief Generates the anchors of an SSD model like the
+ * MultipleGridAnchorGenerator of the object detection API does, so the
+ * anchors do not need to be an output of the model.
+ *
+ * The anchors are ordered like the box encodings of the model: feature
+ * map by feature map, on each one row by row, then column by column, then
+ * by the anchor specification (scale and aspect ratio). For our SSDLite
+ * model (300x300 input, feature maps of 19, 10, 5, 3, 2 and 1) these are
+ * 1917 anchors.
+ *
+ * @param const SSDAnchorParameters& parameters
+ *
+ * @param int inputWidth width of the model input
+ *
+ * @param int inputHeight height of the model input
+ *
+ * @param std::vector<float>* anchors is overwritten with the normalized
+ * (ycenter, xcenter, height, width) of every anchor
+ *
+ * @return int number of anchors
+ */
+int FilterManagementLibrary::SSDPostProcessor::generateAnchors(
+		const SSDAnchorParameters& parameters, int inputWidth,
+		int inputHeight, std::vector<float>* anchors)
+{
+	anchors->clear();
+
+	if(parameters.layerCount < 1 || parameters.firstLayerStride < 1 ||
+			inputWidth < 1 || inputHeight < 1)
+	{
+		return 0;
+	}
+
+	// Anchors of the same scale have the same size in pixels on
+	// non-square inputs
+	const float minimumSize = std::min(inputWidth, inputHeight);
+	const float baseHeight = minimumSize / inputHeight;
+	const float baseWidth = minimumSize / inputWidth;
+
+	std::vector<float> scales(parameters.layerCount + 1, 1.0f);
+	for(int layer = 0; layer < parameters.layerCount; layer++)
+	{
+		scales[layer] = parameters.minScale;
+
+		if(parameters.layerCount > 1)
+		{
+			scales[layer] += (parameters.maxScale - parameters.minScale) *
+					layer / (parameters.layerCount - 1);
+		}
+	}
+
+	// (height, width) of the anchors of a location
+	std::vector<std::pair<float, float> > anchorSizes;
+
+	for(int layer = 0; layer < parameters.layerCount; layer++)
+	{
+		std::vector<std::pair<float, float> > specifications;
+
+		if(layer == 0 && parameters.reduceBoxesInLowestLayer)
+		{
+			specifications.push_back(std::make_pair(0.1f, 1.0f));
+			specifications.push_back(std::make_pair(scales[0], 2.0f));
+			specifications.push_back(std::make_pair(scales[0], 0.5f));
+		}
+		else
+		{
+			for(float aspectRatio : parameters.aspectRatios)
+				specifications.push_back(std::make_pair(scales[layer],
+						aspectRatio));
+
+			if(parameters.interpolatedScaleAspectRatio > 0.0f)
+			{
+				specifications.push_back(std::make_pair(
+						sqrtf(scales[layer] * scales[layer + 1]),
+						parameters.interpolatedScaleAspectRatio));
+			}
+		}
+
+		anchorSizes.clear();
+		for(const std::pair<float, float>& specification : specifications)
+		{
+			const float ratioRoot = sqrtf(specification.second);
+			anchorSizes.push_back(std::make_pair(
+					specification.first / ratioRoot * baseHeight,
+					specification.first * ratioRoot * baseWidth));
+		}
+
+		const int stride = parameters.firstLayerStride << layer;
+		const int featureMapHeight = (inputHeight + stride - 1) / stride;
+		const int featureMapWidth = (inputWidth + stride - 1) / stride;
+		const float yStride = 1.0f / featureMapHeight;
+		const float xStride = 1.0f / featureMapWidth;
+
+		for(int y = 0; y < featureMapHeight; y++)
+		{
+			for(int x = 0; x < featureMapWidth; x++)
+			{
+				for(const std::pair<float, float>& anchorSize : anchorSizes)
+				{
+					anchors->push_back(y * yStride + 0.5f * yStride);
+					anchors->push_back(x * xStride + 0.5f * xStride);
+					anchors->push_back(anchorSize.first);
+					anchors->push_back(anchorSize.second);
+				}
+			}
+		}
+	}
+
+	return anchors->size() / 4;
+}
@@ -0,0 +1,417 @@
+/*
+ * SharedMemoryRing.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#include "FilterManagementLibrary/SharedMemoryRing.h"
+#include "FilterManagementLibrary/Logger.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+static const uint32_t SHARED_MEMORY_RING_MAGIC = 0x474e4952; // "RING"
+static const uint32_t SHARED_MEMORY_RING_VERSION = 1;
+
+// Slots start at a cache line boundary and are multiples of it, so the
+// writer and the reader never share cache lines between slots.
+static const uint32_t kCacheLineSize = 64;
+
+// The futex syscall works on plain 32 bit words in shared memory.
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+		"std::atomic<uint32_t> can not be used as futex word");
+static_assert(sizeof(FilterManagementLibrary::SharedMemoryRingHeader) <=
+		kCacheLineSize, "SharedMemoryRingHeader exceeds a cache line");
+
+/**
+ * @brief Constructor of SharedMemoryRing.
+ *
+ * The ring is not connected to any shared memory segment after
+ * construction, use create(...) or open(...).
+ */
+FilterManagementLibrary::SharedMemoryRing::SharedMemoryRing() :
+		header(NULL), slots(NULL), mappedSize(0), owner(false)
+{
+}
+
+/**
+ * @brief Destructor of SharedMemoryRing, calls close().
+ */
+FilterManagementLibrary::SharedMemoryRing::~SharedMemoryRing()
+{
+	this->close();
+}
+
+/**
+ * @brief Maps the given shared memory file descriptor.
+ *
+ * Closes fd in any case.
+ */
+bool FilterManagementLibrary::SharedMemoryRing::map(int fd, size_t size)
+{
+	void* memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+			fd, 0);
+	::close(fd);
+
+	if(memory == MAP_FAILED)
+	{
+		Logger::printfln("SharedMemoryRing: mmap of %s failed: %s",
+				this->name.c_str(), strerror(errno));
+		return false;
+	}
+
+	this->header = static_cast<SharedMemoryRingHeader*>(memory);
+	this->mappedSize = size;
+	return true;
+}
+
+/**
+ * @brief Creates a new ring in a shared memory segment.
+ *
+ * An existing segment with the same name (i.e. left over by a crashed
+ * process) is replaced. The segment is removed again when the ring is
+ * closed.
+ *
+ * @param const std::string& name name of the segment, i.e. "/rsapi_frames"
+ *
+ * @param uint32_t slotCount minimum number of slots (will be rounded up
+ * to a power of two), at most 2^31
+ *
+ * @param uint32_t slotSize minimum number of bytes per slot (will be
+ * rounded up to a multiple of the cache line size)
+ *
+ * @return bool true if the ring was created, false otherwise
+ */
+bool FilterManagementLibrary::SharedMemoryRing::create(
+		const std::string& name, uint32_t slotCount, uint32_t slotSize)
+{
+	this->close();
+
+	// Larger sizes would overflow when they are rounded up
+	if(slotCount == 0 || slotSize == 0 || slotCount > (1u << 31) ||
+			slotSize > UINT32_MAX - kCacheLineSize + 1)
+	{
+		Logger::printfln("SharedMemoryRing: invalid ring size");
+		return false;
+	}
+
+	slotSize = (slotSize + kCacheLineSize - 1) / kCacheLineSize *
+			kCacheLineSize;
+
+	// The sequence counters wrap at 2^32, which keeps the slot index
+	// (sequence % slotCount) continuous only for powers of two.
+	uint32_t roundedSlotCount = 1;
+	while(roundedSlotCount < slotCount)
+		roundedSlotCount <<= 1;
+	slotCount = roundedSlotCount;
+
+	const size_t size = kCacheLineSize +
+			static_cast<size_t>(slotCount) * slotSize;
+
+	shm_unlink(name.c_str());
+	int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+
+	if(fd < 0)
+	{
+		Logger::printfln("SharedMemoryRing: shm_open of %s failed: %s",
+				name.c_str(), strerror(errno));
+		return false;
+	}
+
+	if(ftruncate(fd, size) != 0)
+	{
+		Logger::printfln("SharedMemoryRing: ftruncate of %s failed: %s",
+				name.c_str(), strerror(errno));
+		::close(fd);
+		shm_unlink(name.c_str());
+		return false;
+	}
+
+	this->name = name;
+
+	if(!this->map(fd, size))
+	{
+		shm_unlink(name.c_str());
+		return false;
+	}
+
+	this->owner = true;
+	this->header->magic = SHARED_MEMORY_RING_MAGIC;
+	this->header->version = SHARED_MEMORY_RING_VERSION;
+	this->header->slotCount = slotCount;
+	this->header->slotSize = slotSize;
+	this->header->dataOffset = kCacheLineSize;
+	this->header->writeSequence.store(0, std::memory_order_relaxed);
+	this->header->readSequence.store(0, std::memory_order_relaxed);
+	this->header->open.store(1, std::memory_order_release);
+
+	this->slots = reinterpret_cast<uint8_t*>(this->header) +
+			this->header->dataOffset;
+
+	return true;
+}
+
+/**
+ * @brief Opens a ring which was created by another process.
+ *
+ * @param const std::string& name name of the segment passed to create(...)
+ *
+ * @return bool true if the ring was opened, false if it does not exist
+ * (yet) or is invalid
+ */
+bool FilterManagementLibrary::SharedMemoryRing::open(const std::string& name)
+{
+	this->close();
+
+	int fd = shm_open(name.c_str(), O_RDWR, 0600);
+
+	if(fd < 0)
+	{
+		Logger::printfln("SharedMemoryRing: shm_open of %s failed: %s",
+				name.c_str(), strerror(errno));
+		return false;
+	}
+
+	struct stat fileStatus;
+	if(fstat(fd, &fileStatus) != 0 ||
+			fileStatus.st_size < static_cast<off_t>(kCacheLineSize))
+	{
+		Logger::printfln("SharedMemoryRing: %s is not initialized",
+				name.c_str());
+		::close(fd);
+		return false;
+	}
+
+	this->name = name;
+
+	if(!this->map(fd, fileStatus.st_size))
+		return false;
+
+	const SharedMemoryRingHeader* header = this->header;
+
+	if(header->magic != SHARED_MEMORY_RING_MAGIC ||
+			header->version != SHARED_MEMORY_RING_VERSION ||
+			header->open.load(std::memory_order_acquire) == 0 ||
+			header->dataOffset + static_cast<size_t>(header->slotCount) *
+			header->slotSize > this->mappedSize)
+	{
+		Logger::printfln("SharedMemoryRing: %s is invalid or closed",
+				name.c_str());
+		this->close();
+		return false;
+	}
+
+	// The slot index is sequence % slotCount, which needs a power of two
+	// to stay continuous when the sequence counters wrap. The slots must
+	// not overlap the header.
+	if(header->slotCount == 0 || header->slotSize == 0 ||
+			(header->slotCount & (header->slotCount - 1)) != 0 ||
+			header->dataOffset < sizeof(*header))
+	{
+		Logger::printfln("SharedMemoryRing: %s has an invalid ring layout",
+				name.c_str());
+		this->close();
+		return false;
+	}
+
+	this->slots = reinterpret_cast<uint8_t*>(this->header) +
+			header->dataOffset;
+
+	return true;
+}
+
+/**
+ * @brief Disconnects from the shared memory segment.
+ *
+ * If this instance created the ring, it is marked as closed (waking up
+ * all processes waiting on it) and the segment is removed.
+ */
+void FilterManagementLibrary::SharedMemoryRing::close()
+{
+	if(this->header == NULL)
+		return;
+
+	if(this->owner)
+	{
+		this->header->open.store(0, std::memory_order_release);
+		wakeAll(&this->header->writeSequence);
+		wakeAll(&this->header->readSequence);
+		shm_unlink(this->name.c_str());
+	}
+
+	munmap(this->header, this->mappedSize);
+
+	this->header = NULL;
+	this->slots = NULL;
+	this->mappedSize = 0;
+	this->owner = false;
+}
+
+/**
+ * @brief Returns whether the ring is connected and was not closed by
+ * its creator.
+ */
+bool FilterManagementLibrary::SharedMemoryRing::isOpen() const
+{
+	return this->header != NULL &&
+			this->header->open.load(std::memory_order_acquire) != 0;
+}
+
+/**
+ * @brief Returns the number of slots of the ring.
+ */
+uint32_t FilterManagementLibrary::SharedMemoryRing::getSlotCount() const
+{
+	return this->header == NULL ? 0 : this->header->slotCount;
+}
+
+/**
+ * @brief Returns the size of each slot in bytes.
+ */
+uint32_t FilterManagementLibrary::SharedMemoryRing::getSlotSize() const
+{
+	return this->header == NULL ? 0 : this->header->slotSize;
+}
+
+/**
+ * @brief Sleeps until word does not contain value anymore (or it was
+ * woken up for another reason).
+ *
+ * @return bool false if the timeout expired
+ */
+bool FilterManagementLibrary::SharedMemoryRing::waitWhileEqual(
+		std::atomic<uint32_t>* word, uint32_t value, int timeoutMs)
+{
+	struct timespec timeout;
+	timeout.tv_sec = timeoutMs / 1000;
+	timeout.tv_nsec = (timeoutMs % 1000) * 1000000L;
+
+	// Not FUTEX_PRIVATE_FLAG, as the word is shared between processes
+	long result = syscall(SYS_futex, reinterpret_cast<uint32_t*>(word),
+			FUTEX_WAIT, value, timeoutMs < 0 ? NULL : &timeout, NULL, 0);
+
+	return !(result != 0 && errno == ETIMEDOUT);
+}
+
+/**
+ * @brief Wakes up all processes waiting on word.
+ */
+void FilterManagementLibrary::SharedMemoryRing::wakeAll(
+		std::atomic<uint32_t>* word)
+{
+	syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE,
+			INT32_MAX, NULL, NULL, 0);
+}
+
+/**
+ * @brief Returns the next slot to be written, waiting for the reader to
+ * release one if the ring is full.
+ *
+ * Only one process / thread may write to a ring.
+ *
+ * @param int timeoutMs maximum time to wait in milliseconds
+ * (negative: wait forever)
+ *
+ * @return uint8_t* pointer to getSlotSize() writable bytes, or NULL if
+ * the timeout expired or the ring was closed
+ */
+uint8_t* FilterManagementLibrary::SharedMemoryRing::acquireWriteSlot(
+		int timeoutMs)
+{
+	if(this->header == NULL)
+		return NULL;
+
+	const uint32_t writeSequence =
+			this->header->writeSequence.load(std::memory_order_relaxed);
+
+	while(this->isOpen())
+	{
+		const uint32_t readSequence =
+				this->header->readSequence.load(std::memory_order_acquire);
+
+		if(writeSequence - readSequence < this->header->slotCount)
+		{
+			return this->slots + static_cast<size_t>(writeSequence %
+					this->header->slotCount) * this->header->slotSize;
+		}
+
+		if(!waitWhileEqual(&this->header->readSequence, readSequence,
+				timeoutMs))
+		{
+			return NULL;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Publishes the slot returned by acquireWriteSlot(...) to the
+ * reader.
+ */
+void FilterManagementLibrary::SharedMemoryRing::commitWriteSlot()
+{
+	this->header->writeSequence.fetch_add(1, std::memory_order_release);
+	wakeAll(&this->header->writeSequence);
+}
+
+/**
+ * @brief Returns the oldest committed slot, waiting for the writer if
+ * the ring is empty.
+ *
+ * The slot stays valid (and is not touched by the writer) until
+ * releaseReadSlot() is called, so it can be processed in place.
+ * Only one process / thread may read from a ring.
+ *
+ * @param int timeoutMs maximum time to wait in milliseconds
+ * (negative: wait forever)
+ *
+ * @return uint8_t* pointer to the slot, or NULL if the timeout expired
+ * or the ring was closed
+ */
+uint8_t* FilterManagementLibrary::SharedMemoryRing::acquireReadSlot(
+		int timeoutMs)
+{
+	if(this->header == NULL)
+		return NULL;
+
+	const uint32_t readSequence =
+			this->header->readSequence.load(std::memory_order_relaxed);
+
+	while(this->isOpen())
+	{
+		const uint32_t writeSequence =
+				this->header->writeSequence.load(std::memory_order_acquire);
+
+		if(writeSequence != readSequence)
+		{
+			return this->slots + static_cast<size_t>(readSequence %
+					this->header->slotCount) * this->header->slotSize;
+		}
+
+		if(!waitWhileEqual(&this->header->writeSequence, writeSequence,
+				timeoutMs))
+		{
+			return NULL;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Hands the slot returned by acquireReadSlot(...) back to the writer.
+ */
+void FilterManagementLibrary::SharedMemoryRing::releaseReadSlot()
+{
+	this->header->readSequence.fetch_add(1, std::memory_order_release);
+	wakeAll(&this->header->readSequence);
+}
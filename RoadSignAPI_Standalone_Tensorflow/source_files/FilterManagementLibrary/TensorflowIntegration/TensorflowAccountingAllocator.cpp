@@ -0,0 +1,148 @@
+/*
+ * TensorflowAccountingAllocator.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#include "FilterManagementLibrary/TensorflowIntegration/TensorflowAccountingAllocator.h"
+#include "FilterManagementLibrary/MemoryAccounting.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+
+#include <tensorflow/core/framework/allocator_registry.h>
+
+namespace
+{
+	/**
+	 * Stored directly in front of each allocation.
+	 */
+	struct AllocationHeader
+	{
+		FilterManagementLibrary::MemoryAccountState* account;
+		size_t size;
+
+		/**
+		 * Distance from the start of the underlying block to the
+		 * allocation.
+		 */
+		size_t offset;
+	};
+
+	const AllocationHeader* getHeader(const void* ptr)
+	{
+		return reinterpret_cast<const AllocationHeader*>(ptr) - 1;
+	}
+}
+
+/**
+ * @brief Returns the name of the allocator.
+ */
+std::string FilterManagementLibrary::TFIntegration::
+		TensorflowAccountingAllocator::Name()
+{
+	return "rsapi_accounting_cpu";
+}
+
+/**
+ * @brief Allocates numBytes and charges them to the current account.
+ *
+ * @param size_t alignment minimum alignment, a power of 2
+ *
+ * @param size_t numBytes size of the allocation
+ *
+ * @return void* the allocation, NULL on failure
+ */
+void* FilterManagementLibrary::TFIntegration::TensorflowAccountingAllocator::
+		AllocateRaw(size_t alignment, size_t numBytes)
+{
+	alignment = std::max(alignment, sizeof(void*));
+
+	// Smallest multiple of alignment the header fits in
+	const size_t offset = (sizeof(AllocationHeader) + alignment - 1) /
+			alignment * alignment;
+
+	uint8_t* block = static_cast<uint8_t*>(tensorflow::port::AlignedMalloc(
+			numBytes + offset, alignment));
+
+	if(block == NULL)
+		return NULL;
+
+	AllocationHeader* header =
+			reinterpret_cast<AllocationHeader*>(block + offset) - 1;
+	header->size = numBytes;
+	header->offset = offset;
+	header->account = MemoryAccount::charge(
+			MemoryAccount::getTensorflowAccount(), numBytes);
+
+	return block + offset;
+}
+
+/**
+ * @brief Frees an allocation of AllocateRaw(...) and subtracts it from the
+ * account it was charged to.
+ *
+ * @param void* ptr the allocation, NULL is ignored
+ */
+void FilterManagementLibrary::TFIntegration::TensorflowAccountingAllocator::
+		DeallocateRaw(void* ptr)
+{
+	if(ptr == NULL)
+		return;
+
+	const AllocationHeader header = *getHeader(ptr);
+
+	MemoryAccount::release(MemoryAccount::getTensorflowAccount(),
+			header.account, header.size);
+
+	tensorflow::port::AlignedFree(static_cast<uint8_t*>(ptr) - header.offset);
+}
+
+/**
+ * @brief Returns true, the size of every allocation is known.
+ */
+bool FilterManagementLibrary::TFIntegration::TensorflowAccountingAllocator::
+		TracksAllocationSizes()
+{
+	return true;
+}
+
+/**
+ * @brief Returns the size requested for an allocation of AllocateRaw(...).
+ */
+size_t FilterManagementLibrary::TFIntegration::TensorflowAccountingAllocator::
+		RequestedSize(const void* ptr)
+{
+	return getHeader(ptr)->size;
+}
+
+/**
+ * @brief Returns the size of an allocation of AllocateRaw(...), the same as
+ * RequestedSize(...).
+ */
+size_t FilterManagementLibrary::TFIntegration::TensorflowAccountingAllocator::
+		AllocatedSize(const void* ptr)
+{
+	return getHeader(ptr)->size;
+}
+
+/**
+ * @brief Fills in the counters of MemoryAccount::getTensorflowAccount().
+ */
+void FilterManagementLibrary::TFIntegration::TensorflowAccountingAllocator::
+		GetStats(tensorflow::AllocatorStats* stats)
+{
+	const MemoryUsage usage = MemoryAccount::getTensorflowAccount()->getUsage();
+
+	stats->num_allocs = usage.totalAllocations;
+	stats->bytes_in_use = usage.currentBytes;
+	stats->max_bytes_in_use = usage.peakBytes;
+}
+
+using FilterManagementLibrary::TFIntegration::TensorflowAccountingAllocator;
+
+// The default CPU allocator is registered with priority 100
+REGISTER_MEM_ALLOCATOR("RSAPIAccountingCPUAllocator", 200,
+		TensorflowAccountingAllocator);
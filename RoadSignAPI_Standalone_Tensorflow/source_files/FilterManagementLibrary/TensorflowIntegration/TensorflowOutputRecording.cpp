@@ -0,0 +1,462 @@
+/*
+ * TensorflowOutputRecording.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#include "FilterManagementLibrary/TensorflowIntegration/TensorflowOutputRecording.h"
+#include "FilterManagementLibrary/Logger.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+static const uint32_t TENSORFLOW_OUTPUT_MAGIC = 0x524f4654; // "TFOR"
+static const uint32_t TENSORFLOW_OUTPUT_VERSION = 1;
+
+static const uint64_t kAlignment = 8;
+
+static_assert(sizeof(FilterManagementLibrary::TFIntegration::
+		TensorflowOutputTensorHeader) % kAlignment == 0,
+		"TensorflowOutputTensorHeader breaks the alignment");
+
+static uint64_t alignOffset(uint64_t offset)
+{
+	return (offset + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+/**
+ * @brief Constructor of TensorflowOutputRecorder, open(...) needs to be
+ * called before anything can be recorded.
+ */
+FilterManagementLibrary::TFIntegration::TensorflowOutputRecorder::
+		TensorflowOutputRecorder() : file(NULL), offset(0)
+{
+}
+
+/**
+ * @brief Destructor of TensorflowOutputRecorder, calls close().
+ */
+FilterManagementLibrary::TFIntegration::TensorflowOutputRecorder::
+		~TensorflowOutputRecorder()
+{
+	this->close();
+}
+
+/**
+ * @brief Creates a new recording file, an existing file is replaced.
+ *
+ * @param const std::string& path path of the file
+ *
+ * @return bool true on success, false otherwise
+ */
+bool FilterManagementLibrary::TFIntegration::TensorflowOutputRecorder::open(
+		const std::string& path)
+{
+	this->close();
+
+	std::lock_guard<std::mutex> lock(this->mutex);
+
+	this->file = fopen(path.c_str(), "wb");
+	if(this->file == NULL)
+	{
+		Logger::printfln("TensorflowOutputRecorder: could not open %s: %s",
+				path.c_str(), strerror(errno));
+		return false;
+	}
+
+	this->path = path;
+	this->offset = 0;
+	this->index.clear();
+	this->recordedKeys.clear();
+
+	TensorflowOutputFileHeader header;
+	header.magic = TENSORFLOW_OUTPUT_MAGIC;
+	header.version = TENSORFLOW_OUTPUT_VERSION;
+	header.reserved = 0;
+
+	if(!this->write(&header, sizeof(header)))
+	{
+		fclose(this->file);
+		this->file = NULL;
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Writes data at the current offset, followed by the padding to
+ * the next multiple of 8 bytes.
+ */
+bool FilterManagementLibrary::TFIntegration::TensorflowOutputRecorder::write(
+		const void* data, size_t size)
+{
+	static const uint8_t padding[kAlignment] = {0};
+	const size_t paddingSize = alignOffset(size) - size;
+
+	if(fwrite(data, 1, size, this->file) != size ||
+			fwrite(padding, 1, paddingSize, this->file) != paddingSize)
+	{
+		Logger::printfln("TensorflowOutputRecorder: writing %s failed: %s",
+				this->path.c_str(), strerror(errno));
+		return false;
+	}
+
+	this->offset += size + paddingSize;
+	return true;
+}
+
+/**
+ * @brief Records the first outputCount output tensors of an inference.
+ *
+ * Nothing is written if the key was recorded already, as the same input
+ * leads to the same outputs.
+ *
+ * @param uint64_t key key the outputs are replayed with
+ *
+ * @param const TensorflowResultContainer& resultContainer outputs of the
+ * inference
+ *
+ * @param size_t outputCount number of output tensors (the number of
+ * output layer names of the model)
+ *
+ * @return bool true on success (or if the key was recorded already),
+ * false if the recorder is not open, an output can not be recorded
+ * (i.e. a string tensor) or writing failed
+ */
+bool FilterManagementLibrary::TFIntegration::TensorflowOutputRecorder::record(
+		uint64_t key, const TensorflowResultContainer& resultContainer,
+		size_t outputCount)
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+
+	if(this->file == NULL)
+		return false;
+
+	if(this->recordedKeys.count(key) != 0)
+		return true;
+
+	std::vector<const tensorflow::Tensor*> tensors(outputCount);
+
+	for(size_t i = 0; i < outputCount; i++)
+	{
+		tensors[i] = resultContainer.getFloatOutputTensorByID(i);
+
+		// Outputs which are neither float nor quantized
+		if(!tensors[i]->IsInitialized())
+			tensors[i] = resultContainer.getOutputTensorByID(i);
+
+		if(tensors[i]->dtype() == tensorflow::DT_STRING ||
+				tensors[i]->dims() > 6)
+		{
+			Logger::printfln("TensorflowOutputRecorder: output %d can not "
+					"be recorded", (int) i);
+			return false;
+		}
+	}
+
+	TensorflowOutputIndexEntry indexEntry;
+	indexEntry.key = key;
+	indexEntry.offset = this->offset;
+
+	TensorflowOutputRecordHeader recordHeader;
+	recordHeader.key = key;
+	recordHeader.tensorCount = outputCount;
+	recordHeader.reserved = 0;
+
+	if(!this->write(&recordHeader, sizeof(recordHeader)))
+		return false;
+
+	for(const tensorflow::Tensor* tensor : tensors)
+	{
+		TensorflowOutputTensorHeader tensorHeader;
+		memset(&tensorHeader, 0, sizeof(tensorHeader));
+
+		tensorHeader.dataType = tensor->dtype();
+		tensorHeader.dimensionCount = tensor->dims();
+		for(int i = 0; i < tensor->dims(); i++)
+			tensorHeader.dimensions[i] = tensor->dim_size(i);
+
+		const tensorflow::StringPiece tensorData = tensor->tensor_data();
+		tensorHeader.dataSize = tensorData.size();
+
+		if(!this->write(&tensorHeader, sizeof(tensorHeader)) ||
+				!this->write(tensorData.data(), tensorData.size()))
+		{
+			return false;
+		}
+	}
+
+	this->index.push_back(indexEntry);
+	this->recordedKeys.insert(key);
+
+	return true;
+}
+
+/**
+ * @brief Writes the index and closes the file.
+ *
+ * @return bool true on success, false if writing failed (or the recorder
+ * was not open)
+ */
+bool FilterManagementLibrary::TFIntegration::TensorflowOutputRecorder::close()
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+
+	if(this->file == NULL)
+		return false;
+
+	std::sort(this->index.begin(), this->index.end(),
+			[](const TensorflowOutputIndexEntry& a,
+					const TensorflowOutputIndexEntry& b)
+			{
+				return a.key < b.key;
+			});
+
+	TensorflowOutputFileFooter footer;
+	footer.indexOffset = this->offset;
+	footer.recordCount = this->index.size();
+	footer.magic = TENSORFLOW_OUTPUT_MAGIC;
+	footer.version = TENSORFLOW_OUTPUT_VERSION;
+
+	bool success = this->write(this->index.data(),
+			this->index.size() * sizeof(TensorflowOutputIndexEntry)) &&
+			this->write(&footer, sizeof(footer));
+
+	if(fclose(this->file) != 0)
+		success = false;
+
+	this->file = NULL;
+
+	return success;
+}
+
+/**
+ * @brief Returns the number of records written so far.
+ */
+uint64_t FilterManagementLibrary::TFIntegration::TensorflowOutputRecorder::
+		getRecordCount()
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	return this->index.size();
+}
+
+/**
+ * @brief Constructor of TensorflowOutputRecording, use open(...) to map
+ * a recording file.
+ */
+FilterManagementLibrary::TFIntegration::TensorflowOutputRecording::
+		TensorflowOutputRecording() : data(NULL), size(0), index(NULL),
+		recordCount(0)
+{
+}
+
+/**
+ * @brief Destructor of TensorflowOutputRecording, calls close().
+ */
+FilterManagementLibrary::TFIntegration::TensorflowOutputRecording::
+		~TensorflowOutputRecording()
+{
+	this->close();
+}
+
+/**
+ * @brief Maps a recording file written by TensorflowOutputRecorder.
+ *
+ * @param const std::string& path path of the file
+ *
+ * @return bool true on success, false if the file can not be mapped or
+ * is no (complete) recording
+ */
+bool FilterManagementLibrary::TFIntegration::TensorflowOutputRecording::open(
+		const std::string& path)
+{
+	this->close();
+
+	const int fd = ::open(path.c_str(), O_RDONLY);
+	if(fd < 0)
+	{
+		Logger::printfln("TensorflowOutputRecording: could not open %s: %s",
+				path.c_str(), strerror(errno));
+		return false;
+	}
+
+	struct stat fileStatus;
+	if(fstat(fd, &fileStatus) != 0 || (size_t) fileStatus.st_size <
+			sizeof(TensorflowOutputFileHeader) +
+			sizeof(TensorflowOutputFileFooter))
+	{
+		Logger::printfln("TensorflowOutputRecording: %s is no recording",
+				path.c_str());
+		::close(fd);
+		return false;
+	}
+
+	void* memory = mmap(NULL, fileStatus.st_size, PROT_READ, MAP_PRIVATE,
+			fd, 0);
+	::close(fd);
+
+	if(memory == MAP_FAILED)
+	{
+		Logger::printfln("TensorflowOutputRecording: mmap of %s failed: %s",
+				path.c_str(), strerror(errno));
+		return false;
+	}
+
+	this->data = static_cast<const uint8_t*>(memory);
+	this->size = fileStatus.st_size;
+
+	const TensorflowOutputFileHeader* header =
+			reinterpret_cast<const TensorflowOutputFileHeader*>(this->data);
+	const TensorflowOutputFileFooter* footer =
+			reinterpret_cast<const TensorflowOutputFileFooter*>(this->data +
+					this->size - sizeof(TensorflowOutputFileFooter));
+
+	if(header->magic != TENSORFLOW_OUTPUT_MAGIC ||
+			header->version != TENSORFLOW_OUTPUT_VERSION ||
+			footer->magic != TENSORFLOW_OUTPUT_MAGIC ||
+			footer->version != TENSORFLOW_OUTPUT_VERSION ||
+			footer->indexOffset % kAlignment != 0 ||
+			footer->indexOffset > this->size ||
+			footer->recordCount > (this->size - footer->indexOffset) /
+					sizeof(TensorflowOutputIndexEntry))
+	{
+		Logger::printfln("TensorflowOutputRecording: %s is no complete "
+				"recording", path.c_str());
+		this->close();
+		return false;
+	}
+
+	this->index = reinterpret_cast<const TensorflowOutputIndexEntry*>(
+			this->data + footer->indexOffset);
+	this->recordCount = footer->recordCount;
+
+	return true;
+}
+
+/**
+ * @brief Unmaps the recording file.
+ */
+void FilterManagementLibrary::TFIntegration::TensorflowOutputRecording::close()
+{
+	if(this->data != NULL)
+		munmap(const_cast<uint8_t*>(this->data), this->size);
+
+	this->data = NULL;
+	this->size = 0;
+	this->index = NULL;
+	this->recordCount = 0;
+}
+
+/**
+ * @brief Returns true if a recording file is mapped.
+ */
+bool FilterManagementLibrary::TFIntegration::TensorflowOutputRecording::
+		isOpen() const
+{
+	return this->data != NULL;
+}
+
+/**
+ * @brief Returns the number of records in the recording file.
+ */
+uint64_t FilterManagementLibrary::TFIntegration::TensorflowOutputRecording::
+		getRecordCount() const
+{
+	return this->recordCount;
+}
+
+/**
+ * @brief Copies the output tensors recorded under a key.
+ *
+ * The tensors in outputTensors are reused if their type and shape match,
+ * so replaying the outputs of the same model does not allocate.
+ *
+ * @param uint64_t key key the outputs were recorded with
+ *
+ * @param std::vector<tensorflow::Tensor>* outputTensors receives the
+ * output tensors
+ *
+ * @return bool true on success, false if there is no record with this key
+ * (or the record is damaged)
+ */
+bool FilterManagementLibrary::TFIntegration::TensorflowOutputRecording::
+		findRecord(uint64_t key,
+				std::vector<tensorflow::Tensor>* outputTensors) const
+{
+	const TensorflowOutputIndexEntry* indexEnd =
+			this->index + this->recordCount;
+	const TensorflowOutputIndexEntry* indexEntry = std::lower_bound(
+			this->index, indexEnd, key,
+			[](const TensorflowOutputIndexEntry& entry, uint64_t key)
+			{
+				return entry.key < key;
+			});
+
+	if(indexEntry == indexEnd || indexEntry->key != key)
+		return false;
+
+	const uint64_t recordsEnd = reinterpret_cast<const uint8_t*>(
+			this->index) - this->data;
+	uint64_t offset = indexEntry->offset;
+
+	if(offset % kAlignment != 0 ||
+			offset + sizeof(TensorflowOutputRecordHeader) > recordsEnd)
+		return false;
+
+	const TensorflowOutputRecordHeader* recordHeader =
+			reinterpret_cast<const TensorflowOutputRecordHeader*>(
+					this->data + offset);
+	offset += sizeof(TensorflowOutputRecordHeader);
+
+	if(recordHeader->key != key)
+		return false;
+
+	outputTensors->resize(recordHeader->tensorCount);
+
+	for(uint32_t i = 0; i < recordHeader->tensorCount; i++)
+	{
+		if(offset + sizeof(TensorflowOutputTensorHeader) > recordsEnd)
+			return false;
+
+		const TensorflowOutputTensorHeader* tensorHeader =
+				reinterpret_cast<const TensorflowOutputTensorHeader*>(
+						this->data + offset);
+		offset += sizeof(TensorflowOutputTensorHeader);
+
+		if(tensorHeader->dimensionCount > 6 ||
+				tensorHeader->dataSize > recordsEnd - offset)
+			return false;
+
+		tensorflow::TensorShape shape;
+		for(uint32_t j = 0; j < tensorHeader->dimensionCount; j++)
+			shape.AddDim(tensorHeader->dimensions[j]);
+
+		const tensorflow::DataType dataType =
+				static_cast<tensorflow::DataType>(tensorHeader->dataType);
+		tensorflow::Tensor& tensor = (*outputTensors)[i];
+
+		if(!tensor.IsInitialized() || tensor.dtype() != dataType ||
+				!tensor.shape().IsSameSize(shape))
+		{
+			tensor = tensorflow::Tensor(dataType, shape);
+		}
+
+		if(tensor.tensor_data().size() != tensorHeader->dataSize)
+			return false;
+
+		memcpy(const_cast<char*>(tensor.tensor_data().data()),
+				this->data + offset, tensorHeader->dataSize);
+
+		offset += alignOffset(tensorHeader->dataSize);
+	}
+
+	return true;
+}
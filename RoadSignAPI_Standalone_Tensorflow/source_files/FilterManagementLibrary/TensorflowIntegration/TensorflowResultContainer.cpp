@@ -1,67 +1,122 @@
-/*
- * TensorflowResultContainer.cpp
- *
- *  Created on: 03.06.2018
- *      Author: Patrick Langer
- */
-
-#include "FilterManagementLibrary/TensorflowIntegration/TensorflowResultContainer.h"
-#include <assert.h>
-
-
-/**
- * @brief Constructor of TensorflowResultContainer
- * All information / data contained in an objecct of type
- * TensorflowResultContainer will be set using this constructor.
- * It does not contain any other class member variables!
- *
- * @param std::vector<tensorflow::Tensor>* outputTensors the list of
- * output tensors of the corresponding inference
- * (the Tensors containing the result)
- *
- * @param std::vector<std::string> outputTensorNames layer names of the
- * output tensors.
- * The names *HAVE* to be in the same order as the
- * outputTensors vector! Otherwise a wrong tensor would be returned when
- * using the getOutTensorByLayerName(...) function.
- */
-FilterManagementLibrary::TFIntegration::
-					TensorflowResultContainer::TensorflowResultContainer(
-							std::vector<tensorflow::Tensor>* outputTensors,
-							std::vector<std::string> outputTensorNames):
-							outputTensors(outputTensors), outputTensorNames(outputTensorNames)
-{
-
-}
-
-
-/**
- * @brief Returns a pointer to the output Tensor with the given ID.
- *
- * @return tensorflow::Tensor the output Tensor with the given ID.
- */
-tensorflow::Tensor* FilterManagementLibrary::
-	TFIntegration::TensorflowResultContainer::getOutputTensorByID(int id) const
-{
-	return &this->outputTensors->at(id);
-}
-
-/**
- * @brief Returns a pointer to the output Tensor at the given layer name.
- *
- * @return tensorflow::Tensor the output Tensor at the given layer name.
- */
-tensorflow::Tensor* FilterManagementLibrary::TFIntegration::
-	TensorflowResultContainer::getOutputTensorByLayerName(
-			std::string layerName) const
-{
-	// Calculate index in vector by name
-	ptrdiff_t pos = std::distance(this->outputTensorNames.begin(),
-			std::find(this->outputTensorNames.begin(),
-					this->outputTensorNames.end(), layerName));
-
-	assert (pos < this->outputTensorNames.size());
-
-	return &this->outputTensors->at(pos);
-
-}
+/*
+ * TensorflowResultContainer.cpp
+ *
+ *  Created on: 03.06.2018
+ *      Author: Patrick Langer
+ */
+
+#include "FilterManagementLibrary/TensorflowIntegration/TensorflowResultContainer.h"
+#include <assert.h>
+
+
+/**
+ * @brief Constructor of TensorflowResultContainer
+ * All information / data contained in an objecct of type
+ * TensorflowResultContainer will be set using this constructor.
+ * It does not contain any other class member variables!
+ *
+ * @param std::vector<tensorflow::Tensor>* outputTensors the list of
+ * output tensors of the corresponding inference
+ * (the Tensors containing the result)
+ *
+ * @param std::vector<std::string> outputTensorNames layer names of the
+ * output tensors.
+ * The names *HAVE* to be in the same order as the
+ * outputTensors vector! Otherwise a wrong tensor would be returned when
+ * using the getOutTensorByLayerName(...) function.
+ *
+ * @param std::vector<tensorflow::Tensor>* dequantizedOutputTensors float
+ * tensors holding the dequantized values of quantized output tensors, in
+ * the same order as outputTensors (may be NULL if there are none).
+ */
+FilterManagementLibrary::TFIntegration::
+					TensorflowResultContainer::TensorflowResultContainer(
+							std::vector<tensorflow::Tensor>* outputTensors,
+							std::vector<std::string> outputTensorNames,
+							std::vector<tensorflow::Tensor>*
+							dequantizedOutputTensors):
+							outputTensors(outputTensors), outputTensorNames(outputTensorNames),
+							dequantizedOutputTensors(dequantizedOutputTensors)
+{
+
+}
+
+
+/**
+ * @brief Returns a pointer to the output Tensor with the given ID.
+ *
+ * @return tensorflow::Tensor the output Tensor with the given ID.
+ */
+tensorflow::Tensor* FilterManagementLibrary::
+	TFIntegration::TensorflowResultContainer::getOutputTensorByID(int id) const
+{
+	return &this->outputTensors->at(id);
+}
+
+/**
+ * @brief Returns a pointer to the output Tensor at the given layer name.
+ *
+ * @return tensorflow::Tensor the output Tensor at the given layer name.
+ */
+tensorflow::Tensor* FilterManagementLibrary::TFIntegration::
+	TensorflowResultContainer::getOutputTensorByLayerName(
+			std::string layerName) const
+{
+	// Calculate index in vector by name
+	ptrdiff_t pos = std::distance(this->outputTensorNames.begin(),
+			std::find(this->outputTensorNames.begin(),
+					this->outputTensorNames.end(), layerName));
+
+	assert (pos < this->outputTensorNames.size());
+
+	return &this->outputTensors->at(pos);
+
+}
+
+/**
+ * @brief Returns a pointer to a float Tensor holding the output with the given ID.
+ *
+ * If the output Tensor with the given ID already is of type
+ * tensorflow::DT_FLOAT, it is returned directly. If it is a quantized
+ * (tensorflow::DT_UINT8 or tensorflow::DT_INT8) Tensor, the Tensor containing
+ * it's dequantized values is returned instead (see
+ * TensorflowNNInstance::runInference()).
+ * This way, output interpretation (i.e. flat<float>()) works the same way
+ * for float and quantized models.
+ *
+ * @return tensorflow::Tensor the float output Tensor with the given ID.
+ */
+tensorflow::Tensor* FilterManagementLibrary::
+	TFIntegration::TensorflowResultContainer::getFloatOutputTensorByID(int id) const
+{
+	tensorflow::Tensor* outputTensor = &this->outputTensors->at(id);
+
+	if(outputTensor->dtype() == tensorflow::DT_FLOAT ||
+			this->dequantizedOutputTensors == NULL)
+	{
+		return outputTensor;
+	}
+
+	return &this->dequantizedOutputTensors->at(id);
+}
+
+/**
+ * @brief Returns a pointer to a float Tensor holding the output at the given layer name.
+ *
+ * See getFloatOutputTensorByID(...) for a more detailed description.
+ *
+ * @return tensorflow::Tensor the float output Tensor at the given layer name.
+ */
+tensorflow::Tensor* FilterManagementLibrary::TFIntegration::
+	TensorflowResultContainer::getFloatOutputTensorByLayerName(
+			std::string layerName) const
+{
+	// Calculate index in vector by name
+	ptrdiff_t pos = std::distance(this->outputTensorNames.begin(),
+			std::find(this->outputTensorNames.begin(),
+					this->outputTensorNames.end(), layerName));
+
+	assert (pos < this->outputTensorNames.size());
+
+	return this->getFloatOutputTensorByID(pos);
+}
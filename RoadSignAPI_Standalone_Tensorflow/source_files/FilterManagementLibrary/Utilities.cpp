@@ -1,27 +1,69 @@
-/*
- * Utilities.cpp
- *
- *  Created on: 19.05.2018
- *      Author: Patrick Langer
- */
-
-#include "FilterManagementLibrary/Utilities.h"
-
-#include <sys/stat.h>
-
-/**
- * @brief Check if a file with the given path exists.
- *
- * @param const std::string& name string containing the path of the file
- *
- * @return true if the file exists, false if the file does not exist or
- * if we have insufficient permission to read it.
- */
-bool FilterManagementLibrary::Utilities::fileExists
-	(const std::string& name)
-{
-	struct stat buffer;
-	return (stat (name.c_str(), &buffer) == 0);
-}
-
-
+/*
+ * Utilities.cpp
+ *
+ *  Created on: 19.05.2018
+ *      Author: Patrick Langer
+ */
+
+#include "FilterManagementLibrary/Utilities.h"
+
+#include <sys/stat.h>
+
+#include <chrono>
+
+/**
+ * @brief Check if a file with the given path exists.
+ *
+ * @param const std::string& name string containing the path of the file
+ *
+ * @return true if the file exists, false if the file does not exist or
+ * if we have insufficient permission to read it.
+ */
+bool FilterManagementLibrary::Utilities::fileExists
+	(const std::string& name)
+{
+	struct stat buffer;
+	return (stat (name.c_str(), &buffer) == 0);
+}
+
+
+
+/**
+ * @brief Returns a monotonic time in microseconds.
+ *
+ * Not related to the wall clock, only differences of the returned values
+ * are meaningful (i.e. frame push times and deadlines).
+ */
+int64_t FilterManagementLibrary::Utilities::getTimeUs()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Computes the 64 bit FNV-1a hash of a block of memory.
+ *
+ * Not suited for anything security related, only to identify data (i.e.
+ * the input of an inference, see TFNNBasedPipeFilter).
+ *
+ * @param const void* data the data to hash
+ *
+ * @param size_t size size of the data in bytes
+ *
+ * @param uint64_t hash offset basis, or the hash of the preceding data
+ *
+ * @return uint64_t the hash
+ */
+uint64_t FilterManagementLibrary::Utilities::hashFNV1a(const void* data,
+		size_t size, uint64_t hash)
+{
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+
+	for(size_t i = 0; i < size; i++)
+	{
+		hash ^= bytes[i];
+		hash *= 0x100000001b3ULL;
+	}
+
+	return hash;
+}
@@ -0,0 +1,264 @@
+/*
+ * YUVImageUtils.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#include "FilterManagementLibrary/YUVImageUtils.h"
+#include "FilterManagementLibrary/Logger.h"
+
+#include <algorithm>
+#include <vector>
+
+// Fixed point precision of the bilinear interpolation weights.
+static const int kWeightBits = 10;
+static const int kWeightOne = 1 << kWeightBits;
+
+/**
+ * @brief Precomputes the source sample positions for one axis.
+ *
+ * Maps each of the dstSize destination positions to the region
+ * [regionStart, regionStart + regionSize) of an axis of length
+ * frameSize (pixel centers aligned, like cv::resize). Writes the two
+ * neighbouring luma indices, the fixed point weight of the second one and
+ * the index of the corresponding (subsampled) chroma sample.
+ */
+static void computeSampleTable(int regionStart, int regionSize,
+		int dstSize, int frameSize, bool mirrored,
+		int* index0, int* index1, int* weight, int* chromaIndex)
+{
+	const float scale = static_cast<float>(regionSize) / dstSize;
+
+	for(int d = 0; d < dstSize; d++)
+	{
+		float s = regionStart + (d + 0.5f) * scale - 0.5f;
+		s = std::min(static_cast<float>(frameSize - 1), std::max(0.0f, s));
+
+		if(mirrored)
+			s = (frameSize - 1) - s;
+
+		int i = static_cast<int>(s);
+		index0[d] = i;
+		index1[d] = std::min(i + 1, frameSize - 1);
+		weight[d] = static_cast<int>((s - i) * kWeightOne);
+		chromaIndex[d] = std::min(static_cast<int>(s + 0.5f),
+				frameSize - 1) >> 1;
+	}
+}
+
+/**
+ * @brief Creates a YUVFrame from plane pointers and row strides.
+ *
+ * For NV21 and NV12, planes[1] needs to point to the interleaved chroma
+ * plane (planes[2] is ignored and may be NULL). For I420, planes[1] and
+ * planes[2] point to the U and V planes.
+ * strides[i] is the row stride in bytes of plane i (strides[2] is ignored
+ * for NV21 / NV12). Nothing is copied, the planes need to stay valid as
+ * long as the frame is used.
+ *
+ * @param const uint8_t* const planes[3] pointers to the planes of the frame
+ * @param const int strides[3] row strides of the planes
+ * @param YUVFormat format memory layout of the frame
+ * @param int width width of the frame in pixels
+ * @param int height height of the frame in pixels
+ * @param bool rotate180 whether the frame shall be interpreted as rotated
+ * by 180 degrees
+ * @param YUVFrame* frame frame description which will be filled
+ *
+ * @return bool true if the given planes describe a valid frame,
+ * false otherwise
+ */
+bool FilterManagementLibrary::YUVImageUtils::describeFrame(
+		const uint8_t* const planes[3], const int strides[3],
+		YUVFormat format, int width, int height, bool rotate180,
+		YUVFrame* frame)
+{
+	if(width <= 0 || height <= 0 || planes[0] == NULL || planes[1] == NULL ||
+			(format == YUVFormat::I420 && planes[2] == NULL))
+	{
+		Logger::printfln("YUVImageUtils: invalid frame description");
+		return false;
+	}
+
+	frame->yPlane = planes[0];
+	frame->yRowStride = strides[0];
+	frame->uvRowStride = strides[1];
+	frame->width = width;
+	frame->height = height;
+	frame->rotate180 = rotate180;
+
+	switch(format)
+	{
+		case YUVFormat::NV21:
+		{
+			frame->vPlane = planes[1];
+			frame->uPlane = planes[1] + 1;
+			frame->uvPixelStride = 2;
+		}
+		break;
+		case YUVFormat::NV12:
+		{
+			frame->uPlane = planes[1];
+			frame->vPlane = planes[1] + 1;
+			frame->uvPixelStride = 2;
+		}
+		break;
+		case YUVFormat::I420:
+		{
+			if(strides[1] != strides[2])
+			{
+				Logger::printfln(
+						"YUVImageUtils: U and V planes need the same stride");
+				return false;
+			}
+			frame->uPlane = planes[1];
+			frame->vPlane = planes[2];
+			frame->uvPixelStride = 1;
+		}
+		break;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Samples a region of a YUV frame into a BGR Mat of arbitrary size.
+ *
+ * Only the pixels of dst are color converted, so scaling a full frame down
+ * to the detector input size or cutting out a small sign costs just as much
+ * as the result has pixels. Luma is interpolated bilinearly, chroma is
+ * taken from the nearest (subsampled) sample.
+ * If frame.rotate180 is set, region refers to the rotated image.
+ *
+ * dst needs to be an allocated 8UC3 Mat, it's size determines the
+ * output size. region needs to lie inside the frame, we don't do any
+ * safety checks here, because we want to be *fast*.
+ *
+ * @param const YUVFrame& frame frame to sample from
+ * @param const cv::Rect& region region of the frame which will be sampled
+ * @param cv::Mat* dst 8UC3 BGR Mat the result will be written to
+ */
+void FilterManagementLibrary::YUVImageUtils::resizeRegionToBGR(
+		const YUVFrame& frame, const cv::Rect& region, cv::Mat* dst)
+{
+	const int dstWidth = dst->cols;
+	const int dstHeight = dst->rows;
+
+	std::vector<int> columnTables(dstWidth * 4);
+	int* x0 = &columnTables[0];
+	int* x1 = x0 + dstWidth;
+	int* weightX = x1 + dstWidth;
+	int* chromaX = weightX + dstWidth;
+
+	std::vector<int> rowTables(dstHeight * 4);
+	int* y0 = &rowTables[0];
+	int* y1 = y0 + dstHeight;
+	int* weightY = y1 + dstHeight;
+	int* chromaY = weightY + dstHeight;
+
+	computeSampleTable(region.x, region.width, dstWidth, frame.width,
+			frame.rotate180, x0, x1, weightX, chromaX);
+	computeSampleTable(region.y, region.height, dstHeight, frame.height,
+			frame.rotate180, y0, y1, weightY, chromaY);
+
+	for(int dx = 0; dx < dstWidth; dx++)
+	{
+		chromaX[dx] *= frame.uvPixelStride;
+	}
+
+	std::vector<uint8_t> sampleRows(dstWidth * 3);
+	uint8_t* ySamples = &sampleRows[0];
+	uint8_t* uSamples = ySamples + dstWidth;
+	uint8_t* vSamples = uSamples + dstWidth;
+
+	for(int dy = 0; dy < dstHeight; dy++)
+	{
+		const uint8_t* yRow0 = frame.yPlane + y0[dy] * frame.yRowStride;
+		const uint8_t* yRow1 = frame.yPlane + y1[dy] * frame.yRowStride;
+		const uint8_t* uRow = frame.uPlane + chromaY[dy] * frame.uvRowStride;
+		const uint8_t* vRow = frame.vPlane + chromaY[dy] * frame.uvRowStride;
+		const int wy = weightY[dy];
+
+		for(int dx = 0; dx < dstWidth; dx++)
+		{
+			const int wx = weightX[dx];
+			int top = yRow0[x0[dx]] * (kWeightOne - wx) + yRow0[x1[dx]] * wx;
+			int bottom = yRow1[x0[dx]] * (kWeightOne - wx) + yRow1[x1[dx]] * wx;
+
+			ySamples[dx] = static_cast<uint8_t>(
+					(top * (kWeightOne - wy) + bottom * wy +
+					(1 << (2 * kWeightBits - 1))) >> (2 * kWeightBits));
+			uSamples[dx] = uRow[chromaX[dx]];
+			vSamples[dx] = vRow[chromaX[dx]];
+		}
+
+		ImageConversion::convertYUVRow(ySamples, uSamples, vSamples,
+				dst->ptr<uint8_t>(dy), dstWidth,
+				ImageConversion::PixelFormat::BGR);
+	}
+}
+
+/**
+ * @brief Converts a whole YUV frame into a caller provided packed buffer.
+ *
+ * Unlike resizeRegionToBGR(...), no scaling is done, each output pixel
+ * corresponds to exactly one luma sample. Chroma samples are duplicated
+ * (like yuv2rgb.cc does). If frame.rotate180 is set, the output is the
+ * rotated image, so it matches the coordinates of all results.
+ *
+ * @param const YUVFrame& frame frame to convert
+ * @param uint8_t* dst output buffer with at least frame.height rows
+ * @param int dstStride row stride of dst in bytes
+ * @param ImageConversion::PixelFormat format memory layout of the output
+ * pixels
+ */
+void FilterManagementLibrary::YUVImageUtils::convertFrame(
+		const YUVFrame& frame, uint8_t* dst, int dstStride,
+		ImageConversion::PixelFormat format)
+{
+	const int width = frame.width;
+	const int height = frame.height;
+
+	std::vector<uint8_t> sampleRows(width * 3);
+	uint8_t* ySamples = &sampleRows[0];
+	uint8_t* uSamples = ySamples + width;
+	uint8_t* vSamples = uSamples + width;
+
+	int lastChromaRow = -1;
+
+	for(int y = 0; y < height; y++)
+	{
+		const int srcY = frame.rotate180 ? height - 1 - y : y;
+		const uint8_t* yRow = frame.yPlane + srcY * frame.yRowStride;
+
+		if(frame.rotate180)
+		{
+			for(int x = 0; x < width; x++)
+			{
+				ySamples[x] = yRow[width - 1 - x];
+			}
+			yRow = ySamples;
+		}
+
+		// Chroma of a row only changes every second source row
+		const int chromaRow = srcY >> 1;
+		if(chromaRow != lastChromaRow)
+		{
+			const uint8_t* uRow = frame.uPlane + chromaRow * frame.uvRowStride;
+			const uint8_t* vRow = frame.vPlane + chromaRow * frame.uvRowStride;
+
+			for(int x = 0; x < width; x++)
+			{
+				const int srcX = frame.rotate180 ? width - 1 - x : x;
+				const int offset = (srcX >> 1) * frame.uvPixelStride;
+				uSamples[x] = uRow[offset];
+				vSamples[x] = vRow[offset];
+			}
+			lastChromaRow = chromaRow;
+		}
+
+		ImageConversion::convertYUVRow(yRow, uSamples, vSamples,
+				dst + y * dstStride, width, format);
+	}
+}
@@ -0,0 +1,188 @@
+/*
+ * AnnotatedOutputRenderer.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#include "RoadSignAPI/AnnotatedOutputRenderer.h"
+#include "FilterManagementLibrary/Logger.h"
+
+#include <algorithm>
+#include <sstream>
+
+typedef FilterManagementLibrary::ImageConversion ImageConversion;
+
+/**
+ * @brief Returns a cv::Scalar for a BGR color matching the channel order
+ * of the given pixel format.
+ */
+static cv::Scalar colorForFormat(int blue, int green, int red,
+		ImageConversion::PixelFormat format)
+{
+	if(format == ImageConversion::PixelFormat::RGBA)
+		return cv::Scalar(red, green, blue, 255);
+
+	return cv::Scalar(blue, green, red, 255);
+}
+
+/**
+ * @brief Draws the box and (optionally) the label of a single sign.
+ */
+static void drawSign(cv::Mat* canvas, const cv::Point& upperLeft,
+		const cv::Point& lowerRight, int classID, float confidence,
+		const cv::Scalar& color, const cv::Scalar& textColor,
+		const RoadSignAPI::AnnotationOptions& options)
+{
+	cv::rectangle(*canvas, upperLeft, lowerRight, color,
+			options.lineThickness);
+
+	if(options.drawLabels)
+	{
+		std::stringstream ss;
+		ss << classID << " " << confidence;
+		cv::putText(*canvas, ss.str(),
+				cv::Point(upperLeft.x, upperLeft.y - 20),
+				cv::FONT_HERSHEY_COMPLEX_SMALL, 1.0, textColor, 3);
+	}
+}
+
+/**
+ * @brief Renders the lastly processed frame and its results into a
+ * caller provided buffer.
+ *
+ * If the frame was fed via feedImageYUV(...), its planes need to be still
+ * valid when this is called (i.e. call it before the camera buffer is
+ * released or reused).
+ *
+ * @param const RSAPIWorkingDataSet& workingDataSet working data set of the
+ * RoadSignAPI which processed the frame
+ *
+ * @param uint8_t* output buffer with at least originalImageHeight rows of
+ * originalImageWidth pixels
+ *
+ * @param int outputStride row stride of output in bytes
+ *
+ * @param ImageConversion::PixelFormat format memory layout of the output
+ * pixels
+ *
+ * @param const AnnotationOptions& options what will be drawn on top of
+ * the frame
+ *
+ * @return bool true if the frame was rendered, false if there is no frame
+ * or the output buffer is too small
+ */
+bool RoadSignAPI::AnnotatedOutputRenderer::render(
+		const RSAPIWorkingDataSet& workingDataSet,
+		uint8_t* output, int outputStride,
+		ImageConversion::PixelFormat format,
+		const AnnotationOptions& options)
+{
+	const int width = workingDataSet.originalImageWidth;
+	const int height = workingDataSet.originalImageHeight;
+	const int bytesPerPixel =
+			format == ImageConversion::PixelFormat::BGR ? 3 : 4;
+
+	if(width <= 0 || height <= 0 || output == NULL)
+	{
+		FilterManagementLibrary::Logger::printfln(
+				"AnnotatedOutputRenderer: no frame to render");
+		return false;
+	}
+
+	if(outputStride < width * bytesPerPixel)
+	{
+		FilterManagementLibrary::Logger::printfln(
+				"AnnotatedOutputRenderer: output stride %d too small "
+				"for %d pixels", outputStride, width);
+		return false;
+	}
+
+	if(workingDataSet.yuvInput)
+	{
+		FilterManagementLibrary::YUVImageUtils::convertFrame(
+				workingDataSet.originalYUVFrame, output, outputStride, format);
+	}
+	else
+	{
+		const cv::Mat& image = workingDataSet.originalBGRImage;
+
+		if(image.empty() || image.type() != CV_8UC3)
+		{
+			FilterManagementLibrary::Logger::printfln(
+					"AnnotatedOutputRenderer: no frame to render");
+			return false;
+		}
+
+		for(int y = 0; y < height; y++)
+		{
+			ImageConversion::convertBGRRow(image.ptr<uint8_t>(y),
+					output + y * outputStride, width, format);
+		}
+	}
+
+	if(!options.drawDetectedSigns && !options.drawSignCombinations)
+		return true;
+
+	// Wraps the output buffer, so we can draw using OpenCV without copying
+	cv::Mat canvas(height, width, bytesPerPixel == 3 ? CV_8UC3 : CV_8UC4,
+			output, outputStride);
+
+	const cv::Scalar signColor = colorForFormat(0, 255, 0, format);
+	const cv::Scalar combinationColor = colorForFormat(0, 0, 255, format);
+	const cv::Scalar textColor = colorForFormat(255, 255, 255, format);
+
+	if(options.drawDetectedSigns)
+	{
+		for(unsigned int i = 0; i < workingDataSet.detectedSigns.size(); i++)
+		{
+			const DetectedSignDescriptor* sign =
+					&workingDataSet.detectedSigns[i];
+
+			drawSign(&canvas, sign->upperLeft, sign->lowerRight,
+					sign->detectionPredictedClassID, sign->detectorConfidence,
+					signColor, textColor, options);
+		}
+	}
+
+	if(options.drawSignCombinations)
+	{
+		for(unsigned int i = 0;
+				i < workingDataSet.detectedSignCombinations.size(); i++)
+		{
+			const std::vector<DetectedSignDescriptor>* signs =
+					workingDataSet.detectedSignCombinations[i].
+					getSignsInCombination();
+
+			if(signs->empty())
+				continue;
+
+			cv::Point combinationUpperLeft = signs->at(0).upperLeft;
+			cv::Point combinationLowerRight = signs->at(0).lowerRight;
+
+			for(unsigned int j = 0; j < signs->size(); j++)
+			{
+				const DetectedSignDescriptor* sign = &signs->at(j);
+
+				drawSign(&canvas, sign->upperLeft, sign->lowerRight,
+						sign->classifierApprovedClassID,
+						sign->classifierConfidence,
+						signColor, textColor, options);
+
+				combinationUpperLeft.x =
+						std::min(combinationUpperLeft.x, sign->upperLeft.x);
+				combinationUpperLeft.y =
+						std::min(combinationUpperLeft.y, sign->upperLeft.y);
+				combinationLowerRight.x =
+						std::max(combinationLowerRight.x, sign->lowerRight.x);
+				combinationLowerRight.y =
+						std::max(combinationLowerRight.y, sign->lowerRight.y);
+			}
+
+			cv::rectangle(canvas, combinationUpperLeft, combinationLowerRight,
+					combinationColor, options.lineThickness);
+		}
+	}
+
+	return true;
+}
@@ -1,149 +1,203 @@
-/*
- * DetectedSignCombination.cpp
- *
- *  Created on: 21.06.2018
- *      Author: oracion
- */
-
-#include "RoadSignAPI/DetectedSignCombination.h"
-#include "FilterManagementLibrary/Logger.h"
-
-/**
- * @brief Constructor of DetectedSignCombination.
- *
- * Intializes all member variables and constructs a new object
- * of type DetectedSignCombination. Does not do any other specific tasks.
- */
-RoadSignAPI::DetectedSignCombination::DetectedSignCombination() :
-			estimatedPolePositionX(0)
-{
-	this->signs.clear();
-}
-
-/**
- * @brief Adds a sign to the list of signs of this combination.
- *
- *Uses insertSorted(...) to add a detected sign to the
-* list of signs in the this combination, so that the list is
-* sorted by the y values of the signs (from top to bottom)
-*/
-void RoadSignAPI::DetectedSignCombination::
-		addDetectedSign(DetectedSignDescriptor detectedSign)
-{
-
-	this->insertSorted(&detectedSign);
-
-	int numSignsOnPole = this->signs.size();
-	int estimatedPoleXSum = 0;
-
-	DetectedSignDescriptor* detectedSignDescriptor;
-	for(int i = 0; i < this->signs.size(); i++)
-	{
-		detectedSignDescriptor = &this->signs[i];
-
-		estimatedPoleXSum +=
-				(detectedSignDescriptor->lowerRight.x +
-				detectedSignDescriptor->upperLeft.x) / 2;
-	}
-
-
-	this->estimatedPolePositionX = estimatedPoleXSum / this->signs.size();
-}
-
-/** @brief Inserts a detectedSign at the right position of this combination
-*
-* Uses insertion sort to add the detected sign to the
-* list of signs in the this combination, so that the list is
-* sorted by the y values of the signs (from top to bottom).
-*/
-void RoadSignAPI::DetectedSignCombination::insertSorted(
-		DetectedSignDescriptor* detectedSign)
-{
-	if(this->signs.size() == 0)
-	{
-		this->signs.push_back(*detectedSign);
-	}
-	else
-	{
-		DetectedSignDescriptor* currentSign;
-
-		int currentSignPosYUpperLeft = 0;
-		int signToAddPosYUpperLeft = detectedSign->upperLeft.y;
-
-		bool added = false;
-
-
-		for(int i = 0; i < this->signs.size(); i++)
-		{
-
-			currentSign = &this->signs.at(i);
-			currentSignPosYUpperLeft = currentSign->upperLeft.y;
-
-			// the array is sorted from top to bottom, so if the (upper) y
-			// coordinate of the sign to add is higher as the (upper) y
-			// coordinate of the currentSign, while we are iterating
-			// from top to bottom, insert the sign at the position of the
-			// currentSign.
-			if(signToAddPosYUpperLeft < currentSignPosYUpperLeft)
-			{
-
-				this->signs.insert(this->signs.begin() + i , *detectedSign);
-				added = true;
-				break;
-			}
-
-
-
-		}
-		if(!added)
-		{
-			this->signs.push_back(*detectedSign);
-		}
-	}
-}
-
-/**
- * @brief Returns the amount of signs contained by this combination.
- * @return int Size of the list (= amount of entries in the list) containing
- * all @link{DetectedSignDescriptor}s of this combination.
- */
-int RoadSignAPI::DetectedSignCombination::getDetectedSignsAmount() const
-{
-	return this->signs.size();
-}
-
-/**
- * @brief Returns the estimated pole position X coordinate of this sign combination.
- *
- * The estimated pole position X is calculated by forming the average of
- * the center X coordinate (middle of the box in which a sign is contained).
- */
-int RoadSignAPI::DetectedSignCombination::getGestimatedPolePositionX() const
-{
-	return this->estimatedPolePositionX;
-}
-
-/**
- * @brief Returns a vector containing all Signs of this combination.
- *
- * All @link{DetectedSignCombination}s which were added to this combination
- * will be added to a list, which can be retrieved using this function.
- * This list is sorted by the y values of the signs from top to bottom.
- */
-const std::vector<RoadSignAPI::DetectedSignDescriptor>*
-				 RoadSignAPI::DetectedSignCombination::
-									getSignsInCombination() const
-{
-	return &this->signs;
-}
-
-/**
- * @brief Standard Destructor of DetectedSignCombination.
- *
- * Standard Destructor of DetectedSignCombination, does not do any specific
- * tasks.
- */
-RoadSignAPI::DetectedSignCombination::~DetectedSignCombination()
-{
-
-}
+/*
+ * DetectedSignCombination.cpp
+ *
+ *  Created on: 21.06.2018
+ *      Author: oracion
+ */
+
+#include "RoadSignAPI/DetectedSignCombination.h"
+#include "FilterManagementLibrary/Logger.h"
+
+#include <algorithm>
+
+/**
+ * @brief Constructor of DetectedSignCombination.
+ *
+ * Intializes all member variables and constructs a new object
+ * of type DetectedSignCombination. Does not do any other specific tasks.
+ */
+RoadSignAPI::DetectedSignCombination::DetectedSignCombination() :
+			estimatedPolePositionX(0), estimatedPoleXSum(0), trackID(0)
+{
+	this->signs.clear();
+}
+
+/**
+ * @brief Adds a sign to the list of signs of this combination.
+ *
+ *Uses insertSorted(...) to add a detected sign to the
+* list of signs in the this combination, so that the list is
+* sorted by the y values of the signs (from top to bottom).
+* The estimated pole position is updated from the running sum of the
+* center X coordinates, so the signs don't need to be iterated again.
+*/
+void RoadSignAPI::DetectedSignCombination::
+		addDetectedSign(DetectedSignDescriptor detectedSign)
+{
+
+	this->insertSorted(&detectedSign);
+
+	this->estimatedPoleXSum +=
+			(detectedSign.lowerRight.x + detectedSign.upperLeft.x) / 2;
+
+	this->estimatedPolePositionX =
+			this->estimatedPoleXSum / (int) this->signs.size();
+}
+
+/**
+ * @brief Adds a sign to the end of the list of signs of this combination.
+ *
+ * Like addDetectedSign(...), but without keeping the list sorted, for
+ * adding many signs at once: call sortDetectedSigns() after the last one.
+ */
+void RoadSignAPI::DetectedSignCombination::
+		appendDetectedSign(const DetectedSignDescriptor& detectedSign)
+{
+	this->signs.push_back(detectedSign);
+
+	this->estimatedPoleXSum +=
+			(detectedSign.lowerRight.x + detectedSign.upperLeft.x) / 2;
+
+	this->estimatedPolePositionX =
+			this->estimatedPoleXSum / (int) this->signs.size();
+}
+
+/**
+ * @brief Sorts the signs of this combination by their y values (from top
+ * to bottom).
+ *
+ * Signs with the same y value keep the order they were added in, so the
+ * result is the same as adding all of them with addDetectedSign(...).
+ */
+void RoadSignAPI::DetectedSignCombination::sortDetectedSigns()
+{
+	std::stable_sort(this->signs.begin(), this->signs.end(),
+			[](const DetectedSignDescriptor& first,
+					const DetectedSignDescriptor& second)
+			{
+				return first.upperLeft.y < second.upperLeft.y;
+			});
+}
+
+/** @brief Inserts a detectedSign at the right position of this combination
+*
+* Uses insertion sort to add the detected sign to the
+* list of signs in the this combination, so that the list is
+* sorted by the y values of the signs (from top to bottom).
+*/
+void RoadSignAPI::DetectedSignCombination::insertSorted(
+		DetectedSignDescriptor* detectedSign)
+{
+	if(this->signs.size() == 0)
+	{
+		this->signs.push_back(*detectedSign);
+	}
+	else
+	{
+		DetectedSignDescriptor* currentSign;
+
+		int currentSignPosYUpperLeft = 0;
+		int signToAddPosYUpperLeft = detectedSign->upperLeft.y;
+
+		bool added = false;
+
+
+		for(int i = 0; i < this->signs.size(); i++)
+		{
+
+			currentSign = &this->signs.at(i);
+			currentSignPosYUpperLeft = currentSign->upperLeft.y;
+
+			// the array is sorted from top to bottom, so if the (upper) y
+			// coordinate of the sign to add is higher as the (upper) y
+			// coordinate of the currentSign, while we are iterating
+			// from top to bottom, insert the sign at the position of the
+			// currentSign.
+			if(signToAddPosYUpperLeft < currentSignPosYUpperLeft)
+			{
+
+				this->signs.insert(this->signs.begin() + i , *detectedSign);
+				added = true;
+				break;
+			}
+
+
+
+		}
+		if(!added)
+		{
+			this->signs.push_back(*detectedSign);
+		}
+	}
+}
+
+/**
+ * @brief Returns the amount of signs contained by this combination.
+ * @return int Size of the list (= amount of entries in the list) containing
+ * all @link{DetectedSignDescriptor}s of this combination.
+ */
+int RoadSignAPI::DetectedSignCombination::getDetectedSignsAmount() const
+{
+	return this->signs.size();
+}
+
+/**
+ * @brief Returns the estimated pole position X coordinate of this sign combination.
+ *
+ * The estimated pole position X is calculated by forming the average of
+ * the center X coordinate (middle of the box in which a sign is contained).
+ */
+int RoadSignAPI::DetectedSignCombination::getGestimatedPolePositionX() const
+{
+	return this->estimatedPolePositionX;
+}
+
+/**
+ * @brief Returns the ID of the track this combination belongs to.
+ *
+ * Combinations showing the same pole in consecutive frames get the same
+ * ID (see ClassifiedSignsGrouper and SignCombinationTrack).
+ *
+ * @return uint32_t the track ID, 0 if the combination is not tracked
+ */
+uint32_t RoadSignAPI::DetectedSignCombination::getTrackID() const
+{
+	return this->trackID;
+}
+
+/**
+ * @brief Sets the ID of the track this combination belongs to.
+ *
+ * Called by the ClassifiedSignsGrouper.
+ *
+ * @param uint32_t trackID the track ID
+ */
+void RoadSignAPI::DetectedSignCombination::setTrackID(uint32_t trackID)
+{
+	this->trackID = trackID;
+}
+
+/**
+ * @brief Returns a vector containing all Signs of this combination.
+ *
+ * All @link{DetectedSignCombination}s which were added to this combination
+ * will be added to a list, which can be retrieved using this function.
+ * This list is sorted by the y values of the signs from top to bottom.
+ */
+const std::vector<RoadSignAPI::DetectedSignDescriptor>*
+				 RoadSignAPI::DetectedSignCombination::
+									getSignsInCombination() const
+{
+	return &this->signs;
+}
+
+/**
+ * @brief Standard Destructor of DetectedSignCombination.
+ *
+ * Standard Destructor of DetectedSignCombination, does not do any specific
+ * tasks.
+ */
+RoadSignAPI::DetectedSignCombination::~DetectedSignCombination()
+{
+
+}
@@ -0,0 +1,217 @@
+/*
+ * DetectionTable.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#include "RoadSignAPI/DetectionTable.h"
+
+#include <algorithm>
+
+/**
+ * @brief Returns the number of detected signs (rows) in the table.
+ */
+int RoadSignAPI::DetectionTable::size() const
+{
+	return this->x1.size();
+}
+
+/**
+ * @brief Returns true if the table contains no detected signs.
+ */
+bool RoadSignAPI::DetectionTable::empty() const
+{
+	return this->x1.empty();
+}
+
+/**
+ * @brief Removes all detected signs, the capacity of the columns is kept.
+ */
+void RoadSignAPI::DetectionTable::clear()
+{
+	this->resize(0);
+}
+
+/**
+ * @brief Resizes all columns to count rows. New rows are zero, except for
+ * classifierApprovedClassID which is UNCLASSIFIED_SIGN_CLASS_ID.
+ *
+ * @param int count the new number of rows
+ */
+void RoadSignAPI::DetectionTable::resize(int count)
+{
+	this->x1.resize(count);
+	this->y1.resize(count);
+	this->x2.resize(count);
+	this->y2.resize(count);
+	this->detectorConfidence.resize(count);
+	this->detectionPredictedClassID.resize(count);
+	this->classifierApprovedClassID.resize(count,
+			UNCLASSIFIED_SIGN_CLASS_ID);
+	this->classifierConfidence.resize(count);
+}
+
+/**
+ * @brief Reserves memory for count rows in all columns.
+ *
+ * @param int count number of rows
+ */
+void RoadSignAPI::DetectionTable::reserve(int count)
+{
+	this->x1.reserve(count);
+	this->y1.reserve(count);
+	this->x2.reserve(count);
+	this->y2.reserve(count);
+	this->detectorConfidence.reserve(count);
+	this->detectionPredictedClassID.reserve(count);
+	this->classifierApprovedClassID.reserve(count);
+	this->classifierConfidence.reserve(count);
+}
+
+/**
+ * @brief Appends a detected sign as the last row.
+ *
+ * @param const DetectedSignDescriptor& descriptor the sign to append
+ */
+void RoadSignAPI::DetectionTable::append(
+		const DetectedSignDescriptor& descriptor)
+{
+	this->x1.push_back(descriptor.upperLeft.x);
+	this->y1.push_back(descriptor.upperLeft.y);
+	this->x2.push_back(descriptor.lowerRight.x);
+	this->y2.push_back(descriptor.lowerRight.y);
+	this->detectorConfidence.push_back(descriptor.detectorConfidence);
+	this->detectionPredictedClassID.push_back(
+			descriptor.detectionPredictedClassID);
+	this->classifierApprovedClassID.push_back(
+			descriptor.classifierApprovedClassID);
+	this->classifierConfidence.push_back(descriptor.classifierConfidence);
+}
+
+/**
+ * @brief Appends detections decoded by SSDPostProcessor, scaled to the
+ * size of the original image.
+ *
+ * The detections are converted in one pass per column, the coordinates
+ * are truncated like cv::Point truncates them.
+ *
+ * @param const SSDDetections& ssdDetections detections with normalized
+ * boxes
+ *
+ * @param int imageWidth width of the original image
+ *
+ * @param int imageHeight height of the original image
+ */
+void RoadSignAPI::DetectionTable::appendSSDDetections(
+		const FilterManagementLibrary::SSDDetections& ssdDetections,
+		int imageWidth, int imageHeight)
+{
+	const int count = ssdDetections.size();
+	const int first = this->size();
+	this->resize(first + count);
+
+	const float width = imageWidth;
+	const float height = imageHeight;
+
+	int* x1 = this->x1.data() + first;
+	int* y1 = this->y1.data() + first;
+	int* x2 = this->x2.data() + first;
+	int* y2 = this->y2.data() + first;
+	float* detectorConfidence = this->detectorConfidence.data() + first;
+	int* detectionPredictedClassID =
+			this->detectionPredictedClassID.data() + first;
+
+	const float* xMin = ssdDetections.xMin.data();
+	const float* yMin = ssdDetections.yMin.data();
+	const float* xMax = ssdDetections.xMax.data();
+	const float* yMax = ssdDetections.yMax.data();
+
+	for(int i = 0; i < count; i++)
+	{
+		x1[i] = (int) (width * xMin[i]);
+		y1[i] = (int) (height * yMin[i]);
+		x2[i] = (int) (width * xMax[i]);
+		y2[i] = (int) (height * yMax[i]);
+	}
+
+	std::copy(ssdDetections.scores.begin(), ssdDetections.scores.end(),
+			detectorConfidence);
+	std::copy(ssdDetections.classIDs.begin(), ssdDetections.classIDs.end(),
+			detectionPredictedClassID);
+}
+
+/**
+ * @brief Removes a row by overwriting it with the last row, so the order
+ * of the rows changes, but no other rows need to be moved.
+ *
+ * @param int index the row to remove
+ */
+void RoadSignAPI::DetectionTable::removeBySwapWithBack(int index)
+{
+	this->x1[index] = this->x1.back();
+	this->y1[index] = this->y1.back();
+	this->x2[index] = this->x2.back();
+	this->y2[index] = this->y2.back();
+	this->detectorConfidence[index] = this->detectorConfidence.back();
+	this->detectionPredictedClassID[index] =
+			this->detectionPredictedClassID.back();
+	this->classifierApprovedClassID[index] =
+			this->classifierApprovedClassID.back();
+	this->classifierConfidence[index] = this->classifierConfidence.back();
+
+	this->resize(this->size() - 1);
+}
+
+/**
+ * @brief Returns a row as DetectedSignDescriptor.
+ *
+ * @param int index the row
+ */
+RoadSignAPI::DetectedSignDescriptor
+		RoadSignAPI::DetectionTable::getDescriptor(int index) const
+{
+	DetectedSignDescriptor descriptor;
+	descriptor.upperLeft = cv::Point(this->x1[index], this->y1[index]);
+	descriptor.lowerRight = cv::Point(this->x2[index], this->y2[index]);
+	descriptor.detectionPredictedClassID =
+			this->detectionPredictedClassID[index];
+	descriptor.detectorConfidence = this->detectorConfidence[index];
+	descriptor.classifierApprovedClassID =
+			this->classifierApprovedClassID[index];
+	descriptor.classifierConfidence = this->classifierConfidence[index];
+	return descriptor;
+}
+
+/**
+ * @brief Converts the table to a vector of descriptors, in the order of
+ * the rows.
+ *
+ * @param std::vector<DetectedSignDescriptor>* descriptors is overwritten
+ * with one descriptor per row
+ */
+void RoadSignAPI::DetectionTable::toDescriptors(
+		std::vector<DetectedSignDescriptor>* descriptors) const
+{
+	const int count = this->size();
+
+	descriptors->resize(count);
+	for(int i = 0; i < count; i++)
+		(*descriptors)[i] = this->getDescriptor(i);
+}
+
+/**
+ * @brief Replaces the content of the table by a vector of descriptors.
+ *
+ * @param const std::vector<DetectedSignDescriptor>& descriptors one row
+ * is created per descriptor, in the same order
+ */
+void RoadSignAPI::DetectionTable::fromDescriptors(
+		const std::vector<DetectedSignDescriptor>& descriptors)
+{
+	this->clear();
+	this->reserve(descriptors.size());
+
+	for(const DetectedSignDescriptor& descriptor : descriptors)
+		this->append(descriptor);
+}
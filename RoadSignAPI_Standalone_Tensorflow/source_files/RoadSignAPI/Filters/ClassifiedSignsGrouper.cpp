@@ -1,153 +1,403 @@
-/*
- * ClassifiedSignsGrouper.cpp
- *
- *  Created on: 21.06.2018
- *      Author: oracion
- */
-
-
-#include "RoadSignAPI/Filters/ClassifiedSignsGrouper.h"
-
-
-/**
- * @brief Initializes the filter.
- *
- * As this filter does not need any specific environment variables,
- * nothing really exciting is happenning here..
- *
- * @return true, always
- */
-bool RoadSignAPI::ClassifiedSignsGrouper::initByPipeSetup()
-{
-	FilterManagementLibrary::Logger::printfln("ClassifiedSignsGrouper init");
-
-	this->castedWorkingDataSet =
-			(RSAPIWorkingDataSet*) this->pipeWorkingDataSet;
-
-
-	return true;
-}
-
-/** @brief The process function of this filter.
- *
- * Iterates through all signs that were successfully classified and
- * whose IDs were thus added to the classifierApprovedSigns list
- * of the @link{RSAPIWorkingDataSet}. It calculates an estimated
- * Position of the pole of a sign (by using the middle of the
- * X coordinates of the edges of the box in which a sign is contained)
- * and adding a threshold to it defined in the local member variable
- * horizontalRangePercentage. which should not be to big!
- * For the first sign in the list, a new @link{DetectedSignCombination}
- * will be created. For all other signs, they are checked against all
- * existing signCombinations (so for the second sign, there is exactly one!).
- * If their X coordinates match the estimated pole area of a
- * @link{DetectedSignCombination), than they are added to it (one sign
- * is only added to one combination!). If no matching combination were found,
- * a new one is created.
- *
- */
-bool RoadSignAPI::ClassifiedSignsGrouper::process()
-{
-	// Store current image width in a local copy
-	this->imageWidth = this->castedWorkingDataSet->originalImageWidth;
-
-	// first is the left boundary, second is the right boundary
-	// of the box in (from y = 0 : imageHeight) in which the pole
-	// of the signCombination is expected.
-	std::pair<int, int> detectedSignCombinationEstimatedPoleArea;
-
-	int currentGroupEstimatedPolePositionX;
-
-	int currentSignHorizontalMiddle = 0;
-
-	int poleAreaHorizontalRangeInEachDirection =
-			this->imageWidth * this->horizontalRangePercentage;
-
-
-	DetectedSignDescriptor* currentDetectedSignDescriptor;
-
-	bool signAddedToExistingCombination = false;
-	DetectedSignCombination* detectedSignCombination;
-	for(int classifiedSignID : this->castedWorkingDataSet->classifierApprovedSigns)
-	{
-
-		signAddedToExistingCombination = false;
-
-		currentDetectedSignDescriptor =
-				&this->castedWorkingDataSet->detectedSigns[classifiedSignID];
-
-		currentSignHorizontalMiddle =
-				(currentDetectedSignDescriptor->lowerRight.x +
-				currentDetectedSignDescriptor->upperLeft.x) / 2;
-
-
-		// Iterate over all already created sign combinations and check
-		// if the current sign fits into the combination because it's
-		// estimated pole position is contained within the
-		// detectedSignCombinationEstimatedPoleArea of the current combination.
-		if(this->castedWorkingDataSet->detectedSignCombinations.size() > 0)
-		{
-			for(int j = 0; j <
-				this->castedWorkingDataSet->detectedSignCombinations.size(); j++)
-			{
-				// Calculate the estimated pole area of the sign combination.
-
-				detectedSignCombination = &this->castedWorkingDataSet->detectedSignCombinations[j];
-
-				// First is left boundary
-
-				detectedSignCombinationEstimatedPoleArea.first =
-						detectedSignCombination->getGestimatedPolePositionX()
-						- poleAreaHorizontalRangeInEachDirection;
-
-				if(detectedSignCombinationEstimatedPoleArea.first < 0)
-					detectedSignCombinationEstimatedPoleArea.first = 0;
-
-				// Second is right boundary
-				detectedSignCombinationEstimatedPoleArea.second =
-						detectedSignCombination->getGestimatedPolePositionX()
-						+ poleAreaHorizontalRangeInEachDirection;
-
-				if(detectedSignCombinationEstimatedPoleArea.second
-							> this->imageWidth)
-								detectedSignCombinationEstimatedPoleArea.second
-									= this->imageWidth;
-
-				if(detectedSignCombinationEstimatedPoleArea.second > this->imageWidth)
-					detectedSignCombinationEstimatedPoleArea.second = this->imageWidth;
-
-
-
-
-				// Check if the current sign fits into the combination.
-
-
-				if(currentSignHorizontalMiddle >=
-						detectedSignCombinationEstimatedPoleArea.first &&
-						currentSignHorizontalMiddle <=
-						detectedSignCombinationEstimatedPoleArea.second)
-				{
-					signAddedToExistingCombination = true;
-
-					// This will also recalculate the estimatedPolePositionX
-					// of the combination.
-					detectedSignCombination->addDetectedSign(
-							*currentDetectedSignDescriptor);
-					break;
-				}
-			}
-		}
-
-		if(!signAddedToExistingCombination)
-		{
-			// In this case we create a new combination and add the sign to it.
-			DetectedSignCombination newDetectedSignCombination;
-			newDetectedSignCombination.addDetectedSign(*currentDetectedSignDescriptor);
-			this->castedWorkingDataSet->detectedSignCombinations.
-								push_back(newDetectedSignCombination);
-		}
-	}
-
-	this->indicateProcessingFinished();
-	return true;
-}
+/*
+ * ClassifiedSignsGrouper.cpp
+ *
+ *  Created on: 21.06.2018
+ *      Author: oracion
+ */
+
+
+#include "RoadSignAPI/Filters/ClassifiedSignsGrouper.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+
+/**
+ * @brief Initializes the filter.
+ *
+ * As this filter does not need any specific environment variables,
+ * nothing really exciting is happenning here..
+ *
+ * @return true, always
+ */
+bool RoadSignAPI::ClassifiedSignsGrouper::initByPipeSetup()
+{
+	FilterManagementLibrary::Logger::printfln("ClassifiedSignsGrouper init");
+
+	this->castedWorkingDataSet =
+			(RSAPIWorkingDataSet*) this->pipeWorkingDataSet;
+
+	// Data flow for the DAG scheduling mode of the pipe
+	this->declareInput("classifiedSigns");
+	this->declareOutput("signCombinations");
+
+
+	return true;
+}
+
+/** @brief The process function of this filter.
+ *
+ * Iterates through all signs that were successfully classified and
+ * whose IDs were thus added to the classifierApprovedSigns list
+ * of the @link{RSAPIWorkingDataSet}. It calculates an estimated
+ * Position of the pole of a sign (by using the middle of the
+ * X coordinates of the edges of the box in which a sign is contained)
+ * and adding a threshold to it defined in the local member variable
+ * horizontalRangePercentage. which should not be to big!
+ * Signs whose X coordinates match the estimated pole area of a
+ * @link{DetectedSignCombination) are added to it (one sign is only added
+ * to one combination!), for all other signs a new combination is created
+ * (see groupSigns(...)).
+ * Afterwards, the combinations are assigned to the tracks of the previous
+ * frames (see updateTracks()).
+ * This filter is invoked for every frame, even if no signs were
+ * classified, so tracks of poles which are not visible anymore expire.
+ * As the last filter of the frame, it also copies the detections table
+ * to the detectedSigns the API returns.
+ *
+ */
+bool RoadSignAPI::ClassifiedSignsGrouper::process()
+{
+	// Store current image width in a local copy
+	this->imageWidth = this->castedWorkingDataSet->originalImageWidth;
+
+	this->castedWorkingDataSet->detections.toDescriptors(
+			&this->castedWorkingDataSet->detectedSigns);
+
+	this->groupSigns(this->castedWorkingDataSet->detectedSigns,
+			this->castedWorkingDataSet->classifierApprovedSigns,
+			this->imageWidth,
+			&this->castedWorkingDataSet->detectedSignCombinations);
+	this->updateTracks();
+
+	this->indicateProcessingFinished();
+	return true;
+}
+
+/**
+ * @brief Sets the width of the pole area, see horizontalRangePercentage.
+ *
+ * @param float horizontalRangePercentage range in each direction as
+ * percentage of the image width
+ */
+void RoadSignAPI::ClassifiedSignsGrouper::setHorizontalRangePercentage(
+		float horizontalRangePercentage)
+{
+	this->horizontalRangePercentage = horizontalRangePercentage;
+}
+
+/**
+ * @brief Groups signs into @link{DetectedSignCombination}s by their
+ * estimated pole position, see process().
+ *
+ * The signs are visited in the order of signIDs. Each one joins the
+ * first combination (in the order they were created) whose pole area,
+ * the average center of its signs +- horizontalRangePercentage of the
+ * image width clamped to the image, contains the center of the sign.
+ * Otherwise it starts a new combination. As pole areas move while signs
+ * join, the result depends on the order of the signs, i.e. for chained
+ * pole areas.
+ * Instead of checking every sign against every combination, the pole
+ * positions are kept sorted, so only the combinations whose pole lies
+ * within the range of the sign center are checked (usually at most
+ * one), found by binary search. This gives the same combinations as
+ * checking all of them with O(log n) comparisons per sign for poles which
+ * are apart. Adding a new pole still moves all poles right of it in the
+ * sorted vector, so n separate poles cost O(n^2) element moves in the
+ * worst case, which are cheap compared to the checks they replace.
+ * The signs are appended to their combinations unsorted and each
+ * combination is sorted by y once at the end.
+ *
+ * @param const std::vector<DetectedSignDescriptor>& detectedSigns all
+ * signs of the frame
+ *
+ * @param const std::vector<int>& signIDs indices of the signs in
+ * detectedSigns which shall be grouped
+ *
+ * @param int imageWidth width of the image the signs were detected in
+ *
+ * @param std::vector<DetectedSignCombination>* combinations receives the
+ * combinations (cleared first)
+ */
+void RoadSignAPI::ClassifiedSignsGrouper::groupSigns(
+		const std::vector<DetectedSignDescriptor>& detectedSigns,
+		const std::vector<int>& signIDs, int imageWidth,
+		std::vector<DetectedSignCombination>* combinations)
+{
+	combinations->clear();
+	this->polePositions.clear();
+
+	const int poleAreaHorizontalRangeInEachDirection =
+			imageWidth * this->horizontalRangePercentage;
+
+	for(int i = 0; i < signIDs.size(); i++)
+	{
+		const DetectedSignDescriptor* sign = &detectedSigns[signIDs[i]];
+		const int signHorizontalMiddle =
+				(sign->lowerRight.x + sign->upperLeft.x) / 2;
+
+		// Position in polePositions of the matching combination
+		int match = -1;
+
+		// The clamped pole area contains the middle exactly if the pole
+		// is within the range of the middle and the middle is within the
+		// image
+		if(signHorizontalMiddle >= 0 && signHorizontalMiddle <= imageWidth)
+		{
+			std::vector<std::pair<int, int> >::const_iterator pole =
+					std::lower_bound(this->polePositions.begin(),
+							this->polePositions.end(),
+							std::make_pair(signHorizontalMiddle -
+									poleAreaHorizontalRangeInEachDirection,
+									std::numeric_limits<int>::min()));
+
+			for(; pole != this->polePositions.end() &&
+					pole->first <= signHorizontalMiddle +
+							poleAreaHorizontalRangeInEachDirection; pole++)
+			{
+				if(match < 0 ||
+						pole->second < this->polePositions[match].second)
+				{
+					match = pole - this->polePositions.begin();
+				}
+			}
+		}
+
+		if(match < 0)
+		{
+			combinations->push_back(DetectedSignCombination());
+			combinations->back().appendDetectedSign(*sign);
+
+			const std::pair<int, int> polePosition = std::make_pair(
+					combinations->back().getGestimatedPolePositionX(),
+					(int) combinations->size() - 1);
+
+			this->polePositions.insert(std::upper_bound(
+					this->polePositions.begin(), this->polePositions.end(),
+					polePosition), polePosition);
+			continue;
+		}
+
+		DetectedSignCombination* combination =
+				&(*combinations)[this->polePositions[match].second];
+		combination->appendDetectedSign(*sign);
+
+		// The pole moved a bit, restore the order
+		this->polePositions[match].first =
+				combination->getGestimatedPolePositionX();
+
+		while(match > 0 && this->polePositions[match] <
+				this->polePositions[match - 1])
+		{
+			std::swap(this->polePositions[match],
+					this->polePositions[match - 1]);
+			match--;
+		}
+
+		while(match + 1 < this->polePositions.size() &&
+				this->polePositions[match + 1] < this->polePositions[match])
+		{
+			std::swap(this->polePositions[match],
+					this->polePositions[match + 1]);
+			match++;
+		}
+	}
+
+	for(DetectedSignCombination& combination : *combinations)
+	{
+		combination.sortDetectedSigns();
+	}
+}
+
+/**
+ * @brief Assigns the combinations of the current frame to the
+ * @link{SignCombinationTrack}s of the previous frames.
+ *
+ * All pairs of combination and track whose poles are within
+ * trackMatchingRangePercentage of the image width are sorted by distance
+ * and assigned greedily, closest first, so each track gets at most one
+ * combination. Combinations without a track start a new one, tracks
+ * without a combination are MISSED until they expire after
+ * maxMissedFrames frames.
+ * Each combination gets the ID of its track (see
+ * DetectedSignCombination::getTrackID()).
+ */
+void RoadSignAPI::ClassifiedSignsGrouper::updateTracks()
+{
+	std::vector<DetectedSignCombination>* combinations =
+			&this->castedWorkingDataSet->detectedSignCombinations;
+	std::vector<SignCombinationTrack>* tracks =
+			&this->castedWorkingDataSet->signCombinationTracks;
+
+	this->castedWorkingDataSet->expiredSignCombinationTrackIDs.clear();
+
+	const int trackMatchingRange =
+			this->imageWidth * this->trackMatchingRangePercentage;
+
+	this->trackMatchingCandidates.clear();
+
+	for(int i = 0; i < combinations->size(); i++)
+	{
+		for(int j = 0; j < tracks->size(); j++)
+		{
+			const int distance = std::abs(
+					(*combinations)[i].getGestimatedPolePositionX() -
+					(int) (*tracks)[j].estimatedPolePositionX);
+
+			if(distance <= trackMatchingRange)
+			{
+				this->trackMatchingCandidates.push_back(
+						std::make_pair(distance, std::make_pair(i, j)));
+			}
+		}
+	}
+
+	std::sort(this->trackMatchingCandidates.begin(),
+			this->trackMatchingCandidates.end());
+
+	this->trackMatched.assign(tracks->size(), false);
+
+	for(const std::pair<int, std::pair<int, int> >& candidate :
+			this->trackMatchingCandidates)
+	{
+		DetectedSignCombination* combination =
+				&(*combinations)[candidate.second.first];
+
+		// Combinations of the current frame are not tracked yet, so a
+		// trackID != 0 means it was already assigned to a closer track.
+		if(this->trackMatched[candidate.second.second] ||
+				combination->getTrackID() != 0)
+		{
+			continue;
+		}
+
+		SignCombinationTrack* track = &(*tracks)[candidate.second.second];
+
+		this->trackMatched[candidate.second.second] = true;
+		combination->setTrackID(track->trackID);
+		this->updateTrack(track, *combination);
+	}
+
+	// Remove expired tracks, keeping the order of the remaining ones
+	int keptTracks = 0;
+	for(int j = 0; j < tracks->size(); j++)
+	{
+		SignCombinationTrack* track = &(*tracks)[j];
+
+		if(!this->trackMatched[j])
+		{
+			track->state = SignCombinationTrackState::MISSED;
+			track->missedFrames++;
+
+			if(track->missedFrames > this->maxMissedFrames)
+			{
+				this->castedWorkingDataSet->
+						expiredSignCombinationTrackIDs.push_back(
+								track->trackID);
+				continue;
+			}
+		}
+
+		if(keptTracks != j)
+			(*tracks)[keptTracks] = std::move(*track);
+
+		keptTracks++;
+	}
+	tracks->erase(tracks->begin() + keptTracks, tracks->end());
+
+	for(int i = 0; i < combinations->size(); i++)
+	{
+		DetectedSignCombination* combination = &(*combinations)[i];
+
+		if(combination->getTrackID() != 0)
+			continue;
+
+		SignCombinationTrack track;
+		track.trackID = this->nextTrackID++;
+		if(this->nextTrackID == 0)
+			this->nextTrackID = 1;
+
+		track.state = SignCombinationTrackState::NEW;
+		track.estimatedPolePositionX =
+				combination->getGestimatedPolePositionX();
+		track.hits = 1;
+		track.missedFrames = 0;
+		track.reportedPolePositionX =
+				combination->getGestimatedPolePositionX();
+
+		for(const DetectedSignDescriptor& sign :
+				*combination->getSignsInCombination())
+		{
+			track.reportedClassIDs.push_back(sign.classifierApprovedClassID);
+		}
+
+		combination->setTrackID(track.trackID);
+		track.combination = *combination;
+
+		tracks->push_back(std::move(track));
+	}
+}
+
+/**
+ * @brief Updates a track with the combination assigned to it in the
+ * current frame.
+ *
+ * The pole position of the track is a running average: the plain average
+ * of all positions for the first 1 / poleSmoothingFactor frames, an
+ * exponential moving average afterwards (so it follows the pole while
+ * the car moves). The track is UPDATED if its signs changed or if its
+ * pole moved by more than reportThresholdPercentage of the image width
+ * since it was last reported, UNCHANGED otherwise.
+ *
+ * @param SignCombinationTrack* track the track to update
+ *
+ * @param const DetectedSignCombination& combination the combination
+ * assigned to the track
+ */
+void RoadSignAPI::ClassifiedSignsGrouper::updateTrack(
+		SignCombinationTrack* track,
+		const DetectedSignCombination& combination) const
+{
+	track->hits++;
+	track->missedFrames = 0;
+
+	const float weight = std::max(1.0f / track->hits,
+			this->poleSmoothingFactor);
+
+	track->estimatedPolePositionX += weight *
+			(combination.getGestimatedPolePositionX() -
+			track->estimatedPolePositionX);
+
+	track->combination = combination;
+
+	const std::vector<DetectedSignDescriptor>* signs =
+			combination.getSignsInCombination();
+
+	bool changed = std::abs((int) track->estimatedPolePositionX -
+			track->reportedPolePositionX) >
+			this->imageWidth * this->reportThresholdPercentage;
+
+	changed = changed || signs->size() != track->reportedClassIDs.size();
+
+	for(int i = 0; !changed && i < signs->size(); i++)
+	{
+		changed = (*signs)[i].classifierApprovedClassID !=
+				track->reportedClassIDs[i];
+	}
+
+	if(!changed)
+	{
+		track->state = SignCombinationTrackState::UNCHANGED;
+		return;
+	}
+
+	track->state = SignCombinationTrackState::UPDATED;
+	track->reportedPolePositionX = (int) track->estimatedPolePositionX;
+	track->reportedClassIDs.clear();
+
+	for(const DetectedSignDescriptor& sign : *signs)
+	{
+		track->reportedClassIDs.push_back(sign.classifierApprovedClassID);
+	}
+}
@@ -1,266 +1,507 @@
-/*
- * SSDLite_RoadSignDetector.cpp
- *
- *  Created on: 03.06.2018
- *      Author: Patrick Langer
- */
-
-
-#include "RoadSignAPI/Filters/SSDLiteRoadSignDetector.h"
-#include "RoadSignAPI/DetectedSignDescriptor.h"
-#include "RoadSignAPI/RSAPIPipeRegisteredFilters/RSAPIPipeRegisteredFilters.h"
-#include "FilterManagementLibrary/Logger.h"
-#include "FilterManagementLibrary/TensorflowOpenCVUtils.h"
-
-
-#ifdef __ANDROID__
-/**
- * @brief Constructor of SSDLiteRoadSignDetector for Android environments.
- * It basically just calls the TFNNBasedPipeFilter super constructor.
- * Refer to it for a more detailed description.
- * Under Android, the RoadSignAPI expects the model files of our neuronal
- * networks to be placed in the assets folder of the app.
- * Thus, this constructor needs to be passed a pointer to an AssetManager
- * (from java), which is MANDATORY for the RoadSignAPI under Android!
- *
- * All other class-member variables will be initialized to their default values.
- *
- * @param TensorflowNNModelDescription nnModelDescription a description of
- * the Tensorflow model which will be used by the filter.
- *
- * @param int numThreads number of threads Tensorflow is allowed to use
- * for computation.
- *
- * @param AAssetManager* const assetManager pointer to an Android Asset
- * Manager which needs to be passed from the Java part of the Android App
- * by any means. Manadatory to load the neuronal network models from
- * the assets directory of the app.
- */
-RoadSignAPI::SSDLiteRoadSignDetector::SSDLiteRoadSignDetector(
-		FilterManagementLibrary::TFIntegration::
-		TensorflowNNModelDescription nnModelDescription, int numThreads,
-		 AAssetManager* const assetManager) :
-		TFNNBasedPipeFilter(nnModelDescription, numThreads),
-		castedWorkingDataSet(NULL), nnModelInputHeight(0),
-		nnModelInputWidth(0), assetManager(assetManager)
-{
-
-}
-#else
-/**
- * @brief Constructor of SSDLiteRoadSignDetector
- * It basically just calls the TFNNBasedPipeFilter super constructor.
- * Refer to it for a more detailed description.
- *
- * All class-member variables will be initialized to their default values.
- *
- * @param TensorflowNNModelDescription nnModelDescription a description of
- * the Tensorflow model which will be used by the filter.
- *
- * @param int numThreads number of threads Tensorflow is allowed to use
- * for computation.
- */
-RoadSignAPI::SSDLiteRoadSignDetector::SSDLiteRoadSignDetector(
-		FilterManagementLibrary::TFIntegration::
-		TensorflowNNModelDescription nnModelDescription, int numThreads) :
-		TFNNBasedPipeFilter(nnModelDescription, numThreads),
-		castedWorkingDataSet(NULL), nnModelInputHeight(0),
-		nnModelInputWidth(0)
-{
-
-}
-#endif
-
-/**
- * @brief Initializes the filter.
- *
- * Will be called by ProcessingPipeline.
- * Here, basically just the neuronal network model will be loaded.
- * For this, the setupModel() function will be called, refer to
- * TFNNBasedPipeFilter for a more detailed description.
- * Also the RSAPIWorkingDataSet's detectorSgaledBGRImage
- * will be initialized (with the corresponding size and type).
- *
- * @return true, if the model could be loaded successfully, flase otherwise
- */
-bool RoadSignAPI::SSDLiteRoadSignDetector::initByPipeSetup()
-{
-	this->castedWorkingDataSet =
-			(RSAPIWorkingDataSet*) this->pipeWorkingDataSet;
-			
-	FilterManagementLibrary::Logger::printfln("RoadSignDetector init");
-	FilterManagementLibrary::Logger::printfln("Loading model ...");
-
-	// As this code belongs to the RoadSignAPI, and RoadSignAPI does not solve
-	// any general tasks but rather has a really specific task: road sign,
-	// detection we do not care about a more fancy way to provide a platform
-	// independent way to setup the model files: As under Android, both
-	// setupModelFromAssets(...) and setupModelFromFile() are available, as
-	// the FilterManagementLibrary provides them, we would need a separate
-	// initByPipeSetup() function (like one for Android, one for other
-	// systems), if not using the #ifdef approach (because either how,
-	// somwehere has to be checked if we are under Android and if that's the
-	// case, we want to load the model file from Assets, but this code would
-	// not be able to compile under other systems if just using a normal
-	// variable to determine whether we are under Android, for example).
-	#ifdef __ANDROID__
-		if(this->setupModelFromAssets(this->assetManager))
-	#else
-		if(this->setupModelFromFile())
-	#endif
-	{
-		FilterManagementLibrary::Logger::printfln("Model loaded");
-
-		const FilterManagementLibrary::
-				TFIntegration::TensorflowNNModelDescription*
-				modelDescription = this->getNNModelDescription();
-		this->nnModelInputHeight = modelDescription->inputHeight;
-		this->nnModelInputWidth = modelDescription->inputWidth;
-
-		this->castedWorkingDataSet->detectorScaledBGRImage =
-				cv::Mat(this->nnModelInputWidth,
-						this->nnModelInputHeight, CV_8UC3);
-		return true;
-	}
-	else
-	{
-		FilterManagementLibrary::Logger::printfln("Setup model failed");
-		return false;
-	}
-}
-
-/**
- * @brief Uses the neuronal network to detect signs on the current image.
- *
- * The originalBGR image will be scaled to the size the network model expects.
- * Afterfards, it uses the TFNNBasedPipeFilter super class's
- * evaluateInputVectorByNN() function to detect the road signs.
- * @return true if evaluateInputVectorByNN() return true, false otherwise
- * (does NOT return false if no signs were detected!)
- */
-bool RoadSignAPI::SSDLiteRoadSignDetector::process()
-{
-	this->castedWorkingDataSet->detectedSigns.clear();
-	this->castedWorkingDataSet->detectedSignCombinations.clear();
-
-	cv::resize(this->castedWorkingDataSet->originalBGRImage,
-			this->castedWorkingDataSet->detectorScaledBGRImage,
-			cv::Size(this->nnModelInputWidth, this->nnModelInputHeight),
-			0.0, 0.0, cv::INTER_CUBIC );
-
-
-	this->applyImageVectorFromOpenCVMat(
-			&this->castedWorkingDataSet->detectorScaledBGRImage);
-
-
-	
-	if(this->evaluateInputVectorByNN())
-	{
-		// Will be ignored if this->indicateProcessingFinished(); was called
-		this->invokeNext(((RSAPIPipeRegisteredFilters*)
-				this->pipeRegisteredFilters)->
-					SIGN_DUPLICATION_DELETER_FILTER);
-		return true;
-	}
-	else
-	{
-		FilterManagementLibrary::Logger::printfln("Failed.");
-		return false;
-	}
-}
-
-/**
- * @brief Callback, will be called when the network finished it's prediction
- *
- * In process(), the TFNNBasedPipeFilter's (super class)
- * evaluteInputVectorByNN() will be called. If it was successfull,
- * this callback will be called and passed a TensorflowResultContainer
- * with the result of the inference of the neuronal network model.
- * Here, we will interpete the output of the network.
- * We iterate over all it's detections and add them to a
- * DetectedSignDescriptor, if the cofidence exceeds a certain threshold value.
- * This descriptor is then added to RSAPIWorkingDataSet.
- *
- * @param const TensorflowResultContainer resultContainer contains the
- * results (in Tensorflow tensors) of the network prediction.
- */
-void RoadSignAPI::SSDLiteRoadSignDetector::onNNEvaluationFinished
-				(const FilterManagementLibrary::TFIntegration::
-						TensorflowResultContainer resultContainer)
-{
-
-	tensorflow::TTypes<float>::Flat scores = resultContainer.getOutputTensorByLayerName(
-			"detection_scores")->flat<float>();
-	tensorflow::TTypes<float>::Flat classes = resultContainer.getOutputTensorByLayerName(
-			"detection_classes")->flat<float>();
-	tensorflow::TTypes<float>::Flat num_detections = resultContainer.getOutputTensorByLayerName(
-			"num_detections")->flat<float>();
-	auto boxes = resultContainer.getOutputTensorByLayerName(
-			"detection_boxes")->flat_outer_dims<float,3>();
-
-	if(num_detections(0) > 0)
-	{
-		for(size_t i = 0; i < num_detections(0) && i < 20;++i)
-		{
-
-			if(scores(i) > this->threshold)
-			{
-
-				RoadSignAPI::DetectedSignDescriptor detectedSignDescriptor;
-
-
-				detectedSignDescriptor.upperLeft =
-						cv::Point(this->castedWorkingDataSet->
-								originalImageWidth * boxes(0, i, 1),
-								this->castedWorkingDataSet->
-								originalImageHeight * boxes(0, i, 0));
-								
-				detectedSignDescriptor.lowerRight =
-						cv::Point(this->castedWorkingDataSet->
-								originalImageWidth * boxes(0, i, 3) ,
-								this->castedWorkingDataSet->
-								originalImageHeight * boxes(0, i, 2));
-
-				detectedSignDescriptor.detectionPredictedClassID = (int) classes(i);
-
-				detectedSignDescriptor.detectorConfidence = (float) scores(i);
-
-
-
-				this->castedWorkingDataSet->detectedSigns.push_back(
-						detectedSignDescriptor);
-
-			}
-		}
-	}
-	else
-	{
-		// If we did not detect any sign on the image, that's okay!
-		// It's not an error. As in this case any following hasn't any
-		// work to do, we just indicate that the current working data
-		// set has been fully processed!
-
-		this->indicateProcessingFinished();
-	}
-
-
-
-}
-
-/**
- * @brief Uses TensorflowOpenCVUtils to apply a mat as input to the network.
- *
- * @param cv::Mat *mat pointer to an OpenCV Mat which shall be used as input.
- *
- * @return void
- */
-void RoadSignAPI::SSDLiteRoadSignDetector::
-		applyImageVectorFromOpenCVMat(cv::Mat *mat)
-{
-	FilterManagementLibrary::TensorflowOpenCVUtils::
-		fastApplyCVMatOnInputTensorUInt8(mat,
-				this->getNNInputTensor());
-}
-
-
-
+/*
+ * SSDLite_RoadSignDetector.cpp
+ *
+ *  Created on: 03.06.2018
+ *      Author: Patrick Langer
+ */
+
+
+#include "RoadSignAPI/Filters/SSDLiteRoadSignDetector.h"
+#include "RoadSignAPI/DetectedSignDescriptor.h"
+#include "RoadSignAPI/RSAPIPipeRegisteredFilters/RSAPIPipeRegisteredFilters.h"
+#include "FilterManagementLibrary/Logger.h"
+#include "FilterManagementLibrary/TensorflowOpenCVUtils.h"
+#include "FilterManagementLibrary/YUVImageUtils.h"
+
+#include <algorithm>
+
+
+#ifdef __ANDROID__
+/**
+ * @brief Constructor of SSDLiteRoadSignDetector for Android environments.
+ * It basically just calls the TFNNBasedPipeFilter super constructor.
+ * Refer to it for a more detailed description.
+ * Under Android, the RoadSignAPI expects the model files of our neuronal
+ * networks to be placed in the assets folder of the app.
+ * Thus, this constructor needs to be passed a pointer to an AssetManager
+ * (from java), which is MANDATORY for the RoadSignAPI under Android!
+ *
+ * All other class-member variables will be initialized to their default values.
+ *
+ * @param TensorflowNNModelDescription nnModelDescription a description of
+ * the Tensorflow model which will be used by the filter.
+ *
+ * @param int numThreads number of threads Tensorflow is allowed to use
+ * for computation.
+ *
+ * @param AAssetManager* const assetManager pointer to an Android Asset
+ * Manager which needs to be passed from the Java part of the Android App
+ * by any means. Manadatory to load the neuronal network models from
+ * the assets directory of the app.
+ */
+RoadSignAPI::SSDLiteRoadSignDetector::SSDLiteRoadSignDetector(
+		FilterManagementLibrary::TFIntegration::
+		TensorflowNNModelDescription nnModelDescription, int numThreads,
+		 AAssetManager* const assetManager) :
+		TFNNBasedPipeFilter(nnModelDescription, numThreads),
+		castedWorkingDataSet(NULL), nnModelInputHeight(0),
+		nnModelInputWidth(0), assetManager(assetManager)
+{
+
+}
+#else
+/**
+ * @brief Constructor of SSDLiteRoadSignDetector
+ * It basically just calls the TFNNBasedPipeFilter super constructor.
+ * Refer to it for a more detailed description.
+ *
+ * All class-member variables will be initialized to their default values.
+ *
+ * @param TensorflowNNModelDescription nnModelDescription a description of
+ * the Tensorflow model which will be used by the filter.
+ *
+ * @param int numThreads number of threads Tensorflow is allowed to use
+ * for computation.
+ */
+RoadSignAPI::SSDLiteRoadSignDetector::SSDLiteRoadSignDetector(
+		FilterManagementLibrary::TFIntegration::
+		TensorflowNNModelDescription nnModelDescription, int numThreads) :
+		TFNNBasedPipeFilter(nnModelDescription, numThreads),
+		castedWorkingDataSet(NULL), nnModelInputHeight(0),
+		nnModelInputWidth(0)
+{
+
+}
+#endif
+
+/**
+ * @brief Initializes the filter.
+ *
+ * Will be called by ProcessingPipeline.
+ * Here, basically just the neuronal network model will be loaded
+ * (see loadModels()).
+ * Also the RSAPIWorkingDataSet's detectorSgaledBGRImage
+ * will be initialized (with the corresponding size and type).
+ *
+ * @return true, if the model could be loaded successfully, flase otherwise
+ */
+bool RoadSignAPI::SSDLiteRoadSignDetector::initByPipeSetup()
+{
+	this->castedWorkingDataSet =
+			(RSAPIWorkingDataSet*) this->pipeWorkingDataSet;
+
+	// Data flow for the DAG scheduling mode of the pipe
+	this->declareInput("frame");
+	this->declareOutput("detectedSigns");
+			
+	FilterManagementLibrary::Logger::printfln("RoadSignDetector init");
+
+	if(!this->loadModels())
+		return false;
+
+	this->applyModelInputSize();
+	return true;
+}
+
+/**
+ * @brief Loads all model variants which are not loaded yet.
+ *
+ * For this, the setupModelFromFile() or setupModelFromAssets() function
+ * will be called accordingly, depending whether we are under an Android
+ * environment or not. Refer to TFNNBasedPipeFilter for a more detailed
+ * description. Can be called again after a model variant was added
+ * (see TFNNBasedPipeFilter::addModelVariant(...)).
+ *
+ * @return true, if the models could be loaded successfully, false otherwise
+ */
+bool RoadSignAPI::SSDLiteRoadSignDetector::loadModels()
+{
+	FilterManagementLibrary::Logger::printfln("Loading model ...");
+
+	// As this code belongs to the RoadSignAPI, and RoadSignAPI does not solve
+	// any general tasks but rather has a really specific task: road sign,
+	// detection we do not care about a more fancy way to provide a platform
+	// independent way to setup the model files: As under Android, both
+	// setupModelFromAssets(...) and setupModelFromFile() are available, as
+	// the FilterManagementLibrary provides them, we would need a separate
+	// initByPipeSetup() function (like one for Android, one for other
+	// systems), if not using the #ifdef approach (because either how,
+	// somwehere has to be checked if we are under Android and if that's the
+	// case, we want to load the model file from Assets, but this code would
+	// not be able to compile under other systems if just using a normal
+	// variable to determine whether we are under Android, for example).
+	#ifdef __ANDROID__
+		if(this->setupModelFromAssets(this->assetManager))
+	#else
+		if(this->setupModelFromFile())
+	#endif
+	{
+		FilterManagementLibrary::Logger::printfln("Model loaded");
+		return true;
+	}
+	else
+	{
+		FilterManagementLibrary::Logger::printfln("Setup model failed");
+		return false;
+	}
+}
+
+/**
+ * @brief Replaces a model variant by a new model while the pipe keeps
+ * running.
+ *
+ * The model is loaded in the background from the Android assets or from
+ * file, like loadModels() does, and swapped in between two frames, see
+ * TFNNBasedPipeFilter::replaceModelVariantFromFile(...).
+ *
+ * @param int modelVariant index of the variant to replace, 0 for the
+ * model passed to the constructor
+ *
+ * @param TensorflowNNModelDescription nnModelDescription description of
+ * the new model
+ *
+ * @return true, if loading the model was started, false otherwise
+ */
+bool RoadSignAPI::SSDLiteRoadSignDetector::replaceModel(int modelVariant,
+		FilterManagementLibrary::TFIntegration::TensorflowNNModelDescription
+		nnModelDescription)
+{
+	#ifdef __ANDROID__
+		return this->replaceModelVariantFromAssets(modelVariant,
+				nnModelDescription, this->assetManager);
+	#else
+		return this->replaceModelVariantFromFile(modelVariant,
+				nnModelDescription);
+	#endif
+}
+
+/**
+ * @brief Takes the input size of the selected model variant and
+ * allocates the RSAPIWorkingDataSet's detectorScaledBGRImage accordingly.
+ * Also checks whether the model includes the postprocessing of the
+ * object detection API (see rawModelOutputs) and generates the anchors
+ * if the model does not output them.
+ */
+void RoadSignAPI::SSDLiteRoadSignDetector::applyModelInputSize()
+{
+	const FilterManagementLibrary::
+			TFIntegration::TensorflowNNModelDescription*
+			modelDescription = this->getNNModelDescription();
+	this->nnModelInputHeight = modelDescription->inputHeight;
+	this->nnModelInputWidth = modelDescription->inputWidth;
+
+	this->rawModelOutputs = std::find(
+			modelDescription->outputLayerNames.begin(),
+			modelDescription->outputLayerNames.end(), "num_detections") ==
+					modelDescription->outputLayerNames.end();
+
+	if(this->rawModelOutputs && modelDescription->outputLayerNames.size() < 3)
+	{
+		FilterManagementLibrary::SSDPostProcessor::generateAnchors(
+				this->anchorParameters, this->nnModelInputWidth,
+				this->nnModelInputHeight, &this->generatedAnchors);
+	}
+	else
+		this->generatedAnchors.clear();
+
+	this->castedWorkingDataSet->detectorScaledBGRImage =
+			cv::Mat(this->nnModelInputHeight,
+					this->nnModelInputWidth, CV_8UC3);
+}
+
+/**
+ * @brief Adapts to the input size of the newly selected model variant
+ * (see TFNNBasedPipeFilter::selectModelVariant(...)).
+ */
+void RoadSignAPI::SSDLiteRoadSignDetector::onModelVariantChanged()
+{
+	// Not set up by the pipe yet, initByPipeSetup() will do it
+	if(this->castedWorkingDataSet == NULL)
+		return;
+
+	this->applyModelInputSize();
+}
+
+/**
+ * @brief Lets the detector only run on every keyframeInterval-th frame.
+ *
+ * The frames in between reuse the detections of the last keyframe
+ * (which the classifier then classifies on the current frame), which is
+ * reported as DEGRADATION_DETECTIONS_REUSED. Should not be called while
+ * the pipe is processing a frame.
+ *
+ * @param int keyframeInterval 1 to detect on every frame (default)
+ */
+void RoadSignAPI::SSDLiteRoadSignDetector::setKeyframeInterval(
+		int keyframeInterval)
+{
+	keyframeInterval = keyframeInterval > 1 ? keyframeInterval : 1;
+
+	if(keyframeInterval != this->keyframeInterval)
+	{
+		// The next frame is a keyframe, so no stale detections are reused
+		this->keyframeInterval = keyframeInterval;
+		this->framesSinceKeyframe = -1;
+	}
+}
+
+/**
+ * @brief Sets the confidence a detection needs to exceed, see threshold.
+ *
+ * Takes effect with the next keyframe, the detections which are reused
+ * until then were filtered with the previous threshold.
+ *
+ * @param float threshold confidence between 0 and 1
+ */
+void RoadSignAPI::SSDLiteRoadSignDetector::setThreshold(float threshold)
+{
+	this->threshold = threshold;
+}
+
+/**
+ * @brief Sets how many detections are kept at most per frame, see
+ * maxDetections.
+ *
+ * @param int maxDetections the detections with the highest confidence
+ * are kept
+ */
+void RoadSignAPI::SSDLiteRoadSignDetector::setMaxDetections(
+		int maxDetections)
+{
+	this->maxDetections = maxDetections > 0 ? maxDetections : 0;
+}
+
+/**
+ * @brief Uses the neuronal network to detect signs on the current image.
+ *
+ * The originalBGR image will be scaled to the size the network model expects.
+ * If the image was fed as YUV frame, the scaled image is sampled straight
+ * from the YUV planes instead (see YUVImageUtils).
+ * Afterfards, it uses the TFNNBasedPipeFilter super class's
+ * evaluateInputVectorByNN() function to detect the road signs.
+ * Between keyframes (see setKeyframeInterval(...)), the detections of the
+ * last keyframe are reused instead.
+ * @return true if evaluateInputVectorByNN() return true, false otherwise
+ * (does NOT return false if no signs were detected!)
+ */
+bool RoadSignAPI::SSDLiteRoadSignDetector::process()
+{
+	this->castedWorkingDataSet->detections.clear();
+	this->castedWorkingDataSet->detectedSigns.clear();
+	this->castedWorkingDataSet->classifierApprovedSigns.clear();
+	this->castedWorkingDataSet->detectedSignCombinations.clear();
+	this->castedWorkingDataSet->rawDetectionCount = 0;
+
+	const cv::Size imageSize(this->castedWorkingDataSet->originalImageWidth,
+			this->castedWorkingDataSet->originalImageHeight);
+
+	if(this->framesSinceKeyframe >= 0 &&
+			this->framesSinceKeyframe + 1 < this->keyframeInterval &&
+			imageSize == this->keyframeImageSize)
+	{
+		this->framesSinceKeyframe++;
+		this->castedWorkingDataSet->detections = this->keyframeDetections;
+		this->castedWorkingDataSet->rawDetectionCount =
+				this->castedWorkingDataSet->detections.size();
+		this->castedWorkingDataSet->degradationFlags |=
+				DEGRADATION_DETECTIONS_REUSED;
+
+		this->invokeNext(((RSAPIPipeRegisteredFilters*)
+				this->pipeRegisteredFilters)->
+					SIGN_DUPLICATION_DELETER_FILTER);
+		return true;
+	}
+
+	if(this->castedWorkingDataSet->yuvInput)
+	{
+		// Only convert the pixels the network actually sees
+		FilterManagementLibrary::YUVImageUtils::resizeRegionToBGR(
+				this->castedWorkingDataSet->originalYUVFrame,
+				cv::Rect(0, 0,
+						this->castedWorkingDataSet->originalImageWidth,
+						this->castedWorkingDataSet->originalImageHeight),
+				&this->castedWorkingDataSet->detectorScaledBGRImage);
+	}
+	else
+	{
+		cv::resize(this->castedWorkingDataSet->originalBGRImage,
+				this->castedWorkingDataSet->detectorScaledBGRImage,
+				cv::Size(this->nnModelInputWidth, this->nnModelInputHeight),
+				0.0, 0.0, cv::INTER_CUBIC );
+	}
+
+
+	this->applyImageVectorFromOpenCVMat(
+			&this->castedWorkingDataSet->detectorScaledBGRImage);
+
+
+	
+	if(this->evaluateInputVectorByNN())
+	{
+		this->castedWorkingDataSet->rawDetectionCount =
+				this->castedWorkingDataSet->detections.size();
+
+		if(this->keyframeInterval > 1)
+		{
+			this->keyframeDetections =
+					this->castedWorkingDataSet->detections;
+			this->keyframeImageSize = imageSize;
+			this->framesSinceKeyframe = 0;
+		}
+
+		// If nothing was detected, the following filters are skipped by
+		// the pipe up to the grouper (see isInputEmpty() of the filters).
+		this->invokeNext(((RSAPIPipeRegisteredFilters*)
+				this->pipeRegisteredFilters)->
+					SIGN_DUPLICATION_DELETER_FILTER);
+		return true;
+	}
+	else
+	{
+		FilterManagementLibrary::Logger::printfln("Failed.");
+		return false;
+	}
+}
+
+/**
+ * @brief Callback, will be called when the network finished it's prediction
+ *
+ * In process(), the TFNNBasedPipeFilter's (super class)
+ * evaluteInputVectorByNN() will be called. If it was successfull,
+ * this callback will be called and passed a TensorflowResultContainer
+ * with the result of the inference of the neuronal network model.
+ * Here, we will interpete the output of the network.
+ * The float output tensors are used, so this works for quantized
+ * models as well.
+ * The SSDPostProcessor selects the (at most maxDetections) detections
+ * whose cofidence exceeds a certain threshold value, which are then
+ * added to the detections table of the RSAPIWorkingDataSet.
+ * Models without the postprocessing of the object detection API (see
+ * rawModelOutputs) are decoded by the SSDPostProcessor, too, including
+ * the non maximum suppression (with iouThreshold and
+ * maxDetectionsPerClass of SSDPostProcessingParameters, whose defaults
+ * match the pipeline.config of our model).
+ *
+ * @param const TensorflowResultContainer resultContainer contains the
+ * results (in Tensorflow tensors) of the network prediction.
+ */
+void RoadSignAPI::SSDLiteRoadSignDetector::onNNEvaluationFinished
+				(const FilterManagementLibrary::TFIntegration::
+						TensorflowResultContainer resultContainer)
+{
+	this->postProcessingParameters.scoreThreshold = this->threshold;
+	this->postProcessingParameters.maxDetections = this->maxDetections;
+
+	if(this->rawModelOutputs)
+	{
+		tensorflow::Tensor* boxEncodings =
+				resultContainer.getFloatOutputTensorByID(0);
+		tensorflow::Tensor* classPredictions =
+				resultContainer.getFloatOutputTensorByID(1);
+
+		// The box encodings are [1, anchors, 4] or [1, anchors, 1, 4]
+		const int anchorCount = boxEncodings->NumElements() / 4;
+
+		const float* anchors = this->generatedAnchors.data();
+		int availableAnchorCount = this->generatedAnchors.size() / 4;
+
+		if(this->generatedAnchors.empty())
+		{
+			tensorflow::Tensor* anchorTensor =
+					resultContainer.getFloatOutputTensorByID(2);
+			anchors = anchorTensor->flat<float>().data();
+			availableAnchorCount = anchorTensor->NumElements() / 4;
+		}
+
+		if(anchorCount == 0 || availableAnchorCount != anchorCount ||
+				classPredictions->NumElements() % anchorCount != 0)
+		{
+			FilterManagementLibrary::Logger::printfln("SSDLiteRoadSignDetector: "
+					"raw outputs do not match the anchors");
+			return;
+		}
+
+		this->postProcessor.decodeRawOutputs(
+				boxEncodings->flat<float>().data(),
+				classPredictions->flat<float>().data(),
+				anchors, anchorCount,
+				classPredictions->NumElements() / anchorCount,
+				this->postProcessingParameters, &this->ssdDetections);
+	}
+	else
+	{
+		tensorflow::TTypes<float>::Flat scores = resultContainer.getFloatOutputTensorByLayerName(
+				"detection_scores")->flat<float>();
+		tensorflow::TTypes<float>::Flat classes = resultContainer.getFloatOutputTensorByLayerName(
+				"detection_classes")->flat<float>();
+		tensorflow::TTypes<float>::Flat num_detections = resultContainer.getFloatOutputTensorByLayerName(
+				"num_detections")->flat<float>();
+		tensorflow::TTypes<float>::Flat boxes = resultContainer.getFloatOutputTensorByLayerName(
+				"detection_boxes")->flat<float>();
+
+		// Never trust num_detections to be within the output tensors. It
+		// is clamped as float first, converting NaN or infinity to size_t
+		// is undefined (NaN fails the comparison with 0).
+		const size_t detectionLimit = std::min<size_t>(
+				std::min<size_t>(scores.size(), classes.size()),
+				boxes.size() / 4);
+		const float reportedDetections = num_detections(0);
+		const size_t detectionCount = reportedDetections > 0.0f ?
+				std::min(detectionLimit, static_cast<size_t>(std::min(
+						reportedDetections, (float) detectionLimit))) : 0;
+
+		// The boxes tensor is [1, detections, 4]
+		this->postProcessor.decodeDetections(boxes.data(), scores.data(),
+				classes.data(), detectionCount,
+				this->postProcessingParameters, &this->ssdDetections);
+	}
+
+	this->castedWorkingDataSet->detections.appendSSDDetections(
+			this->ssdDetections,
+			this->castedWorkingDataSet->originalImageWidth,
+			this->castedWorkingDataSet->originalImageHeight);
+}
+
+/**
+ * @brief Uses TensorflowOpenCVUtils to apply a mat as input to the network.
+ *
+ * Depending on the input type of the model (see
+ * TensorflowNNModelDescription), the uint8, int8 or float variant of
+ * TensorflowOpenCVUtils is used.
+ *
+ * @param cv::Mat *mat pointer to an OpenCV Mat which shall be used as input.
+ *
+ * @return void
+ */
+void RoadSignAPI::SSDLiteRoadSignDetector::
+		applyImageVectorFromOpenCVMat(cv::Mat *mat)
+{
+	const FilterManagementLibrary::TFIntegration::
+			TensorflowNNModelDescription* modelDescription =
+					this->getNNModelDescription();
+
+	if(modelDescription->input_floating)
+	{
+		FilterManagementLibrary::TensorflowOpenCVUtils::
+			fastApplyCVMatOnInputTensorFloat(mat,
+					this->getNNInputTensor(),
+					modelDescription->input_mean,
+					modelDescription->input_std);
+	}
+	else if(modelDescription->input_int8)
+	{
+		FilterManagementLibrary::TensorflowOpenCVUtils::
+			fastApplyCVMatOnInputTensorInt8(mat,
+					this->getNNInputTensor(),
+					this->getNNInputQuantizationTable());
+	}
+	else
+	{
+		FilterManagementLibrary::TensorflowOpenCVUtils::
+			fastApplyCVMatOnInputTensorUInt8(mat,
+					this->getNNInputTensor());
+	}
+}
+
+
+
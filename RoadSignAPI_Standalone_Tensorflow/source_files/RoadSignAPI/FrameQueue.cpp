@@ -0,0 +1,485 @@
+/*
+ * FrameQueue.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#include "RoadSignAPI/FrameQueue.h"
+#include "FilterManagementLibrary/Logger.h"
+#include "FilterManagementLibrary/Utilities.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+
+/**
+ * @brief Constructor of FrameQueue, streams are added by addStream(...).
+ */
+RoadSignAPI::FrameQueue::FrameQueue() :
+		maxFrameAgeMs(0), waitingConsumers(0), isShutDown(false)
+{
+}
+
+/**
+ * @brief Adds a stream (i.e. a camera) to the queue.
+ *
+ * Must be called before any frames are pushed or acquired.
+ *
+ * @param int priority frames of streams with a higher priority are
+ * handed out first
+ *
+ * @param int bufferCount number of frames of this stream which can be in
+ * use at the same time. One frame may be pending, one per consumer may be
+ * processed and one per producer thread may be filled; with less, frames
+ * are rejected. At least 2 (3 is enough for one producer and one
+ * consumer).
+ *
+ * @return int ID of the stream to pass to push...(...), -1 on failure
+ */
+int RoadSignAPI::FrameQueue::addStream(int priority, int bufferCount)
+{
+	if(bufferCount < 2)
+	{
+		FilterManagementLibrary::Logger::printfln(
+				"FrameQueue: a stream needs at least 2 buffers");
+		return -1;
+	}
+
+	std::unique_ptr<FrameStream> stream(new FrameStream());
+
+	const int streamID = this->streams.size();
+
+	stream->priority = priority;
+	stream->pendingFrame.store(nullptr);
+	stream->pushed.store(0);
+	stream->delivered.store(0);
+	stream->coalesced.store(0);
+	stream->rejected.store(0);
+	stream->expired.store(0);
+	stream->totalQueueingTimeUs.store(0);
+	stream->maxQueueingTimeUs.store(0);
+
+	stream->freeFrames.init(bufferCount);
+
+	for(int i = 0; i < bufferCount; i++)
+	{
+		stream->frames.push_back(
+				std::unique_ptr<QueuedFrame>(new QueuedFrame()));
+		stream->frames.back()->streamID = streamID;
+		stream->freeFrames.tryPush(stream->frames.back().get());
+	}
+
+	this->streams.push_back(std::move(stream));
+
+	// Rebuild the ready queues ordered by descending priority, each
+	// large enough to hold all streams
+	std::vector<int> priorities;
+	for(const std::unique_ptr<FrameStream>& stream : this->streams)
+	{
+		priorities.push_back(stream->priority);
+	}
+	std::sort(priorities.begin(), priorities.end(), std::greater<int>());
+	priorities.erase(std::unique(priorities.begin(), priorities.end()),
+			priorities.end());
+
+	this->readyQueuePriorities = priorities;
+	this->readyQueues.clear();
+
+	for(size_t i = 0; i < priorities.size(); i++)
+	{
+		this->readyQueues.push_back(std::unique_ptr<
+				FilterManagementLibrary::MPMCQueue<int> >(
+				new FilterManagementLibrary::MPMCQueue<int>()));
+		this->readyQueues.back()->init(this->streams.size());
+	}
+
+	for(const std::unique_ptr<FrameStream>& stream : this->streams)
+	{
+		stream->readyQueueIndex = std::find(priorities.begin(),
+				priorities.end(), stream->priority) - priorities.begin();
+	}
+
+	return streamID;
+}
+
+/**
+ * @brief Takes a free buffer of the stream, counts a rejected frame if
+ * there is none.
+ */
+RoadSignAPI::QueuedFrame* RoadSignAPI::FrameQueue::acquireFreeFrame(
+		int streamID)
+{
+	if(streamID < 0 || streamID >= (int) this->streams.size() ||
+			this->isShutDown.load())
+	{
+		return nullptr;
+	}
+
+	FrameStream* stream = this->streams[streamID].get();
+	QueuedFrame* frame;
+
+	if(!stream->freeFrames.tryPop(&frame))
+	{
+		stream->rejected.fetch_add(1, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	return frame;
+}
+
+/**
+ * @brief Makes the filled frame the pending frame of its stream.
+ *
+ * A frame which was still pending is replaced (and its buffer freed).
+ * Otherwise the stream is appended to the ready queue of its priority
+ * and a sleeping consumer is woken up.
+ */
+void RoadSignAPI::FrameQueue::publishFrame(QueuedFrame* frame)
+{
+	FrameStream* stream = this->streams[frame->streamID].get();
+
+	frame->pushTimeUs = getTimeUs();
+	stream->pushed.fetch_add(1, std::memory_order_relaxed);
+
+	QueuedFrame* replacedFrame = stream->pendingFrame.exchange(frame,
+			std::memory_order_acq_rel);
+
+	if(replacedFrame != nullptr)
+	{
+		// Latest frame wins, the stream is already in its ready queue
+		stream->coalesced.fetch_add(1, std::memory_order_relaxed);
+		stream->freeFrames.tryPush(replacedFrame);
+		return;
+	}
+
+	this->readyQueues[stream->readyQueueIndex]->tryPush(frame->streamID);
+
+	// Pairs with the fence in acquireFrame(...): either the consumer sees
+	// the stream in the ready queue or we see the consumer waiting.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	if(this->waitingConsumers.load(std::memory_order_relaxed) > 0)
+	{
+		std::lock_guard<std::mutex> lock(this->waitMutex);
+		this->frameAvailable.notify_one();
+	}
+}
+
+/**
+ * @brief Copies a BGR image into the queue.
+ *
+ * Never blocks. The image is copied into a buffer of the stream, which
+ * keeps its allocation as long as the image size does not change.
+ *
+ * @param int streamID stream returned by addStream(...)
+ *
+ * @param const cv::Mat& image the BGR image
+ *
+ * @param uint64_t frameID ID handed out with the frame
+ *
+ * @return bool true if the frame was queued, false if all buffers of the
+ * stream are in use (or the queue was shut down)
+ */
+bool RoadSignAPI::FrameQueue::pushImage(int streamID, const cv::Mat& image,
+		uint64_t frameID)
+{
+	QueuedFrame* frame = this->acquireFreeFrame(streamID);
+
+	if(frame == nullptr)
+		return false;
+
+	image.copyTo(frame->bgrImage);
+
+	frame->frameID = frameID;
+	frame->yuvInput = false;
+	frame->width = image.cols;
+	frame->height = image.rows;
+	frame->rotate180 = false;
+
+	this->publishFrame(frame);
+	return true;
+}
+
+/**
+ * @brief Copies a YUV 4:2:0 frame into the queue.
+ *
+ * Never blocks. The planes are described like for
+ * RoadSignAPI::feedImageYUV(...) and are copied tightly packed into a
+ * buffer of the stream, so they only need to be valid during the call.
+ *
+ * @param int streamID stream returned by addStream(...)
+ *
+ * @param const uint8_t* const planes[3] pointers to the planes
+ *
+ * @param const int strides[3] row strides of the planes
+ *
+ * @param YUVFormat format memory layout of the frame
+ *
+ * @param int width width of the frame in pixels
+ *
+ * @param int height height of the frame in pixels
+ *
+ * @param bool rotate180 whether the frame shall be rotated
+ *
+ * @param uint64_t frameID ID handed out with the frame
+ *
+ * @return bool true if the frame was queued, false if the description is
+ * invalid or all buffers of the stream are in use
+ */
+bool RoadSignAPI::FrameQueue::pushImageYUV(int streamID,
+		const uint8_t* const planes[3], const int strides[3],
+		FilterManagementLibrary::YUVFormat format, int width, int height,
+		bool rotate180, uint64_t frameID)
+{
+	const bool planar = format == FilterManagementLibrary::YUVFormat::I420;
+
+	if(width <= 0 || height <= 0 || planes[0] == NULL ||
+			planes[1] == NULL || (planar && planes[2] == NULL))
+	{
+		return false;
+	}
+
+	QueuedFrame* frame = this->acquireFreeFrame(streamID);
+
+	if(frame == nullptr)
+		return false;
+
+	const int chromaWidth = (width + 1) / 2;
+	const int chromaHeight = (height + 1) / 2;
+
+	int rowBytes[3] = {width, planar ? chromaWidth : 2 * chromaWidth,
+			planar ? chromaWidth : 0};
+	int rows[3] = {height, chromaHeight, planar ? chromaHeight : 0};
+
+	size_t size = 0;
+	for(int i = 0; i < 3; i++)
+	{
+		frame->yuvStrides[i] = rowBytes[i];
+		frame->yuvPlaneOffsets[i] = size;
+		size += (size_t) rowBytes[i] * rows[i];
+	}
+
+	frame->yuvData.resize(size);
+
+	for(int i = 0; i < 3; i++)
+	{
+		for(int y = 0; y < rows[i]; y++)
+		{
+			memcpy(&frame->yuvData[frame->yuvPlaneOffsets[i] +
+					(size_t) y * rowBytes[i]],
+					planes[i] + (size_t) y * strides[i], rowBytes[i]);
+		}
+	}
+
+	frame->frameID = frameID;
+	frame->yuvInput = true;
+	frame->yuvFormat = format;
+	frame->width = width;
+	frame->height = height;
+	frame->rotate180 = rotate180;
+
+	this->publishFrame(frame);
+	return true;
+}
+
+/**
+ * @brief Takes the pending frame of the first ready stream, highest
+ * priority first, without waiting.
+ *
+ * Frames older than maxFrameAgeMs are dropped on the way.
+ *
+ * @return QueuedFrame* the frame, nullptr if there is none
+ */
+RoadSignAPI::QueuedFrame* RoadSignAPI::FrameQueue::tryAcquireFrame()
+{
+	const int64_t now = getTimeUs();
+
+	for(size_t i = 0; i < this->readyQueues.size(); i++)
+	{
+		int streamID;
+
+		while(this->readyQueues[i]->tryPop(&streamID))
+		{
+			FrameStream* stream = this->streams[streamID].get();
+			QueuedFrame* frame = stream->pendingFrame.exchange(nullptr,
+					std::memory_order_acq_rel);
+
+			if(frame == nullptr)
+				continue;
+
+			const uint64_t queueingTimeUs =
+					std::max<int64_t>(now - frame->pushTimeUs, 0);
+
+			if(this->maxFrameAgeMs > 0 &&
+					queueingTimeUs > (uint64_t) this->maxFrameAgeMs * 1000)
+			{
+				stream->expired.fetch_add(1, std::memory_order_relaxed);
+				stream->freeFrames.tryPush(frame);
+				continue;
+			}
+
+			stream->delivered.fetch_add(1, std::memory_order_relaxed);
+			stream->totalQueueingTimeUs.fetch_add(queueingTimeUs,
+					std::memory_order_relaxed);
+
+			uint64_t maxQueueingTimeUs =
+					stream->maxQueueingTimeUs.load(std::memory_order_relaxed);
+			while(queueingTimeUs > maxQueueingTimeUs &&
+					!stream->maxQueueingTimeUs.compare_exchange_weak(
+							maxQueueingTimeUs, queueingTimeUs,
+							std::memory_order_relaxed))
+			{
+			}
+
+			return frame;
+		}
+	}
+
+	return nullptr;
+}
+
+/**
+ * @brief Waits for the next frame.
+ *
+ * Streams with a higher priority are served first. The frame stays owned
+ * by the queue; pass it to releaseFrame(...) once it (and all results
+ * referring to its pixels) is no longer needed.
+ *
+ * @param int timeoutMs maximum time to wait in milliseconds (negative:
+ * wait forever, 0: don't wait)
+ *
+ * @return QueuedFrame* the frame, nullptr if the timeout expired or the
+ * queue was shut down
+ */
+RoadSignAPI::QueuedFrame* RoadSignAPI::FrameQueue::acquireFrame(
+		int timeoutMs)
+{
+	const std::chrono::steady_clock::time_point deadline =
+			std::chrono::steady_clock::now() +
+			std::chrono::milliseconds(std::max(timeoutMs, 0));
+
+	for(;;)
+	{
+		QueuedFrame* frame = this->tryAcquireFrame();
+
+		if(frame != nullptr || timeoutMs == 0 || this->isShutDown.load())
+			return frame;
+
+		std::unique_lock<std::mutex> lock(this->waitMutex);
+
+		this->waitingConsumers.fetch_add(1);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		frame = this->tryAcquireFrame();
+
+		bool timedOut = false;
+
+		if(frame == nullptr && !this->isShutDown.load())
+		{
+			if(timeoutMs < 0)
+				this->frameAvailable.wait(lock);
+			else
+			{
+				timedOut = this->frameAvailable.wait_until(lock, deadline) ==
+						std::cv_status::timeout;
+			}
+		}
+
+		this->waitingConsumers.fetch_sub(1);
+
+		if(frame != nullptr)
+			return frame;
+
+		if(timedOut)
+		{
+			lock.unlock();
+			return this->tryAcquireFrame();
+		}
+	}
+}
+
+/**
+ * @brief Hands a frame returned by acquireFrame(...) back to its stream.
+ */
+void RoadSignAPI::FrameQueue::releaseFrame(QueuedFrame* frame)
+{
+	if(frame != nullptr)
+		this->streams[frame->streamID]->freeFrames.tryPush(frame);
+}
+
+/**
+ * @brief Wakes up all waiting consumers and refuses further frames,
+ * i.e. before stopping the processing thread.
+ */
+void RoadSignAPI::FrameQueue::shutdown()
+{
+	{
+		std::lock_guard<std::mutex> lock(this->waitMutex);
+		this->isShutDown.store(true);
+	}
+	this->frameAvailable.notify_all();
+}
+
+/**
+ * @brief Sets the maximum age of frames handed out by acquireFrame(...).
+ *
+ * Must not be called while frames are acquired.
+ *
+ * @param int maxFrameAgeMs older frames are dropped (0: never)
+ */
+void RoadSignAPI::FrameQueue::setMaxFrameAge(int maxFrameAgeMs)
+{
+	this->maxFrameAgeMs = std::max(maxFrameAgeMs, 0);
+}
+
+/**
+ * @brief Returns the number of streams added so far.
+ */
+int RoadSignAPI::FrameQueue::getStreamCount() const
+{
+	return this->streams.size();
+}
+
+/**
+ * @brief Returns the counters of a stream.
+ *
+ * The counters are read one by one while frames may be pushed, so they
+ * don't necessarily add up exactly.
+ *
+ * @param int streamID stream returned by addStream(...)
+ *
+ * @return FrameStreamStatistics the counters, all 0 for unknown streams
+ */
+RoadSignAPI::FrameStreamStatistics
+		RoadSignAPI::FrameQueue::getStreamStatistics(int streamID) const
+{
+	FrameStreamStatistics statistics;
+
+	if(streamID < 0 || streamID >= (int) this->streams.size())
+		return statistics;
+
+	const FrameStream* stream = this->streams[streamID].get();
+
+	statistics.pushed = stream->pushed.load(std::memory_order_relaxed);
+	statistics.delivered = stream->delivered.load(std::memory_order_relaxed);
+	statistics.coalesced = stream->coalesced.load(std::memory_order_relaxed);
+	statistics.rejected = stream->rejected.load(std::memory_order_relaxed);
+	statistics.expired = stream->expired.load(std::memory_order_relaxed);
+	statistics.totalQueueingTimeUs =
+			stream->totalQueueingTimeUs.load(std::memory_order_relaxed);
+	statistics.maxQueueingTimeUs =
+			stream->maxQueueingTimeUs.load(std::memory_order_relaxed);
+
+	return statistics;
+}
+
+/**
+ * @brief Returns a monotonic time in microseconds, used for the push
+ * times of the frames (see Utilities::getTimeUs()).
+ */
+int64_t RoadSignAPI::FrameQueue::getTimeUs()
+{
+	return FilterManagementLibrary::Utilities::getTimeUs();
+}
@@ -0,0 +1,207 @@
+/*
+ * QoSController.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#include "RoadSignAPI/QoSController.h"
+#include "FilterManagementLibrary/Logger.h"
+
+#include <algorithm>
+
+/**
+ * @brief Appends an operating point, which needs to be cheaper than the
+ * ones added before.
+ *
+ * @param const QoSOperatingPoint& operatingPoint the operating point
+ *
+ * @return int index of the operating point
+ */
+int RoadSignAPI::QoSController::addOperatingPoint(
+		const QoSOperatingPoint& operatingPoint)
+{
+	this->operatingPoints.push_back(operatingPoint);
+	return this->operatingPoints.size() - 1;
+}
+
+/**
+ * @brief Sets the frame rate the controller tries to hold.
+ *
+ * @param float framesPerSecond target frame rate, 0 disables the
+ * controller (the current operating point is kept)
+ */
+void RoadSignAPI::QoSController::setTargetFrameRate(float framesPerSecond)
+{
+	this->targetFrameTimeUs = framesPerSecond > 0.0f ?
+			(int64_t) (1000000.0f / framesPerSecond) : 0;
+	this->window.reset();
+}
+
+/**
+ * @brief Configures when the controller switches, see the class
+ * description.
+ *
+ * @param float degradeRatio switch to a cheaper point above this
+ * fraction of the target frame time (default 1.0)
+ *
+ * @param float upgradeRatio switch to a better point below this
+ * fraction of the target frame time (default 0.7), needs to be lower than
+ * degradeRatio
+ *
+ * @param int windowFrames frames per decision (default 30)
+ *
+ * @param int upgradeHoldFrames minimum number of frames between a switch
+ * and an upgrade (default 90)
+ *
+ * @param double percentile percentile of the window compared to the
+ * target frame time, 0 to use the mean (default)
+ */
+void RoadSignAPI::QoSController::setHysteresis(float degradeRatio,
+		float upgradeRatio, int windowFrames, int upgradeHoldFrames,
+		double percentile)
+{
+	this->degradeRatio = degradeRatio;
+	this->upgradeRatio = std::min(upgradeRatio, degradeRatio);
+	this->windowFrames = std::max(windowFrames, 1);
+	this->upgradeHoldFrames = std::max(upgradeHoldFrames, 0);
+	this->currentUpgradeHoldFrames = this->upgradeHoldFrames;
+	this->percentile = percentile;
+	this->window.reset();
+}
+
+/**
+ * @brief Returns true if a target frame rate is set and there is more
+ * than one operating point to choose from.
+ */
+bool RoadSignAPI::QoSController::isEnabled() const
+{
+	return this->targetFrameTimeUs > 0 && this->operatingPoints.size() > 1;
+}
+
+/**
+ * @brief Records the processing time of a frame and decides whether to
+ * switch the operating point at the end of a window.
+ *
+ * @param int64_t processingTimeUs processing time of the frame in
+ * microseconds
+ *
+ * @return bool true if the operating point changed, the caller needs to
+ * apply getCurrentOperatingPoint() before the next frame then
+ */
+bool RoadSignAPI::QoSController::recordFrame(int64_t processingTimeUs)
+{
+	if(!this->isEnabled())
+		return false;
+
+	this->framesSinceSwitch++;
+	this->window.record(processingTimeUs);
+
+	if(this->window.getCount() < (uint64_t) this->windowFrames)
+		return false;
+
+	const double latencyUs = this->percentile > 0.0 ?
+			(double) this->window.getPercentile(this->percentile) :
+			this->window.getMean();
+	this->window.reset();
+
+	const int lastOperatingPoint = this->operatingPoints.size() - 1;
+
+	if(latencyUs > this->degradeRatio * this->targetFrameTimeUs &&
+			this->currentOperatingPoint < lastOperatingPoint)
+	{
+		// The better point could not be sustained, probe it less often
+		if(this->lastSwitchWasUpgrade &&
+				this->framesSinceSwitch <= 4 * this->windowFrames)
+		{
+			this->currentUpgradeHoldFrames = std::min(
+					this->currentUpgradeHoldFrames * 2,
+					this->upgradeHoldFrames * 8);
+		}
+
+		this->lastSwitchWasUpgrade = false;
+		this->switchTo(this->currentOperatingPoint + 1);
+		return true;
+	}
+
+	if(latencyUs < this->upgradeRatio * this->targetFrameTimeUs &&
+			this->currentOperatingPoint > 0 &&
+			this->framesSinceSwitch >= this->currentUpgradeHoldFrames)
+	{
+		this->lastSwitchWasUpgrade = true;
+		this->switchTo(this->currentOperatingPoint - 1);
+		return true;
+	}
+
+	// An upgrade which held for a while ends the back-off
+	if(this->lastSwitchWasUpgrade &&
+			this->framesSinceSwitch > 16 * this->windowFrames)
+	{
+		this->currentUpgradeHoldFrames = this->upgradeHoldFrames;
+	}
+
+	return false;
+}
+
+/**
+ * @brief Selects the given operating point and starts a new window.
+ */
+void RoadSignAPI::QoSController::switchTo(int operatingPoint)
+{
+	FilterManagementLibrary::Logger::printfln(
+			"QoS: switching from operating point %d to %d",
+			this->currentOperatingPoint, operatingPoint);
+
+	this->currentOperatingPoint = operatingPoint;
+	this->framesSinceSwitch = 0;
+	this->switchCount++;
+}
+
+/**
+ * @brief Returns the number of operating points.
+ */
+int RoadSignAPI::QoSController::getOperatingPointCount() const
+{
+	return this->operatingPoints.size();
+}
+
+/**
+ * @brief Returns the index of the selected operating point.
+ */
+int RoadSignAPI::QoSController::getCurrentOperatingPointIndex() const
+{
+	return this->currentOperatingPoint;
+}
+
+/**
+ * @brief Returns the selected operating point, NULL if there is none.
+ */
+const RoadSignAPI::QoSOperatingPoint*
+		RoadSignAPI::QoSController::getCurrentOperatingPoint() const
+{
+	if(this->operatingPoints.empty())
+		return NULL;
+
+	return &this->operatingPoints[this->currentOperatingPoint];
+}
+
+/**
+ * @brief Returns how often the operating point changed.
+ */
+uint64_t RoadSignAPI::QoSController::getSwitchCount() const
+{
+	return this->switchCount;
+}
+
+/**
+ * @brief Goes back to the best operating point and forgets the back-off
+ * and the current window.
+ */
+void RoadSignAPI::QoSController::reset()
+{
+	this->currentOperatingPoint = 0;
+	this->currentUpgradeHoldFrames = this->upgradeHoldFrames;
+	this->framesSinceSwitch = 0;
+	this->lastSwitchWasUpgrade = false;
+	this->window.reset();
+}
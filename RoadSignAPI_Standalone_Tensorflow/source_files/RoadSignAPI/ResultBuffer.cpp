@@ -0,0 +1,339 @@
+/*
+ * ResultBuffer.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#include "RoadSignAPI/ResultBuffer.h"
+#include "FilterManagementLibrary/Logger.h"
+
+// The layout is part of the format, so make sure no compiler adds padding.
+static_assert(sizeof(RoadSignAPI::ResultBufferHeader) == 56,
+		"unexpected ResultBufferHeader layout");
+static_assert(sizeof(RoadSignAPI::ResultSignRecord) == 32,
+		"unexpected ResultSignRecord layout");
+static_assert(sizeof(RoadSignAPI::ResultCombinationSpan) == 16,
+		"unexpected ResultCombinationSpan layout");
+
+/**
+ * @brief Returns the number of bytes serialize(...) needs for the given
+ * combinations.
+ *
+ * @param const std::vector<DetectedSignCombination>& combinations
+ * the results to be serialized
+ *
+ * @return size_t required buffer size in bytes
+ */
+size_t RoadSignAPI::ResultBufferWriter::getRequiredSize(
+		const std::vector<DetectedSignCombination>& combinations)
+{
+	size_t signCount = 0;
+
+	for(unsigned int i = 0; i < combinations.size(); i++)
+	{
+		signCount += combinations[i].getDetectedSignsAmount();
+	}
+
+	return sizeof(ResultBufferHeader) +
+			signCount * sizeof(ResultSignRecord) +
+			combinations.size() * sizeof(ResultCombinationSpan);
+}
+
+/**
+ * @brief Serializes the given combinations into a caller provided buffer.
+ *
+ * Does not allocate any memory, so it can be called for every frame
+ * (i.e. writing straight into a shared memory segment). The signs of all
+ * combinations are written one after the other, each combination
+ * references its signs as a span.
+ *
+ * @param const std::vector<DetectedSignCombination>& combinations
+ * the results to be serialized
+ *
+ * @param int imageWidth width of the image the results refer to
+ *
+ * @param int imageHeight height of the image the results refer to
+ *
+ * @param uint64_t frameIndex number of the frame the results belong to
+ *
+ * @param uint8_t* buffer destination, needs to be 8 byte aligned
+ *
+ * @param size_t bufferSize size of buffer in bytes, see getRequiredSize(...)
+ *
+ * @param size_t* writtenSize if not NULL, receives the number of bytes
+ * written
+ *
+ * @param uint32_t degradationFlags DegradationFlag bits of the frame
+ *
+ * @return bool true if the results were written, false if the buffer is
+ * too small or misaligned
+ */
+bool RoadSignAPI::ResultBufferWriter::serialize(
+		const std::vector<DetectedSignCombination>& combinations,
+		int imageWidth, int imageHeight, uint64_t frameIndex,
+		uint8_t* buffer, size_t bufferSize, size_t* writtenSize,
+		uint32_t degradationFlags)
+{
+	const size_t requiredSize = getRequiredSize(combinations);
+
+	if(buffer == NULL || reinterpret_cast<uintptr_t>(buffer) % 8 != 0)
+	{
+		FilterManagementLibrary::Logger::printfln(
+				"ResultBufferWriter: buffer needs to be 8 byte aligned");
+		return false;
+	}
+
+	if(bufferSize < requiredSize)
+	{
+		FilterManagementLibrary::Logger::printfln(
+				"ResultBufferWriter: buffer too small (%zu < %zu bytes)",
+				bufferSize, requiredSize);
+		return false;
+	}
+
+	const uint32_t combinationCount = combinations.size();
+	const uint32_t signCount = (requiredSize - sizeof(ResultBufferHeader) -
+			combinationCount * sizeof(ResultCombinationSpan)) /
+			sizeof(ResultSignRecord);
+
+	ResultBufferHeader* header = reinterpret_cast<ResultBufferHeader*>(buffer);
+	header->magic = RESULT_BUFFER_MAGIC;
+	header->version = RESULT_BUFFER_VERSION;
+	header->headerSize = sizeof(ResultBufferHeader);
+	header->totalSize = requiredSize;
+	header->signCount = signCount;
+	header->combinationCount = combinationCount;
+	header->signRecordSize = sizeof(ResultSignRecord);
+	header->combinationRecordSize = sizeof(ResultCombinationSpan);
+	header->signsOffset = sizeof(ResultBufferHeader);
+	header->combinationsOffset = sizeof(ResultBufferHeader) +
+			signCount * sizeof(ResultSignRecord);
+	header->imageWidth = imageWidth;
+	header->imageHeight = imageHeight;
+	header->degradationFlags = degradationFlags;
+	header->frameIndex = frameIndex;
+
+	ResultSignRecord* signRecords =
+			reinterpret_cast<ResultSignRecord*>(buffer + header->signsOffset);
+	ResultCombinationSpan* combinationSpans =
+			reinterpret_cast<ResultCombinationSpan*>(
+					buffer + header->combinationsOffset);
+
+	uint32_t signIndex = 0;
+
+	for(uint32_t i = 0; i < combinationCount; i++)
+	{
+		const std::vector<DetectedSignDescriptor>* signs =
+				combinations[i].getSignsInCombination();
+
+		combinationSpans[i].firstSign = signIndex;
+		combinationSpans[i].signCount = signs->size();
+		combinationSpans[i].estimatedPolePositionX =
+				combinations[i].getGestimatedPolePositionX();
+		combinationSpans[i].trackID = combinations[i].getTrackID();
+
+		for(unsigned int j = 0; j < signs->size(); j++)
+		{
+			const DetectedSignDescriptor* sign = &signs->at(j);
+			ResultSignRecord* record = &signRecords[signIndex++];
+
+			record->classID = sign->classifierApprovedClassID;
+			record->confidence = sign->classifierConfidence;
+			record->detectorClassID = sign->detectionPredictedClassID;
+			record->detectorConfidence = sign->detectorConfidence;
+			record->upperLeftX = sign->upperLeft.x;
+			record->upperLeftY = sign->upperLeft.y;
+			record->lowerRightX = sign->lowerRight.x;
+			record->lowerRightY = sign->lowerRight.y;
+		}
+	}
+
+	if(writtenSize != NULL)
+		*writtenSize = requiredSize;
+
+	return true;
+}
+
+/**
+ * @brief Constructor of ResultBufferReader.
+ *
+ * The reader is not attached to any buffer after construction.
+ */
+RoadSignAPI::ResultBufferReader::ResultBufferReader() :
+		buffer(NULL), header(NULL)
+{
+}
+
+/**
+ * @brief Attaches the reader to a serialized result buffer.
+ *
+ * Validates the header and all offsets, so the getters do not need to
+ * do any checks later on. Buffers written by a newer version with
+ * larger records can be read as well (the additional fields are ignored).
+ * Nothing is copied.
+ *
+ * @param const uint8_t* buffer serialized results, 8 byte aligned
+ *
+ * @param size_t bufferSize number of valid bytes in buffer
+ *
+ * @return bool true if buffer contains valid results, false otherwise
+ * (the reader is detached then)
+ */
+bool RoadSignAPI::ResultBufferReader::attach(const uint8_t* buffer,
+		size_t bufferSize)
+{
+	this->buffer = NULL;
+	this->header = NULL;
+
+	if(buffer == NULL || reinterpret_cast<uintptr_t>(buffer) % 8 != 0 ||
+			bufferSize < sizeof(ResultBufferHeader))
+	{
+		FilterManagementLibrary::Logger::printfln(
+				"ResultBufferReader: invalid buffer");
+		return false;
+	}
+
+	const ResultBufferHeader* header =
+			reinterpret_cast<const ResultBufferHeader*>(buffer);
+
+	if(header->magic != RESULT_BUFFER_MAGIC)
+	{
+		FilterManagementLibrary::Logger::printfln(
+				"ResultBufferReader: wrong magic value (byte order?)");
+		return false;
+	}
+
+	if(header->version < RESULT_BUFFER_VERSION ||
+			header->headerSize < sizeof(ResultBufferHeader) ||
+			header->signRecordSize < sizeof(ResultSignRecord) ||
+			header->combinationRecordSize < sizeof(ResultCombinationSpan) ||
+			header->signRecordSize % 4 != 0 ||
+			header->combinationRecordSize % 4 != 0 ||
+			header->signsOffset % 4 != 0 ||
+			header->combinationsOffset % 4 != 0 ||
+			header->totalSize > bufferSize)
+	{
+		FilterManagementLibrary::Logger::printfln(
+				"ResultBufferReader: unsupported or corrupt header");
+		return false;
+	}
+
+	const uint64_t signsEnd = static_cast<uint64_t>(header->signsOffset) +
+			static_cast<uint64_t>(header->signCount) * header->signRecordSize;
+	const uint64_t combinationsEnd =
+			static_cast<uint64_t>(header->combinationsOffset) +
+			static_cast<uint64_t>(header->combinationCount) *
+			header->combinationRecordSize;
+
+	if(header->signsOffset < header->headerSize ||
+			header->combinationsOffset < header->headerSize ||
+			signsEnd > header->totalSize ||
+			combinationsEnd > header->totalSize)
+	{
+		FilterManagementLibrary::Logger::printfln(
+				"ResultBufferReader: records exceed the buffer");
+		return false;
+	}
+
+	this->buffer = buffer;
+	this->header = header;
+
+	for(uint32_t i = 0; i < header->combinationCount; i++)
+	{
+		const ResultCombinationSpan* span = this->getCombination(i);
+
+		if(static_cast<uint64_t>(span->firstSign) + span->signCount >
+				header->signCount)
+		{
+			FilterManagementLibrary::Logger::printfln(
+					"ResultBufferReader: combination %u references "
+					"invalid signs", i);
+			this->buffer = NULL;
+			this->header = NULL;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * @brief Returns the header of the attached buffer.
+ *
+ * @return const ResultBufferHeader* the header, or NULL if the reader
+ * is not attached
+ */
+const RoadSignAPI::ResultBufferHeader*
+		RoadSignAPI::ResultBufferReader::getHeader() const
+{
+	return this->header;
+}
+
+/**
+ * @brief Returns the number of signs in the attached buffer.
+ */
+uint32_t RoadSignAPI::ResultBufferReader::getSignCount() const
+{
+	return this->header == NULL ? 0 : this->header->signCount;
+}
+
+/**
+ * @brief Returns the number of combinations in the attached buffer.
+ */
+uint32_t RoadSignAPI::ResultBufferReader::getCombinationCount() const
+{
+	return this->header == NULL ? 0 : this->header->combinationCount;
+}
+
+/**
+ * @brief Returns a sign record of the attached buffer.
+ *
+ * We don't check index here, because we want to be *fast*.
+ *
+ * @param uint32_t index index of the sign, smaller than getSignCount()
+ *
+ * @return const ResultSignRecord* pointer into the attached buffer
+ */
+const RoadSignAPI::ResultSignRecord*
+		RoadSignAPI::ResultBufferReader::getSign(uint32_t index) const
+{
+	return reinterpret_cast<const ResultSignRecord*>(this->buffer +
+			this->header->signsOffset + index * this->header->signRecordSize);
+}
+
+/**
+ * @brief Returns a combination span of the attached buffer.
+ *
+ * We don't check index here, because we want to be *fast*.
+ *
+ * @param uint32_t index index of the combination, smaller than
+ * getCombinationCount()
+ *
+ * @return const ResultCombinationSpan* pointer into the attached buffer
+ */
+const RoadSignAPI::ResultCombinationSpan*
+		RoadSignAPI::ResultBufferReader::getCombination(uint32_t index) const
+{
+	return reinterpret_cast<const ResultCombinationSpan*>(this->buffer +
+			this->header->combinationsOffset +
+			index * this->header->combinationRecordSize);
+}
+
+/**
+ * @brief Returns a sign of a combination of the attached buffer.
+ *
+ * @param uint32_t combinationIndex index of the combination
+ *
+ * @param uint32_t signIndex index of the sign inside the combination,
+ * smaller than its signCount
+ *
+ * @return const ResultSignRecord* pointer into the attached buffer
+ */
+const RoadSignAPI::ResultSignRecord*
+		RoadSignAPI::ResultBufferReader::getSignOfCombination(
+		uint32_t combinationIndex, uint32_t signIndex) const
+{
+	return this->getSign(
+			this->getCombination(combinationIndex)->firstSign + signIndex);
+}
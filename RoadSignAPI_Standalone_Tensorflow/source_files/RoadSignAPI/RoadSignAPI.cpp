@@ -1,424 +1,1661 @@
-/*
- * RoadSignAPI.cpp
- *
- *  Created on: 05.06.2018
- *      Author: Patrick Langer
- */
-
-
-#include "RoadSignAPI/RoadSignAPI.h"
-
-// Instantiation
-RoadSignAPI::RoadSignAPI* RoadSignAPI::RoadSignAPI::instance;
-
-FilterManagementLibrary::TFIntegration::TensorflowNNModelDescription RoadSignAPI::RoadSignAPI::ssdLiteModelDescription;
-FilterManagementLibrary::TFIntegration::TensorflowNNModelDescription RoadSignAPI::RoadSignAPI::mobilenetModelDescription;
-
-
-#ifdef __ANDROID__
-/**
- * @brief Constructor of the RoadSignAPI for Android environments.
- *
- * Under Android, we need a slightly different constructor for the
- * RoadSignAPI: As we want to store the neuronal network model files
- * in the assets folder of the app, we need a Pointer to an AssetManager
- * passed from the Java part of the app (by any means).
- * The Android-platform dependent code of the RoadSignAPI expects this
- * (also refer to {@link SSDLiteRoadSignDetector}
- * and {@link MobilenetV2RoadSignClassificator} for more details).
- * Of course this constructor is only available under Android environments.
- * For other platforms, please use the corresponding constructor.
- * Calls the constructor of the ProcessingPipeline and all filters.
- * Afterwards the filters are registered to the pipe.
- *
- * @param TensorflowNNModelDescription The model description for the detector
- * network.
- *
- * @param TensorflowNNModelDescription The model description for the
- * classificator network.
- *
- * @param const int numThreads Number of threads Tensorflow shall be allowed
- * to use at max.
- *
- * @param AAssetManager* const assetManager pointer to an AssetManager, which
- * we will use to load neuronal network model files from the assets folder of
- * the Android app. Needs to be passed from the Java part of the app
- * by any means.
- */
-RoadSignAPI::RoadSignAPI::RoadSignAPI(FilterManagementLibrary::
-			TFIntegration::TensorflowNNModelDescription
-			detectorModelDescription,
-			FilterManagementLibrary::
-			TFIntegration::TensorflowNNModelDescription
-			classificatorModelDescription,
-			const int numThreads, AAssetManager* const assetManager) :
-
-	processingPipeline(&workingDataSet, &pipeRegisteredFilters, false),
-	roadSignDetector(detectorModelDescription, numThreads, assetManager),
-	roadSignClassificator(
-			classificatorModelDescription, numThreads, assetManager),
-			classifiedSignsGrouper(), roadSignDuplicationDeleter(),
-
-			assetManager(assetManager)
-{
-	this->processingPipeline.registerFilter(
-			&this->roadSignDetector,
-			&this->pipeRegisteredFilters.SIGN_DETECTION_FILTER);
-
-	this->processingPipeline.registerFilter(
-				&this->roadSignClassificator,
-				&this->pipeRegisteredFilters.SIGN_RECOGNITION_FILTER);
-
-	this->processingPipeline.registerFilter(
-				&this->detectionBasedImageSlicer,
-				&this->pipeRegisteredFilters.
-				DETECTION_BASED_IMAGE_SLICER_FILTER);
-
-	this->processingPipeline.registerFilter(
-				&this->classifiedSignsGrouper,
-				&this->pipeRegisteredFilters.
-				CLASSIFIED_SIGNS_GROUPER_FILTER);
-
-	this->processingPipeline.registerFilter(
-				&this->roadSignDuplicationDeleter,
-				&this->pipeRegisteredFilters.
-				SIGN_DUPLICATION_DELETER_FILTER);
-}
-#else
-/**
- * @brief Constructor of the RoadSignAPI for non Android environments.
- *
- * Calls the constructor of the ProcessingPipeline and all filters.
- * Afterwards the filters are registered to the pipe.
- *
- * @param TensorflowNNModelDescription The model description for the detector
- * network.
- *
- * @param TensorflowNNModelDescription The model description for the
- * classificator network.
- *
- * @param const int numThreads Number of threads Tensorflow shall be allowed
- * to use at max.
- *
- */
-RoadSignAPI::RoadSignAPI::RoadSignAPI(FilterManagementLibrary::
-			TFIntegration::TensorflowNNModelDescription
-			detectorModelDescription,
-			FilterManagementLibrary::
-			TFIntegration::TensorflowNNModelDescription
-			classificatorModelDescription,
-			const int numThreads) :
-	processingPipeline(&workingDataSet, &pipeRegisteredFilters, false),
-	roadSignDetector(detectorModelDescription, numThreads),
-	roadSignClassificator(classificatorModelDescription, numThreads),
-	classifiedSignsGrouper(), roadSignDuplicationDeleter()
-{
-
-	this->processingPipeline.registerFilter(
-			&this->roadSignDetector,
-			&this->pipeRegisteredFilters.SIGN_DETECTION_FILTER);
-
-	this->processingPipeline.registerFilter(
-				&this->roadSignClassificator,
-				&this->pipeRegisteredFilters.SIGN_RECOGNITION_FILTER);
-
-	this->processingPipeline.registerFilter(
-				&this->detectionBasedImageSlicer,
-				&this->pipeRegisteredFilters.
-				DETECTION_BASED_IMAGE_SLICER_FILTER);
-
-	this->processingPipeline.registerFilter(
-			&this->classifiedSignsGrouper,
-			&this->pipeRegisteredFilters.
-			CLASSIFIED_SIGNS_GROUPER_FILTER);
-
-	this->processingPipeline.registerFilter(
-				&this->roadSignDuplicationDeleter,
-				&this->pipeRegisteredFilters.
-				SIGN_DUPLICATION_DELETER_FILTER);
-
-
-}
-#endif
-
-/**
- * @brief Initializes the RoadSignAPI's static interface.
- *
- * We use a Singleton to provide a static interface to the RoadSignAPI.
- * This Singleton will be initialized in this function:
- * The model descriptions for the SSDLite and MobilenetV2 neuronal networks
- * will be created, the RoadSignAPI will be instantiated and the
- * ProcessingPipeline's setUp function is called.
- */
-bool RoadSignAPI::RoadSignAPI::init()
-{
-	return this->processingPipeline.setup();
-}
-
-
-/**
- * @brief Takes an OpenCV Mat uses the filter to examine it for road signs.
- */
-bool RoadSignAPI::RoadSignAPI::feedImage(cv::Mat image)
-{
-	this->workingDataSet.originalBGRImage = image;
-	this->workingDataSet.originalImageHeight = image.rows;
-	this->workingDataSet.originalImageWidth = image.cols;
-
-	return this->processingPipeline.processCurrentDataSet();
-}
-
-/**
- * @brief Returns a vector of all detected (not classified!) signs
- *
- * Should only be called after the feedImage(...) function was used.
- * The vector contains all signs which were detected on the previous image.
- *
- * @return const std::vector<DetectedSignDescriptor> a vector containing
- * all detected signs.
- */
-const std::vector<RoadSignAPI::DetectedSignDescriptor>*
-				RoadSignAPI::RoadSignAPI::getDetectedSigns()
-{
-	return &this->workingDataSet.detectedSigns;
-}
-
-/**
- * @brief Returns a vector of all classified signs.
- *
- * Should only be called after the feedImage(...) function was used.
- * The vector contains all signs which were detected AND classified on
- * the previous image. All images which were detected but could not be
- * classified or are classified as a part of the unwanted classes won't
- * be contained in this list!
- *
- * @param std::vector<const DetectedSignDescriptor*>* a pointer to a
- * vector of pointers to a DetectedSignDescriptor. The vector
- * will be filled with the DetectedSignDescriptors of the RSAPIWorkingDataSet
- * which were successfully classified as relevant roadsigns.
- *
- * @return void
- */
-void RoadSignAPI::RoadSignAPI::getClassifierApprovedDetectedSigns(
-		std::vector<const DetectedSignDescriptor*>* detectedSigns)
-{
-
-
-	detectedSigns->clear();
-
-	for(int i = 0; i < this->
-	workingDataSet.classifierApprovedSigns.size(); i++)
-	{
-		detectedSigns->push_back(&this->workingDataSet.detectedSigns
-				[this->workingDataSet.classifierApprovedSigns[i]]);
-	}
-}
-
-
-/**
- * @brief Returns a vector of all @link{DetectedSignCombination}s.
- *
- * Should only be called after the feedImage(...) function was used.
- * The vector contains all signs which were detected AND classified on
- * the previous image grouped into @link{DetectedSignCombination}s.
- * All images which were detected but could not be
- * classified or are classified as a part of the unwanted classes won't
- * be contained in this list!
- *
- * @return const std::vector<DetectedSignCombination>* const pointer to
- * a vector containing all @link{DetectedSignCombination}s, that were
- * found in the image that was lastly provided to feedImage(...).
- */
-const std::vector<RoadSignAPI::DetectedSignCombination>*
-			const RoadSignAPI::RoadSignAPI::getDetectedSignCombinations() const
-{
-	return &this->workingDataSet.detectedSignCombinations;
-}
-
-#ifdef __ANDROID__
-/**
- * @brief Initializes the RoadSignAPI's static interface.
- *
- * This is the staticInit function for Android environments. As under Android,
- * we want the neuronal network model files to be stored inside the assets
- * folder of the app, we need an AssetManager passed from the Java part of the
- * app to be able to do so. On non Android environments, this function just lacks
- * it's last parameter.
- *
- * We use a Singleton to provide a static interface to the RoadSignAPI.
- * This Singleton will be initialized in this function:
- * The model descriptions for the SSDLite and MobilenetV2 neuronal networks
- * will be created, the RoadSignAPI will be instantiated and the
- * ProcessingPipeline's setUp function is called.
- *
- */
-bool RoadSignAPI::RoadSignAPI::staticInit(
-		const int numThreads, AAssetManager* const assetManager)
-{
-
-
-	RoadSignAPI::RoadSignAPI::
-		ssdLiteModelDescription.inputHeight = 300;
-	RoadSignAPI::RoadSignAPI::
-		ssdLiteModelDescription.inputWidth = 300;
-	RoadSignAPI::RoadSignAPI::
-		ssdLiteModelDescription.channels = 3;
-	RoadSignAPI::RoadSignAPI::
-		ssdLiteModelDescription.input_floating = false;
-	RoadSignAPI::RoadSignAPI::
-		ssdLiteModelDescription.inputLayerNameStr = "image_tensor";
-	RoadSignAPI::RoadSignAPI::
-		ssdLiteModelDescription.outputLayerNames =
-		{"detection_boxes","detection_scores","detection_classes","num_detections"};
-	RoadSignAPI::RoadSignAPI::
-		ssdLiteModelDescription.modelFile = "ssdlite.pb";
-
-
-
-	RoadSignAPI::RoadSignAPI::
-		mobilenetModelDescription.inputHeight = 96;
-	RoadSignAPI::RoadSignAPI::
-		mobilenetModelDescription.inputWidth = 96;
-	RoadSignAPI::RoadSignAPI::
-	mobilenetModelDescription.channels = 3;
-	RoadSignAPI::RoadSignAPI::
-		mobilenetModelDescription.input_floating = true;
-	RoadSignAPI::RoadSignAPI::
-		mobilenetModelDescription.inputLayerNameStr = "input_1";
-	RoadSignAPI::RoadSignAPI::
-		mobilenetModelDescription.outputLayerNames = {"output_node0"};
-	RoadSignAPI::RoadSignAPI::
-		mobilenetModelDescription.modelFile = "mobilenetv2.pb";
-	//RoadSignAPI::RoadSignAPI::instance->processingPipeline.registerFilter((FilterManagementLibrary::PipeSystem::PipeFilter*)(&(RoadSignAPI::RoadSignAPI::instance->roadSignDetector)), &RoadSignAPI::RoadSignAPI::instance->pipeRegisteredFilters.SIGN_DETECTION_FILTER);
-	RoadSignAPI::RoadSignAPI::instance = new RoadSignAPI(RoadSignAPI::RoadSignAPI::
-			ssdLiteModelDescription, RoadSignAPI::RoadSignAPI::
-			mobilenetModelDescription, numThreads, assetManager);
-	return RoadSignAPI::RoadSignAPI::instance->init();
-}
-#else
-/**
- * @brief Initializes the RoadSignAPI's static interface.
- *
- * This is the staticInit function for non-Android environments.
- * We use a Singleton to provide a static interface to the RoadSignAPI.
- * This Singleton will be initialized in this function:
- * The model descriptions for the SSDLite and MobilenetV2 neuronal networks
- * will be created, the RoadSignAPI will be instantiated and the
- * ProcessingPipeline's setUp function is called.
- */
-bool RoadSignAPI::RoadSignAPI::staticInit(const int numThreads)
-{
-
-
-	RoadSignAPI::RoadSignAPI::
-		ssdLiteModelDescription.inputHeight = 300;
-	RoadSignAPI::RoadSignAPI::
-		ssdLiteModelDescription.inputWidth = 300;
-	RoadSignAPI::RoadSignAPI::
-		ssdLiteModelDescription.channels = 3;
-	RoadSignAPI::RoadSignAPI::
-		ssdLiteModelDescription.input_floating = false;
-	RoadSignAPI::RoadSignAPI::
-		ssdLiteModelDescription.inputLayerNameStr = "image_tensor";
-	RoadSignAPI::RoadSignAPI::
-		ssdLiteModelDescription.outputLayerNames =
-		{"detection_boxes","detection_scores","detection_classes","num_detections"};
-	RoadSignAPI::RoadSignAPI::
-		ssdLiteModelDescription.modelFile = "ssdlite.pb";
-
-
-
-	RoadSignAPI::RoadSignAPI::
-		mobilenetModelDescription.inputHeight = 96;
-	RoadSignAPI::RoadSignAPI::
-		mobilenetModelDescription.inputWidth = 96;
-	RoadSignAPI::RoadSignAPI::
-	mobilenetModelDescription.channels = 3;
-	RoadSignAPI::RoadSignAPI::
-		mobilenetModelDescription.input_floating = true;
-	RoadSignAPI::RoadSignAPI::
-		mobilenetModelDescription.input_mean = 127.5f;
-	RoadSignAPI::RoadSignAPI::
-		mobilenetModelDescription.input_std = 127.5f;
-	RoadSignAPI::RoadSignAPI::
-		mobilenetModelDescription.inputLayerNameStr = "input_1";
-	RoadSignAPI::RoadSignAPI::
-		mobilenetModelDescription.outputLayerNames = {"output_node0"};
-	RoadSignAPI::RoadSignAPI::
-		mobilenetModelDescription.modelFile = "mobilenetv2.pb";
-	//RoadSignAPI::RoadSignAPI::instance->processingPipeline.registerFilter((FilterManagementLibrary::PipeSystem::PipeFilter*)(&(RoadSignAPI::RoadSignAPI::instance->roadSignDetector)), &RoadSignAPI::RoadSignAPI::instance->pipeRegisteredFilters.SIGN_DETECTION_FILTER);
-	RoadSignAPI::RoadSignAPI::instance = new RoadSignAPI(RoadSignAPI::RoadSignAPI::
-			ssdLiteModelDescription, RoadSignAPI::RoadSignAPI::
-			mobilenetModelDescription, numThreads);
-	return RoadSignAPI::RoadSignAPI::instance->init();
-}
-#endif
-
-/**
- * @brief Takes an OpenCV Mat uses the filter to examine it for road signs.
- */
-bool RoadSignAPI::RoadSignAPI::staticFeedImage(cv::Mat image)
-{
-	return RoadSignAPI::RoadSignAPI::instance->feedImage(image);
-}
-
-/**
- * @brief Returns a vector of all detected (not classified!) signs
- *
- * Should only be called after the feedImage(...) function was used.
- * The vector contains all signs which were detected on the previous image.
- *
- * @return const std::vector<DetectedSignDescriptor> a vector containing
- * all detected signs.
- */
-const std::vector<RoadSignAPI::DetectedSignDescriptor>*
-				RoadSignAPI::RoadSignAPI::staticGetDetectedSigns()
-{
-	return RoadSignAPI::RoadSignAPI::instance->getDetectedSigns();
-}
-
-/**
- * @brief Returns a vector of all classified signs.
- *
- * Should only be called after the staticFeedImage(...) function was used.
- * The vector contains all signs which were detected AND classified on
- * the previous image. All images which were detected but could not be
- * classified or are classified as a part of the unwanted classes won't
- * be contained in this list!
- *
- * @param std::vector<const DetectedSignDescriptor*>* a pointer to a
- * vector of pointers to a DetectedSignDescriptor. The vector
- * will be filled with the DetectedSignDescriptors of the RSAPIWorkingDataSet
- * which were successfully classified as relevant roadsigns.
- *
- * @return void
- */
-void RoadSignAPI::RoadSignAPI::staticGetClassifierApprovedDetectedSigns(
-		std::vector<const DetectedSignDescriptor*>* detectedSigns)
-{
-
-
-	return RoadSignAPI::RoadSignAPI::instance->
-			getClassifierApprovedDetectedSigns(detectedSigns);
-}
-
-/**
- * @brief Returns a vector of all @link{DetectedSignCombination}s.
- *
- * Should only be called after the staticFeedImage(...) function was used.
- * The vector contains all signs which were detected AND classified on
- * the previous image grouped into @link{DetectedSignCombination}s.
- * All images which were detected but could not be
- * classified or are classified as a part of the unwanted classes won't
- * be contained in this list!
- *
- * @return const std::vector<DetectedSignCombination>* const pointer to
- * a vector containing all @link{DetectedSignCombination}s, that were
- * found in the image that was lastly provided to staticFeedImage(...).
- */
-const std::vector<RoadSignAPI::DetectedSignCombination>*
-			const RoadSignAPI::RoadSignAPI::staticGetDetectedSignCombinations()
-{
-	return RoadSignAPI::RoadSignAPI::instance->getDetectedSignCombinations();
-}
-
+/*
+ * RoadSignAPI.cpp
+ *
+ *  Created on: 05.06.2018
+ *      Author: Patrick Langer
+ */
+
+
+#include "RoadSignAPI/RoadSignAPI.h"
+#include "FilterManagementLibrary/Logger.h"
+#include "FilterManagementLibrary/Utilities.h"
+
+// Instantiation
+RoadSignAPI::RoadSignAPI* RoadSignAPI::RoadSignAPI::instance;
+
+FilterManagementLibrary::TFIntegration::TensorflowNNModelDescription RoadSignAPI::RoadSignAPI::ssdLiteModelDescription;
+FilterManagementLibrary::TFIntegration::TensorflowNNModelDescription RoadSignAPI::RoadSignAPI::mobilenetModelDescription;
+
+
+#ifdef __ANDROID__
+/**
+ * @brief Constructor of the RoadSignAPI for Android environments.
+ *
+ * Under Android, we need a slightly different constructor for the
+ * RoadSignAPI: As we want to store the neuronal network model files
+ * in the assets folder of the app, we need a Pointer to an AssetManager
+ * passed from the Java part of the app (by any means).
+ * The Android-platform dependent code of the RoadSignAPI expects this
+ * (also refer to {@link SSDLiteRoadSignDetector}
+ * and {@link MobilenetV2RoadSignClassificator} for more details).
+ * Of course this constructor is only available under Android environments.
+ * For other platforms, please use the corresponding constructor.
+ * Calls the constructor of the ProcessingPipeline and all filters.
+ * Afterwards the filters are registered to the pipe, and the memory of
+ * the models and of the cv::Mats is accounted to the pipe (see
+ * getPipelineMemoryUsage()).
+ *
+ * @param TensorflowNNModelDescription The model description for the detector
+ * network.
+ *
+ * @param TensorflowNNModelDescription The model description for the
+ * classificator network.
+ *
+ * @param const int numThreads Number of threads Tensorflow shall be allowed
+ * to use at max.
+ *
+ * @param AAssetManager* const assetManager pointer to an AssetManager, which
+ * we will use to load neuronal network model files from the assets folder of
+ * the Android app. Needs to be passed from the Java part of the app
+ * by any means.
+ */
+RoadSignAPI::RoadSignAPI::RoadSignAPI(FilterManagementLibrary::
+			TFIntegration::TensorflowNNModelDescription
+			detectorModelDescription,
+			FilterManagementLibrary::
+			TFIntegration::TensorflowNNModelDescription
+			classificatorModelDescription,
+			const int numThreads, AAssetManager* const assetManager) :
+
+	processingPipeline(&workingDataSet, &pipeRegisteredFilters, false),
+	roadSignDetector(detectorModelDescription, numThreads, assetManager),
+	roadSignClassificator(
+			classificatorModelDescription, numThreads, assetManager),
+			classifiedSignsGrouper(), roadSignDuplicationDeleter(),
+			frameCounter(0), frameBudgetUs(0),
+			tracedClassifierInferenceCount(0),
+
+			assetManager(assetManager)
+{
+	this->processingPipeline.registerFilter(
+			&this->roadSignDetector,
+			&this->pipeRegisteredFilters.SIGN_DETECTION_FILTER);
+
+	this->processingPipeline.registerFilter(
+				&this->roadSignClassificator,
+				&this->pipeRegisteredFilters.SIGN_RECOGNITION_FILTER);
+
+	this->processingPipeline.registerFilter(
+				&this->detectionBasedImageSlicer,
+				&this->pipeRegisteredFilters.
+				DETECTION_BASED_IMAGE_SLICER_FILTER);
+
+	this->processingPipeline.registerFilter(
+				&this->classifiedSignsGrouper,
+				&this->pipeRegisteredFilters.
+				CLASSIFIED_SIGNS_GROUPER_FILTER);
+
+	this->processingPipeline.registerFilter(
+				&this->roadSignDuplicationDeleter,
+				&this->pipeRegisteredFilters.
+				SIGN_DUPLICATION_DELETER_FILTER);
+
+	// The models count towards the memory of the pipe
+	this->roadSignDetector.getMemoryAccount()->setParent(
+			this->processingPipeline.getMemoryAccount());
+	this->roadSignClassificator.getMemoryAccount()->setParent(
+			this->processingPipeline.getMemoryAccount());
+
+	FilterManagementLibrary::MemoryAccount::enableOpenCVAccounting();
+}
+#else
+/**
+ * @brief Constructor of the RoadSignAPI for non Android environments.
+ *
+ * Calls the constructor of the ProcessingPipeline and all filters.
+ * Afterwards the filters are registered to the pipe, and the memory of
+ * the models and of the cv::Mats is accounted to the pipe (see
+ * getPipelineMemoryUsage()).
+ *
+ * @param TensorflowNNModelDescription The model description for the detector
+ * network.
+ *
+ * @param TensorflowNNModelDescription The model description for the
+ * classificator network.
+ *
+ * @param const int numThreads Number of threads Tensorflow shall be allowed
+ * to use at max.
+ *
+ */
+RoadSignAPI::RoadSignAPI::RoadSignAPI(FilterManagementLibrary::
+			TFIntegration::TensorflowNNModelDescription
+			detectorModelDescription,
+			FilterManagementLibrary::
+			TFIntegration::TensorflowNNModelDescription
+			classificatorModelDescription,
+			const int numThreads) :
+	processingPipeline(&workingDataSet, &pipeRegisteredFilters, false),
+	roadSignDetector(detectorModelDescription, numThreads),
+	roadSignClassificator(classificatorModelDescription, numThreads),
+	classifiedSignsGrouper(), roadSignDuplicationDeleter(), frameCounter(0),
+	frameBudgetUs(0), tracedClassifierInferenceCount(0)
+{
+
+	this->processingPipeline.registerFilter(
+			&this->roadSignDetector,
+			&this->pipeRegisteredFilters.SIGN_DETECTION_FILTER);
+
+	this->processingPipeline.registerFilter(
+				&this->roadSignClassificator,
+				&this->pipeRegisteredFilters.SIGN_RECOGNITION_FILTER);
+
+	this->processingPipeline.registerFilter(
+				&this->detectionBasedImageSlicer,
+				&this->pipeRegisteredFilters.
+				DETECTION_BASED_IMAGE_SLICER_FILTER);
+
+	this->processingPipeline.registerFilter(
+			&this->classifiedSignsGrouper,
+			&this->pipeRegisteredFilters.
+			CLASSIFIED_SIGNS_GROUPER_FILTER);
+
+	this->processingPipeline.registerFilter(
+				&this->roadSignDuplicationDeleter,
+				&this->pipeRegisteredFilters.
+				SIGN_DUPLICATION_DELETER_FILTER);
+
+	// The models count towards the memory of the pipe
+	this->roadSignDetector.getMemoryAccount()->setParent(
+			this->processingPipeline.getMemoryAccount());
+	this->roadSignClassificator.getMemoryAccount()->setParent(
+			this->processingPipeline.getMemoryAccount());
+
+	FilterManagementLibrary::MemoryAccount::enableOpenCVAccounting();
+}
+#endif
+
+/**
+ * @brief Initializes the RoadSignAPI's static interface.
+ *
+ * We use a Singleton to provide a static interface to the RoadSignAPI.
+ * This Singleton will be initialized in this function:
+ * The model descriptions for the SSDLite and MobilenetV2 neuronal networks
+ * will be created, the RoadSignAPI will be instantiated and the
+ * ProcessingPipeline's setUp function is called.
+ */
+bool RoadSignAPI::RoadSignAPI::init()
+{
+	return this->processingPipeline.setup();
+}
+
+
+/**
+ * @brief Takes an OpenCV Mat uses the filter to examine it for road signs.
+ */
+bool RoadSignAPI::RoadSignAPI::feedImage(cv::Mat image)
+{
+	this->setBGRInput(image);
+
+	return this->processFrame(
+			FilterManagementLibrary::Utilities::getTimeUs());
+}
+
+/**
+ * @brief Takes a YUV 4:2:0 frame and uses the filter to examine it for road signs.
+ *
+ * In contrast to feedImage(...), the frame is not converted to BGR as a
+ * whole. The filters only sample the pixels they actually need (the
+ * downscaled detector input and the classifier crops) straight from the
+ * YUV planes (see YUVImageUtils), which saves the full resolution color
+ * conversion on every frame.
+ * The planes are not copied, so they only need to stay valid until this
+ * function returns (or until renderAnnotatedImage(...) returns, if the
+ * frame shall be displayed, too).
+ *
+ * @param const uint8_t* const planes[3] pointers to the planes of the frame.
+ * For NV21 / NV12, planes[1] points to the interleaved chroma plane and
+ * planes[2] is ignored.
+ *
+ * @param const int strides[3] row strides in bytes of the planes
+ *
+ * @param YUVFormat format memory layout of the frame
+ *
+ * @param const int width width of the frame in pixels
+ *
+ * @param const int height height of the frame in pixels
+ *
+ * @param const bool rotate180 whether the frame shall be interpreted as
+ * rotated by 180 degrees (all results refer to the rotated image then)
+ *
+ * @return bool true if the frame could be processed, false otherwise
+ */
+bool RoadSignAPI::RoadSignAPI::feedImageYUV(const uint8_t* const planes[3],
+		const int strides[3], FilterManagementLibrary::YUVFormat format,
+		const int width, const int height, const bool rotate180)
+{
+	if(!this->setYUVInput(planes, strides, format, width, height, rotate180))
+		return false;
+
+	return this->processFrame(
+			FilterManagementLibrary::Utilities::getTimeUs());
+}
+
+/**
+ * @brief Feeds a frame acquired from a FrameQueue.
+ *
+ * Nothing is copied, the frame may only be released back to its queue
+ * after the results were read (or rendered).
+ * The frame budget (see setFrameBudget(...)) counts from the time the
+ * frame was pushed, so the time it spent in the queue is included.
+ *
+ * @param const QueuedFrame* frame frame returned by
+ * FrameQueue::acquireFrame(...)
+ *
+ * @return bool true if the frame was processed, false otherwise
+ */
+bool RoadSignAPI::RoadSignAPI::feedQueuedFrame(const QueuedFrame* frame)
+{
+	if(!frame->yuvInput)
+		this->setBGRInput(frame->bgrImage);
+	else
+	{
+		const uint8_t* planes[3];
+		for(int i = 0; i < 3; i++)
+		{
+			planes[i] = frame->yuvData.data() + frame->yuvPlaneOffsets[i];
+		}
+
+		if(!this->setYUVInput(planes, frame->yuvStrides, frame->yuvFormat,
+				frame->width, frame->height, frame->rotate180))
+		{
+			return false;
+		}
+	}
+
+	return this->processFrame(frame->pushTimeUs);
+}
+
+/**
+ * @brief Makes image the input of the next processFrame(...) call.
+ */
+void RoadSignAPI::RoadSignAPI::setBGRInput(cv::Mat image)
+{
+	this->workingDataSet.yuvInput = false;
+	this->workingDataSet.originalBGRImage = image;
+	this->workingDataSet.originalImageHeight = image.rows;
+	this->workingDataSet.originalImageWidth = image.cols;
+}
+
+/**
+ * @brief Makes the given YUV frame the input of the next
+ * processFrame(...) call, see feedImageYUV(...) for the parameters.
+ *
+ * @return bool true on success, false if the frame description is invalid
+ */
+bool RoadSignAPI::RoadSignAPI::setYUVInput(const uint8_t* const planes[3],
+		const int strides[3], FilterManagementLibrary::YUVFormat format,
+		const int width, const int height, const bool rotate180)
+{
+	if(!FilterManagementLibrary::YUVImageUtils::describeFrame(planes, strides,
+			format, width, height, rotate180,
+			&this->workingDataSet.originalYUVFrame))
+	{
+		return false;
+	}
+
+	this->workingDataSet.yuvInput = true;
+	this->workingDataSet.originalBGRImage.release();
+	this->workingDataSet.originalImageHeight = height;
+	this->workingDataSet.originalImageWidth = width;
+
+	return true;
+}
+
+/**
+ * @brief Runs the pipe on the current input.
+ *
+ * Models which were replaced in the background and are ready by now
+ * (see replaceDetectorModel(...)) are swapped in first. Sets the
+ * deadline of the frame from the frame budget, resets the degradation
+ * flags and adds DEGRADATION_DEADLINE_MISSED if the results were not
+ * ready in time anyway. The processing time is passed to the QoS
+ * controller, which may select another operating point for the
+ * following frames.
+ *
+ * @param int64_t arrivalTimeUs time the frame arrived (see
+ * Utilities::getTimeUs()), the budget counts from there
+ *
+ * @return bool true if the frame was processed, false otherwise
+ */
+bool RoadSignAPI::RoadSignAPI::processFrame(int64_t arrivalTimeUs)
+{
+	// Models loaded in the background are swapped in between two frames
+	this->roadSignDetector.applyPendingModelSwap();
+	this->roadSignClassificator.applyPendingModelSwap();
+
+	this->workingDataSet.frameDeadlineUs = this->frameBudgetUs > 0 ?
+			arrivalTimeUs + this->frameBudgetUs : 0;
+	this->workingDataSet.degradationFlags = DEGRADATION_NONE;
+	this->frameCounter++;
+
+	const int64_t startTimeUs = FilterManagementLibrary::Utilities::getTimeUs();
+	const bool processed = this->processingPipeline.processCurrentDataSet();
+	const int64_t endTimeUs = FilterManagementLibrary::Utilities::getTimeUs();
+
+	if(this->workingDataSet.frameDeadlineUs != 0 &&
+			endTimeUs > this->workingDataSet.frameDeadlineUs)
+	{
+		this->workingDataSet.degradationFlags |= DEGRADATION_DEADLINE_MISSED;
+	}
+
+	if(this->frameTraceWriter.isOpen())
+		this->traceFrame(arrivalTimeUs, startTimeUs, endTimeUs, processed);
+
+	// A new operating point takes effect with the next frame
+	if(processed && this->qosController.recordFrame(endTimeUs - startTimeUs))
+		this->applyQoSOperatingPoint();
+
+	return processed;
+}
+
+/**
+ * @brief Appends the record of the current frame to the frame trace, see
+ * startFrameTrace(...).
+ *
+ * @param int64_t arrivalTimeUs time the frame arrived
+ *
+ * @param int64_t startTimeUs time the pipe started processing the frame
+ *
+ * @param int64_t endTimeUs time the pipe finished processing the frame
+ *
+ * @param bool processed whether the frame was processed successfully
+ */
+void RoadSignAPI::RoadSignAPI::traceFrame(int64_t arrivalTimeUs,
+		int64_t startTimeUs, int64_t endTimeUs, bool processed)
+{
+	FilterManagementLibrary::FrameTraceRecordHeader frame;
+	frame.frameID = this->frameCounter - 1;
+	frame.arrivalTimeUs = arrivalTimeUs;
+	frame.startTimeUs = startTimeUs;
+	frame.endTimeUs = endTimeUs;
+	frame.flags = this->workingDataSet.degradationFlags;
+	frame.processed = processed ? 1 : 0;
+
+	const uint64_t classifierInferenceCount =
+			this->roadSignClassificator.getInferenceCount();
+
+	// In the order of the counter names in startFrameTrace(...)
+	const int64_t counters[] = {
+			this->workingDataSet.rawDetectionCount,
+			(int64_t) this->workingDataSet.detectedSigns.size(),
+			(int64_t) (classifierInferenceCount -
+					this->tracedClassifierInferenceCount),
+			(int64_t) this->workingDataSet.classifierApprovedSigns.size(),
+			(int64_t) this->workingDataSet.detectedSignCombinations.size(),
+			this->getQoSOperatingPoint()
+	};
+
+	this->tracedClassifierInferenceCount = classifierInferenceCount;
+
+	this->frameTraceWriter.append(frame,
+			this->processingPipeline.getLastDataSetTimings()->data(),
+			counters);
+}
+
+/**
+ * @brief Selects the models and the keyframe interval of the current
+ * operating point of the QoS controller.
+ *
+ * @return bool true on success, false if a model variant could not be
+ * selected
+ */
+bool RoadSignAPI::RoadSignAPI::applyQoSOperatingPoint()
+{
+	const QoSOperatingPoint* operatingPoint =
+			this->qosController.getCurrentOperatingPoint();
+
+	if(operatingPoint == NULL)
+		return true;
+
+	this->roadSignDetector.setKeyframeInterval(
+			operatingPoint->keyframeInterval);
+
+	return this->roadSignDetector.selectModelVariant(
+				operatingPoint->detectorModelVariant) &&
+			this->roadSignClassificator.selectModelVariant(
+				operatingPoint->classifierModelVariant);
+}
+
+/**
+ * @brief Returns a vector of all detected (not classified!) signs
+ *
+ * Should only be called after the feedImage(...) function was used.
+ * The vector contains all signs which were detected on the previous image.
+ *
+ * @return const std::vector<DetectedSignDescriptor> a vector containing
+ * all detected signs.
+ */
+const std::vector<RoadSignAPI::DetectedSignDescriptor>*
+				RoadSignAPI::RoadSignAPI::getDetectedSigns()
+{
+	return &this->workingDataSet.detectedSigns;
+}
+
+/**
+ * @brief Returns a vector of all classified signs.
+ *
+ * Should only be called after the feedImage(...) function was used.
+ * The vector contains all signs which were detected AND classified on
+ * the previous image. All images which were detected but could not be
+ * classified or are classified as a part of the unwanted classes won't
+ * be contained in this list!
+ *
+ * @param std::vector<const DetectedSignDescriptor*>* a pointer to a
+ * vector of pointers to a DetectedSignDescriptor. The vector
+ * will be filled with the DetectedSignDescriptors of the RSAPIWorkingDataSet
+ * which were successfully classified as relevant roadsigns.
+ *
+ * @return void
+ */
+void RoadSignAPI::RoadSignAPI::getClassifierApprovedDetectedSigns(
+		std::vector<const DetectedSignDescriptor*>* detectedSigns)
+{
+
+
+	detectedSigns->clear();
+
+	for(int i = 0; i < this->
+	workingDataSet.classifierApprovedSigns.size(); i++)
+	{
+		detectedSigns->push_back(&this->workingDataSet.detectedSigns
+				[this->workingDataSet.classifierApprovedSigns[i]]);
+	}
+}
+
+
+/**
+ * @brief Returns a vector of all @link{DetectedSignCombination}s.
+ *
+ * Should only be called after the feedImage(...) function was used.
+ * The vector contains all signs which were detected AND classified on
+ * the previous image grouped into @link{DetectedSignCombination}s.
+ * All images which were detected but could not be
+ * classified or are classified as a part of the unwanted classes won't
+ * be contained in this list!
+ *
+ * @return const std::vector<DetectedSignCombination>* const pointer to
+ * a vector containing all @link{DetectedSignCombination}s, that were
+ * found in the image that was lastly provided to feedImage(...).
+ */
+const std::vector<RoadSignAPI::DetectedSignCombination>*
+			const RoadSignAPI::RoadSignAPI::getDetectedSignCombinations() const
+{
+	return &this->workingDataSet.detectedSignCombinations;
+}
+
+/**
+ * @brief Returns all @link{SignCombinationTrack}s.
+ *
+ * The tracks follow the @link{DetectedSignCombination}s over consecutive
+ * frames (see ClassifiedSignsGrouper). The state of each track tells
+ * whether it is NEW, UPDATED, UNCHANGED or MISSED in the frame that was
+ * lastly provided, so consumers only interested in changes can skip
+ * most of them.
+ *
+ * @return const std::vector<SignCombinationTrack>* pointer to a vector
+ * containing all tracks which did not expire yet.
+ */
+const std::vector<RoadSignAPI::SignCombinationTrack>*
+			RoadSignAPI::RoadSignAPI::getSignCombinationTracks() const
+{
+	return &this->workingDataSet.signCombinationTracks;
+}
+
+/**
+ * @brief Returns the IDs of the @link{SignCombinationTrack}s which
+ * expired in the frame that was lastly provided.
+ *
+ * @return const std::vector<uint32_t>* pointer to a vector containing
+ * the track IDs.
+ */
+const std::vector<uint32_t>*
+			RoadSignAPI::RoadSignAPI::getExpiredSignCombinationTrackIDs() const
+{
+	return &this->workingDataSet.expiredSignCombinationTrackIDs;
+}
+
+/**
+ * @brief Returns the invocation and skip counters of the filters.
+ *
+ * @return const std::vector<PipeFilterStatistics>* pointer to a vector
+ * containing the counters of each filter in registration order.
+ */
+const std::vector<FilterManagementLibrary::
+			PipeSystem::PipeFilterStatistics>*
+			RoadSignAPI::RoadSignAPI::getPipelineStatistics() const
+{
+	return this->processingPipeline.getFilterStatistics();
+}
+
+/**
+ * @brief Selects how the filters of the pipe are scheduled.
+ *
+ * All filters of the RoadSignAPI declare the data they read and write,
+ * so the pipe can build its schedule from them in DAG scheduling mode
+ * (see ProcessingPipeline::setSchedulingMode(...)).
+ *
+ * @param SchedulingMode schedulingMode the mode to use
+ *
+ * @param int workerThreadCount number of additional threads running
+ * independent filters and the signs of map filters (see PipeMapFilter),
+ * in both modes
+ *
+ * @return bool true on success, false if the schedule could not be built
+ */
+bool RoadSignAPI::RoadSignAPI::setPipelineSchedulingMode(
+		FilterManagementLibrary::PipeSystem::ProcessingPipeline::
+		SchedulingMode schedulingMode, int workerThreadCount)
+{
+	return this->processingPipeline.setSchedulingMode(schedulingMode,
+			workerThreadCount);
+}
+
+/**
+ * @brief Measures the filters with hardware counters (cycles,
+ * instructions, last level cache misses, branch misses).
+ *
+ * The counts are added to the pipeline statistics (see
+ * getPipelineStatistics()): processCounters for the whole filter,
+ * sectionCounters for the model inferences of the detector and the
+ * classifier. May only be called between two frames.
+ *
+ * @param bool enabled whether to measure the filters
+ *
+ * @return bool true on success, false if the counters are not available
+ * (see PerformanceCounters)
+ */
+bool RoadSignAPI::RoadSignAPI::setPerformanceCountersEnabled(bool enabled)
+{
+	return this->processingPipeline.setPerformanceCountersEnabled(enabled);
+}
+
+/**
+ * @brief Returns the memory of the pipe: the models of the detector and
+ * the classifier and the cv::Mats allocated while processing frames
+ * (i.e. the working data set and the crops).
+ *
+ * Intermediate results Tensorflow allocates on its own threads during the
+ * inferences are not included, see MemoryAccount. Peaks are kept since
+ * the instance was created or resetMemoryPeaks() was called.
+ *
+ * @return MemoryUsage current and peak bytes
+ */
+FilterManagementLibrary::MemoryUsage
+		RoadSignAPI::RoadSignAPI::getPipelineMemoryUsage()
+{
+	return this->processingPipeline.getMemoryAccount()->getUsage();
+}
+
+/**
+ * @brief Returns the memory of the detector models (all variants),
+ * see TFNNBasedPipeFilter::getMemoryAccount().
+ */
+FilterManagementLibrary::MemoryUsage
+		RoadSignAPI::RoadSignAPI::getDetectorMemoryUsage()
+{
+	return this->roadSignDetector.getMemoryAccount()->getUsage();
+}
+
+/**
+ * @brief Returns the memory of the classifier models (all variants),
+ * see TFNNBasedPipeFilter::getMemoryAccount().
+ */
+FilterManagementLibrary::MemoryUsage
+		RoadSignAPI::RoadSignAPI::getClassifierMemoryUsage()
+{
+	return this->roadSignClassificator.getMemoryAccount()->getUsage();
+}
+
+/**
+ * @brief Sets the peaks of the pipe and the models to their current
+ * bytes, i.e. to measure the steady state after the models were loaded.
+ */
+void RoadSignAPI::RoadSignAPI::resetMemoryPeaks()
+{
+	this->processingPipeline.getMemoryAccount()->resetPeak();
+	this->roadSignDetector.getMemoryAccount()->resetPeak();
+	this->roadSignClassificator.getMemoryAccount()->resetPeak();
+}
+
+/**
+ * @brief Adds another detector model, i.e. with a smaller input size.
+ *
+ * The model is loaded right away (which may take a while), afterwards
+ * operating points can refer to it (see addQoSOperatingPoint(...)).
+ * The outputs of the model need to match the ones of the detector model
+ * passed to the constructor.
+ *
+ * @param TensorflowNNModelDescription modelDescription description of
+ * the model
+ *
+ * @return int index of the model variant, -1 if it could not be loaded
+ */
+int RoadSignAPI::RoadSignAPI::addDetectorModelVariant(
+		FilterManagementLibrary::TFIntegration::TensorflowNNModelDescription
+		modelDescription)
+{
+	const int modelVariant =
+			this->roadSignDetector.addModelVariant(modelDescription);
+
+	return this->roadSignDetector.loadModels() ? modelVariant : -1;
+}
+
+/**
+ * @brief Adds another classifier model, i.e. a quantized one.
+ *
+ * See addDetectorModelVariant(...), the outputs of the model need to
+ * match the ones of the classifier model passed to the constructor.
+ *
+ * @param TensorflowNNModelDescription modelDescription description of
+ * the model
+ *
+ * @return int index of the model variant, -1 if it could not be loaded
+ */
+int RoadSignAPI::RoadSignAPI::addClassifierModelVariant(
+		FilterManagementLibrary::TFIntegration::TensorflowNNModelDescription
+		modelDescription)
+{
+	const int modelVariant =
+			this->roadSignClassificator.addModelVariant(modelDescription);
+
+	return this->roadSignClassificator.loadModels() ? modelVariant : -1;
+}
+
+/**
+ * @brief Replaces a detector model by an updated one without stopping
+ * the processing of frames.
+ *
+ * The new model is loaded and warmed up on a separate thread while the
+ * frames keep being processed with the previous one. It is swapped in
+ * before the first frame fed after it is ready, the previous model is
+ * closed on the loading thread afterwards. Only one detector model can
+ * be replaced at a time, see getDetectorModelSwapState().
+ *
+ * @param int modelVariant index of the model variant to replace, 0 for
+ * the detector model passed to the constructor
+ *
+ * @param TensorflowNNModelDescription modelDescription description of
+ * the new model, its outputs need to match the ones of the model it
+ * replaces
+ *
+ * @return bool true if loading the model was started, false otherwise
+ */
+bool RoadSignAPI::RoadSignAPI::replaceDetectorModel(int modelVariant,
+		FilterManagementLibrary::TFIntegration::TensorflowNNModelDescription
+		modelDescription)
+{
+	return this->roadSignDetector.replaceModel(modelVariant,
+			modelDescription);
+}
+
+/**
+ * @brief Replaces a classifier model by an updated one without stopping
+ * the processing of frames, see replaceDetectorModel(...).
+ *
+ * @param int modelVariant index of the model variant to replace, 0 for
+ * the classifier model passed to the constructor
+ *
+ * @param TensorflowNNModelDescription modelDescription description of
+ * the new model
+ *
+ * @return bool true if loading the model was started, false otherwise
+ */
+bool RoadSignAPI::RoadSignAPI::replaceClassifierModel(int modelVariant,
+		FilterManagementLibrary::TFIntegration::TensorflowNNModelDescription
+		modelDescription)
+{
+	return this->roadSignClassificator.replaceModel(modelVariant,
+			modelDescription);
+}
+
+/**
+ * @brief Returns the state of the lastly started detector model
+ * replacement, see replaceDetectorModel(...).
+ */
+FilterManagementLibrary::PipeSystem::TFNNBasedPipeFilter::ModelSwapState
+		RoadSignAPI::RoadSignAPI::getDetectorModelSwapState() const
+{
+	return this->roadSignDetector.getModelSwapState();
+}
+
+/**
+ * @brief Returns the state of the lastly started classifier model
+ * replacement, see replaceClassifierModel(...).
+ */
+FilterManagementLibrary::PipeSystem::TFNNBasedPipeFilter::ModelSwapState
+		RoadSignAPI::RoadSignAPI::getClassifierModelSwapState() const
+{
+	return this->roadSignClassificator.getModelSwapState();
+}
+
+/**
+ * @brief Adds an operating point the QoS controller can switch to.
+ *
+ * Operating points have to be added from the best (and most expensive)
+ * to the cheapest one, the first one is selected right away. The models
+ * are switched between two frames, without setting up the pipe again.
+ *
+ * @param const QoSOperatingPoint& operatingPoint model variants (0 for
+ * the models passed to the constructor) and keyframe interval
+ *
+ * @return int index of the operating point, -1 if it refers to a model
+ * variant which does not exist
+ */
+int RoadSignAPI::RoadSignAPI::addQoSOperatingPoint(
+		const QoSOperatingPoint& operatingPoint)
+{
+	if(operatingPoint.detectorModelVariant < 0 ||
+			operatingPoint.detectorModelVariant >=
+			this->roadSignDetector.getModelVariantCount() ||
+			operatingPoint.classifierModelVariant < 0 ||
+			operatingPoint.classifierModelVariant >=
+			this->roadSignClassificator.getModelVariantCount())
+	{
+		FilterManagementLibrary::Logger::printfln(
+				"QoS operating point refers to an unknown model variant");
+		return -1;
+	}
+
+	const int index = this->qosController.addOperatingPoint(operatingPoint);
+
+	if(index == 0)
+		this->applyQoSOperatingPoint();
+
+	return index;
+}
+
+/**
+ * @brief Sets the frame rate the QoS controller tries to hold by
+ * switching between the operating points (see QoSController).
+ *
+ * @param float framesPerSecond target frame rate, 0 to disable the
+ * controller (the current operating point is kept)
+ */
+void RoadSignAPI::RoadSignAPI::setQoSTargetFrameRate(float framesPerSecond)
+{
+	this->qosController.setTargetFrameRate(framesPerSecond);
+}
+
+/**
+ * @brief Configures when the QoS controller switches, see
+ * QoSController::setHysteresis(...).
+ */
+void RoadSignAPI::RoadSignAPI::setQoSHysteresis(float degradeRatio,
+		float upgradeRatio, int windowFrames, int upgradeHoldFrames,
+		double percentile)
+{
+	this->qosController.setHysteresis(degradeRatio, upgradeRatio,
+			windowFrames, upgradeHoldFrames, percentile);
+}
+
+/**
+ * @brief Returns the index of the operating point the frames are
+ * currently processed with, 0 if there are none.
+ */
+int RoadSignAPI::RoadSignAPI::getQoSOperatingPoint() const
+{
+	return this->qosController.getCurrentOperatingPointIndex();
+}
+
+/**
+ * @brief Returns the processing times of all frames fed so far.
+ *
+ * The processing times of the individual filters can be found in
+ * getPipelineStatistics().
+ *
+ * @return const LatencyHistogram* pointer to the histogram
+ */
+const FilterManagementLibrary::LatencyHistogram*
+		RoadSignAPI::RoadSignAPI::getFrameLatencyHistogram() const
+{
+	return this->processingPipeline.getDataSetLatency();
+}
+
+/**
+ * @brief Sets the latency budget of every frame fed afterwards.
+ *
+ * The results of a frame are due budgetMs after it arrived (was fed, or
+ * pushed into its FrameQueue). To meet this deadline, the classifier
+ * classifies fewer signs as the budget runs out, down to reporting only
+ * the detector results (see MobilenetV2RoadSignClassificator::process()).
+ * What was left out is reported by getDegradationFlags() and in the
+ * serialized results.
+ *
+ * @param int budgetMs budget per frame in milliseconds, 0 to process
+ * every frame completely (default)
+ */
+void RoadSignAPI::RoadSignAPI::setFrameBudget(int budgetMs)
+{
+	this->frameBudgetUs = budgetMs > 0 ? (int64_t) budgetMs * 1000 : 0;
+}
+
+/**
+ * @brief Returns which work was left out in the lastly processed frame to
+ * meet its deadline.
+ *
+ * @return uint32_t combination of DegradationFlag bits,
+ * DEGRADATION_NONE if the frame was processed completely
+ */
+uint32_t RoadSignAPI::RoadSignAPI::getDegradationFlags() const
+{
+	return this->workingDataSet.degradationFlags;
+}
+
+/**
+ * @brief Sets the tuning parameters of the filters (see RSAPIParameters).
+ *
+ * May only be called between two frames, the parameters take effect with
+ * the next one. If any of the parameters is out of range, none of them
+ * is applied.
+ *
+ * @param const RSAPIParameters& parameters the new parameters
+ *
+ * @return bool true on success, false if a parameter is out of range
+ */
+bool RoadSignAPI::RoadSignAPI::setParameters(
+		const RSAPIParameters& parameters)
+{
+	if(parameters.detectorThreshold < 0.0f ||
+			parameters.detectorThreshold > 1.0f ||
+			parameters.detectorMaxDetections < 1 ||
+			parameters.classifierThreshold < 0.0f ||
+			parameters.classifierThreshold > 1.0f ||
+			parameters.duplicateMinOverlapPercentage < 0.0f ||
+			parameters.duplicateMinOverlapPercentage > 1.0f ||
+			parameters.sliceExpandPercentage < 0.0f ||
+			parameters.groupHorizontalRangePercentage < 0.0f ||
+			parameters.groupHorizontalRangePercentage > 1.0f)
+	{
+		FilterManagementLibrary::Logger::printfln(
+				"RoadSignAPI: parameters out of range");
+		return false;
+	}
+
+	this->parameters = parameters;
+
+	this->roadSignDetector.setThreshold(parameters.detectorThreshold);
+	this->roadSignDetector.setMaxDetections(parameters.detectorMaxDetections);
+	this->roadSignClassificator.setThreshold(parameters.classifierThreshold);
+	this->roadSignDuplicationDeleter.setMinOverlapPercentage(
+			parameters.duplicateMinOverlapPercentage);
+	this->detectionBasedImageSlicer.setExpandPercentage(
+			parameters.sliceExpandPercentage);
+	this->classifiedSignsGrouper.setHorizontalRangePercentage(
+			parameters.groupHorizontalRangePercentage);
+
+	return true;
+}
+
+/**
+ * @brief Returns the tuning parameters the filters currently use.
+ */
+const RoadSignAPI::RSAPIParameters&
+		RoadSignAPI::RoadSignAPI::getParameters() const
+{
+	return this->parameters;
+}
+
+/**
+ * @brief Starts writing a record for every frame to a trace file.
+ *
+ * Each record holds the frame index (as in the serialized results), the
+ * time the frame arrived (so the queue wait of frames fed via
+ * feedQueuedFrame(...) is visible), when each filter ran, the
+ * degradation flags and the number of detections before and after the
+ * duplicates were removed, of crops classified, of signs approved by
+ * the classifier and of sign combinations, as well as the QoS operating
+ * point. The records are buffered and written by a background thread
+ * (see FrameTraceWriter), tools/rsapi_trace2json converts the trace for
+ * chrome://tracing or Perfetto.
+ * May only be called between two frames.
+ *
+ * @param const std::string& path path of the trace file, an existing file
+ * is replaced
+ *
+ * @return bool true on success, false if the file could not be created
+ */
+bool RoadSignAPI::RoadSignAPI::startFrameTrace(const std::string& path)
+{
+	std::vector<std::string> filterNames(
+			this->processingPipeline.getLastDataSetTimings()->size());
+
+	filterNames[this->pipeRegisteredFilters.SIGN_DETECTION_FILTER] =
+			"SSDLiteRoadSignDetector";
+	filterNames[this->pipeRegisteredFilters.SIGN_RECOGNITION_FILTER] =
+			"MobilenetV2RoadSignClassificator";
+	filterNames[this->pipeRegisteredFilters.
+			SIGN_DUPLICATION_DELETER_FILTER] = "RoadSignDuplicationDeleter";
+	filterNames[this->pipeRegisteredFilters.
+			DETECTION_BASED_IMAGE_SLICER_FILTER] = "DetectionBasedImageSlicer";
+	filterNames[this->pipeRegisteredFilters.
+			CLASSIFIED_SIGNS_GROUPER_FILTER] = "ClassifiedSignsGrouper";
+
+	const std::vector<std::string> counterNames = {"raw_detections",
+			"detections", "classified_crops", "approved_signs",
+			"sign_combinations", "qos_operating_point"};
+
+	this->tracedClassifierInferenceCount =
+			this->roadSignClassificator.getInferenceCount();
+
+	return this->frameTraceWriter.open(path, filterNames, counterNames);
+}
+
+/**
+ * @brief Stops the frame trace started by startFrameTrace(...) and writes
+ * the remaining records.
+ *
+ * @return bool true if all records were written, false otherwise (or if
+ * no trace was started)
+ */
+bool RoadSignAPI::RoadSignAPI::stopFrameTrace()
+{
+	return this->frameTraceWriter.close();
+}
+
+/**
+ * @brief Records the outputs of the detector and the classifier models for
+ * every frame (see TFNNBasedPipeFilter::setOutputRecorder(...)).
+ *
+ * May only be called between two frames. The recorders can be shared by
+ * several instances of RoadSignAPI, NULL stops recording the respective
+ * model.
+ *
+ * @param TensorflowOutputRecorder* detectorRecorder opened recorder for the
+ * outputs of the SSDLiteRoadSignDetector
+ *
+ * @param TensorflowOutputRecorder* classifierRecorder opened recorder for
+ * the outputs of the MobilenetV2RoadSignClassificator
+ */
+void RoadSignAPI::RoadSignAPI::setOutputRecorders(
+		FilterManagementLibrary::TFIntegration::TensorflowOutputRecorder*
+		detectorRecorder,
+		FilterManagementLibrary::TFIntegration::TensorflowOutputRecorder*
+		classifierRecorder)
+{
+	this->roadSignDetector.setOutputRecorder(detectorRecorder);
+	this->roadSignClassificator.setOutputRecorder(classifierRecorder);
+}
+
+/**
+ * @brief Replays recorded model outputs instead of running the detector
+ * and the classifier (see TFNNBasedPipeFilter::setOutputReplay(...)).
+ *
+ * Should be called before init(), so the model files are not loaded at
+ * all. Frames which were not recorded with the same input fail to
+ * process. The recordings can be shared by several instances of
+ * RoadSignAPI.
+ *
+ * @param const TensorflowOutputRecording* detectorRecording opened
+ * recording of the SSDLiteRoadSignDetector outputs
+ *
+ * @param const TensorflowOutputRecording* classifierRecording opened
+ * recording of the MobilenetV2RoadSignClassificator outputs
+ */
+void RoadSignAPI::RoadSignAPI::setOutputReplay(
+		const FilterManagementLibrary::TFIntegration::
+		TensorflowOutputRecording* detectorRecording,
+		const FilterManagementLibrary::TFIntegration::
+		TensorflowOutputRecording* classifierRecording)
+{
+	this->roadSignDetector.setOutputReplay(detectorRecording);
+	this->roadSignClassificator.setOutputReplay(classifierRecording);
+}
+
+/**
+ * @brief Returns the buffer size serializeResults(...) needs for the
+ * results of the lastly processed frame.
+ *
+ * @return size_t required buffer size in bytes
+ */
+size_t RoadSignAPI::RoadSignAPI::getSerializedResultsSize() const
+{
+	return ResultBufferWriter::getRequiredSize(
+			this->workingDataSet.detectedSignCombinations);
+}
+
+/**
+ * @brief Writes the results of the lastly processed frame into a flat
+ * buffer.
+ *
+ * Serializes all @link{DetectedSignCombination}s in the format described
+ * in ResultBuffer.h, without allocating any memory. The buffer can be
+ * read with ResultBufferReader without copying, i.e. in another process.
+ * The frame index in the buffer is the number of frames this instance
+ * processed before, see the overload with a frameIndex parameter to use
+ * another numbering.
+ *
+ * @param uint8_t* buffer 8 byte aligned destination buffer
+ *
+ * @param size_t bufferSize size of buffer in bytes, should be at least
+ * getSerializedResultsSize()
+ *
+ * @param size_t* writtenSize if not NULL, receives the number of bytes
+ * written
+ *
+ * @return bool true if the results were written, false otherwise
+ */
+bool RoadSignAPI::RoadSignAPI::serializeResults(uint8_t* buffer,
+		size_t bufferSize, size_t* writtenSize) const
+{
+	return this->serializeResults(buffer, bufferSize, writtenSize,
+			this->frameCounter - 1);
+}
+
+/**
+ * @brief Writes the results of the lastly processed frame into a flat
+ * buffer, with the given frame index.
+ *
+ * Like serializeResults(buffer, bufferSize, writtenSize), but the frame
+ * index is given by the caller, i.e. the frame ID a producer assigned
+ * to the frame (see SharedMemoryFrameServer).
+ *
+ * @param uint8_t* buffer 8 byte aligned destination buffer
+ *
+ * @param size_t bufferSize size of buffer in bytes, should be at least
+ * getSerializedResultsSize()
+ *
+ * @param size_t* writtenSize if not NULL, receives the number of bytes
+ * written
+ *
+ * @param uint64_t frameIndex written as ResultBufferHeader::frameIndex
+ *
+ * @return bool true if the results were written, false otherwise
+ */
+bool RoadSignAPI::RoadSignAPI::serializeResults(uint8_t* buffer,
+		size_t bufferSize, size_t* writtenSize, uint64_t frameIndex) const
+{
+	return ResultBufferWriter::serialize(
+			this->workingDataSet.detectedSignCombinations,
+			this->workingDataSet.originalImageWidth,
+			this->workingDataSet.originalImageHeight,
+			frameIndex, buffer, bufferSize, writtenSize,
+			this->workingDataSet.degradationFlags);
+}
+
+/**
+ * @brief Renders the lastly processed frame and its results into a buffer.
+ *
+ * Optional output stage, which is not part of the ProcessingPipeline:
+ * Only call it if the frame shall be displayed. The frame is converted
+ * straight into output (see AnnotatedOutputRenderer), boxes are drawn
+ * according to options.
+ * Must be called before the next frame is fed. If the frame was fed
+ * using feedImageYUV(...), its planes need to be still valid.
+ *
+ * @param uint8_t* output buffer which can hold the whole frame in the
+ * requested pixel format
+ *
+ * @param int outputStride row stride of output in bytes
+ *
+ * @param PixelFormat format memory layout of the output pixels
+ * (i.e. BGRA for Java int[] ARGB buffers)
+ *
+ * @param const AnnotationOptions& options what will be drawn on top of
+ * the frame
+ *
+ * @return bool true if the frame was rendered, false otherwise
+ */
+bool RoadSignAPI::RoadSignAPI::renderAnnotatedImage(uint8_t* output,
+		int outputStride,
+		FilterManagementLibrary::ImageConversion::PixelFormat format,
+		const AnnotationOptions& options) const
+{
+	return AnnotatedOutputRenderer::render(this->workingDataSet, output,
+			outputStride, format, options);
+}
+
+/**
+ * @brief Fills the static descriptions of the SSDLite and MobilenetV2
+ * models the static interface uses.
+ */
+void RoadSignAPI::RoadSignAPI::setupModelDescriptions()
+{
+	RoadSignAPI::RoadSignAPI::
+		ssdLiteModelDescription.inputHeight = 300;
+	RoadSignAPI::RoadSignAPI::
+		ssdLiteModelDescription.inputWidth = 300;
+	RoadSignAPI::RoadSignAPI::
+		ssdLiteModelDescription.channels = 3;
+	RoadSignAPI::RoadSignAPI::
+		ssdLiteModelDescription.input_floating = false;
+	RoadSignAPI::RoadSignAPI::
+		ssdLiteModelDescription.inputLayerNameStr = "image_tensor";
+	RoadSignAPI::RoadSignAPI::
+		ssdLiteModelDescription.outputLayerNames =
+		{"detection_boxes","detection_scores","detection_classes","num_detections"};
+	RoadSignAPI::RoadSignAPI::
+		ssdLiteModelDescription.modelFile = "ssdlite.pb";
+
+
+
+	RoadSignAPI::RoadSignAPI::
+		mobilenetModelDescription.inputHeight = 96;
+	RoadSignAPI::RoadSignAPI::
+		mobilenetModelDescription.inputWidth = 96;
+	RoadSignAPI::RoadSignAPI::
+	mobilenetModelDescription.channels = 3;
+	RoadSignAPI::RoadSignAPI::
+		mobilenetModelDescription.input_floating = true;
+	RoadSignAPI::RoadSignAPI::
+		mobilenetModelDescription.input_mean = 127.5f;
+	RoadSignAPI::RoadSignAPI::
+		mobilenetModelDescription.input_std = 127.5f;
+	RoadSignAPI::RoadSignAPI::
+		mobilenetModelDescription.inputLayerNameStr = "input_1";
+	RoadSignAPI::RoadSignAPI::
+		mobilenetModelDescription.outputLayerNames = {"output_node0"};
+	RoadSignAPI::RoadSignAPI::
+		mobilenetModelDescription.modelFile = "mobilenetv2.pb";
+}
+
+/**
+ * @brief Returns the description of the detector model the static
+ * interface uses, i.e. to create further instances of RoadSignAPI.
+ */
+FilterManagementLibrary::TFIntegration::TensorflowNNModelDescription
+		RoadSignAPI::RoadSignAPI::getDefaultDetectorModelDescription()
+{
+	RoadSignAPI::RoadSignAPI::setupModelDescriptions();
+	return RoadSignAPI::RoadSignAPI::ssdLiteModelDescription;
+}
+
+/**
+ * @brief Returns the description of the detector model the static
+ * interface uses, but with the raw box encodings and class predictions
+ * of the model as outputs instead of the detections.
+ *
+ * Tensorflow only runs the operations needed for the requested outputs,
+ * so the postprocessing operations of the graph (anchor decoding, score
+ * conversion, non maximum suppression) are skipped and done by the
+ * SSDPostProcessor of the SSDLiteRoadSignDetector instead, which also
+ * generates the anchors. Squeeze and concat_1 are the names of these
+ * outputs in graphs exported by export_inference_graph.py of the object
+ * detection API. Unlike the graph, which drops all detections with a
+ * score up to 0.3 before the non maximum suppression, the detector
+ * threshold is used for this, see RSAPIParameters::detectorThreshold.
+ * tools/rsapi_ssd_validate.cpp compares the detections of both.
+ */
+FilterManagementLibrary::TFIntegration::TensorflowNNModelDescription
+		RoadSignAPI::RoadSignAPI::getRawOutputDetectorModelDescription()
+{
+	FilterManagementLibrary::TFIntegration::TensorflowNNModelDescription
+		modelDescription =
+				RoadSignAPI::RoadSignAPI::getDefaultDetectorModelDescription();
+
+	modelDescription.outputLayerNames = {"Squeeze", "concat_1"};
+	return modelDescription;
+}
+
+/**
+ * @brief Returns the description of the classifier model the static
+ * interface uses.
+ */
+FilterManagementLibrary::TFIntegration::TensorflowNNModelDescription
+		RoadSignAPI::RoadSignAPI::getDefaultClassifierModelDescription()
+{
+	RoadSignAPI::RoadSignAPI::setupModelDescriptions();
+	return RoadSignAPI::RoadSignAPI::mobilenetModelDescription;
+}
+
+#ifdef __ANDROID__
+/**
+ * @brief Initializes the RoadSignAPI's static interface.
+ *
+ * This is the staticInit function for Android environments. As under Android,
+ * we want the neuronal network model files to be stored inside the assets
+ * folder of the app, we need an AssetManager passed from the Java part of the
+ * app to be able to do so. On non Android environments, this function just lacks
+ * it's last parameter.
+ *
+ * We use a Singleton to provide a static interface to the RoadSignAPI.
+ * This Singleton will be initialized in this function:
+ * The model descriptions for the SSDLite and MobilenetV2 neuronal networks
+ * will be created, the RoadSignAPI will be instantiated and the
+ * ProcessingPipeline's setUp function is called.
+ *
+ */
+bool RoadSignAPI::RoadSignAPI::staticInit(
+		const int numThreads, AAssetManager* const assetManager)
+{
+
+
+	RoadSignAPI::RoadSignAPI::setupModelDescriptions();
+	//RoadSignAPI::RoadSignAPI::instance->processingPipeline.registerFilter((FilterManagementLibrary::PipeSystem::PipeFilter*)(&(RoadSignAPI::RoadSignAPI::instance->roadSignDetector)), &RoadSignAPI::RoadSignAPI::instance->pipeRegisteredFilters.SIGN_DETECTION_FILTER);
+	RoadSignAPI::RoadSignAPI::instance = new RoadSignAPI(RoadSignAPI::RoadSignAPI::
+			ssdLiteModelDescription, RoadSignAPI::RoadSignAPI::
+			mobilenetModelDescription, numThreads, assetManager);
+	return RoadSignAPI::RoadSignAPI::instance->init();
+}
+#else
+/**
+ * @brief Initializes the RoadSignAPI's static interface.
+ *
+ * This is the staticInit function for non-Android environments.
+ * We use a Singleton to provide a static interface to the RoadSignAPI.
+ * This Singleton will be initialized in this function:
+ * The model descriptions for the SSDLite and MobilenetV2 neuronal networks
+ * will be created, the RoadSignAPI will be instantiated and the
+ * ProcessingPipeline's setUp function is called.
+ */
+bool RoadSignAPI::RoadSignAPI::staticInit(const int numThreads)
+{
+
+
+	RoadSignAPI::RoadSignAPI::setupModelDescriptions();
+	//RoadSignAPI::RoadSignAPI::instance->processingPipeline.registerFilter((FilterManagementLibrary::PipeSystem::PipeFilter*)(&(RoadSignAPI::RoadSignAPI::instance->roadSignDetector)), &RoadSignAPI::RoadSignAPI::instance->pipeRegisteredFilters.SIGN_DETECTION_FILTER);
+	RoadSignAPI::RoadSignAPI::instance = new RoadSignAPI(RoadSignAPI::RoadSignAPI::
+			ssdLiteModelDescription, RoadSignAPI::RoadSignAPI::
+			mobilenetModelDescription, numThreads);
+	return RoadSignAPI::RoadSignAPI::instance->init();
+}
+#endif
+
+/**
+ * @brief Takes an OpenCV Mat uses the filter to examine it for road signs.
+ */
+bool RoadSignAPI::RoadSignAPI::staticFeedImage(cv::Mat image)
+{
+	return RoadSignAPI::RoadSignAPI::instance->feedImage(image);
+}
+
+/**
+ * @brief Takes a YUV 4:2:0 frame and uses the filter to examine it for road signs.
+ *
+ * See feedImageYUV(...) for a more detailed description.
+ */
+bool RoadSignAPI::RoadSignAPI::staticFeedImageYUV(
+		const uint8_t* const planes[3], const int strides[3],
+		FilterManagementLibrary::YUVFormat format,
+		const int width, const int height, const bool rotate180)
+{
+	return RoadSignAPI::RoadSignAPI::instance->feedImageYUV(planes, strides,
+			format, width, height, rotate180);
+}
+
+/**
+ * @brief Feeds a frame acquired from a FrameQueue into the static
+ * instance, see feedQueuedFrame(...).
+ */
+bool RoadSignAPI::RoadSignAPI::staticFeedQueuedFrame(const QueuedFrame* frame)
+{
+	return RoadSignAPI::RoadSignAPI::instance->feedQueuedFrame(frame);
+}
+
+/**
+ * @brief Returns a vector of all detected (not classified!) signs
+ *
+ * Should only be called after the feedImage(...) function was used.
+ * The vector contains all signs which were detected on the previous image.
+ *
+ * @return const std::vector<DetectedSignDescriptor> a vector containing
+ * all detected signs.
+ */
+const std::vector<RoadSignAPI::DetectedSignDescriptor>*
+				RoadSignAPI::RoadSignAPI::staticGetDetectedSigns()
+{
+	return RoadSignAPI::RoadSignAPI::instance->getDetectedSigns();
+}
+
+/**
+ * @brief Returns a vector of all classified signs.
+ *
+ * Should only be called after the staticFeedImage(...) function was used.
+ * The vector contains all signs which were detected AND classified on
+ * the previous image. All images which were detected but could not be
+ * classified or are classified as a part of the unwanted classes won't
+ * be contained in this list!
+ *
+ * @param std::vector<const DetectedSignDescriptor*>* a pointer to a
+ * vector of pointers to a DetectedSignDescriptor. The vector
+ * will be filled with the DetectedSignDescriptors of the RSAPIWorkingDataSet
+ * which were successfully classified as relevant roadsigns.
+ *
+ * @return void
+ */
+void RoadSignAPI::RoadSignAPI::staticGetClassifierApprovedDetectedSigns(
+		std::vector<const DetectedSignDescriptor*>* detectedSigns)
+{
+
+
+	return RoadSignAPI::RoadSignAPI::instance->
+			getClassifierApprovedDetectedSigns(detectedSigns);
+}
+
+/**
+ * @brief Returns a vector of all @link{DetectedSignCombination}s.
+ *
+ * Should only be called after the staticFeedImage(...) function was used.
+ * The vector contains all signs which were detected AND classified on
+ * the previous image grouped into @link{DetectedSignCombination}s.
+ * All images which were detected but could not be
+ * classified or are classified as a part of the unwanted classes won't
+ * be contained in this list!
+ *
+ * @return const std::vector<DetectedSignCombination>* const pointer to
+ * a vector containing all @link{DetectedSignCombination}s, that were
+ * found in the image that was lastly provided to staticFeedImage(...).
+ */
+const std::vector<RoadSignAPI::DetectedSignCombination>*
+			const RoadSignAPI::RoadSignAPI::staticGetDetectedSignCombinations()
+{
+	return RoadSignAPI::RoadSignAPI::instance->getDetectedSignCombinations();
+}
+
+/**
+ * @brief Returns all @link{SignCombinationTrack}s, see
+ * getSignCombinationTracks().
+ */
+const std::vector<RoadSignAPI::SignCombinationTrack>*
+			RoadSignAPI::RoadSignAPI::staticGetSignCombinationTracks()
+{
+	return RoadSignAPI::RoadSignAPI::instance->getSignCombinationTracks();
+}
+
+/**
+ * @brief Returns the IDs of the tracks which expired in the lastly
+ * processed frame, see getExpiredSignCombinationTrackIDs().
+ */
+const std::vector<uint32_t>*
+			RoadSignAPI::RoadSignAPI::staticGetExpiredSignCombinationTrackIDs()
+{
+	return RoadSignAPI::RoadSignAPI::instance->
+			getExpiredSignCombinationTrackIDs();
+}
+
+/**
+ * @brief Returns the invocation and skip counters of the filters of the
+ * static instance.
+ */
+const std::vector<FilterManagementLibrary::
+			PipeSystem::PipeFilterStatistics>*
+			RoadSignAPI::RoadSignAPI::staticGetPipelineStatistics()
+{
+	return RoadSignAPI::RoadSignAPI::instance->getPipelineStatistics();
+}
+
+/**
+ * @brief Selects how the filters of the pipe of the static instance are
+ * scheduled, see setPipelineSchedulingMode(...).
+ */
+bool RoadSignAPI::RoadSignAPI::staticSetPipelineSchedulingMode(
+		FilterManagementLibrary::PipeSystem::ProcessingPipeline::
+		SchedulingMode schedulingMode, int workerThreadCount)
+{
+	return RoadSignAPI::RoadSignAPI::instance->setPipelineSchedulingMode(
+			schedulingMode, workerThreadCount);
+}
+
+/**
+ * @brief Measures the filters of the static instance with hardware
+ * counters, see setPerformanceCountersEnabled(...).
+ */
+bool RoadSignAPI::RoadSignAPI::staticSetPerformanceCountersEnabled(
+		bool enabled)
+{
+	return RoadSignAPI::RoadSignAPI::instance->
+			setPerformanceCountersEnabled(enabled);
+}
+
+/**
+ * @brief Returns the memory of the pipe of the static instance, see
+ * getPipelineMemoryUsage().
+ */
+FilterManagementLibrary::MemoryUsage
+		RoadSignAPI::RoadSignAPI::staticGetPipelineMemoryUsage()
+{
+	return RoadSignAPI::RoadSignAPI::instance->getPipelineMemoryUsage();
+}
+
+/**
+ * @brief Returns the memory of the detector models of the static
+ * instance, see getDetectorMemoryUsage().
+ */
+FilterManagementLibrary::MemoryUsage
+		RoadSignAPI::RoadSignAPI::staticGetDetectorMemoryUsage()
+{
+	return RoadSignAPI::RoadSignAPI::instance->getDetectorMemoryUsage();
+}
+
+/**
+ * @brief Returns the memory of the classifier models of the static
+ * instance, see getClassifierMemoryUsage().
+ */
+FilterManagementLibrary::MemoryUsage
+		RoadSignAPI::RoadSignAPI::staticGetClassifierMemoryUsage()
+{
+	return RoadSignAPI::RoadSignAPI::instance->getClassifierMemoryUsage();
+}
+
+/**
+ * @brief Resets the memory peaks of the static instance, see
+ * resetMemoryPeaks().
+ */
+void RoadSignAPI::RoadSignAPI::staticResetMemoryPeaks()
+{
+	RoadSignAPI::RoadSignAPI::instance->resetMemoryPeaks();
+}
+
+/**
+ * @brief Adds another detector model to the static instance, see
+ * addDetectorModelVariant(...).
+ */
+int RoadSignAPI::RoadSignAPI::staticAddDetectorModelVariant(
+		FilterManagementLibrary::TFIntegration::TensorflowNNModelDescription
+		modelDescription)
+{
+	return RoadSignAPI::RoadSignAPI::instance->addDetectorModelVariant(
+			modelDescription);
+}
+
+/**
+ * @brief Adds another classifier model to the static instance, see
+ * addClassifierModelVariant(...).
+ */
+int RoadSignAPI::RoadSignAPI::staticAddClassifierModelVariant(
+		FilterManagementLibrary::TFIntegration::TensorflowNNModelDescription
+		modelDescription)
+{
+	return RoadSignAPI::RoadSignAPI::instance->addClassifierModelVariant(
+			modelDescription);
+}
+
+/**
+ * @brief Replaces a detector model of the static instance, see
+ * replaceDetectorModel(...).
+ */
+bool RoadSignAPI::RoadSignAPI::staticReplaceDetectorModel(int modelVariant,
+		FilterManagementLibrary::TFIntegration::TensorflowNNModelDescription
+		modelDescription)
+{
+	return RoadSignAPI::RoadSignAPI::instance->replaceDetectorModel(
+			modelVariant, modelDescription);
+}
+
+/**
+ * @brief Replaces a classifier model of the static instance, see
+ * replaceClassifierModel(...).
+ */
+bool RoadSignAPI::RoadSignAPI::staticReplaceClassifierModel(int modelVariant,
+		FilterManagementLibrary::TFIntegration::TensorflowNNModelDescription
+		modelDescription)
+{
+	return RoadSignAPI::RoadSignAPI::instance->replaceClassifierModel(
+			modelVariant, modelDescription);
+}
+
+/**
+ * @brief Returns the state of the lastly started detector model
+ * replacement of the static instance.
+ */
+FilterManagementLibrary::PipeSystem::TFNNBasedPipeFilter::ModelSwapState
+		RoadSignAPI::RoadSignAPI::staticGetDetectorModelSwapState()
+{
+	return RoadSignAPI::RoadSignAPI::instance->getDetectorModelSwapState();
+}
+
+/**
+ * @brief Returns the state of the lastly started classifier model
+ * replacement of the static instance.
+ */
+FilterManagementLibrary::PipeSystem::TFNNBasedPipeFilter::ModelSwapState
+		RoadSignAPI::RoadSignAPI::staticGetClassifierModelSwapState()
+{
+	return RoadSignAPI::RoadSignAPI::instance->getClassifierModelSwapState();
+}
+
+/**
+ * @brief Adds an operating point to the QoS controller of the static
+ * instance, see addQoSOperatingPoint(...).
+ */
+int RoadSignAPI::RoadSignAPI::staticAddQoSOperatingPoint(
+		const QoSOperatingPoint& operatingPoint)
+{
+	return RoadSignAPI::RoadSignAPI::instance->addQoSOperatingPoint(
+			operatingPoint);
+}
+
+/**
+ * @brief Sets the frame rate the QoS controller of the static instance
+ * tries to hold, see setQoSTargetFrameRate(...).
+ */
+void RoadSignAPI::RoadSignAPI::staticSetQoSTargetFrameRate(
+		float framesPerSecond)
+{
+	RoadSignAPI::RoadSignAPI::instance->setQoSTargetFrameRate(
+			framesPerSecond);
+}
+
+/**
+ * @brief Configures when the QoS controller of the static instance
+ * switches, see setQoSHysteresis(...).
+ */
+void RoadSignAPI::RoadSignAPI::staticSetQoSHysteresis(float degradeRatio,
+		float upgradeRatio, int windowFrames, int upgradeHoldFrames,
+		double percentile)
+{
+	RoadSignAPI::RoadSignAPI::instance->setQoSHysteresis(degradeRatio,
+			upgradeRatio, windowFrames, upgradeHoldFrames, percentile);
+}
+
+/**
+ * @brief Returns the current operating point of the static instance,
+ * see getQoSOperatingPoint().
+ */
+int RoadSignAPI::RoadSignAPI::staticGetQoSOperatingPoint()
+{
+	return RoadSignAPI::RoadSignAPI::instance->getQoSOperatingPoint();
+}
+
+/**
+ * @brief Returns the processing times of all frames fed into the static
+ * instance, see getFrameLatencyHistogram().
+ */
+const FilterManagementLibrary::LatencyHistogram*
+		RoadSignAPI::RoadSignAPI::staticGetFrameLatencyHistogram()
+{
+	return RoadSignAPI::RoadSignAPI::instance->getFrameLatencyHistogram();
+}
+
+/**
+ * @brief Sets the latency budget of every frame fed into the static
+ * instance afterwards, see setFrameBudget(...).
+ */
+void RoadSignAPI::RoadSignAPI::staticSetFrameBudget(int budgetMs)
+{
+	RoadSignAPI::RoadSignAPI::instance->setFrameBudget(budgetMs);
+}
+
+/**
+ * @brief Returns which work was left out in the lastly processed frame,
+ * see getDegradationFlags().
+ */
+uint32_t RoadSignAPI::RoadSignAPI::staticGetDegradationFlags()
+{
+	return RoadSignAPI::RoadSignAPI::instance->getDegradationFlags();
+}
+
+/**
+ * @brief Sets the tuning parameters of the static instance, see
+ * setParameters(...).
+ */
+bool RoadSignAPI::RoadSignAPI::staticSetParameters(
+		const RSAPIParameters& parameters)
+{
+	return RoadSignAPI::RoadSignAPI::instance->setParameters(parameters);
+}
+
+/**
+ * @brief Returns the tuning parameters of the static instance.
+ */
+const RoadSignAPI::RSAPIParameters&
+		RoadSignAPI::RoadSignAPI::staticGetParameters()
+{
+	return RoadSignAPI::RoadSignAPI::instance->getParameters();
+}
+
+/**
+ * @brief Starts the frame trace of the static instance, see
+ * startFrameTrace(...).
+ */
+bool RoadSignAPI::RoadSignAPI::staticStartFrameTrace(const std::string& path)
+{
+	return RoadSignAPI::RoadSignAPI::instance->startFrameTrace(path);
+}
+
+/**
+ * @brief Stops the frame trace of the static instance, see
+ * stopFrameTrace().
+ */
+bool RoadSignAPI::RoadSignAPI::staticStopFrameTrace()
+{
+	return RoadSignAPI::RoadSignAPI::instance->stopFrameTrace();
+}
+
+/**
+ * @brief Returns the buffer size staticSerializeResults(...) needs for the
+ * results of the lastly processed frame.
+ */
+size_t RoadSignAPI::RoadSignAPI::staticGetSerializedResultsSize()
+{
+	return RoadSignAPI::RoadSignAPI::instance->getSerializedResultsSize();
+}
+
+/**
+ * @brief Writes the results of the lastly processed frame into a flat
+ * buffer.
+ *
+ * See serializeResults(...) for a more detailed description.
+ */
+bool RoadSignAPI::RoadSignAPI::staticSerializeResults(uint8_t* buffer,
+		size_t bufferSize, size_t* writtenSize)
+{
+	return RoadSignAPI::RoadSignAPI::instance->serializeResults(buffer,
+			bufferSize, writtenSize);
+}
+
+/**
+ * @brief Writes the results of the lastly processed frame into a flat
+ * buffer, with the given frame index.
+ *
+ * See serializeResults(...) for a more detailed description.
+ */
+bool RoadSignAPI::RoadSignAPI::staticSerializeResults(uint8_t* buffer,
+		size_t bufferSize, size_t* writtenSize, uint64_t frameIndex)
+{
+	return RoadSignAPI::RoadSignAPI::instance->serializeResults(buffer,
+			bufferSize, writtenSize, frameIndex);
+}
+
+/**
+ * @brief Renders the lastly processed frame and its results into a buffer.
+ *
+ * See renderAnnotatedImage(...) for a more detailed description.
+ */
+bool RoadSignAPI::RoadSignAPI::staticRenderAnnotatedImage(uint8_t* output,
+		int outputStride,
+		FilterManagementLibrary::ImageConversion::PixelFormat format,
+		const AnnotationOptions& options)
+{
+	return RoadSignAPI::RoadSignAPI::instance->renderAnnotatedImage(output,
+			outputStride, format, options);
+}
@@ -0,0 +1,222 @@
+/*
+ * SharedMemoryFrameProducer.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#include "RoadSignAPI/SharedMemoryTransport/SharedMemoryFrameProducer.h"
+#include "FilterManagementLibrary/Logger.h"
+
+#include <algorithm>
+
+/**
+ * @brief Connects to a running SharedMemoryFrameServer.
+ *
+ * @param const std::string& name base name passed to
+ * SharedMemoryFrameServer::start(...)
+ *
+ * @return bool true if both rings were opened, false otherwise
+ */
+bool RoadSignAPI::SharedMemoryFrameProducer::connect(const std::string& name)
+{
+	if(!this->frameRing.open(getSharedMemoryFrameRingName(name)) ||
+			!this->resultRing.open(getSharedMemoryResultRingName(name)))
+	{
+		this->disconnect();
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Disconnects from the server, the server keeps running.
+ */
+void RoadSignAPI::SharedMemoryFrameProducer::disconnect()
+{
+	this->frameRing.close();
+	this->resultRing.close();
+}
+
+/**
+ * @brief Returns whether the producer is connected to a running server.
+ */
+bool RoadSignAPI::SharedMemoryFrameProducer::isConnected() const
+{
+	return this->frameRing.isOpen() && this->resultRing.isOpen();
+}
+
+/**
+ * @brief Reserves the next frame slot and describes a tightly packed
+ * frame of the given format in it.
+ *
+ * The caller writes the pixel data to the returned plane pointers and
+ * calls commitFrame() afterwards. The strides are stored in the returned
+ * header: the width for the Y plane, the width rounded up to an even
+ * number for interleaved NV21 / NV12 chroma, half of it for the I420
+ * chroma planes and 3 * width for BGR.
+ *
+ * @param SharedMemoryFrameFormat format layout of the frame
+ *
+ * @param int width width of the frame in pixels
+ *
+ * @param int height height of the frame in pixels
+ *
+ * @param bool rotate180 true if the frame shall be rotated before
+ * processing
+ *
+ * @param uint64_t frameID id returned with the results of this frame
+ *
+ * @param uint8_t* planes[3] receives the start of each plane (unused
+ * planes are set to NULL)
+ *
+ * @param int timeoutMs maximum time to wait for a free slot in
+ * milliseconds (negative: wait forever)
+ *
+ * @return SharedMemoryFrameSlotHeader* header of the reserved slot, or
+ * NULL if the frame does not fit into a slot, the timeout expired or the
+ * server stopped
+ */
+RoadSignAPI::SharedMemoryFrameSlotHeader*
+		RoadSignAPI::SharedMemoryFrameProducer::acquireFrame(
+		SharedMemoryFrameFormat format, int width, int height,
+		bool rotate180, uint64_t frameID, uint8_t* planes[3], int timeoutMs)
+{
+	if(width <= 0 || height <= 0)
+		return NULL;
+
+	const uint32_t chromaWidth = (width + 1) / 2;
+	const uint32_t chromaHeight = (height + 1) / 2;
+
+	int32_t strides[3] = {0, 0, 0};
+	uint32_t planeOffsets[3] = {0, 0, 0};
+	uint32_t frameEnd = SHARED_MEMORY_FRAME_DATA_OFFSET;
+
+	planeOffsets[0] = SHARED_MEMORY_FRAME_DATA_OFFSET;
+
+	switch(format)
+	{
+		case SharedMemoryFrameFormat::BGR:
+		{
+			strides[0] = 3 * width;
+			frameEnd += strides[0] * height;
+		}
+		break;
+		case SharedMemoryFrameFormat::NV21:
+		case SharedMemoryFrameFormat::NV12:
+		{
+			strides[0] = width;
+			strides[1] = 2 * chromaWidth;
+			planeOffsets[1] = planeOffsets[0] + strides[0] * height;
+			frameEnd = planeOffsets[1] + strides[1] * chromaHeight;
+		}
+		break;
+		case SharedMemoryFrameFormat::I420:
+		{
+			strides[0] = width;
+			strides[1] = strides[2] = chromaWidth;
+			planeOffsets[1] = planeOffsets[0] + strides[0] * height;
+			planeOffsets[2] = planeOffsets[1] + strides[1] * chromaHeight;
+			frameEnd = planeOffsets[2] + strides[2] * chromaHeight;
+		}
+		break;
+		default:
+			return NULL;
+	}
+
+	if(frameEnd > this->frameRing.getSlotSize())
+	{
+		FilterManagementLibrary::Logger::printfln(
+				"SharedMemoryFrameProducer: frame %d x %d exceeds slot size",
+				width, height);
+		return NULL;
+	}
+
+	uint8_t* slot = this->frameRing.acquireWriteSlot(timeoutMs);
+
+	if(slot == NULL)
+		return NULL;
+
+	SharedMemoryFrameSlotHeader* header =
+			reinterpret_cast<SharedMemoryFrameSlotHeader*>(slot);
+
+	header->frameID = frameID;
+	header->format = static_cast<uint32_t>(format);
+	header->width = width;
+	header->height = height;
+	header->rotate180 = rotate180 ? 1 : 0;
+
+	for(int i = 0; i < 3; i++)
+	{
+		header->strides[i] = strides[i];
+		header->planeOffsets[i] = planeOffsets[i];
+		planes[i] = planeOffsets[i] == 0 ? NULL : slot + planeOffsets[i];
+	}
+
+	return header;
+}
+
+/**
+ * @brief Hands the frame reserved by acquireFrame(...) to the server.
+ */
+void RoadSignAPI::SharedMemoryFrameProducer::commitFrame()
+{
+	this->frameRing.commitWriteSlot();
+}
+
+/**
+ * @brief Waits for the results of the next frame.
+ *
+ * Results are returned in the order the frames were committed. The
+ * reader points into the result slot, it stays valid until
+ * releaseResult() is called.
+ *
+ * @param ResultBufferReader* reader attached to the serialized results
+ *
+ * @param uint64_t* frameID receives the id passed to acquireFrame(...)
+ *
+ * @param SharedMemoryResultStatus* status receives the status of the
+ * frame; if it is not OK, the results are empty
+ *
+ * @param int timeoutMs maximum time to wait in milliseconds
+ * (negative: wait forever)
+ *
+ * @return bool true if a result was acquired, false if the timeout
+ * expired or the server stopped
+ */
+bool RoadSignAPI::SharedMemoryFrameProducer::acquireResult(
+		ResultBufferReader* reader, uint64_t* frameID,
+		SharedMemoryResultStatus* status, int timeoutMs)
+{
+	uint8_t* slot = this->resultRing.acquireReadSlot(timeoutMs);
+
+	if(slot == NULL)
+		return false;
+
+	const SharedMemoryResultSlotHeader* header =
+			reinterpret_cast<const SharedMemoryResultSlotHeader*>(slot);
+
+	*frameID = header->frameID;
+	*status = static_cast<SharedMemoryResultStatus>(header->status);
+
+	const size_t resultSize = std::min<size_t>(header->resultSize,
+			this->resultRing.getSlotSize() - SHARED_MEMORY_RESULT_OFFSET);
+
+	if(!reader->attach(slot + SHARED_MEMORY_RESULT_OFFSET, resultSize))
+	{
+		this->resultRing.releaseReadSlot();
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Hands the result slot returned by acquireResult(...) back to the
+ * server.
+ */
+void RoadSignAPI::SharedMemoryFrameProducer::releaseResult()
+{
+	this->resultRing.releaseReadSlot();
+}
@@ -0,0 +1,353 @@
+/*
+ * SharedMemoryFrameServer.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#include "RoadSignAPI/SharedMemoryTransport/SharedMemoryFrameServer.h"
+#include "RoadSignAPI/RoadSignAPI.h"
+#include "FilterManagementLibrary/Logger.h"
+
+/**
+ * @brief Constructor of SharedMemoryFrameServer.
+ *
+ * The rings are created by start(...).
+ */
+RoadSignAPI::SharedMemoryFrameServer::SharedMemoryFrameServer() :
+		transportOnly(false), resultTimeoutMs(100),
+		processedFrames(0), droppedResults(0)
+{
+}
+
+/**
+ * @brief Creates the frame and result rings.
+ *
+ * The rings are named getSharedMemoryFrameRingName(name) and
+ * getSharedMemoryResultRingName(name). Producers connect using the same
+ * base name.
+ *
+ * @param const std::string& name base name of the shared memory segments,
+ * needs to start with a slash (i.e. "/rsapi")
+ *
+ * @param uint32_t slotCount number of slots of each ring, i.e. the
+ * maximum number of frames in flight
+ *
+ * @param int maxWidth maximum width of the frames in pixels
+ *
+ * @param int maxHeight maximum height of the frames in pixels
+ *
+ * @param int maxSigns maximum number of signs per frame which fit into
+ * a result slot
+ *
+ * @return bool true if both rings were created, false otherwise
+ */
+bool RoadSignAPI::SharedMemoryFrameServer::start(const std::string& name,
+		uint32_t slotCount, int maxWidth, int maxHeight, int maxSigns)
+{
+	// Large enough for 8 bit BGR, which is the largest format we accept
+	const uint32_t frameSlotSize = SHARED_MEMORY_FRAME_DATA_OFFSET +
+			static_cast<uint32_t>(maxWidth) * maxHeight * 3;
+
+	const uint32_t resultSlotSize = SHARED_MEMORY_RESULT_OFFSET +
+			sizeof(ResultBufferHeader) + maxSigns *
+			(sizeof(ResultSignRecord) + sizeof(ResultCombinationSpan));
+
+	if(!this->frameRing.create(getSharedMemoryFrameRingName(name),
+			slotCount, frameSlotSize) ||
+			!this->resultRing.create(getSharedMemoryResultRingName(name),
+			slotCount, resultSlotSize))
+	{
+		this->stop();
+		return false;
+	}
+
+	FilterManagementLibrary::Logger::printfln(
+			"SharedMemoryFrameServer: serving on %s (%u slots, %d x %d)",
+			name.c_str(), this->frameRing.getSlotCount(), maxWidth, maxHeight);
+
+	return true;
+}
+
+/**
+ * @brief Closes and removes both rings, connected producers are woken up.
+ */
+void RoadSignAPI::SharedMemoryFrameServer::stop()
+{
+	this->frameRing.close();
+	this->resultRing.close();
+}
+
+/**
+ * @brief Checks that all planes of a frame lie inside its slot.
+ */
+bool RoadSignAPI::SharedMemoryFrameServer::isFrameValid(
+		const SharedMemoryFrameSlotHeader* frame) const
+{
+	if(frame->width <= 0 || frame->height <= 0 ||
+			frame->format > static_cast<uint32_t>(SharedMemoryFrameFormat::BGR))
+	{
+		return false;
+	}
+
+	const SharedMemoryFrameFormat format =
+			static_cast<SharedMemoryFrameFormat>(frame->format);
+
+	const int64_t chromaWidth = (frame->width + 1) / 2;
+	const int64_t chromaHeight = (frame->height + 1) / 2;
+
+	int planeCount = 0;
+	int64_t rowBytes[3];
+	int64_t rows[3];
+
+	switch(format)
+	{
+		case SharedMemoryFrameFormat::BGR:
+		{
+			planeCount = 1;
+			rowBytes[0] = 3 * static_cast<int64_t>(frame->width);
+			rows[0] = frame->height;
+		}
+		break;
+		case SharedMemoryFrameFormat::NV21:
+		case SharedMemoryFrameFormat::NV12:
+		{
+			planeCount = 2;
+			rowBytes[0] = frame->width;
+			rows[0] = frame->height;
+			rowBytes[1] = 2 * chromaWidth;
+			rows[1] = chromaHeight;
+		}
+		break;
+		case SharedMemoryFrameFormat::I420:
+		{
+			planeCount = 3;
+			rowBytes[0] = frame->width;
+			rows[0] = frame->height;
+			rowBytes[1] = rowBytes[2] = chromaWidth;
+			rows[1] = rows[2] = chromaHeight;
+		}
+		break;
+	}
+
+	for(int i = 0; i < planeCount; i++)
+	{
+		if(frame->strides[i] < rowBytes[i] ||
+				frame->planeOffsets[i] < sizeof(SharedMemoryFrameSlotHeader) ||
+				frame->planeOffsets[i] + frame->strides[i] * (rows[i] - 1) +
+				rowBytes[i] > this->frameRing.getSlotSize())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * @brief Feeds the frame in the given slot into the RoadSignAPI.
+ */
+RoadSignAPI::SharedMemoryResultStatus
+		RoadSignAPI::SharedMemoryFrameServer::feedFrame(uint8_t* slot)
+{
+	const SharedMemoryFrameSlotHeader* frame =
+			reinterpret_cast<const SharedMemoryFrameSlotHeader*>(slot);
+
+	if(!this->isFrameValid(frame))
+		return SharedMemoryResultStatus::INVALID_FRAME;
+
+	if(this->transportOnly)
+		return SharedMemoryResultStatus::OK;
+
+	bool processed = false;
+
+	if(frame->format == static_cast<uint32_t>(SharedMemoryFrameFormat::BGR))
+	{
+		// Only a header on the slot memory, nothing is copied
+		cv::Mat image(frame->height, frame->width, CV_8UC3,
+				slot + frame->planeOffsets[0], frame->strides[0]);
+
+		processed = RoadSignAPI::staticFeedImage(image);
+	}
+	else
+	{
+		const uint8_t* planes[3];
+		for(int i = 0; i < 3; i++)
+		{
+			planes[i] = slot + frame->planeOffsets[i];
+		}
+
+		FilterManagementLibrary::YUVFormat format;
+		switch(static_cast<SharedMemoryFrameFormat>(frame->format))
+		{
+			case SharedMemoryFrameFormat::NV12:
+				format = FilterManagementLibrary::YUVFormat::NV12;
+			break;
+			case SharedMemoryFrameFormat::I420:
+				format = FilterManagementLibrary::YUVFormat::I420;
+			break;
+			default:
+				format = FilterManagementLibrary::YUVFormat::NV21;
+			break;
+		}
+
+		processed = RoadSignAPI::staticFeedImageYUV(planes, frame->strides,
+				format, frame->width, frame->height, frame->rotate180 != 0);
+	}
+
+	return processed ? SharedMemoryResultStatus::OK :
+			SharedMemoryResultStatus::PROCESSING_FAILED;
+}
+
+/**
+ * @brief Waits for the next frame, processes it and publishes its results.
+ *
+ * The frame slot is handed back to the producer as soon as the pipeline
+ * finished, before the results are serialized. If the result ring stays
+ * full for longer than the result timeout, the results are dropped.
+ *
+ * @param int timeoutMs maximum time to wait for a frame in milliseconds
+ * (negative: wait forever)
+ *
+ * @return bool true if a frame was processed, false if the timeout
+ * expired or the server was stopped
+ */
+bool RoadSignAPI::SharedMemoryFrameServer::processNextFrame(int timeoutMs)
+{
+	uint8_t* slot = this->frameRing.acquireReadSlot(timeoutMs);
+
+	if(slot == NULL)
+		return false;
+
+	const uint64_t frameID =
+			reinterpret_cast<SharedMemoryFrameSlotHeader*>(slot)->frameID;
+	const int width = reinterpret_cast<SharedMemoryFrameSlotHeader*>(
+			slot)->width;
+	const int height = reinterpret_cast<SharedMemoryFrameSlotHeader*>(
+			slot)->height;
+
+	SharedMemoryResultStatus status = this->feedFrame(slot);
+
+	this->frameRing.releaseReadSlot();
+	this->processedFrames++;
+
+	uint8_t* resultSlot = this->resultRing.acquireWriteSlot(
+			this->resultTimeoutMs);
+
+	if(resultSlot == NULL)
+	{
+		this->droppedResults++;
+		return true;
+	}
+
+	SharedMemoryResultSlotHeader* result =
+			reinterpret_cast<SharedMemoryResultSlotHeader*>(resultSlot);
+	uint8_t* resultBuffer = resultSlot + SHARED_MEMORY_RESULT_OFFSET;
+	const size_t resultBufferSize =
+			this->resultRing.getSlotSize() - SHARED_MEMORY_RESULT_OFFSET;
+	size_t resultSize = 0;
+
+	if(status == SharedMemoryResultStatus::OK)
+	{
+		bool serialized;
+
+		if(this->transportOnly)
+		{
+			const std::vector<DetectedSignCombination> noCombinations;
+			serialized = ResultBufferWriter::serialize(noCombinations,
+					width, height, frameID, resultBuffer, resultBufferSize,
+					&resultSize);
+		}
+		else
+		{
+			// The producer's frame ID, like on the other paths, so the
+			// result buffer and the result slot header agree
+			serialized = RoadSignAPI::staticSerializeResults(resultBuffer,
+					resultBufferSize, &resultSize, frameID);
+		}
+
+		if(!serialized)
+			status = SharedMemoryResultStatus::RESULT_TOO_LARGE;
+	}
+
+	if(status != SharedMemoryResultStatus::OK)
+	{
+		const std::vector<DetectedSignCombination> noCombinations;
+		ResultBufferWriter::serialize(noCombinations, width, height,
+				frameID, resultBuffer, resultBufferSize, &resultSize);
+	}
+
+	result->frameID = frameID;
+	result->status = static_cast<uint32_t>(status);
+	result->resultSize = resultSize;
+
+	this->resultRing.commitWriteSlot();
+	return true;
+}
+
+/**
+ * @brief Processes frames until stopRequested is set.
+ *
+ * Checks stopRequested at least every 100 milliseconds.
+ *
+ * @param const std::atomic<bool>* stopRequested flag to stop serving,
+ * i.e. set by a signal handler
+ */
+void RoadSignAPI::SharedMemoryFrameServer::run(
+		const std::atomic<bool>* stopRequested)
+{
+	while(!stopRequested->load())
+	{
+		this->processNextFrame(100);
+	}
+
+	FilterManagementLibrary::Logger::printfln(
+			"SharedMemoryFrameServer: processed %llu frames, "
+			"dropped %llu results",
+			static_cast<unsigned long long>(this->processedFrames),
+			static_cast<unsigned long long>(this->droppedResults));
+}
+
+/**
+ * @brief Enables or disables the transport only mode.
+ *
+ * In transport only mode, frames are validated but not fed into the
+ * RoadSignAPI, empty results are returned. Useful to test producers
+ * (and to measure the transport overhead) without any models.
+ *
+ * @param bool transportOnly true to skip the RoadSignAPI
+ */
+void RoadSignAPI::SharedMemoryFrameServer::setTransportOnly(
+		bool transportOnly)
+{
+	this->transportOnly = transportOnly;
+}
+
+/**
+ * @brief Sets how long to wait for a free result slot before results
+ * are dropped.
+ *
+ * @param int resultTimeoutMs timeout in milliseconds
+ */
+void RoadSignAPI::SharedMemoryFrameServer::setResultTimeout(
+		int resultTimeoutMs)
+{
+	this->resultTimeoutMs = resultTimeoutMs;
+}
+
+/**
+ * @brief Returns the number of frames processed so far.
+ */
+uint64_t RoadSignAPI::SharedMemoryFrameServer::getProcessedFrames() const
+{
+	return this->processedFrames;
+}
+
+/**
+ * @brief Returns the number of results dropped so far, because the
+ * producer did not read them in time.
+ */
+uint64_t RoadSignAPI::SharedMemoryFrameServer::getDroppedResults() const
+{
+	return this->droppedResults;
+}
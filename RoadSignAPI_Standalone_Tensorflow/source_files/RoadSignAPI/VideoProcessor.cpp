@@ -0,0 +1,437 @@
+/*
+ * VideoProcessor.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ */
+
+#include "RoadSignAPI/VideoProcessor.h"
+#include "RoadSignAPI/RoadSignAPI.h"
+
+#include "FilterManagementLibrary/Logger.h"
+#include "FilterManagementLibrary/Utilities.h"
+
+#include <algorithm>
+#include <system_error>
+
+/**
+ * @brief Appends a frame, fails if the channel was closed.
+ */
+bool RoadSignAPI::VideoProcessor::FrameChannel::push(VideoFrame frame)
+{
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+
+		if(this->closed)
+			return false;
+
+		this->frames.push_back(std::move(frame));
+	}
+	this->framesAvailable.notify_one();
+
+	return true;
+}
+
+/**
+ * @brief Takes the oldest frame, waits until there is one.
+ *
+ * @return bool false if the channel was closed and is empty
+ */
+bool RoadSignAPI::VideoProcessor::FrameChannel::pop(VideoFrame* frame)
+{
+	std::unique_lock<std::mutex> lock(this->mutex);
+
+	this->framesAvailable.wait(lock, [this]
+			{
+				return !this->frames.empty() || this->closed;
+			});
+
+	if(this->frames.empty())
+		return false;
+
+	*frame = std::move(this->frames.front());
+	this->frames.pop_front();
+
+	return true;
+}
+
+/**
+ * @brief Closes the channel and wakes up all waiting threads.
+ */
+void RoadSignAPI::VideoProcessor::FrameChannel::close()
+{
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->closed = true;
+	}
+	this->framesAvailable.notify_all();
+}
+
+/**
+ * @brief Removes all frames and opens the channel again.
+ */
+void RoadSignAPI::VideoProcessor::FrameChannel::reset()
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+
+	this->frames.clear();
+	this->closed = false;
+}
+
+/**
+ * @brief Standard constructor of VideoProcessor.
+ */
+RoadSignAPI::VideoProcessor::VideoProcessor() : outputFrameRate(0.0),
+		stopDecoding(false)
+{
+
+}
+
+/**
+ * @brief Opens a video file or stream.
+ *
+ * @param const std::string& input anything cv::VideoCapture can open,
+ * i.e. a file or an RTSP URL
+ *
+ * @return bool true on success, false otherwise
+ */
+bool RoadSignAPI::VideoProcessor::open(const std::string& input)
+{
+	if(!this->capture.open(input))
+	{
+		FilterManagementLibrary::Logger::printfln(
+				"VideoProcessor: could not open %s", input.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Sets the options of the next run(...), see VideoProcessorOptions.
+ */
+void RoadSignAPI::VideoProcessor::setOptions(
+		const VideoProcessorOptions& options)
+{
+	this->options = options;
+	this->options.stride = std::max(this->options.stride, 1);
+	this->options.startFrame = std::max(this->options.startFrame, 0);
+	this->options.decodeAheadFrames =
+			std::max(this->options.decodeAheadFrames, 1);
+	this->options.encodeQueueFrames =
+			std::max(this->options.encodeQueueFrames, 1);
+}
+
+/**
+ * @brief Sets the function called for every processed frame, i.e. to
+ * read the results of the frame from the RoadSignAPI.
+ */
+void RoadSignAPI::VideoProcessor::setFrameCallback(
+		FrameCallback frameCallback)
+{
+	this->frameCallback = frameCallback;
+}
+
+/**
+ * @brief Processes the opened video until it ends, maxFrames frames were
+ * processed or a stop is requested.
+ *
+ * The decoding and encoding threads are started, the frames are
+ * processed on the calling thread. Returns once all annotated frames
+ * were encoded and the threads have finished. A frame which could not
+ * be processed is skipped (and not written to the output).
+ *
+ * @param const std::atomic<bool>* stopRequested optional, stops the
+ * processing once it becomes true
+ *
+ * @return bool true on success, false if no video is open or the threads
+ * or the output file could not be created
+ */
+bool RoadSignAPI::VideoProcessor::run(const std::atomic<bool>* stopRequested)
+{
+	if(!this->capture.isOpened())
+	{
+		FilterManagementLibrary::Logger::printfln(
+				"VideoProcessor: no video opened");
+		return false;
+	}
+
+	this->statistics = VideoProcessorStatistics();
+	this->stopDecoding = false;
+
+	this->decodedFrames.reset();
+	this->freeDecodeBuffers.reset();
+	this->annotatedFrames.reset();
+	this->freeEncodeBuffers.reset();
+
+	for(int i = 0; i < this->options.decodeAheadFrames; i++)
+		this->freeDecodeBuffers.push(VideoFrame());
+
+	bool encoding = !this->options.outputFile.empty();
+
+	if(encoding)
+	{
+		for(int i = 0; i < this->options.encodeQueueFrames; i++)
+			this->freeEncodeBuffers.push(VideoFrame());
+
+		this->outputFrameRate = this->options.outputFrameRate;
+		if(this->outputFrameRate <= 0.0)
+		{
+			// Streams often don't report a frame rate
+			double inputFrameRate = this->capture.get(cv::CAP_PROP_FPS);
+			if(inputFrameRate <= 0.0)
+				inputFrameRate = 30.0;
+
+			this->outputFrameRate = inputFrameRate / this->options.stride;
+		}
+	}
+
+	const int64_t startTimeUs = FilterManagementLibrary::Utilities::getTimeUs();
+
+	try
+	{
+		this->decoder = std::thread(&VideoProcessor::decodeFrames, this);
+
+		if(encoding)
+			this->encoder = std::thread(&VideoProcessor::encodeFrames, this);
+	}
+	catch(const std::system_error& error)
+	{
+		FilterManagementLibrary::Logger::printfln(
+				"VideoProcessor: failed to create thread: %s", error.what());
+		this->stopThreads();
+		return false;
+	}
+
+	bool success = true;
+	VideoFrame frame;
+
+	while(stopRequested == nullptr || !stopRequested->load())
+	{
+		if(this->options.maxFrames > 0 && this->statistics.processedFrames >=
+				(uint64_t) this->options.maxFrames)
+			break;
+
+		const int64_t waitStartTimeUs =
+				FilterManagementLibrary::Utilities::getTimeUs();
+
+		if(!this->decodedFrames.pop(&frame))
+			break;
+
+		const int64_t processStartTimeUs =
+				FilterManagementLibrary::Utilities::getTimeUs();
+		this->statistics.decodeWaitTimeUs +=
+				processStartTimeUs - waitStartTimeUs;
+
+		if(RoadSignAPI::staticFeedImage(frame.image))
+		{
+			this->statistics.processedFrames++;
+
+			if(this->frameCallback)
+				this->frameCallback(frame.frameIndex, frame.image);
+
+			VideoFrame output;
+			const int64_t encodeWaitStartTimeUs =
+					FilterManagementLibrary::Utilities::getTimeUs();
+
+			if(encoding && this->freeEncodeBuffers.pop(&output))
+			{
+				this->statistics.encodeWaitTimeUs +=
+						FilterManagementLibrary::Utilities::getTimeUs() -
+						encodeWaitStartTimeUs;
+
+				output.frameIndex = frame.frameIndex;
+				output.image.create(frame.image.rows, frame.image.cols,
+						CV_8UC3);
+
+				RoadSignAPI::staticRenderAnnotatedImage(output.image.data,
+						(int) output.image.step,
+						FilterManagementLibrary::ImageConversion::
+						PixelFormat::BGR, this->options.annotationOptions);
+
+				encoding = this->annotatedFrames.push(std::move(output));
+			}
+			else
+				encoding = false;
+
+			// The encoding thread gave up (see encodeFrames())
+			if(!encoding && !this->options.outputFile.empty())
+				success = false;
+		}
+		else
+		{
+			FilterManagementLibrary::Logger::printfln(
+					"VideoProcessor: processing frame %llu failed",
+					(unsigned long long) frame.frameIndex);
+		}
+
+		this->statistics.processTimeUs +=
+				FilterManagementLibrary::Utilities::getTimeUs() -
+				processStartTimeUs;
+
+		// The RoadSignAPI still refers to the frame, but won't touch it
+		// before the next frame is fed
+		this->freeDecodeBuffers.push(std::move(frame));
+	}
+
+	this->stopThreads();
+
+	this->statistics.totalTimeUs =
+			FilterManagementLibrary::Utilities::getTimeUs() - startTimeUs;
+
+	return success;
+}
+
+/**
+ * @brief Body of the decoding thread.
+ *
+ * Skips startFrame frames, then decodes every stride-th frame into a
+ * free buffer until the video ends or the processing stops. Closes
+ * decodedFrames when done, so the processing thread knows the video
+ * ended.
+ */
+void RoadSignAPI::VideoProcessor::decodeFrames()
+{
+	uint64_t frameIndex = 0;
+	bool grabbed = true;
+
+	for(int i = 0; i < this->options.startFrame && grabbed; i++)
+	{
+		grabbed = this->capture.grab();
+		frameIndex++;
+	}
+
+	VideoFrame frame;
+
+	while(grabbed && !this->stopDecoding.load() &&
+			this->freeDecodeBuffers.pop(&frame))
+	{
+		const int64_t startTimeUs =
+				FilterManagementLibrary::Utilities::getTimeUs();
+
+		// Reuses the memory of the buffer if the size did not change
+		if(!this->capture.read(frame.image) || frame.image.empty())
+			break;
+
+		frame.frameIndex = frameIndex;
+
+		this->statistics.decodedFrames++;
+		this->statistics.decodeTimeUs +=
+				FilterManagementLibrary::Utilities::getTimeUs() - startTimeUs;
+
+		if(!this->decodedFrames.push(std::move(frame)))
+			break;
+
+		const int64_t skipStartTimeUs =
+				FilterManagementLibrary::Utilities::getTimeUs();
+
+		for(int i = 1; i < this->options.stride && grabbed; i++)
+			grabbed = this->capture.grab();
+
+		frameIndex += this->options.stride;
+
+		this->statistics.decodeTimeUs +=
+				FilterManagementLibrary::Utilities::getTimeUs() -
+				skipStartTimeUs;
+	}
+
+	this->decodedFrames.close();
+}
+
+/**
+ * @brief Body of the encoding thread.
+ *
+ * Writes the annotated frames to the output file, which is opened with
+ * the size of the first frame. If it can not be opened, both encoding
+ * channels are closed, so the processing thread stops rendering frames.
+ */
+void RoadSignAPI::VideoProcessor::encodeFrames()
+{
+	VideoFrame frame;
+
+	while(this->annotatedFrames.pop(&frame))
+	{
+		if(!this->writer.isOpened() &&
+				!this->openWriter(frame.image.cols, frame.image.rows))
+		{
+			this->annotatedFrames.close();
+			this->freeEncodeBuffers.close();
+			return;
+		}
+
+		const int64_t startTimeUs =
+				FilterManagementLibrary::Utilities::getTimeUs();
+
+		this->writer.write(frame.image);
+
+		this->statistics.encodedFrames++;
+		this->statistics.encodeTimeUs +=
+				FilterManagementLibrary::Utilities::getTimeUs() - startTimeUs;
+
+		this->freeEncodeBuffers.push(std::move(frame));
+	}
+}
+
+/**
+ * @brief Opens the output file.
+ *
+ * @param int width width of the annotated frames
+ * @param int height height of the annotated frames
+ *
+ * @return bool true on success, false otherwise
+ */
+bool RoadSignAPI::VideoProcessor::openWriter(int width, int height)
+{
+	if(!this->writer.open(this->options.outputFile, this->options.outputFourcc,
+			this->outputFrameRate, cv::Size(width, height)))
+	{
+		FilterManagementLibrary::Logger::printfln(
+				"VideoProcessor: could not open %s for writing",
+				this->options.outputFile.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Stops the decoding thread, lets the encoding thread write the
+ * remaining frames and closes the output file.
+ */
+void RoadSignAPI::VideoProcessor::stopThreads()
+{
+	this->stopDecoding = true;
+	this->freeDecodeBuffers.close();
+	this->decodedFrames.close();
+
+	if(this->decoder.joinable())
+		this->decoder.join();
+
+	this->annotatedFrames.close();
+
+	if(this->encoder.joinable())
+		this->encoder.join();
+
+	this->freeEncodeBuffers.close();
+
+	if(this->writer.isOpened())
+		this->writer.release();
+}
+
+/**
+ * @brief Returns the counters and times of the last run(...).
+ */
+const RoadSignAPI::VideoProcessorStatistics&
+		RoadSignAPI::VideoProcessor::getStatistics() const
+{
+	return this->statistics;
+}
+
+/**
+ * @brief Destructor of VideoProcessor, stops the threads if run(...) was
+ * interrupted by an exception.
+ */
+RoadSignAPI::VideoProcessor::~VideoProcessor()
+{
+	this->stopThreads();
+}
@@ -0,0 +1,207 @@
+/*
+ * EvaluationDataset.h
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ *
+ * Ground truth handling shared by the evaluation tools (rsapi_eval,
+ * rsapi_sweep).
+ */
+
+#ifndef TOOLS_EVALUATIONDATASET_H_
+#define TOOLS_EVALUATIONDATASET_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+struct GroundTruthBox
+{
+	cv::Rect box;
+	std::string className;
+};
+
+struct GroundTruthImage
+{
+	std::string filename;
+	std::vector<GroundTruthBox> groundTruth;
+};
+
+struct MatchCounts
+{
+	uint64_t truePositives = 0;
+	uint64_t falsePositives = 0;
+	uint64_t falseNegatives = 0;
+
+	// Matched detections whose classifier label equals the ground truth
+	uint64_t correctlyClassified = 0;
+
+	double getPrecision() const
+	{
+		return truePositives + falsePositives == 0 ? 0.0 :
+				(double) truePositives / (truePositives + falsePositives);
+	}
+
+	double getRecall() const
+	{
+		return truePositives + falseNegatives == 0 ? 0.0 :
+				(double) truePositives / (truePositives + falseNegatives);
+	}
+
+	double getF1Score() const
+	{
+		const double precision = this->getPrecision();
+		const double recall = this->getRecall();
+
+		return precision + recall == 0.0 ? 0.0 :
+				2.0 * precision * recall / (precision + recall);
+	}
+};
+
+/**
+ * Splits a CSV line, fields may be quoted (i.e. "(Sonstiges, gelb)").
+ */
+inline std::vector<std::string> splitCSVLine(const std::string& line)
+{
+	std::vector<std::string> fields(1);
+	bool quoted = false;
+
+	for(size_t i = 0; i < line.size(); i++)
+	{
+		const char c = line[i];
+
+		if(c == '"')
+		{
+			if(quoted && i + 1 < line.size() && line[i + 1] == '"')
+				fields.back() += line[++i];
+			else
+				quoted = !quoted;
+		}
+		else if(c == ',' && !quoted)
+			fields.push_back(std::string());
+		else if(c != '\r')
+			fields.back() += c;
+	}
+
+	return fields;
+}
+
+/**
+ * Reads a ground truth CSV in the format of ToolChain/Dataset/CSVs
+ * (filename,width,height,class,xmin,ymin,xmax,ymax), one Image (derived
+ * from GroundTruthImage) is appended per file name.
+ */
+template<typename Image>
+bool loadGroundTruth(const std::string& path, std::vector<Image>* images)
+{
+	std::ifstream file(path);
+	if(!file)
+	{
+		std::cout << "Could not open " << path << std::endl;
+		return false;
+	}
+
+	std::string line;
+	std::getline(file, line);
+
+	const std::vector<std::string> header = splitCSVLine(line);
+	const char* const columnNames[] = {"filename", "class", "xmin", "ymin",
+			"xmax", "ymax"};
+	int columns[6];
+
+	for(int i = 0; i < 6; i++)
+	{
+		columns[i] = std::find(header.begin(), header.end(), columnNames[i]) -
+				header.begin();
+
+		if(columns[i] == (int) header.size())
+		{
+			std::cout << path << " has no column " << columnNames[i]
+					<< std::endl;
+			return false;
+		}
+	}
+
+	const int maxColumn = *std::max_element(columns, columns + 6);
+	std::map<std::string, size_t> imageIndices;
+
+	while(std::getline(file, line))
+	{
+		const std::vector<std::string> fields = splitCSVLine(line);
+		if((int) fields.size() <= maxColumn)
+			continue;
+
+		const std::string& filename = fields[columns[0]];
+
+		std::map<std::string, size_t>::iterator image =
+				imageIndices.find(filename);
+
+		if(image == imageIndices.end())
+		{
+			image = imageIndices.insert(
+					std::make_pair(filename, images->size())).first;
+			images->push_back(Image());
+			images->back().filename = filename;
+		}
+
+		GroundTruthBox groundTruth;
+		groundTruth.className = fields[columns[1]];
+		groundTruth.box = cv::Rect(cv::Point(atoi(fields[columns[2]].c_str()),
+						atoi(fields[columns[3]].c_str())),
+				cv::Point(atoi(fields[columns[4]].c_str()),
+						atoi(fields[columns[5]].c_str())));
+
+		(*images)[image->second].groundTruth.push_back(groundTruth);
+	}
+
+	return true;
+}
+
+inline double getIoU(const cv::Rect& a, const cv::Rect& b)
+{
+	const double intersection = (a & b).area();
+	const double unionArea = a.area() + b.area() - intersection;
+
+	return unionArea <= 0.0 ? 0.0 : intersection / unionArea;
+}
+
+/**
+ * Finds the unmatched ground truth box the detection overlaps most, with
+ * an IoU of at least minIoU.
+ *
+ * @return int index of the box, -1 if there is none
+ */
+inline int findBestMatch(const cv::Rect& detection,
+		const std::vector<GroundTruthBox>& groundTruth,
+		const std::vector<bool>& matched, double minIoU)
+{
+	int bestMatch = -1;
+	double bestIoU = minIoU;
+
+	for(size_t i = 0; i < groundTruth.size(); i++)
+	{
+		if(matched[i])
+			continue;
+
+		const double iou = getIoU(detection, groundTruth[i].box);
+
+		if(iou >= bestIoU)
+		{
+			bestIoU = iou;
+			bestMatch = i;
+		}
+	}
+
+	return bestMatch;
+}
+
+
+#endif /* TOOLS_EVALUATIONDATASET_H_ */
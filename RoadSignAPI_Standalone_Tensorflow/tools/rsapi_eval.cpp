@@ -0,0 +1,594 @@
+/*
+ * rsapi_eval.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ *
+ * Evaluates the RoadSignAPI pipeline (the same code that is shipped, not
+ * the Python graph of ToolChain/Evaluation) on a labeled dataset and
+ * computes precision, recall and F1 score of the detections, matched to
+ * the ground truth boxes by IoU.
+ *
+ * The images are distributed over several RoadSignAPI instances running
+ * in parallel, each with its own models.
+ *
+ * Usage: rsapi_eval --csv labels.csv --images <image folder>
+ *                   [--instances 4] [--threads 1] [--iou 0.5]
+ *                   [--confidence 0.5] [--stage classifier|detector]
+ *                   [--classifier-labels labels_classifier.pbtxt]
+ *                   [--detections detections.csv] [--max-images 0]
+ *                   [--record <dir> | --replay <dir>]
+ *        rsapi_eval --folder <image folder> --detections detections.csv
+ *
+ * The ground truth CSV has the format of ToolChain/Dataset/CSVs
+ * (filename,width,height,class,xmin,ymin,xmax,ymax). With --folder, all
+ * images of the folder are processed without ground truth, only the
+ * detections are written.
+ * The detections CSV has the format detect_folder.py writes
+ * (filename,class,confidence,xmin,ymin,xmax,ymax), so calc_f1_score.py
+ * can still be used on it.
+ *
+ * --stage classifier (default) evaluates the signs the classifier
+ * approved, which is what the RoadSignAPI reports; --stage detector
+ * evaluates all detections (after the duplicates were removed).
+ * If --classifier-labels is given, the share of the matched signs whose
+ * classifier label equals the ground truth class is reported as well.
+ *
+ * --record writes the outputs of both models for every image to
+ * <dir>/detector.tfout and <dir>/classifier.tfout. --replay uses these
+ * outputs instead of running the models, so changes of the filters
+ * after the inference (thresholds, duplicate deletion, grouping) can be
+ * evaluated quickly and without the model files. Replaying only works
+ * for the same images and the same preprocessing of the model inputs.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+#include "RoadSignAPI/RoadSignAPI.h"
+#include "FilterManagementLibrary/TensorflowIntegration/TensorflowOutputRecording.h"
+#include "FilterManagementLibrary/Utilities.h"
+
+#include "EvaluationDataset.h"
+
+struct Detection
+{
+	cv::Rect box;
+	float confidence;
+	int classID;
+};
+
+struct EvaluationImage : public GroundTruthImage
+{
+	// Sorted by confidence, highest first
+	std::vector<Detection> detections;
+	bool processed = false;
+};
+
+static bool loadFolder(const std::string& folder,
+		std::vector<EvaluationImage>* images)
+{
+	const char* const patterns[] = {"*.png", "*.jpg", "*.jpeg", "*.ppm"};
+	std::vector<std::string> files;
+
+	for(const char* pattern : patterns)
+	{
+		std::vector<std::string> matches;
+		cv::glob(folder + "/" + pattern, matches, false);
+		files.insert(files.end(), matches.begin(), matches.end());
+	}
+
+	std::sort(files.begin(), files.end());
+
+	for(const std::string& file : files)
+	{
+		images->push_back(EvaluationImage());
+		images->back().filename = file.substr(file.find_last_of('/') + 1);
+	}
+
+	if(images->empty())
+	{
+		std::cout << "No images found in " << folder << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * Reads the class names of a labels file with lines like "8:VZ 1000".
+ * The Misc classes of the classifier are all mapped to "Misc", like
+ * translated.csv does.
+ */
+static bool loadClassifierLabels(const std::string& path,
+		std::vector<std::string>* labels)
+{
+	std::ifstream file(path);
+	if(!file)
+	{
+		std::cout << "Could not open " << path << std::endl;
+		return false;
+	}
+
+	std::string line;
+	while(std::getline(file, line))
+	{
+		if(!line.empty() && line.back() == '\r')
+			line.pop_back();
+
+		const size_t separator = line.find(':');
+		const int classID = atoi(line.c_str());
+
+		if(separator == std::string::npos || classID < 0)
+			continue;
+
+		std::string name = line.substr(separator + 1);
+		if(name.compare(0, 4, "Misc") == 0)
+			name = "Misc";
+
+		if(classID >= (int) labels->size())
+			labels->resize(classID + 1);
+
+		(*labels)[classID] = name;
+	}
+
+	return true;
+}
+
+/**
+ * Matches the detections of an image with at least minConfidence to the
+ * ground truth: the detections are visited from the most confident one
+ * on, each one is matched to the unmatched ground truth box it overlaps
+ * most, if the IoU is at least minIoU. Unmatched detections are false
+ * positives, unmatched ground truth boxes false negatives.
+ */
+static void matchDetections(const EvaluationImage& image,
+		float minConfidence, double minIoU,
+		const std::vector<std::string>& classifierLabels,
+		MatchCounts* counts)
+{
+	std::vector<bool> matched(image.groundTruth.size(), false);
+	uint64_t matchedCount = 0;
+
+	for(const Detection& detection : image.detections)
+	{
+		if(detection.confidence < minConfidence)
+			break;
+
+		const int bestMatch = findBestMatch(detection.box, image.groundTruth,
+				matched, minIoU);
+
+		if(bestMatch < 0)
+		{
+			counts->falsePositives++;
+			continue;
+		}
+
+		matched[bestMatch] = true;
+		matchedCount++;
+		counts->truePositives++;
+
+		if(detection.classID >= 0 &&
+				detection.classID < (int) classifierLabels.size() &&
+				classifierLabels[detection.classID] ==
+				image.groundTruth[bestMatch].className)
+		{
+			counts->correctlyClassified++;
+		}
+	}
+
+	counts->falseNegatives += image.groundTruth.size() - matchedCount;
+}
+
+/**
+ * Model outputs shared by all evaluation threads, see --record / --replay.
+ */
+struct OutputRecordings
+{
+	bool record = false;
+	bool replay = false;
+
+	FilterManagementLibrary::TFIntegration::TensorflowOutputRecorder
+		detectorRecorder;
+	FilterManagementLibrary::TFIntegration::TensorflowOutputRecorder
+		classifierRecorder;
+
+	FilterManagementLibrary::TFIntegration::TensorflowOutputRecording
+		detectorRecording;
+	FilterManagementLibrary::TFIntegration::TensorflowOutputRecording
+		classifierRecording;
+
+	bool open(const std::string& directory)
+	{
+		const std::string detectorFile = directory + "/detector.tfout";
+		const std::string classifierFile = directory + "/classifier.tfout";
+
+		if(this->record)
+		{
+			return this->detectorRecorder.open(detectorFile) &&
+					this->classifierRecorder.open(classifierFile);
+		}
+
+		if(this->replay)
+		{
+			return this->detectorRecording.open(detectorFile) &&
+					this->classifierRecording.open(classifierFile);
+		}
+
+		return true;
+	}
+
+	bool close()
+	{
+		if(!this->record)
+			return true;
+
+		const bool detectorClosed = this->detectorRecorder.close();
+		const bool classifierClosed = this->classifierRecorder.close();
+
+		std::cout << "Recorded " << this->detectorRecorder.getRecordCount()
+				<< " detector and " << this->classifierRecorder.getRecordCount()
+				<< " classifier outputs" << std::endl;
+
+		return detectorClosed && classifierClosed;
+	}
+
+	void attach(RoadSignAPI::RoadSignAPI* roadSignAPI)
+	{
+		if(this->record)
+		{
+			roadSignAPI->setOutputRecorders(&this->detectorRecorder,
+					&this->classifierRecorder);
+		}
+		else if(this->replay)
+		{
+			roadSignAPI->setOutputReplay(&this->detectorRecording,
+					&this->classifierRecording);
+		}
+	}
+};
+
+static bool sortByConfidence(const Detection& a, const Detection& b)
+{
+	return a.confidence > b.confidence;
+}
+
+/**
+ * Body of the evaluation threads: every thread has its own RoadSignAPI
+ * and takes the next unprocessed image until all are done.
+ */
+static void evaluateImages(const std::string& imageFolder,
+		const FilterManagementLibrary::TFIntegration::
+		TensorflowNNModelDescription& detectorModelDescription,
+		const FilterManagementLibrary::TFIntegration::
+		TensorflowNNModelDescription& classifierModelDescription,
+		int numThreads, bool classifierStage,
+		OutputRecordings* outputRecordings,
+		std::vector<EvaluationImage>* images, std::atomic<size_t>* nextImage,
+		std::atomic<size_t>* doneImages, std::atomic<bool>* failed)
+{
+	std::unique_ptr<RoadSignAPI::RoadSignAPI> roadSignAPI(
+			new RoadSignAPI::RoadSignAPI(detectorModelDescription,
+					classifierModelDescription, numThreads));
+
+	// Before init(), so replaying does not load the models
+	outputRecordings->attach(roadSignAPI.get());
+
+	if(!roadSignAPI->init())
+	{
+		std::cout << "Initializing the RoadSignAPI failed" << std::endl;
+		failed->store(true);
+		return;
+	}
+
+	std::vector<const RoadSignAPI::DetectedSignDescriptor*> approvedSigns;
+
+	for(size_t index = nextImage->fetch_add(1); index < images->size() &&
+			!failed->load(); index = nextImage->fetch_add(1))
+	{
+		EvaluationImage& image = (*images)[index];
+		const cv::Mat frame = cv::imread(imageFolder + "/" + image.filename);
+
+		if(frame.empty())
+		{
+			std::cerr << "Could not read " << image.filename << std::endl;
+		}
+		else if(roadSignAPI->feedImage(frame))
+		{
+			image.processed = true;
+
+			approvedSigns.clear();
+			if(classifierStage)
+				roadSignAPI->getClassifierApprovedDetectedSigns(&approvedSigns);
+			else
+			{
+				for(const RoadSignAPI::DetectedSignDescriptor& sign :
+						*roadSignAPI->getDetectedSigns())
+				{
+					approvedSigns.push_back(&sign);
+				}
+			}
+
+			for(const RoadSignAPI::DetectedSignDescriptor* sign :
+					approvedSigns)
+			{
+				Detection detection;
+				detection.box = cv::Rect(sign->upperLeft, sign->lowerRight);
+				detection.confidence = sign->detectorConfidence;
+				detection.classID = classifierStage ?
+						sign->classifierApprovedClassID :
+						sign->detectionPredictedClassID;
+
+				image.detections.push_back(detection);
+			}
+
+			std::sort(image.detections.begin(), image.detections.end(),
+					sortByConfidence);
+		}
+
+		const size_t done = doneImages->fetch_add(1) + 1;
+		if(done % 100 == 0)
+			std::cerr << done << " / " << images->size() << " images\r";
+	}
+}
+
+static bool writeDetections(const std::string& path,
+		const std::vector<EvaluationImage>& images)
+{
+	std::ofstream file(path);
+	if(!file)
+	{
+		std::cout << "Could not open " << path << std::endl;
+		return false;
+	}
+
+	file << "filename,class,confidence,xmin,ymin,xmax,ymax\n";
+
+	for(const EvaluationImage& image : images)
+	{
+		for(const Detection& detection : image.detections)
+		{
+			file << image.filename << ',' << detection.classID << ','
+				<< detection.confidence << ',' << detection.box.x << ','
+				<< detection.box.y << ','
+				<< detection.box.x + detection.box.width << ','
+				<< detection.box.y + detection.box.height << '\n';
+		}
+	}
+
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	std::string groundTruthFile;
+	std::string imageFolder;
+	std::string detectionsFile;
+	std::string classifierLabelsFile;
+	std::string recordingDirectory;
+	OutputRecordings outputRecordings;
+	int instanceCount = std::max(1u, std::thread::hardware_concurrency() / 2);
+	int numThreads = 1;
+	double minIoU = 0.5;
+	float minConfidence = 0.5f;
+	bool classifierStage = true;
+	size_t maxImages = 0;
+
+	for(int i = 1; i < argc; i++)
+	{
+		const bool hasValue = i + 1 < argc;
+
+		if(strcmp(argv[i], "--csv") == 0 && hasValue)
+			groundTruthFile = argv[++i];
+		else if((strcmp(argv[i], "--images") == 0 ||
+				strcmp(argv[i], "--folder") == 0) && hasValue)
+			imageFolder = argv[++i];
+		else if(strcmp(argv[i], "--detections") == 0 && hasValue)
+			detectionsFile = argv[++i];
+		else if(strcmp(argv[i], "--classifier-labels") == 0 && hasValue)
+			classifierLabelsFile = argv[++i];
+		else if(strcmp(argv[i], "--instances") == 0 && hasValue)
+			instanceCount = std::max(atoi(argv[++i]), 1);
+		else if(strcmp(argv[i], "--threads") == 0 && hasValue)
+			numThreads = std::max(atoi(argv[++i]), 1);
+		else if(strcmp(argv[i], "--iou") == 0 && hasValue)
+			minIoU = atof(argv[++i]);
+		else if(strcmp(argv[i], "--confidence") == 0 && hasValue)
+			minConfidence = atof(argv[++i]);
+		else if(strcmp(argv[i], "--stage") == 0 && hasValue)
+			classifierStage = strcmp(argv[++i], "detector") != 0;
+		else if(strcmp(argv[i], "--max-images") == 0 && hasValue)
+			maxImages = std::max(atoi(argv[++i]), 0);
+		else if(strcmp(argv[i], "--record") == 0 && hasValue)
+		{
+			recordingDirectory = argv[++i];
+			outputRecordings.record = true;
+		}
+		else if(strcmp(argv[i], "--replay") == 0 && hasValue)
+		{
+			recordingDirectory = argv[++i];
+			outputRecordings.replay = true;
+		}
+		else
+		{
+			std::cout << "Unknown argument " << argv[i] << std::endl;
+			return 1;
+		}
+	}
+
+	if(imageFolder.empty())
+	{
+		std::cout << "No image folder given (--images / --folder)"
+				<< std::endl;
+		return 1;
+	}
+
+	if(outputRecordings.record && outputRecordings.replay)
+	{
+		std::cout << "--record and --replay can not be combined" << std::endl;
+		return 1;
+	}
+
+	if(!outputRecordings.open(recordingDirectory))
+		return 1;
+
+	std::vector<EvaluationImage> images;
+	const bool hasGroundTruth = !groundTruthFile.empty();
+
+	if(hasGroundTruth ? !loadGroundTruth(groundTruthFile, &images) :
+			!loadFolder(imageFolder, &images))
+		return 1;
+
+	if(maxImages > 0 && images.size() > maxImages)
+		images.resize(maxImages);
+
+	// The class IDs of the detector do not refer to the classifier labels
+	std::vector<std::string> classifierLabels;
+	if(classifierStage && !classifierLabelsFile.empty() &&
+			!loadClassifierLabels(classifierLabelsFile, &classifierLabels))
+		return 1;
+
+	instanceCount = std::min<int>(instanceCount, images.size());
+
+	std::cout << "Evaluating " << images.size() << " images with "
+			<< instanceCount << " instances" << std::endl;
+
+	const FilterManagementLibrary::TFIntegration::TensorflowNNModelDescription
+		detectorModelDescription = RoadSignAPI::RoadSignAPI::
+				getDefaultDetectorModelDescription();
+	const FilterManagementLibrary::TFIntegration::TensorflowNNModelDescription
+		classifierModelDescription = RoadSignAPI::RoadSignAPI::
+				getDefaultClassifierModelDescription();
+
+	std::atomic<size_t> nextImage(0);
+	std::atomic<size_t> doneImages(0);
+	std::atomic<bool> failed(false);
+	std::vector<std::thread> workers;
+
+	const int64_t startTimeUs = FilterManagementLibrary::Utilities::getTimeUs();
+
+	for(int i = 0; i < instanceCount; i++)
+	{
+		workers.push_back(std::thread(evaluateImages, imageFolder,
+				std::cref(detectorModelDescription),
+				std::cref(classifierModelDescription), numThreads,
+				classifierStage, &outputRecordings, &images, &nextImage,
+				&doneImages, &failed));
+	}
+
+	for(std::thread& worker : workers)
+		worker.join();
+
+	if(!outputRecordings.close())
+		return 1;
+
+	const double seconds = (FilterManagementLibrary::Utilities::getTimeUs() -
+			startTimeUs) / 1000000.0;
+
+	if(failed.load())
+		return 1;
+
+	size_t processedImages = 0;
+	for(const EvaluationImage& image : images)
+	{
+		if(image.processed)
+			processedImages++;
+	}
+
+	std::cout << "Processed " << processedImages << " of " << images.size()
+			<< " images in " << seconds << " s ("
+			<< processedImages / seconds << " images/s)" << std::endl;
+
+	if(!detectionsFile.empty() && !writeDetections(detectionsFile, images))
+		return 1;
+
+	if(!hasGroundTruth)
+		return 0;
+
+	// Images which could not be read would count as misses otherwise
+	images.erase(std::remove_if(images.begin(), images.end(),
+			[](const EvaluationImage& image) { return !image.processed; }),
+			images.end());
+
+	std::cout << std::fixed << std::setprecision(4);
+	std::cout << "IoU >= " << minIoU << ", "
+			<< (classifierStage ? "classifier approved signs" :
+					"all detections") << std::endl;
+
+	// The instances run with the default parameters. Detections below the
+	// detector threshold never leave the pipeline, so all lower
+	// confidences would give the same row as the threshold itself.
+	const float detectorThreshold =
+			RoadSignAPI::RSAPIParameters().detectorThreshold;
+	std::vector<float> confidences(1, detectorThreshold);
+	for(int step = 0; step <= 20; step++)
+	{
+		if(step * 0.05f > detectorThreshold)
+			confidences.push_back(step * 0.05f);
+	}
+
+	std::cout << "Confidences below the detector threshold of "
+			<< detectorThreshold << " are not swept" << std::endl;
+	std::cout << "confidence  precision  recall  f1" << std::endl;
+
+	MatchCounts best;
+	float bestConfidence = detectorThreshold;
+
+	for(float confidence : confidences)
+	{
+		MatchCounts counts;
+
+		for(const EvaluationImage& image : images)
+		{
+			matchDetections(image, confidence, minIoU, classifierLabels,
+					&counts);
+		}
+
+		std::cout << confidence << "      " << counts.getPrecision() << "     "
+				<< counts.getRecall() << "  " << counts.getF1Score()
+				<< std::endl;
+
+		if(counts.getF1Score() > best.getF1Score())
+		{
+			best = counts;
+			bestConfidence = confidence;
+		}
+	}
+
+	MatchCounts counts;
+	for(const EvaluationImage& image : images)
+		matchDetections(image, minConfidence, minIoU, classifierLabels, &counts);
+
+	std::cout << "At confidence " << minConfidence << ": TP "
+			<< counts.truePositives << ", FP " << counts.falsePositives
+			<< ", FN " << counts.falseNegatives << std::endl;
+	std::cout << "Precision: " << counts.getPrecision() << std::endl;
+	std::cout << "Recall: " << counts.getRecall() << std::endl;
+	std::cout << "F1-Score: " << counts.getF1Score() << std::endl;
+
+	if(!classifierLabels.empty() && counts.truePositives > 0)
+	{
+		std::cout << "Correctly classified: "
+				<< (double) counts.correctlyClassified / counts.truePositives
+				<< std::endl;
+	}
+
+	std::cout << "Best F1-Score " << best.getF1Score() << " at confidence "
+			<< bestConfidence << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,164 @@
+/*
+ * rsapi_frame_queue_benchmark.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ *
+ * Feeds a FrameQueue from several synthetic cameras (one thread each) and
+ * drains it with a consumer which takes a fixed time per frame instead of
+ * running the RoadSignAPI. Shows how the queue behaves under overload:
+ * how many frames are delivered, coalesced, rejected or expired per stream
+ * and how long the delivered frames were queued.
+ * Stream 0 has a higher priority than the others.
+ *
+ * Usage: rsapi_frame_queue_benchmark [--streams 4] [--fps 30]
+ *        [--process-ms 20] [--seconds 5] [--max-age-ms 0] [--yuv]
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "RoadSignAPI/FrameQueue.h"
+
+int main(int argc, char** argv)
+{
+	int streamCount = 4;
+	int fps = 30;
+	int processMs = 20;
+	int seconds = 5;
+	int maxAgeMs = 0;
+	bool yuv = false;
+
+	for(int i = 1; i < argc; i++)
+	{
+		const bool hasValue = i + 1 < argc;
+
+		if(strcmp(argv[i], "--streams") == 0 && hasValue)
+			streamCount = atoi(argv[++i]);
+		else if(strcmp(argv[i], "--fps") == 0 && hasValue)
+			fps = atoi(argv[++i]);
+		else if(strcmp(argv[i], "--process-ms") == 0 && hasValue)
+			processMs = atoi(argv[++i]);
+		else if(strcmp(argv[i], "--seconds") == 0 && hasValue)
+			seconds = atoi(argv[++i]);
+		else if(strcmp(argv[i], "--max-age-ms") == 0 && hasValue)
+			maxAgeMs = atoi(argv[++i]);
+		else if(strcmp(argv[i], "--yuv") == 0)
+			yuv = true;
+		else
+		{
+			std::cout << "Unknown argument " << argv[i] << std::endl;
+			return 1;
+		}
+	}
+
+	if(streamCount <= 0 || fps <= 0)
+	{
+		std::cout << "Need at least one stream and fps > 0" << std::endl;
+		return 1;
+	}
+
+	RoadSignAPI::FrameQueue frameQueue;
+	frameQueue.setMaxFrameAge(maxAgeMs);
+
+	for(int i = 0; i < streamCount; i++)
+	{
+		frameQueue.addStream(i == 0 ? 1 : 0);
+	}
+
+	std::atomic<bool> stopRequested(false);
+	std::vector<std::thread> cameras;
+
+	const int width = 1280;
+	const int height = 720;
+
+	for(int streamID = 0; streamID < streamCount; streamID++)
+	{
+		cameras.push_back(std::thread([&, streamID]()
+		{
+			cv::Mat image(height, width, CV_8UC3,
+					cv::Scalar(streamID * 40, 128, 255 - streamID * 40));
+			std::vector<uint8_t> yuvFrame(width * height * 3 / 2,
+					streamID * 40);
+			const uint8_t* planes[3] = {yuvFrame.data(),
+					yuvFrame.data() + width * height, NULL};
+			const int strides[3] = {width, width, 0};
+
+			const std::chrono::microseconds frameInterval(1000000 / fps);
+			std::chrono::steady_clock::time_point nextFrame =
+					std::chrono::steady_clock::now();
+
+			for(uint64_t frameID = 0; !stopRequested.load(); frameID++)
+			{
+				if(yuv)
+				{
+					frameQueue.pushImageYUV(streamID, planes, strides,
+							FilterManagementLibrary::YUVFormat::NV21,
+							width, height, false, frameID);
+				}
+				else
+					frameQueue.pushImage(streamID, image, frameID);
+
+				nextFrame += frameInterval;
+				std::this_thread::sleep_until(nextFrame);
+			}
+		}));
+	}
+
+	std::vector<uint64_t> processed(streamCount, 0);
+
+	std::thread consumer([&]()
+	{
+		for(;;)
+		{
+			RoadSignAPI::QueuedFrame* frame = frameQueue.acquireFrame(-1);
+
+			if(frame == nullptr)
+				break;
+
+			// Stands in for RoadSignAPI::staticFeedQueuedFrame(frame)
+			std::this_thread::sleep_for(
+					std::chrono::milliseconds(processMs));
+
+			processed[frame->streamID]++;
+			frameQueue.releaseFrame(frame);
+		}
+	});
+
+	std::this_thread::sleep_for(std::chrono::seconds(seconds));
+
+	stopRequested.store(true);
+	for(std::thread& camera : cameras)
+	{
+		camera.join();
+	}
+
+	frameQueue.shutdown();
+	consumer.join();
+
+	std::cout << "stream\tpushed\tdelivered\tcoalesced\trejected\texpired\t"
+			"mean queued ms\tmax queued ms" << std::endl;
+
+	for(int streamID = 0; streamID < streamCount; streamID++)
+	{
+		const RoadSignAPI::FrameStreamStatistics statistics =
+				frameQueue.getStreamStatistics(streamID);
+
+		const double meanQueueingMs = statistics.delivered == 0 ? 0.0 :
+				statistics.totalQueueingTimeUs / 1000.0 / statistics.delivered;
+
+		std::cout << streamID << "\t" << statistics.pushed << "\t"
+				<< statistics.delivered << "\t" << statistics.coalesced
+				<< "\t" << statistics.rejected << "\t" << statistics.expired
+				<< "\t" << meanQueueingMs << "\t"
+				<< statistics.maxQueueingTimeUs / 1000.0 << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,323 @@
+/*
+ * rsapi_grouper_benchmark.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ *
+ * Compares ClassifiedSignsGrouper::groupSigns(...) against the previous
+ * sign by sign grouping (kept here as reference) on synthetic frames with
+ * increasing numbers of signs: checks that both produce the same
+ * combinations and measures the time per frame.
+ *
+ * Two layouts are generated: "separate" frames with at least two pole
+ * areas between neighbouring poles, and "chained" frames with poles only
+ * one to two pole ranges apart, so the pole areas overlap and the
+ * grouping depends on the order of the signs. Additionally, a fixed
+ * frame with chained pole areas is checked against the known result.
+ *
+ * Usage: rsapi_grouper_benchmark [--frames 200] [--seed 1]
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "RoadSignAPI/Filters/ClassifiedSignsGrouper.h"
+
+static const int kImageHeight = 1080;
+
+// Half the width of a pole area in pixels and the distance between
+// poles of the separate layout. The frames get as wide as needed to hold
+// all poles.
+static const int kPoleRange = 24;
+static const int kPoleDistance = 4 * kPoleRange + 1;
+
+static double getMicroseconds()
+{
+	struct timeval time;
+	gettimeofday(&time, NULL);
+	return time.tv_sec * 1000000.0 + time.tv_usec;
+}
+
+/**
+ * The grouping ClassifiedSignsGrouper used before the pole positions were
+ * kept sorted: every sign is checked against all combinations created so
+ * far.
+ */
+static void groupSignsReference(
+		const std::vector<RoadSignAPI::DetectedSignDescriptor>& detectedSigns,
+		const std::vector<int>& signIDs, int imageWidth,
+		float horizontalRangePercentage,
+		std::vector<RoadSignAPI::DetectedSignCombination>* combinations)
+{
+	combinations->clear();
+
+	const int range = imageWidth * horizontalRangePercentage;
+
+	for(int signID : signIDs)
+	{
+		const RoadSignAPI::DetectedSignDescriptor* sign =
+				&detectedSigns[signID];
+		const int middle = (sign->lowerRight.x + sign->upperLeft.x) / 2;
+
+		bool added = false;
+
+		for(RoadSignAPI::DetectedSignCombination& combination :
+				*combinations)
+		{
+			const int left = std::max(
+					combination.getGestimatedPolePositionX() - range, 0);
+			const int right = std::min(
+					combination.getGestimatedPolePositionX() + range,
+					imageWidth);
+
+			if(middle >= left && middle <= right)
+			{
+				combination.addDetectedSign(*sign);
+				added = true;
+				break;
+			}
+		}
+
+		if(!added)
+		{
+			combinations->push_back(RoadSignAPI::DetectedSignCombination());
+			combinations->back().addDetectedSign(*sign);
+		}
+	}
+}
+
+/**
+ * Creates a frame with signCount signs stacked on poles (up to 4 per
+ * pole). With chained set, neighbouring poles are one to two pole ranges
+ * apart, otherwise there are at least two pole areas between them. The
+ * sign order is shuffled.
+ *
+ * @return int width of the frame
+ */
+static int createFrame(int signCount, bool chained, std::mt19937* random,
+		std::vector<RoadSignAPI::DetectedSignDescriptor>* detectedSigns,
+		std::vector<int>* signIDs)
+{
+	const int poleCount = std::max(1, (signCount + 3) / 4);
+
+	std::uniform_int_distribution<int> jitter(-kPoleRange / 2 + 1,
+			kPoleRange / 2 - 1);
+	std::uniform_int_distribution<int> chainedDistance(kPoleRange,
+			2 * kPoleRange);
+	std::uniform_int_distribution<int> size(20, 80);
+	std::uniform_int_distribution<int> top(0, kImageHeight - 100);
+	std::uniform_int_distribution<int> classID(0, 40);
+
+	std::vector<int> polePositions(poleCount, 2 * kPoleRange);
+	for(int i = 1; i < poleCount; i++)
+	{
+		polePositions[i] = polePositions[i - 1] +
+				(chained ? chainedDistance(*random) : kPoleDistance);
+	}
+
+	detectedSigns->clear();
+	signIDs->clear();
+
+	for(int i = 0; i < signCount; i++)
+	{
+		const int poleX = polePositions[i % poleCount];
+		const int width = size(*random);
+		const int middle = poleX + jitter(*random);
+
+		RoadSignAPI::DetectedSignDescriptor sign;
+		sign.upperLeft = cv::Point(middle - width / 2, top(*random));
+		sign.lowerRight = cv::Point(middle - width / 2 + width,
+				sign.upperLeft.y + width);
+		sign.detectionPredictedClassID = 1;
+		sign.detectorConfidence = 0.9f;
+		sign.classifierApprovedClassID = classID(*random);
+		sign.classifierConfidence = 0.9f;
+
+		detectedSigns->push_back(sign);
+		signIDs->push_back(i);
+	}
+
+	std::shuffle(signIDs->begin(), signIDs->end(), *random);
+
+	return polePositions.back() + 2 * kPoleRange;
+}
+
+static RoadSignAPI::DetectedSignDescriptor createSign(int middle, int top,
+		int classID)
+{
+	RoadSignAPI::DetectedSignDescriptor sign;
+	sign.upperLeft = cv::Point(middle - 20, top);
+	sign.lowerRight = cv::Point(middle + 20, top + 40);
+	sign.detectionPredictedClassID = 1;
+	sign.detectorConfidence = 0.9f;
+	sign.classifierApprovedClassID = classID;
+	sign.classifierConfidence = 0.9f;
+	return sign;
+}
+
+static bool areCombinationsEqual(
+		const std::vector<RoadSignAPI::DetectedSignCombination>& first,
+		const std::vector<RoadSignAPI::DetectedSignCombination>& second)
+{
+	if(first.size() != second.size())
+		return false;
+
+	for(int i = 0; i < first.size(); i++)
+	{
+		const std::vector<RoadSignAPI::DetectedSignDescriptor>* firstSigns =
+				first[i].getSignsInCombination();
+		const std::vector<RoadSignAPI::DetectedSignDescriptor>* secondSigns =
+				second[i].getSignsInCombination();
+
+		if(first[i].getGestimatedPolePositionX() !=
+				second[i].getGestimatedPolePositionX() ||
+				firstSigns->size() != secondSigns->size())
+		{
+			return false;
+		}
+
+		for(int j = 0; j < firstSigns->size(); j++)
+		{
+			if((*firstSigns)[j].upperLeft != (*secondSigns)[j].upperLeft ||
+					(*firstSigns)[j].lowerRight !=
+					(*secondSigns)[j].lowerRight ||
+					(*firstSigns)[j].classifierApprovedClassID !=
+					(*secondSigns)[j].classifierApprovedClassID)
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Signs A, B and C at x = 100, 150 and 190 with a pole range of 60,
+ * approved in the order C, A, B: A is too far from C and starts its own
+ * combination, B lies within the pole area of C (but also within the
+ * one of A) and joins C, which was created first. So the combinations
+ * are {C, B} and {A}, although A and B are closer to each other.
+ */
+static bool checkChainedPoleAreas(RoadSignAPI::ClassifiedSignsGrouper* grouper)
+{
+	const int imageWidth = 1000;
+	const float horizontalRangePercentage = (60 + 0.5f) / imageWidth;
+
+	std::vector<RoadSignAPI::DetectedSignDescriptor> detectedSigns;
+	detectedSigns.push_back(createSign(100, 300, 1));
+	detectedSigns.push_back(createSign(150, 200, 2));
+	detectedSigns.push_back(createSign(190, 100, 3));
+
+	const std::vector<int> signIDs = {2, 0, 1};
+
+	std::vector<RoadSignAPI::DetectedSignCombination> combinations;
+	std::vector<RoadSignAPI::DetectedSignCombination> referenceCombinations;
+
+	grouper->setHorizontalRangePercentage(horizontalRangePercentage);
+	grouper->groupSigns(detectedSigns, signIDs, imageWidth, &combinations);
+	groupSignsReference(detectedSigns, signIDs, imageWidth,
+			horizontalRangePercentage, &referenceCombinations);
+
+	return areCombinationsEqual(combinations, referenceCombinations) &&
+			combinations.size() == 2 &&
+			combinations[0].getSignsInCombination()->size() == 2 &&
+			(*combinations[0].getSignsInCombination())[0].
+					classifierApprovedClassID == 3 &&
+			(*combinations[0].getSignsInCombination())[1].
+					classifierApprovedClassID == 2 &&
+			combinations[0].getGestimatedPolePositionX() == 170 &&
+			combinations[1].getSignsInCombination()->size() == 1 &&
+			combinations[1].getGestimatedPolePositionX() == 100;
+}
+
+int main(int argc, char** argv)
+{
+	int frameCount = 200;
+	unsigned int seed = 1;
+
+	for(int i = 1; i < argc; i++)
+	{
+		const bool hasValue = i + 1 < argc;
+
+		if(strcmp(argv[i], "--frames") == 0 && hasValue)
+			frameCount = atoi(argv[++i]);
+		else if(strcmp(argv[i], "--seed") == 0 && hasValue)
+			seed = atoi(argv[++i]);
+		else
+		{
+			std::cout << "Unknown argument " << argv[i] << std::endl;
+			return 1;
+		}
+	}
+
+	std::mt19937 random(seed);
+
+	RoadSignAPI::ClassifiedSignsGrouper grouper;
+
+	bool allEqual = checkChainedPoleAreas(&grouper);
+	std::cout << "Chained pole areas: " << (allEqual ? "ok" : "MISMATCH")
+			<< std::endl;
+
+	std::vector<RoadSignAPI::DetectedSignDescriptor> detectedSigns;
+	std::vector<int> signIDs;
+	std::vector<RoadSignAPI::DetectedSignCombination> combinations;
+	std::vector<RoadSignAPI::DetectedSignCombination> referenceCombinations;
+
+	const int signCounts[] = {4, 16, 64, 256, 1024, 4096};
+
+	std::cout << "layout\tsigns\treference us\tgrouper us\tmismatches"
+			<< std::endl;
+
+	for(int layout = 0; layout < 2; layout++)
+	{
+		const bool chained = layout == 1;
+
+		for(int signCount : signCounts)
+		{
+			double referenceTime = 0.0;
+			double grouperTime = 0.0;
+			int mismatches = 0;
+
+			for(int frame = 0; frame < frameCount; frame++)
+			{
+				const int imageWidth = createFrame(signCount, chained,
+						&random, &detectedSigns, &signIDs);
+
+				// Pole areas of kPoleRange pixels, whatever the frame width
+				const float horizontalRangePercentage =
+						(kPoleRange + 0.5f) / imageWidth;
+				grouper.setHorizontalRangePercentage(
+						horizontalRangePercentage);
+
+				double start = getMicroseconds();
+				groupSignsReference(detectedSigns, signIDs, imageWidth,
+						horizontalRangePercentage, &referenceCombinations);
+				referenceTime += getMicroseconds() - start;
+
+				start = getMicroseconds();
+				grouper.groupSigns(detectedSigns, signIDs, imageWidth,
+						&combinations);
+				grouperTime += getMicroseconds() - start;
+
+				if(!areCombinationsEqual(combinations, referenceCombinations))
+					mismatches++;
+			}
+
+			allEqual = allEqual && mismatches == 0;
+
+			std::cout << (chained ? "chained" : "separate") << "\t"
+					<< signCount << "\t" << referenceTime / frameCount
+					<< "\t" << grouperTime / frameCount << "\t"
+					<< mismatches << std::endl;
+		}
+	}
+
+	return allEqual ? 0 : 1;
+}
@@ -0,0 +1,490 @@
+/*
+ * rsapi_image_conversion_check.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ *
+ * Checks the image conversion of ImageConversion and YUVImageUtils
+ * byte for byte against the scalar port and against the original routines
+ * of the Tensorflow Android example (build_for_android/jni/yuv2rgb.cc and
+ * rgb2yuv.cc), which are compiled into this tool.
+ *
+ * For every row kernel ImageConversion::selectKernel(...) accepts on the
+ * executing CPU (scalar, SSE4.1, AVX2, NEON), random NV21, NV12 and I420
+ * frames with odd widths and heights and padded row strides are converted
+ * to all pixel formats. Additionally, the RGB to YUV port is compared with
+ * ConvertARGB8888ToYUV420SP(...) once per frame size.
+ *
+ * Returns non-zero if any output differs.
+ *
+ * Usage: rsapi_image_conversion_check [--max-width 69] [--max-height 17]
+ *                                     [--seed 1]
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "FilterManagementLibrary/ImageConversion.h"
+#include "FilterManagementLibrary/YUVImageUtils.h"
+
+#include "tensorflow/examples/android/jni/rgb2yuv.h"
+#include "tensorflow/examples/android/jni/yuv2rgb.h"
+
+typedef FilterManagementLibrary::ImageConversion ImageConversion;
+typedef FilterManagementLibrary::ImageConversion::Kernel Kernel;
+typedef FilterManagementLibrary::ImageConversion::PixelFormat PixelFormat;
+typedef FilterManagementLibrary::YUVFormat YUVFormat;
+
+// Extra bytes at the end of every plane row, so the strides differ from
+// the width
+static const int kRowPadding = 7;
+
+// Mismatches which are printed in detail, all others are only counted
+static const int kMaxReportedMismatches = 10;
+
+static const Kernel kKernels[] = {Kernel::SCALAR, Kernel::SSE41,
+		Kernel::AVX2, Kernel::NEON};
+
+static const YUVFormat kYUVFormats[] = {YUVFormat::NV21, YUVFormat::NV12,
+		YUVFormat::I420};
+
+static const PixelFormat kPixelFormats[] = {PixelFormat::BGR,
+		PixelFormat::BGRA, PixelFormat::RGBA};
+
+/**
+ * Random YUV frame and the plane layout needed to describe it.
+ */
+struct TestFrame
+{
+	std::vector<uint8_t> yPlane;
+	std::vector<uint8_t> uvPlane;
+	std::vector<uint8_t> vPlane;
+	int yRowStride;
+	int uvRowStride;
+	int width;
+	int height;
+};
+
+static int reportedMismatches = 0;
+
+static const char* getYUVFormatName(YUVFormat format)
+{
+	switch(format)
+	{
+		case YUVFormat::NV21: return "nv21";
+		case YUVFormat::NV12: return "nv12";
+		case YUVFormat::I420: return "i420";
+	}
+	return "unknown";
+}
+
+static const char* getPixelFormatName(PixelFormat format)
+{
+	switch(format)
+	{
+		case PixelFormat::BGR: return "bgr";
+		case PixelFormat::BGRA: return "bgra";
+		case PixelFormat::RGBA: return "rgba";
+	}
+	return "unknown";
+}
+
+static int getBytesPerPixel(PixelFormat format)
+{
+	return format == PixelFormat::BGR ? 3 : 4;
+}
+
+static void fillRandom(std::vector<uint8_t>* data, std::mt19937* random)
+{
+	std::uniform_int_distribution<int> distribution(0, 255);
+	for(uint8_t& value : *data)
+	{
+		value = distribution(*random);
+	}
+}
+
+/**
+ * Creates a frame with random samples. NV21 / NV12 frames get one
+ * interleaved chroma plane (uvPlane), I420 frames separate U (uvPlane)
+ * and V (vPlane) planes.
+ */
+static void createFrame(int width, int height, YUVFormat format,
+		std::mt19937* random, TestFrame* frame)
+{
+	const int chromaWidth = (width + 1) / 2;
+	const int chromaHeight = (height + 1) / 2;
+	const bool interleaved = format != YUVFormat::I420;
+
+	frame->width = width;
+	frame->height = height;
+	frame->yRowStride = width + kRowPadding;
+	frame->uvRowStride = (interleaved ? 2 * chromaWidth : chromaWidth) +
+			kRowPadding;
+
+	frame->yPlane.resize(frame->yRowStride * height);
+	frame->uvPlane.resize(frame->uvRowStride * chromaHeight);
+	frame->vPlane.resize(interleaved ? 0 : frame->uvPlane.size());
+
+	fillRandom(&frame->yPlane, random);
+	fillRandom(&frame->uvPlane, random);
+	fillRandom(&frame->vPlane, random);
+}
+
+static void describeFrame(const TestFrame& frame, YUVFormat format,
+		FilterManagementLibrary::YUVFrame* yuvFrame)
+{
+	const uint8_t* const planes[3] = {&frame.yPlane[0], &frame.uvPlane[0],
+			frame.vPlane.empty() ? NULL : &frame.vPlane[0]};
+	const int strides[3] = {frame.yRowStride, frame.uvRowStride,
+			frame.uvRowStride};
+
+	FilterManagementLibrary::YUVImageUtils::describeFrame(planes, strides,
+			format, frame.width, frame.height, false, yuvFrame);
+}
+
+/**
+ * Converts the frame with the original ConvertYUV420ToARGB8888(...),
+ * using the same plane pointers and strides as YUVImageUtils.
+ */
+static void convertOriginal(const TestFrame& frame, YUVFormat format,
+		std::vector<uint32_t>* argb)
+{
+	FilterManagementLibrary::YUVFrame yuvFrame;
+	describeFrame(frame, format, &yuvFrame);
+
+	argb->resize(frame.width * frame.height);
+	ConvertYUV420ToARGB8888(yuvFrame.yPlane, yuvFrame.uPlane,
+			yuvFrame.vPlane, &(*argb)[0], frame.width, frame.height,
+			yuvFrame.yRowStride, yuvFrame.uvRowStride,
+			yuvFrame.uvPixelStride);
+}
+
+/**
+ * Repacks 0xAARRGGBB pixels of the original routines into the given
+ * pixel format.
+ */
+static void packARGB(const std::vector<uint32_t>& argb, PixelFormat format,
+		std::vector<uint8_t>* packed)
+{
+	const int bytesPerPixel = getBytesPerPixel(format);
+	packed->resize(argb.size() * bytesPerPixel);
+
+	for(size_t i = 0; i < argb.size(); i++)
+	{
+		const uint8_t r = (argb[i] >> 16) & 0xFF;
+		const uint8_t g = (argb[i] >> 8) & 0xFF;
+		const uint8_t b = argb[i] & 0xFF;
+		const uint8_t a = argb[i] >> 24;
+
+		uint8_t* pixel = &(*packed)[i * bytesPerPixel];
+		switch(format)
+		{
+			case PixelFormat::BGR:
+			{
+				pixel[0] = b; pixel[1] = g; pixel[2] = r;
+			}
+			break;
+			case PixelFormat::BGRA:
+			{
+				pixel[0] = b; pixel[1] = g; pixel[2] = r; pixel[3] = a;
+			}
+			break;
+			case PixelFormat::RGBA:
+			{
+				pixel[0] = r; pixel[1] = g; pixel[2] = b; pixel[3] = a;
+			}
+			break;
+		}
+	}
+}
+
+/**
+ * Compares two outputs byte for byte and prints the first differing byte.
+ *
+ * @return bool true if both are equal
+ */
+static bool compareBytes(const uint8_t* actual, const uint8_t* expected,
+		size_t size, const char* kernelName, const char* what,
+		const char* reference, int width, int height)
+{
+	for(size_t i = 0; i < size; i++)
+	{
+		if(actual[i] == expected[i])
+			continue;
+
+		if(reportedMismatches++ < kMaxReportedMismatches)
+		{
+			std::cout << "MISMATCH " << kernelName << " " << what << " vs "
+					<< reference << " at " << width << "x" << height
+					<< ", byte " << i << ": " << int(actual[i]) << " != "
+					<< int(expected[i]) << std::endl;
+		}
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Checks all conversions of the active kernel for one frame.
+ *
+ * @return int number of differing outputs
+ */
+static int checkYUVFrame(const TestFrame& frame, YUVFormat format,
+		const char* kernelName)
+{
+	const int width = frame.width;
+	const int height = frame.height;
+	int mismatches = 0;
+
+	FilterManagementLibrary::YUVFrame yuvFrame;
+	describeFrame(frame, format, &yuvFrame);
+
+	std::vector<uint32_t> originalARGB;
+	convertOriginal(frame, format, &originalARGB);
+
+	// ImageConversion::convertYUV420ToARGB8888(...)
+	std::vector<uint32_t> portARGB(width * height);
+	ImageConversion::convertYUV420ToARGB8888(yuvFrame.yPlane,
+			yuvFrame.uPlane, yuvFrame.vPlane, &portARGB[0], width, height,
+			yuvFrame.yRowStride, yuvFrame.uvRowStride, yuvFrame.uvPixelStride);
+	if(!compareBytes(reinterpret_cast<const uint8_t*>(&portARGB[0]),
+			reinterpret_cast<const uint8_t*>(&originalARGB[0]),
+			portARGB.size() * sizeof(uint32_t), kernelName,
+			getYUVFormatName(format), "ConvertYUV420ToARGB8888", width,
+			height))
+		mismatches++;
+
+	// YUVImageUtils::convertFrame(...) into every pixel format, against
+	// the original and against the scalar row kernel
+	for(PixelFormat pixelFormat : kPixelFormats)
+	{
+		const int rowBytes = width * getBytesPerPixel(pixelFormat);
+
+		std::vector<uint8_t> original;
+		packARGB(originalARGB, pixelFormat, &original);
+
+		std::vector<uint8_t> converted(rowBytes * height);
+		FilterManagementLibrary::YUVImageUtils::convertFrame(yuvFrame,
+				&converted[0], rowBytes, pixelFormat);
+
+		std::vector<uint8_t> scalar(rowBytes * height);
+		std::vector<uint8_t> uSamples(width);
+		std::vector<uint8_t> vSamples(width);
+		for(int y = 0; y < height; y++)
+		{
+			const uint8_t* uRow = yuvFrame.uPlane +
+					(y >> 1) * yuvFrame.uvRowStride;
+			const uint8_t* vRow = yuvFrame.vPlane +
+					(y >> 1) * yuvFrame.uvRowStride;
+			for(int x = 0; x < width; x++)
+			{
+				uSamples[x] = uRow[(x >> 1) * yuvFrame.uvPixelStride];
+				vSamples[x] = vRow[(x >> 1) * yuvFrame.uvPixelStride];
+			}
+			ImageConversion::convertYUVRowScalar(
+					yuvFrame.yPlane + y * yuvFrame.yRowStride,
+					&uSamples[0], &vSamples[0], &scalar[y * rowBytes],
+					width, pixelFormat);
+		}
+
+		std::string what = std::string(getYUVFormatName(format)) + " to " +
+				getPixelFormatName(pixelFormat);
+
+		if(!compareBytes(&converted[0], &original[0], converted.size(),
+				kernelName, what.c_str(), "ConvertYUV420ToARGB8888",
+				width, height))
+			mismatches++;
+		if(!compareBytes(&converted[0], &scalar[0], converted.size(),
+				kernelName, what.c_str(), "scalar port", width, height))
+			mismatches++;
+	}
+
+	// ImageConversion::convertYUV420SPToARGB8888(...) only knows
+	// contiguous NV21 frames (NV12 on Apple platforms), like the original
+	if(format == YUVFormat::NV21)
+	{
+		const int chromaHeight = (height + 1) / 2;
+		std::vector<uint8_t> contiguous(width * height +
+				width * chromaHeight + 1);
+		for(int y = 0; y < height; y++)
+		{
+			memcpy(&contiguous[y * width],
+					&frame.yPlane[y * frame.yRowStride], width);
+		}
+		// The original reads width + 1 bytes of every chroma row at odd
+		// widths, overlapping the next row
+		for(int y = 0; y < chromaHeight; y++)
+		{
+			memcpy(&contiguous[width * height + y * width],
+					&frame.uvPlane[y * frame.uvRowStride], width + 1);
+		}
+
+		const uint8_t* yData = &contiguous[0];
+		const uint8_t* uvData = yData + width * height;
+
+		std::vector<uint32_t> originalSP(width * height);
+		ConvertYUV420SPToARGB8888(yData, uvData, &originalSP[0], width,
+				height);
+
+		std::vector<uint32_t> portSP(width * height);
+		ImageConversion::convertYUV420SPToARGB8888(yData, uvData,
+				&portSP[0], width, height);
+
+		if(!compareBytes(reinterpret_cast<const uint8_t*>(&portSP[0]),
+				reinterpret_cast<const uint8_t*>(&originalSP[0]),
+				portSP.size() * sizeof(uint32_t), kernelName, "nv21",
+				"ConvertYUV420SPToARGB8888", width, height))
+			mismatches++;
+	}
+
+	return mismatches;
+}
+
+/**
+ * Checks the BGR row kernel of the active kernel against the scalar one.
+ *
+ * @return int number of differing outputs
+ */
+static int checkBGRRows(int width, std::mt19937* random,
+		const char* kernelName)
+{
+	int mismatches = 0;
+
+	std::vector<uint8_t> bgr(width * 3);
+	fillRandom(&bgr, random);
+
+	for(PixelFormat pixelFormat : kPixelFormats)
+	{
+		const int rowBytes = width * getBytesPerPixel(pixelFormat);
+		std::vector<uint8_t> converted(rowBytes);
+		std::vector<uint8_t> scalar(rowBytes);
+
+		ImageConversion::convertBGRRow(&bgr[0], &converted[0], width,
+				pixelFormat);
+		ImageConversion::convertBGRRowScalar(&bgr[0], &scalar[0], width,
+				pixelFormat);
+
+		std::string what = std::string("bgr row to ") +
+				getPixelFormatName(pixelFormat);
+		if(!compareBytes(&converted[0], &scalar[0], rowBytes, kernelName,
+				what.c_str(), "scalar port", width, 1))
+			mismatches++;
+	}
+
+	return mismatches;
+}
+
+/**
+ * Checks ImageConversion::convertARGB8888ToYUV420SP(...) against the
+ * original ConvertARGB8888ToYUV420SP(...).
+ *
+ * @return int number of differing outputs
+ */
+static int checkRGBToYUV(int width, int height, std::mt19937* random)
+{
+	std::vector<uint8_t> pixels(width * height * sizeof(uint32_t));
+	fillRandom(&pixels, random);
+	const uint32_t* argb = reinterpret_cast<const uint32_t*>(&pixels[0]);
+
+	const size_t size = width * height +
+			2 * ((width + 1) / 2) * ((height + 1) / 2);
+	std::vector<uint8_t> original(size);
+	std::vector<uint8_t> port(size);
+
+	ConvertARGB8888ToYUV420SP(argb, &original[0], width, height);
+	ImageConversion::convertARGB8888ToYUV420SP(argb, &port[0], width, height);
+
+	return compareBytes(&port[0], &original[0], size, "scalar", "argb to nv21",
+			"ConvertARGB8888ToYUV420SP", width, height) ? 0 : 1;
+}
+
+int main(int argc, char** argv)
+{
+	int maxWidth = 69;
+	int maxHeight = 17;
+	unsigned int seed = 1;
+
+	for(int i = 1; i < argc; i++)
+	{
+		if(strcmp(argv[i], "--max-width") == 0 && i + 1 < argc)
+			maxWidth = atoi(argv[++i]);
+		else if(strcmp(argv[i], "--max-height") == 0 && i + 1 < argc)
+			maxHeight = atoi(argv[++i]);
+		else if(strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+			seed = strtoul(argv[++i], NULL, 10);
+		else
+		{
+			std::cout << "Usage: " << argv[0] << " [--max-width 69]"
+					" [--max-height 17] [--seed 1]" << std::endl;
+			return 1;
+		}
+	}
+
+	int totalMismatches = 0;
+
+	// The RGB to YUV port has no kernels, check it once
+	std::mt19937 rgbRandom(seed);
+	for(int width = 1; width <= maxWidth; width += 2)
+	{
+		for(int height = 1; height <= maxHeight; height += 2)
+		{
+			totalMismatches += checkRGBToYUV(width, height, &rgbRandom);
+		}
+	}
+	std::cout << "argb to nv21 mismatches: " << totalMismatches << std::endl;
+
+	std::cout << "kernel\tchecks\tmismatches" << std::endl;
+
+	for(Kernel kernel : kKernels)
+	{
+		const char* kernelName = ImageConversion::getKernelName(kernel);
+
+		if(!ImageConversion::selectKernel(kernel))
+		{
+			std::cout << kernelName << "\tnot supported" << std::endl;
+			continue;
+		}
+
+		// Same frames for every kernel
+		std::mt19937 random(seed);
+		int checks = 0;
+		int mismatches = 0;
+
+		for(int width = 1; width <= maxWidth; width += 2)
+		{
+			mismatches += checkBGRRows(width, &random, kernelName);
+			checks++;
+
+			for(int height = 1; height <= maxHeight; height += 2)
+			{
+				for(YUVFormat format : kYUVFormats)
+				{
+					TestFrame frame;
+					createFrame(width, height, format, &random, &frame);
+					mismatches += checkYUVFrame(frame, format, kernelName);
+					checks++;
+				}
+			}
+		}
+
+		std::cout << kernelName << "\t" << checks << "\t" << mismatches
+				<< std::endl;
+		totalMismatches += mismatches;
+	}
+
+	ImageConversion::selectKernel(Kernel::AUTO);
+
+	if(totalMismatches > 0)
+	{
+		std::cout << totalMismatches << " outputs differ" << std::endl;
+		return 1;
+	}
+
+	std::cout << "All outputs match" << std::endl;
+	return 0;
+}
@@ -0,0 +1,93 @@
+/*
+ * rsapi_shm_server.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ *
+ * Serves the RoadSignAPI to other processes via shared memory, see
+ * SharedMemoryFrameServer.
+ *
+ * Usage: rsapi_shm_server [--name /rsapi] [--threads 4] [--slots 4]
+ *                         [--max-width 1920] [--max-height 1080]
+ *                         [--max-signs 64] [--transport-only]
+ */
+
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+#include <iostream>
+#include <string>
+
+#include "RoadSignAPI/RoadSignAPI.h"
+#include "RoadSignAPI/SharedMemoryTransport/SharedMemoryFrameServer.h"
+
+static std::atomic<bool> stopRequested(false);
+
+static void handleSignal(int)
+{
+	stopRequested.store(true);
+}
+
+int main(int argc, char** argv)
+{
+	std::string name = "/rsapi";
+	int numThreads = 4;
+	int slotCount = 4;
+	int maxWidth = 1920;
+	int maxHeight = 1080;
+	int maxSigns = 64;
+	bool transportOnly = false;
+
+	for(int i = 1; i < argc; i++)
+	{
+		const bool hasValue = i + 1 < argc;
+
+		if(strcmp(argv[i], "--name") == 0 && hasValue)
+			name = argv[++i];
+		else if(strcmp(argv[i], "--threads") == 0 && hasValue)
+			numThreads = atoi(argv[++i]);
+		else if(strcmp(argv[i], "--slots") == 0 && hasValue)
+			slotCount = atoi(argv[++i]);
+		else if(strcmp(argv[i], "--max-width") == 0 && hasValue)
+			maxWidth = atoi(argv[++i]);
+		else if(strcmp(argv[i], "--max-height") == 0 && hasValue)
+			maxHeight = atoi(argv[++i]);
+		else if(strcmp(argv[i], "--max-signs") == 0 && hasValue)
+			maxSigns = atoi(argv[++i]);
+		else if(strcmp(argv[i], "--transport-only") == 0)
+			transportOnly = true;
+		else
+		{
+			std::cout << "Unknown argument " << argv[i] << std::endl;
+			return 1;
+		}
+	}
+
+	if(slotCount <= 0 || maxWidth <= 0 || maxHeight <= 0 || maxSigns <= 0)
+	{
+		std::cout << "Invalid ring size" << std::endl;
+		return 1;
+	}
+
+	if(!transportOnly && !RoadSignAPI::RoadSignAPI::staticInit(numThreads))
+	{
+		std::cout << "Initializing the RoadSignAPI failed" << std::endl;
+		return 1;
+	}
+
+	RoadSignAPI::SharedMemoryFrameServer server;
+	server.setTransportOnly(transportOnly);
+
+	if(!server.start(name, slotCount, maxWidth, maxHeight, maxSigns))
+		return 1;
+
+	signal(SIGINT, handleSignal);
+	signal(SIGTERM, handleSignal);
+
+	server.run(&stopRequested);
+	server.stop();
+
+	return 0;
+}
@@ -0,0 +1,143 @@
+/*
+ * rsapi_shm_stub_producer.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ *
+ * Feeds synthetic NV21 frames into a running rsapi_shm_server and reads
+ * back the results. Meant to test the transport locally, i.e. together
+ * with rsapi_shm_server --transport-only.
+ *
+ * Usage: rsapi_shm_stub_producer [--name /rsapi] [--frames 1000]
+ *                                [--width 1280] [--height 720]
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "RoadSignAPI/SharedMemoryTransport/SharedMemoryFrameProducer.h"
+
+static double getMicroseconds()
+{
+	struct timeval time;
+	gettimeofday(&time, NULL);
+	return time.tv_sec * 1000000.0 + time.tv_usec;
+}
+
+int main(int argc, char** argv)
+{
+	std::string name = "/rsapi";
+	int frameCount = 1000;
+	int width = 1280;
+	int height = 720;
+
+	for(int i = 1; i < argc; i++)
+	{
+		const bool hasValue = i + 1 < argc;
+
+		if(strcmp(argv[i], "--name") == 0 && hasValue)
+			name = argv[++i];
+		else if(strcmp(argv[i], "--frames") == 0 && hasValue)
+			frameCount = atoi(argv[++i]);
+		else if(strcmp(argv[i], "--width") == 0 && hasValue)
+			width = atoi(argv[++i]);
+		else if(strcmp(argv[i], "--height") == 0 && hasValue)
+			height = atoi(argv[++i]);
+		else
+		{
+			std::cout << "Unknown argument " << argv[i] << std::endl;
+			return 1;
+		}
+	}
+
+	RoadSignAPI::SharedMemoryFrameProducer producer;
+
+	if(!producer.connect(name))
+	{
+		std::cout << "No server running on " << name << std::endl;
+		return 1;
+	}
+
+	// Send timestamps, indexed by frame id, read by the result thread
+	std::vector<double> sendTimes(frameCount, 0.0);
+	std::vector<double> latencies;
+	latencies.reserve(frameCount);
+
+	int statusErrors = 0;
+	int signCount = 0;
+
+	std::thread resultThread([&]()
+	{
+		RoadSignAPI::ResultBufferReader reader;
+		uint64_t frameID;
+		RoadSignAPI::SharedMemoryResultStatus status;
+
+		while(static_cast<int>(latencies.size()) + statusErrors < frameCount &&
+				producer.acquireResult(&reader, &frameID, &status, 5000))
+		{
+			if(status != RoadSignAPI::SharedMemoryResultStatus::OK)
+				statusErrors++;
+			else if(frameID < sendTimes.size())
+			{
+				latencies.push_back(getMicroseconds() - sendTimes[frameID]);
+				signCount += reader.getSignCount();
+			}
+
+			producer.releaseResult();
+		}
+	});
+
+	const double start = getMicroseconds();
+
+	for(int frame = 0; frame < frameCount; frame++)
+	{
+		uint8_t* planes[3];
+
+		if(producer.acquireFrame(
+				RoadSignAPI::SharedMemoryFrameFormat::NV21, width, height,
+				false, frame, planes, 5000) == NULL)
+		{
+			std::cout << "Acquiring frame slot failed" << std::endl;
+			break;
+		}
+
+		// Moving gradient, written straight into the slot
+		for(int y = 0; y < height; y++)
+		{
+			memset(planes[0] + y * width, (y + frame) & 0xff, width);
+		}
+		memset(planes[1], 128, ((width + 1) / 2) * 2 * ((height + 1) / 2));
+
+		sendTimes[frame] = getMicroseconds();
+		producer.commitFrame();
+	}
+
+	resultThread.join();
+
+	const double elapsed = getMicroseconds() - start;
+
+	std::sort(latencies.begin(), latencies.end());
+
+	std::cout << "Results: " << latencies.size() << " / " << frameCount
+			<< " frames, " << statusErrors << " errors, " << signCount
+			<< " signs" << std::endl;
+
+	if(!latencies.empty())
+	{
+		std::cout << "Throughput: " << latencies.size() * 1000000.0 / elapsed
+				<< " fps" << std::endl;
+		std::cout << "Round trip latency: median "
+				<< latencies[latencies.size() / 2] << " us, p99 "
+				<< latencies[latencies.size() * 99 / 100] << " us" << std::endl;
+	}
+
+	producer.disconnect();
+	return 0;
+}
@@ -0,0 +1,370 @@
+/*
+ * rsapi_ssd_validate.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ *
+ * Validates the native postprocessing of the SSDLite detector (see
+ * SSDPostProcessor) against the postprocessing operations of the graph.
+ *
+ * Every image is run through the detector model twice: once with the
+ * detections of the graph as outputs (detection_boxes, ...,
+ * RoadSignAPI::getDefaultDetectorModelDescription()) and once with the
+ * raw box encodings and class predictions as outputs
+ * (RoadSignAPI::getRawOutputDetectorModelDescription()), which are then
+ * decoded by SSDPostProcessor with generated anchors. The detections of
+ * both are matched by class, score and box; every detection without
+ * counterpart is printed. The time of the inference of the full graph is
+ * compared to the time of the inference of the raw outputs plus the
+ * native postprocessing.
+ *
+ * The defaults of the postprocessing parameters are the ones of the
+ * pipeline.config of our model (MLModels/Detection/object_detection/
+ * SSDLite), they need to match the graph for the detections to match.
+ *
+ * Usage: rsapi_ssd_validate --images <image folder> [--model ssdlite.pb]
+ *                           [--threads 1] [--max-images 0]
+ *                           [--score-threshold 0.3] [--iou 0.6]
+ *                           [--max-per-class 10] [--max-detections 10]
+ *                           [--box-tolerance 0.001]
+ *                           [--score-tolerance 0.001]
+ *
+ * Returns 0 if all detections matched, 1 otherwise.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+#include "RoadSignAPI/RoadSignAPI.h"
+#include "FilterManagementLibrary/SSDPostProcessing.h"
+#include "FilterManagementLibrary/TensorflowOpenCVUtils.h"
+#include "FilterManagementLibrary/TensorflowIntegration/TensorflowNNInstance.h"
+#include "FilterManagementLibrary/Utilities.h"
+
+static bool listImages(const std::string& folder,
+		std::vector<std::string>* files)
+{
+	const char* const patterns[] = {"*.png", "*.jpg", "*.jpeg", "*.ppm"};
+
+	for(const char* pattern : patterns)
+	{
+		std::vector<std::string> matches;
+		cv::glob(folder + "/" + pattern, matches, false);
+		files->insert(files->end(), matches.begin(), matches.end());
+	}
+
+	std::sort(files->begin(), files->end());
+
+	if(files->empty())
+	{
+		std::cout << "No images found in " << folder << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+static bool runModel(FilterManagementLibrary::TFIntegration::
+		TensorflowNNInstance* model, cv::Mat* image)
+{
+	FilterManagementLibrary::TensorflowOpenCVUtils::
+		fastApplyCVMatOnInputTensorUInt8(image, model->getInputTensor());
+
+	if(!model->runInference())
+	{
+		std::cout << "Inference failed (error "
+				<< (int) model->getLastError() << ")" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+static float getBoxDifference(const FilterManagementLibrary::SSDDetections& a,
+		int indexA, const FilterManagementLibrary::SSDDetections& b,
+		int indexB)
+{
+	return std::max(
+			std::max(fabsf(a.yMin[indexA] - b.yMin[indexB]),
+					fabsf(a.xMin[indexA] - b.xMin[indexB])),
+			std::max(fabsf(a.yMax[indexA] - b.yMax[indexB]),
+					fabsf(a.xMax[indexA] - b.xMax[indexB])));
+}
+
+static void printDetection(const std::string& label,
+		const FilterManagementLibrary::SSDDetections& detections, int index)
+{
+	std::cout << "  " << label << " class " << detections.classIDs[index]
+			<< " score " << detections.scores[index] << " box ("
+			<< detections.yMin[index] << ", " << detections.xMin[index]
+			<< ", " << detections.yMax[index] << ", "
+			<< detections.xMax[index] << ")" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+	std::string imageFolder;
+	std::string modelFile;
+	int threads = 1;
+	size_t maxImages = 0;
+	float boxTolerance = 0.001f;
+	float scoreTolerance = 0.001f;
+
+	FilterManagementLibrary::SSDPostProcessingParameters parameters;
+	parameters.scoreThreshold = 0.3f;
+	parameters.iouThreshold = 0.6f;
+	parameters.maxDetectionsPerClass = 10;
+	parameters.maxDetections = 10;
+
+	for(int i = 1; i < argc; i++)
+	{
+		const bool hasValue = i + 1 < argc;
+
+		if(strcmp(argv[i], "--images") == 0 && hasValue)
+			imageFolder = argv[++i];
+		else if(strcmp(argv[i], "--model") == 0 && hasValue)
+			modelFile = argv[++i];
+		else if(strcmp(argv[i], "--threads") == 0 && hasValue)
+			threads = std::max(atoi(argv[++i]), 1);
+		else if(strcmp(argv[i], "--max-images") == 0 && hasValue)
+			maxImages = std::max(atoi(argv[++i]), 0);
+		else if(strcmp(argv[i], "--score-threshold") == 0 && hasValue)
+			parameters.scoreThreshold = atof(argv[++i]);
+		else if(strcmp(argv[i], "--iou") == 0 && hasValue)
+			parameters.iouThreshold = atof(argv[++i]);
+		else if(strcmp(argv[i], "--max-per-class") == 0 && hasValue)
+			parameters.maxDetectionsPerClass = atoi(argv[++i]);
+		else if(strcmp(argv[i], "--max-detections") == 0 && hasValue)
+			parameters.maxDetections = atoi(argv[++i]);
+		else if(strcmp(argv[i], "--box-tolerance") == 0 && hasValue)
+			boxTolerance = atof(argv[++i]);
+		else if(strcmp(argv[i], "--score-tolerance") == 0 && hasValue)
+			scoreTolerance = atof(argv[++i]);
+		else
+		{
+			std::cout << "Unknown argument " << argv[i] << std::endl;
+			return 1;
+		}
+	}
+
+	if(imageFolder.empty())
+	{
+		std::cout << "No image folder given (--images)" << std::endl;
+		return 1;
+	}
+
+	std::vector<std::string> files;
+	if(!listImages(imageFolder, &files))
+		return 1;
+
+	if(maxImages > 0 && files.size() > maxImages)
+		files.resize(maxImages);
+
+	FilterManagementLibrary::TFIntegration::TensorflowNNModelDescription
+		fullModelDescription =
+				RoadSignAPI::RoadSignAPI::getDefaultDetectorModelDescription();
+	FilterManagementLibrary::TFIntegration::TensorflowNNModelDescription
+		rawModelDescription = RoadSignAPI::RoadSignAPI::
+				getRawOutputDetectorModelDescription();
+
+	if(!modelFile.empty())
+	{
+		fullModelDescription.modelFile = modelFile;
+		rawModelDescription.modelFile = modelFile;
+	}
+
+	FilterManagementLibrary::TFIntegration::TensorflowNNInstance fullModel(
+			fullModelDescription, threads);
+	FilterManagementLibrary::TFIntegration::TensorflowNNInstance rawModel(
+			rawModelDescription, threads);
+
+	if(!fullModel.setupModelFromFile() || !rawModel.setupModelFromFile())
+	{
+		std::cout << "Could not load " << fullModelDescription.modelFile
+				<< std::endl;
+		return 1;
+	}
+
+	fullModel.warmUp();
+	rawModel.warmUp();
+
+	std::vector<float> anchors;
+	FilterManagementLibrary::SSDPostProcessor::generateAnchors(
+			FilterManagementLibrary::SSDAnchorParameters(),
+			rawModelDescription.inputWidth, rawModelDescription.inputHeight,
+			&anchors);
+	const int anchorCount = anchors.size() / 4;
+
+	// The detections of the graph are only selected, not filtered
+	FilterManagementLibrary::SSDPostProcessingParameters fullParameters;
+	fullParameters.scoreThreshold = -1.0f;
+
+	FilterManagementLibrary::SSDPostProcessor postProcessor;
+	FilterManagementLibrary::SSDDetections fullDetections;
+	FilterManagementLibrary::SSDDetections rawDetections;
+
+	cv::Mat input(fullModelDescription.inputHeight,
+			fullModelDescription.inputWidth, CV_8UC3);
+
+	int fullDetectionCount = 0;
+	int rawDetectionCount = 0;
+	int matchedCount = 0;
+	float maxScoreDifference = 0.0f;
+	float maxBoxDifference = 0.0f;
+	int64_t fullTimeUs = 0;
+	int64_t rawTimeUs = 0;
+	int64_t postProcessingTimeUs = 0;
+	size_t processedImages = 0;
+
+	for(const std::string& file : files)
+	{
+		const cv::Mat image = cv::imread(file);
+		if(image.empty())
+		{
+			std::cout << "Could not read " << file << std::endl;
+			continue;
+		}
+
+		// Like the SSDLiteRoadSignDetector scales its input
+		cv::resize(image, input, input.size(), 0.0, 0.0, cv::INTER_CUBIC);
+
+		int64_t startTimeUs = FilterManagementLibrary::Utilities::getTimeUs();
+		if(!runModel(&fullModel, &input))
+			return 1;
+		fullTimeUs += FilterManagementLibrary::Utilities::getTimeUs() -
+				startTimeUs;
+
+		startTimeUs = FilterManagementLibrary::Utilities::getTimeUs();
+		if(!runModel(&rawModel, &input))
+			return 1;
+		const int64_t inferenceEndTimeUs =
+				FilterManagementLibrary::Utilities::getTimeUs();
+
+		FilterManagementLibrary::TFIntegration::TensorflowResultContainer
+			rawResult = rawModel.getResultContainer();
+		tensorflow::Tensor* boxEncodings = rawResult.getFloatOutputTensorByID(0);
+		tensorflow::Tensor* classPredictions =
+				rawResult.getFloatOutputTensorByID(1);
+
+		if(boxEncodings->NumElements() != 4 * anchorCount ||
+				classPredictions->NumElements() % anchorCount != 0)
+		{
+			std::cout << "The raw outputs do not match the " << anchorCount
+					<< " anchors" << std::endl;
+			return 1;
+		}
+
+		postProcessor.decodeRawOutputs(boxEncodings->flat<float>().data(),
+				classPredictions->flat<float>().data(), anchors.data(),
+				anchorCount, classPredictions->NumElements() / anchorCount,
+				parameters, &rawDetections);
+
+		const int64_t endTimeUs = FilterManagementLibrary::Utilities::getTimeUs();
+		rawTimeUs += endTimeUs - startTimeUs;
+		postProcessingTimeUs += endTimeUs - inferenceEndTimeUs;
+
+		FilterManagementLibrary::TFIntegration::TensorflowResultContainer
+			fullResult = fullModel.getResultContainer();
+		tensorflow::TTypes<float>::Flat boxes = fullResult.
+				getFloatOutputTensorByLayerName("detection_boxes")->flat<float>();
+		tensorflow::TTypes<float>::Flat scores = fullResult.
+				getFloatOutputTensorByLayerName("detection_scores")->flat<float>();
+		tensorflow::TTypes<float>::Flat classes = fullResult.
+				getFloatOutputTensorByLayerName("detection_classes")->flat<float>();
+		tensorflow::TTypes<float>::Flat numDetections = fullResult.
+				getFloatOutputTensorByLayerName("num_detections")->flat<float>();
+
+		const int count = std::min<int>(std::max(numDetections(0), 0.0f),
+				std::min<int>(std::min<int>(scores.size(), classes.size()),
+						boxes.size() / 4));
+
+		postProcessor.decodeDetections(boxes.data(), scores.data(),
+				classes.data(), count, fullParameters, &fullDetections);
+
+		processedImages++;
+		fullDetectionCount += fullDetections.size();
+		rawDetectionCount += rawDetections.size();
+
+		std::vector<char> rawMatched(rawDetections.size(), 0);
+		std::vector<int> unmatchedFull;
+
+		for(int i = 0; i < fullDetections.size(); i++)
+		{
+			int match = -1;
+
+			for(int j = 0; j < rawDetections.size() && match < 0; j++)
+			{
+				if(!rawMatched[j] &&
+						rawDetections.classIDs[j] == fullDetections.classIDs[i] &&
+						fabsf(rawDetections.scores[j] - fullDetections.scores[i])
+								<= scoreTolerance &&
+						getBoxDifference(fullDetections, i, rawDetections, j)
+								<= boxTolerance)
+				{
+					match = j;
+				}
+			}
+
+			if(match < 0)
+			{
+				unmatchedFull.push_back(i);
+				continue;
+			}
+
+			rawMatched[match] = 1;
+			matchedCount++;
+			maxScoreDifference = std::max(maxScoreDifference,
+					fabsf(rawDetections.scores[match] -
+							fullDetections.scores[i]));
+			maxBoxDifference = std::max(maxBoxDifference,
+					getBoxDifference(fullDetections, i, rawDetections, match));
+		}
+
+		const bool mismatch = !unmatchedFull.empty() ||
+				std::find(rawMatched.begin(), rawMatched.end(), 0) !=
+						rawMatched.end();
+
+		if(mismatch)
+		{
+			std::cout << file << ":" << std::endl;
+
+			for(int i : unmatchedFull)
+				printDetection("graph only", fullDetections, i);
+
+			for(int j = 0; j < rawDetections.size(); j++)
+			{
+				if(!rawMatched[j])
+					printDetection("native only", rawDetections, j);
+			}
+		}
+	}
+
+	if(processedImages == 0)
+		return 1;
+
+	std::cout << std::fixed << std::setprecision(3);
+	std::cout << "Images: " << processedImages << std::endl;
+	std::cout << "Detections: " << fullDetectionCount << " graph, "
+			<< rawDetectionCount << " native, " << matchedCount
+			<< " matched" << std::endl;
+	std::cout << "Max difference of matched detections: score "
+			<< maxScoreDifference << ", box " << maxBoxDifference
+			<< std::endl;
+	std::cout << "Time per image: graph " << fullTimeUs / 1000.0 /
+			processedImages << " ms, raw outputs + native postprocessing "
+			<< rawTimeUs / 1000.0 / processedImages << " ms (postprocessing "
+			<< postProcessingTimeUs / 1000.0 / processedImages << " ms)"
+			<< std::endl;
+
+	return matchedCount == fullDetectionCount &&
+			matchedCount == rawDetectionCount ? 0 : 1;
+}
@@ -0,0 +1,549 @@
+/*
+ * rsapi_sweep.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ *
+ * Sweeps the tuning parameters of the RoadSignAPI (see RSAPIParameters)
+ * on a labeled dataset and prints the combinations which are Pareto
+ * optimal regarding F1 score and processing time per frame.
+ *
+ * The networks only run once per image (and expand percentage): the
+ * dataset is processed with the most permissive parameters (lowest
+ * detector threshold, no duplicates deleted, no classifier threshold)
+ * and every detection is cached together with its classification.
+ * Every parameter combination is then evaluated on the cache: the
+ * detections below the detector threshold are dropped, the duplicates
+ * are deleted by a RoadSignDuplicationDeleter (the same code the pipe
+ * runs) and the classifier threshold is applied. This gives the same
+ * signs as running the pipe with the combination, as the thresholds only
+ * drop detections and the classification of a crop does not depend on
+ * the other detections.
+ *
+ * The time per frame of a combination is estimated from the measured
+ * times of the first pass: detector time per frame plus slicing and
+ * classification time per crop times the crops the combination
+ * classifies, plus the measured time of deleting the duplicates.
+ * The pole range of the grouper is not swept, it does not change which
+ * signs are reported.
+ *
+ * Usage: rsapi_sweep --csv labels.csv --images <image folder>
+ *                    [--instances 4] [--threads 1] [--iou 0.5]
+ *                    [--detector-thresholds 0.2,0.28,0.35,0.45,0.6]
+ *                    [--classifier-thresholds 0.5,0.8,0.9,0.95,0.98]
+ *                    [--overlaps 0.4,0.6,0.8,1.0] [--expands 0.1]
+ *                    [--table sweep.csv] [--max-images 0]
+ *
+ * --table writes all combinations (with a column marking the Pareto
+ * optimal ones) as CSV.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+#include "RoadSignAPI/RoadSignAPI.h"
+#include "FilterManagementLibrary/LatencyHistogram.h"
+#include "FilterManagementLibrary/Utilities.h"
+
+#include "EvaluationDataset.h"
+
+// Positions of the filters in the pipeline statistics, in the order
+// the RoadSignAPI registers them
+static const int DETECTOR_STATISTICS = 0;
+static const int CLASSIFIER_STATISTICS = 1;
+static const int SLICER_STATISTICS = 2;
+
+struct SweepImage : public GroundTruthImage
+{
+	// One list per expand percentage, in the order of the detector.
+	// Signs the classifier did not approve (unwanted classes) have a
+	// classifierConfidence of -1, so no threshold approves them.
+	std::vector<std::vector<RoadSignAPI::DetectedSignDescriptor> > signs;
+	bool processed = false;
+};
+
+struct SweepTimes
+{
+	FilterManagementLibrary::LatencyHistogram detector;
+	FilterManagementLibrary::LatencyHistogram classifier;
+	FilterManagementLibrary::LatencyHistogram slicer;
+
+	// Detections the slicer and the classifier processed
+	uint64_t crops = 0;
+};
+
+struct SweepResult
+{
+	RoadSignAPI::RSAPIParameters parameters;
+	MatchCounts counts;
+	double cropsPerFrame = 0.0;
+	double msPerFrame = 0.0;
+	bool paretoOptimal = false;
+};
+
+static bool parseList(const char* text, std::vector<float>* values)
+{
+	values->clear();
+
+	std::stringstream stream(text);
+	std::string value;
+
+	while(std::getline(stream, value, ','))
+	{
+		char* end;
+		const float number = strtof(value.c_str(), &end);
+
+		if(value.empty() || *end != '\0')
+		{
+			std::cout << "Invalid number " << value << std::endl;
+			return false;
+		}
+
+		values->push_back(number);
+	}
+
+	std::sort(values->begin(), values->end());
+	values->erase(std::unique(values->begin(), values->end()), values->end());
+
+	return !values->empty();
+}
+
+/**
+ * Body of the caching threads: every thread has its own RoadSignAPI and
+ * processes the next image with every expand percentage until all are
+ * done.
+ */
+static void cacheImages(const std::string& imageFolder,
+		const FilterManagementLibrary::TFIntegration::
+		TensorflowNNModelDescription& detectorModelDescription,
+		const FilterManagementLibrary::TFIntegration::
+		TensorflowNNModelDescription& classifierModelDescription,
+		int numThreads, float detectorThreshold,
+		const std::vector<float>& expands, std::vector<SweepImage>* images,
+		std::atomic<size_t>* nextImage, std::atomic<size_t>* doneImages,
+		std::atomic<bool>* failed, SweepTimes* times, std::mutex* timesMutex)
+{
+	std::unique_ptr<RoadSignAPI::RoadSignAPI> roadSignAPI(
+			new RoadSignAPI::RoadSignAPI(detectorModelDescription,
+					classifierModelDescription, numThreads));
+
+	if(!roadSignAPI->init())
+	{
+		std::cout << "Initializing the RoadSignAPI failed" << std::endl;
+		failed->store(true);
+		return;
+	}
+
+	RoadSignAPI::RSAPIParameters parameters;
+	parameters.detectorThreshold = detectorThreshold;
+	parameters.classifierThreshold = 0.0f;
+	parameters.duplicateMinOverlapPercentage = 1.0f;
+
+	std::vector<const RoadSignAPI::DetectedSignDescriptor*> approvedSigns;
+	uint64_t crops = 0;
+
+	for(size_t index = nextImage->fetch_add(1); index < images->size() &&
+			!failed->load(); index = nextImage->fetch_add(1))
+	{
+		SweepImage& image = (*images)[index];
+		const cv::Mat frame = cv::imread(imageFolder + "/" + image.filename);
+
+		if(frame.empty())
+			std::cerr << "Could not read " << image.filename << std::endl;
+		else
+		{
+			image.processed = true;
+			image.signs.resize(expands.size());
+
+			for(size_t i = 0; i < expands.size() && image.processed; i++)
+			{
+				parameters.sliceExpandPercentage = expands[i];
+
+				if(!roadSignAPI->setParameters(parameters) ||
+						!roadSignAPI->feedImage(frame))
+				{
+					image.processed = false;
+					break;
+				}
+
+				const std::vector<RoadSignAPI::DetectedSignDescriptor>&
+					detectedSigns = *roadSignAPI->getDetectedSigns();
+
+				approvedSigns.clear();
+				roadSignAPI->getClassifierApprovedDetectedSigns(
+						&approvedSigns);
+
+				image.signs[i] = detectedSigns;
+				crops += detectedSigns.size();
+
+				std::vector<bool> approved(detectedSigns.size(), false);
+				for(const RoadSignAPI::DetectedSignDescriptor* sign :
+						approvedSigns)
+				{
+					approved[sign - detectedSigns.data()] = true;
+				}
+
+				for(size_t j = 0; j < detectedSigns.size(); j++)
+				{
+					if(!approved[j])
+						image.signs[i][j].classifierConfidence = -1.0f;
+				}
+			}
+		}
+
+		const size_t done = doneImages->fetch_add(1) + 1;
+		if(done % 100 == 0)
+			std::cerr << done << " / " << images->size() << " images\r";
+	}
+
+	const std::vector<FilterManagementLibrary::PipeSystem::
+		PipeFilterStatistics>& statistics =
+			*roadSignAPI->getPipelineStatistics();
+
+	std::lock_guard<std::mutex> lock(*timesMutex);
+
+	times->detector.merge(statistics[DETECTOR_STATISTICS].processingTime);
+	times->classifier.merge(
+			statistics[CLASSIFIER_STATISTICS].processingTime);
+	times->slicer.merge(statistics[SLICER_STATISTICS].processingTime);
+	times->crops += crops;
+}
+
+/**
+ * Evaluates one parameter combination on the cached detections.
+ */
+static void evaluateCombination(const std::vector<SweepImage>& images,
+		size_t expandIndex, double minIoU,
+		RoadSignAPI::RoadSignDuplicationDeleter* deleter,
+		double detectorUsPerFrame, double classificationUsPerCrop,
+		SweepResult* result)
+{
+	const RoadSignAPI::RSAPIParameters& parameters = result->parameters;
+
+	deleter->setMinOverlapPercentage(
+			parameters.duplicateMinOverlapPercentage);
+
+	std::vector<RoadSignAPI::DetectedSignDescriptor> signs;
+	std::vector<std::pair<float, cv::Rect> > detections;
+	std::vector<bool> matched;
+	uint64_t crops = 0;
+	int64_t replayTimeUs = 0;
+
+	for(const SweepImage& image : images)
+	{
+		signs.clear();
+		for(const RoadSignAPI::DetectedSignDescriptor& sign :
+				image.signs[expandIndex])
+		{
+			// The detector keeps the detections above its threshold
+			if(sign.detectorConfidence > parameters.detectorThreshold)
+				signs.push_back(sign);
+		}
+
+		const int64_t startTimeUs =
+				FilterManagementLibrary::Utilities::getTimeUs();
+		deleter->deleteDuplicates(&signs);
+		replayTimeUs += FilterManagementLibrary::Utilities::getTimeUs() -
+				startTimeUs;
+
+		crops += signs.size();
+
+		detections.clear();
+		for(const RoadSignAPI::DetectedSignDescriptor& sign : signs)
+		{
+			if(sign.classifierConfidence >= parameters.classifierThreshold)
+			{
+				detections.push_back(std::make_pair(sign.detectorConfidence,
+						cv::Rect(sign.upperLeft, sign.lowerRight)));
+			}
+		}
+
+		std::sort(detections.begin(), detections.end(),
+				[](const std::pair<float, cv::Rect>& a,
+						const std::pair<float, cv::Rect>& b)
+				{
+					return a.first > b.first;
+				});
+
+		matched.assign(image.groundTruth.size(), false);
+		uint64_t matchedCount = 0;
+
+		for(const std::pair<float, cv::Rect>& detection : detections)
+		{
+			const int bestMatch = findBestMatch(detection.second,
+					image.groundTruth, matched, minIoU);
+
+			if(bestMatch < 0)
+				result->counts.falsePositives++;
+			else
+			{
+				matched[bestMatch] = true;
+				matchedCount++;
+				result->counts.truePositives++;
+			}
+		}
+
+		result->counts.falseNegatives +=
+				image.groundTruth.size() - matchedCount;
+	}
+
+	result->cropsPerFrame = (double) crops / images.size();
+	result->msPerFrame = (detectorUsPerFrame +
+			result->cropsPerFrame * classificationUsPerCrop +
+			(double) replayTimeUs / images.size()) / 1000.0;
+}
+
+/**
+ * Marks the results no other result beats in both F1 score and time.
+ */
+static void markParetoOptimal(std::vector<SweepResult>* results)
+{
+	std::sort(results->begin(), results->end(),
+			[](const SweepResult& a, const SweepResult& b)
+			{
+				if(a.msPerFrame != b.msPerFrame)
+					return a.msPerFrame < b.msPerFrame;
+
+				return a.counts.getF1Score() > b.counts.getF1Score();
+			});
+
+	double bestF1Score = -1.0;
+
+	for(SweepResult& result : *results)
+	{
+		result.paretoOptimal = result.counts.getF1Score() > bestF1Score;
+
+		if(result.paretoOptimal)
+			bestF1Score = result.counts.getF1Score();
+	}
+}
+
+static void printResult(std::ostream& stream, const SweepResult& result,
+		char separator)
+{
+	stream << result.msPerFrame << separator
+		<< result.counts.getF1Score() << separator
+		<< result.counts.getPrecision() << separator
+		<< result.counts.getRecall() << separator
+		<< result.cropsPerFrame << separator
+		<< result.parameters.detectorThreshold << separator
+		<< result.parameters.classifierThreshold << separator
+		<< result.parameters.duplicateMinOverlapPercentage << separator
+		<< result.parameters.sliceExpandPercentage;
+}
+
+int main(int argc, char** argv)
+{
+	std::string groundTruthFile;
+	std::string imageFolder;
+	std::string tableFile;
+	int instanceCount = std::max(1u, std::thread::hardware_concurrency() / 2);
+	int numThreads = 1;
+	double minIoU = 0.5;
+	size_t maxImages = 0;
+
+	std::vector<float> detectorThresholds = {0.2f, 0.28f, 0.35f, 0.45f, 0.6f};
+	std::vector<float> classifierThresholds = {0.5f, 0.8f, 0.9f, 0.95f, 0.98f};
+	std::vector<float> overlaps = {0.4f, 0.6f, 0.8f, 1.0f};
+	std::vector<float> expands = {0.1f};
+
+	for(int i = 1; i < argc; i++)
+	{
+		const bool hasValue = i + 1 < argc;
+
+		if(strcmp(argv[i], "--csv") == 0 && hasValue)
+			groundTruthFile = argv[++i];
+		else if(strcmp(argv[i], "--images") == 0 && hasValue)
+			imageFolder = argv[++i];
+		else if(strcmp(argv[i], "--table") == 0 && hasValue)
+			tableFile = argv[++i];
+		else if(strcmp(argv[i], "--instances") == 0 && hasValue)
+			instanceCount = std::max(atoi(argv[++i]), 1);
+		else if(strcmp(argv[i], "--threads") == 0 && hasValue)
+			numThreads = std::max(atoi(argv[++i]), 1);
+		else if(strcmp(argv[i], "--iou") == 0 && hasValue)
+			minIoU = atof(argv[++i]);
+		else if(strcmp(argv[i], "--max-images") == 0 && hasValue)
+			maxImages = std::max(atoi(argv[++i]), 0);
+		else if(strcmp(argv[i], "--detector-thresholds") == 0 && hasValue)
+		{
+			if(!parseList(argv[++i], &detectorThresholds))
+				return 1;
+		}
+		else if(strcmp(argv[i], "--classifier-thresholds") == 0 && hasValue)
+		{
+			if(!parseList(argv[++i], &classifierThresholds))
+				return 1;
+		}
+		else if(strcmp(argv[i], "--overlaps") == 0 && hasValue)
+		{
+			if(!parseList(argv[++i], &overlaps))
+				return 1;
+		}
+		else if(strcmp(argv[i], "--expands") == 0 && hasValue)
+		{
+			if(!parseList(argv[++i], &expands))
+				return 1;
+		}
+		else
+		{
+			std::cout << "Unknown argument " << argv[i] << std::endl;
+			return 1;
+		}
+	}
+
+	if(groundTruthFile.empty() || imageFolder.empty())
+	{
+		std::cout << "No ground truth (--csv) or image folder (--images) "
+				"given" << std::endl;
+		return 1;
+	}
+
+	std::vector<SweepImage> images;
+	if(!loadGroundTruth(groundTruthFile, &images))
+		return 1;
+
+	if(maxImages > 0 && images.size() > maxImages)
+		images.resize(maxImages);
+
+	instanceCount = std::min<int>(instanceCount, images.size());
+
+	std::cout << "Caching " << images.size() << " images with "
+			<< instanceCount << " instances" << std::endl;
+
+	const FilterManagementLibrary::TFIntegration::TensorflowNNModelDescription
+		detectorModelDescription = RoadSignAPI::RoadSignAPI::
+				getDefaultDetectorModelDescription();
+	const FilterManagementLibrary::TFIntegration::TensorflowNNModelDescription
+		classifierModelDescription = RoadSignAPI::RoadSignAPI::
+				getDefaultClassifierModelDescription();
+
+	std::atomic<size_t> nextImage(0);
+	std::atomic<size_t> doneImages(0);
+	std::atomic<bool> failed(false);
+	SweepTimes times;
+	std::mutex timesMutex;
+	std::vector<std::thread> workers;
+
+	const int64_t startTimeUs = FilterManagementLibrary::Utilities::getTimeUs();
+
+	for(int i = 0; i < instanceCount; i++)
+	{
+		workers.push_back(std::thread(cacheImages, imageFolder,
+				std::cref(detectorModelDescription),
+				std::cref(classifierModelDescription), numThreads,
+				detectorThresholds.front(), std::cref(expands), &images,
+				&nextImage, &doneImages, &failed, &times, &timesMutex));
+	}
+
+	for(std::thread& worker : workers)
+		worker.join();
+
+	if(failed.load())
+		return 1;
+
+	// Images which could not be read would count as misses otherwise
+	images.erase(std::remove_if(images.begin(), images.end(),
+			[](const SweepImage& image) { return !image.processed; }),
+			images.end());
+
+	if(images.empty() || times.detector.getCount() == 0)
+	{
+		std::cout << "No images processed" << std::endl;
+		return 1;
+	}
+
+	const double detectorUsPerFrame = times.detector.getMean();
+	const double classificationUsPerCrop = times.crops == 0 ? 0.0 :
+			(times.classifier.getMean() * times.classifier.getCount() +
+			times.slicer.getMean() * times.slicer.getCount()) / times.crops;
+
+	std::cout << "Cached " << images.size() << " images in "
+			<< (FilterManagementLibrary::Utilities::getTimeUs() -
+					startTimeUs) / 1000000.0 << " s" << std::endl;
+	std::cout << "Detector " << detectorUsPerFrame / 1000.0
+			<< " ms/frame, classification "
+			<< classificationUsPerCrop / 1000.0 << " ms/crop" << std::endl;
+
+	std::vector<SweepResult> results;
+	RoadSignAPI::RoadSignDuplicationDeleter deleter;
+
+	for(size_t e = 0; e < expands.size(); e++)
+	{
+		for(float detectorThreshold : detectorThresholds)
+		{
+			for(float overlap : overlaps)
+			{
+				for(float classifierThreshold : classifierThresholds)
+				{
+					SweepResult result;
+					result.parameters.detectorThreshold = detectorThreshold;
+					result.parameters.classifierThreshold =
+							classifierThreshold;
+					result.parameters.duplicateMinOverlapPercentage = overlap;
+					result.parameters.sliceExpandPercentage = expands[e];
+
+					evaluateCombination(images, e, minIoU, &deleter,
+							detectorUsPerFrame, classificationUsPerCrop,
+							&result);
+
+					results.push_back(result);
+				}
+			}
+		}
+	}
+
+	markParetoOptimal(&results);
+
+	std::cout << std::fixed << std::setprecision(4);
+	std::cout << results.size() << " combinations, IoU >= " << minIoU
+			<< ", Pareto optimal ones:" << std::endl;
+	std::cout << "ms/frame  f1  precision  recall  crops/frame  "
+			"detector  classifier  overlap  expand" << std::endl;
+
+	for(const SweepResult& result : results)
+	{
+		if(result.paretoOptimal)
+		{
+			printResult(std::cout, result, ' ');
+			std::cout << std::endl;
+		}
+	}
+
+	if(!tableFile.empty())
+	{
+		std::ofstream table(tableFile);
+		if(!table)
+		{
+			std::cout << "Could not open " << tableFile << std::endl;
+			return 1;
+		}
+
+		table << "ms_per_frame,f1,precision,recall,crops_per_frame,"
+				"detector_threshold,classifier_threshold,min_overlap,"
+				"expand,pareto\n";
+
+		for(const SweepResult& result : results)
+		{
+			printResult(table, result, ',');
+			table << ',' << (result.paretoOptimal ? 1 : 0) << '\n';
+		}
+	}
+
+	return 0;
+}
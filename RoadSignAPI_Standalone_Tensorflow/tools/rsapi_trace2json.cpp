@@ -0,0 +1,269 @@
+/*
+ * rsapi_trace2json.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ *
+ * Converts a frame trace written by FrameTraceWriter (see
+ * RoadSignAPI::startFrameTrace(...)) to the Chrome trace event JSON
+ * format, which can be opened in chrome://tracing or ui.perfetto.dev.
+ *
+ * Every frame becomes a slice on the "frames" track (with its counters,
+ * degradation flags and queue wait as arguments), the time it waited
+ * before the processing a slice on the "queue wait" track and every
+ * filter that ran a slice on a track of its own. The counters are
+ * additionally shown as counter tracks. Skipped filters are left out.
+ * Times are relative to the first frame of the trace.
+ *
+ * With --top, the slowest frames are printed with their counters, to
+ * find the frames (and scenes) causing latency spikes.
+ *
+ * Usage: rsapi_trace2json --input trace.bin [--output trace.json]
+ *                         [--top 0]
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "FilterManagementLibrary/FrameTrace.h"
+
+struct TracedFrame
+{
+	FilterManagementLibrary::FrameTraceRecordHeader frame;
+	std::vector<int64_t> counters;
+};
+
+static std::string escapeJSON(const std::string& text)
+{
+	std::string escaped;
+
+	for(const char c : text)
+	{
+		if(c == '"' || c == '\\')
+			escaped += '\\';
+
+		if((unsigned char) c >= 0x20)
+			escaped += c;
+	}
+
+	return escaped;
+}
+
+static void writeThreadName(std::ostream& output, int threadID,
+		const std::string& name)
+{
+	output << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+			<< threadID << ",\"args\":{\"name\":\"" << escapeJSON(name)
+			<< "\"}},\n";
+	output << "{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":1,"
+			"\"tid\":" << threadID << ",\"args\":{\"sort_index\":"
+			<< threadID << "}},\n";
+}
+
+static void writeSlice(std::ostream& output, int threadID,
+		const std::string& name, int64_t startTimeUs, int64_t durationUs)
+{
+	output << "{\"name\":\"" << escapeJSON(name) << "\",\"ph\":\"X\","
+			"\"pid\":1,\"tid\":" << threadID << ",\"ts\":" << startTimeUs
+			<< ",\"dur\":" << durationUs;
+}
+
+int main(int argc, char** argv)
+{
+	std::string input;
+	std::string outputFile;
+	size_t topFrames = 0;
+
+	for(int i = 1; i < argc; i++)
+	{
+		const bool hasValue = i + 1 < argc;
+
+		if(strcmp(argv[i], "--input") == 0 && hasValue)
+			input = argv[++i];
+		else if(strcmp(argv[i], "--output") == 0 && hasValue)
+			outputFile = argv[++i];
+		else if(strcmp(argv[i], "--top") == 0 && hasValue)
+			topFrames = std::max(atoi(argv[++i]), 0);
+		else
+		{
+			std::cout << "Unknown argument " << argv[i] << std::endl;
+			return 1;
+		}
+	}
+
+	if(input.empty())
+	{
+		std::cout << "No input given (--input)" << std::endl;
+		return 1;
+	}
+
+	FilterManagementLibrary::FrameTraceReader reader;
+	if(!reader.open(input))
+		return 1;
+
+	const std::vector<std::string>& filterNames = reader.getFilterNames();
+	const std::vector<std::string>& counterNames = reader.getCounterNames();
+
+	std::vector<TracedFrame> frames;
+	std::vector<std::vector<FilterManagementLibrary::PipeSystem::
+		PipeFilterTiming> > filterTimings;
+
+	TracedFrame tracedFrame;
+	std::vector<FilterManagementLibrary::PipeSystem::PipeFilterTiming> timings;
+
+	while(reader.readNext(&tracedFrame.frame, &timings, &tracedFrame.counters))
+	{
+		frames.push_back(tracedFrame);
+		filterTimings.push_back(timings);
+	}
+
+	std::cout << "Read " << frames.size() << " frames" << std::endl;
+
+	if(frames.empty())
+		return 0;
+
+	int64_t baseTimeUs = frames[0].frame.startTimeUs;
+	for(const TracedFrame& frame : frames)
+	{
+		baseTimeUs = std::min(baseTimeUs,
+				std::min(frame.frame.arrivalTimeUs, frame.frame.startTimeUs));
+	}
+
+	if(!outputFile.empty())
+	{
+		std::ofstream output(outputFile);
+		if(!output)
+		{
+			std::cout << "Could not open " << outputFile << std::endl;
+			return 1;
+		}
+
+		// Track 0: frames, 1: queue wait, 2...: filters
+		output << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+		output << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,"
+				"\"args\":{\"name\":\"RoadSignAPI\"}},\n";
+
+		writeThreadName(output, 0, "frames");
+		writeThreadName(output, 1, "queue wait");
+		for(size_t i = 0; i < filterNames.size(); i++)
+			writeThreadName(output, 2 + i, filterNames[i]);
+
+		for(size_t index = 0; index < frames.size(); index++)
+		{
+			const FilterManagementLibrary::FrameTraceRecordHeader& frame =
+					frames[index].frame;
+			const int64_t startTimeUs = frame.startTimeUs - baseTimeUs;
+			const int64_t queueWaitUs =
+					frame.startTimeUs - frame.arrivalTimeUs;
+			const std::string frameName = "frame " +
+					std::to_string(frame.frameID);
+
+			writeSlice(output, 0, frameName, startTimeUs,
+					frame.endTimeUs - frame.startTimeUs);
+
+			output << ",\"args\":{\"frame\":" << frame.frameID
+					<< ",\"processed\":" << frame.processed
+					<< ",\"degradation_flags\":" << frame.flags
+					<< ",\"queue_wait_us\":" << queueWaitUs;
+
+			for(size_t i = 0; i < counterNames.size(); i++)
+			{
+				output << ",\"" << escapeJSON(counterNames[i]) << "\":"
+						<< frames[index].counters[i];
+			}
+			output << "}},\n";
+
+			if(queueWaitUs > 0)
+			{
+				writeSlice(output, 1, frameName,
+						frame.arrivalTimeUs - baseTimeUs, queueWaitUs);
+				output << "},\n";
+			}
+
+			for(size_t i = 0; i < filterNames.size(); i++)
+			{
+				const FilterManagementLibrary::PipeSystem::PipeFilterTiming&
+					timing = filterTimings[index][i];
+
+				if(timing.startTimeUs == 0 ||
+						timing.endTimeUs == timing.startTimeUs)
+				{
+					continue;
+				}
+
+				writeSlice(output, 2 + i, filterNames[i],
+						timing.startTimeUs - baseTimeUs,
+						timing.endTimeUs - timing.startTimeUs);
+				output << ",\"args\":{\"frame\":" << frame.frameID << "}},\n";
+			}
+
+			for(size_t i = 0; i < counterNames.size(); i++)
+			{
+				output << "{\"name\":\"" << escapeJSON(counterNames[i])
+						<< "\",\"ph\":\"C\",\"pid\":1,\"ts\":" << startTimeUs
+						<< ",\"args\":{\"value\":" << frames[index].counters[i]
+						<< "}},\n";
+			}
+		}
+
+		// The metadata event avoids special handling of the last comma
+		output << "{\"name\":\"trace_end\",\"ph\":\"M\",\"pid\":1,"
+				"\"args\":{}}\n]}\n";
+
+		if(!output)
+		{
+			std::cout << "Writing " << outputFile << " failed" << std::endl;
+			return 1;
+		}
+
+		std::cout << "Wrote " << outputFile << std::endl;
+	}
+
+	if(topFrames > 0)
+	{
+		std::vector<size_t> order(frames.size());
+		for(size_t i = 0; i < order.size(); i++)
+			order[i] = i;
+
+		std::sort(order.begin(), order.end(), [&frames](size_t a, size_t b)
+				{
+					return frames[a].frame.endTimeUs -
+							frames[a].frame.arrivalTimeUs >
+							frames[b].frame.endTimeUs -
+							frames[b].frame.arrivalTimeUs;
+				});
+
+		order.resize(std::min(order.size(), topFrames));
+
+		std::cout << "frame  latency_ms  queue_ms  flags";
+		for(const std::string& counterName : counterNames)
+			std::cout << "  " << counterName;
+		std::cout << std::endl;
+
+		std::cout << std::fixed << std::setprecision(2);
+
+		for(size_t index : order)
+		{
+			const FilterManagementLibrary::FrameTraceRecordHeader& frame =
+					frames[index].frame;
+
+			std::cout << frame.frameID << "  "
+					<< (frame.endTimeUs - frame.arrivalTimeUs) / 1000.0 << "  "
+					<< (frame.startTimeUs - frame.arrivalTimeUs) / 1000.0
+					<< "  " << frame.flags;
+
+			for(int64_t counter : frames[index].counters)
+				std::cout << "  " << counter;
+			std::cout << std::endl;
+		}
+	}
+
+	return 0;
+}
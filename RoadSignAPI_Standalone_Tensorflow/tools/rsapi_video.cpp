@@ -0,0 +1,258 @@
+/*
+ * rsapi_video.cpp
+ *
+ *  Created on: 19.10.2026
+ *      Author: oracion
+ *
+ * Runs the RoadSignAPI on a recorded video (or a stream), see
+ * VideoProcessor. Writes the detected sign combinations of every
+ * processed frame as CSV and, optionally, an annotated video.
+ *
+ * Usage: rsapi_video --input drive.mp4 [--results results.csv]
+ *                    [--output annotated.mp4] [--stride 1] [--start 0]
+ *                    [--max-frames 0] [--decode-ahead 4] [--threads 2]
+ *                    [--labels] [--trace trace.bin] [--counters]
+ *                    [--memory]
+ *
+ * CSV columns: frame,track,combination,class,confidence,x1,y1,x2,y2
+ *
+ * --trace writes a record per processed frame (filter times, box counts),
+ * see RoadSignAPI::startFrameTrace(...) and rsapi_trace2json.
+ * --counters prints the hardware counters of each filter (and of its
+ * model inference), see PerformanceCounters.
+ * --memory prints the current and peak memory of the pipe, the models and
+ * of Tensorflow and OpenCV as a whole, see MemoryAccount.
+ */
+
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "RoadSignAPI/RoadSignAPI.h"
+#include "RoadSignAPI/VideoProcessor.h"
+
+static std::atomic<bool> stopRequested(false);
+
+static void handleSignal(int)
+{
+	stopRequested.store(true);
+}
+
+static double toMs(int64_t timeUs)
+{
+	return timeUs / 1000.0;
+}
+
+static void printCounters(const char* name,
+		const FilterManagementLibrary::PerformanceCounterValues& counters)
+{
+	if(counters.samples == 0)
+		return;
+
+	std::cout << "  " << name << ": " << counters.cycles / counters.samples
+			<< " cycles, " << counters.instructions / counters.samples
+			<< " instructions per call, IPC "
+			<< counters.getInstructionsPerCycle() << ", LLC misses/kI "
+			<< counters.getCacheMissesPerKiloInstruction()
+			<< ", branch misses/kI "
+			<< counters.getBranchMissesPerKiloInstruction() << std::endl;
+}
+
+static void printMemoryUsage(const char* name,
+		const FilterManagementLibrary::MemoryUsage& usage)
+{
+	std::cout << "  " << name << ": " << usage.currentBytes / 1048576.0
+			<< " MiB, peak " << usage.peakBytes / 1048576.0 << " MiB, "
+			<< usage.liveAllocations << " allocations" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+	std::string input;
+	std::string resultsFile;
+	std::string traceFile;
+	bool counters = false;
+	bool memory = false;
+	int numThreads = 2;
+	RoadSignAPI::VideoProcessorOptions options;
+
+	for(int i = 1; i < argc; i++)
+	{
+		const bool hasValue = i + 1 < argc;
+
+		if(strcmp(argv[i], "--input") == 0 && hasValue)
+			input = argv[++i];
+		else if(strcmp(argv[i], "--results") == 0 && hasValue)
+			resultsFile = argv[++i];
+		else if(strcmp(argv[i], "--output") == 0 && hasValue)
+			options.outputFile = argv[++i];
+		else if(strcmp(argv[i], "--stride") == 0 && hasValue)
+			options.stride = atoi(argv[++i]);
+		else if(strcmp(argv[i], "--start") == 0 && hasValue)
+			options.startFrame = atoi(argv[++i]);
+		else if(strcmp(argv[i], "--max-frames") == 0 && hasValue)
+			options.maxFrames = atoi(argv[++i]);
+		else if(strcmp(argv[i], "--decode-ahead") == 0 && hasValue)
+			options.decodeAheadFrames = atoi(argv[++i]);
+		else if(strcmp(argv[i], "--threads") == 0 && hasValue)
+			numThreads = atoi(argv[++i]);
+		else if(strcmp(argv[i], "--trace") == 0 && hasValue)
+			traceFile = argv[++i];
+		else if(strcmp(argv[i], "--counters") == 0)
+			counters = true;
+		else if(strcmp(argv[i], "--memory") == 0)
+			memory = true;
+		else if(strcmp(argv[i], "--labels") == 0)
+			options.annotationOptions.drawLabels = true;
+		else
+		{
+			std::cout << "Unknown argument " << argv[i] << std::endl;
+			return 1;
+		}
+	}
+
+	if(input.empty())
+	{
+		std::cout << "No input given (--input)" << std::endl;
+		return 1;
+	}
+
+	std::ofstream results;
+	if(!resultsFile.empty())
+	{
+		results.open(resultsFile);
+		if(!results)
+		{
+			std::cout << "Could not open " << resultsFile << std::endl;
+			return 1;
+		}
+		results << "frame,track,combination,class,confidence,x1,y1,x2,y2\n";
+	}
+
+	if(!RoadSignAPI::RoadSignAPI::staticInit(numThreads))
+	{
+		std::cout << "Initializing the RoadSignAPI failed" << std::endl;
+		return 1;
+	}
+
+	if(!traceFile.empty() &&
+			!RoadSignAPI::RoadSignAPI::staticStartFrameTrace(traceFile))
+		return 1;
+
+	if(counters &&
+			!RoadSignAPI::RoadSignAPI::staticSetPerformanceCountersEnabled(true))
+	{
+		std::cout << "Hardware counters are not available" << std::endl;
+		counters = false;
+	}
+
+	RoadSignAPI::VideoProcessor videoProcessor;
+
+	if(!videoProcessor.open(input))
+		return 1;
+
+	videoProcessor.setOptions(options);
+
+	if(results.is_open())
+	{
+		videoProcessor.setFrameCallback(
+				[&results](uint64_t frameIndex, const cv::Mat&)
+				{
+					const std::vector<RoadSignAPI::DetectedSignCombination>*
+						const signCombinations = RoadSignAPI::RoadSignAPI::
+						staticGetDetectedSignCombinations();
+
+					for(size_t i = 0; i < signCombinations->size(); i++)
+					{
+						const RoadSignAPI::DetectedSignCombination&
+							signCombination = (*signCombinations)[i];
+
+						for(const RoadSignAPI::DetectedSignDescriptor& sign :
+								*signCombination.getSignsInCombination())
+						{
+							results << frameIndex << ','
+								<< signCombination.getTrackID() << ','
+								<< i << ','
+								<< sign.classifierApprovedClassID << ','
+								<< sign.classifierConfidence << ','
+								<< sign.upperLeft.x << ','
+								<< sign.upperLeft.y << ','
+								<< sign.lowerRight.x << ','
+								<< sign.lowerRight.y << '\n';
+						}
+					}
+				});
+	}
+
+	signal(SIGINT, handleSignal);
+	signal(SIGTERM, handleSignal);
+
+	bool success = videoProcessor.run(&stopRequested);
+
+	if(!traceFile.empty() && !RoadSignAPI::RoadSignAPI::staticStopFrameTrace())
+		success = false;
+
+	const RoadSignAPI::VideoProcessorStatistics& statistics =
+			videoProcessor.getStatistics();
+
+	std::cout << "Processed " << statistics.processedFrames << " of "
+			<< statistics.decodedFrames << " decoded frames ("
+			<< statistics.encodedFrames << " encoded) in "
+			<< toMs(statistics.totalTimeUs) << " ms" << std::endl;
+
+	if(statistics.processedFrames > 0)
+	{
+		std::cout << "Frames per second: " << statistics.processedFrames /
+				(statistics.totalTimeUs / 1000000.0) << std::endl;
+	}
+
+	std::cout << "Decode " << toMs(statistics.decodeTimeUs)
+			<< " ms, process " << toMs(statistics.processTimeUs)
+			<< " ms, encode " << toMs(statistics.encodeTimeUs) << " ms"
+			<< std::endl;
+	std::cout << "Waited for decoding " << toMs(statistics.decodeWaitTimeUs)
+			<< " ms, for encoding " << toMs(statistics.encodeWaitTimeUs)
+			<< " ms" << std::endl;
+
+	if(counters)
+	{
+		// In the order the filters are registered
+		const char* const filterNames[] = {"SSDLiteRoadSignDetector",
+				"MobilenetV2RoadSignClassificator",
+				"DetectionBasedImageSlicer", "ClassifiedSignsGrouper",
+				"RoadSignDuplicationDeleter"};
+
+		const std::vector<FilterManagementLibrary::PipeSystem::
+			PipeFilterStatistics>& statistics =
+				*RoadSignAPI::RoadSignAPI::staticGetPipelineStatistics();
+
+		for(size_t i = 0; i < statistics.size() && i < 5; i++)
+		{
+			std::cout << filterNames[i] << std::endl;
+			printCounters("process", statistics[i].processCounters);
+			printCounters("inference", statistics[i].sectionCounters);
+		}
+	}
+
+	if(memory)
+	{
+		std::cout << "Memory" << std::endl;
+		printMemoryUsage("pipeline", RoadSignAPI::RoadSignAPI::
+				staticGetPipelineMemoryUsage());
+		printMemoryUsage("detector", RoadSignAPI::RoadSignAPI::
+				staticGetDetectorMemoryUsage());
+		printMemoryUsage("classifier", RoadSignAPI::RoadSignAPI::
+				staticGetClassifierMemoryUsage());
+		printMemoryUsage("tensorflow", FilterManagementLibrary::
+				MemoryAccount::getTensorflowAccount()->getUsage());
+		printMemoryUsage("opencv", FilterManagementLibrary::
+				MemoryAccount::getOpenCVAccount()->getUsage());
+	}
+
+	return success ? 0 : 1;
+}